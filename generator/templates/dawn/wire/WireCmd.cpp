@@ -296,20 +296,27 @@
             {% endif %}
                 auto memberLength = {{member_length(member, "record.")}};
 
-                {{member_transfer_type(member)}}* memberBuffer;
-                WIRE_TRY(buffer->NextN(memberLength, &memberBuffer));
-
-                {% if member.type.is_wire_transparent %}
-                    memcpy(
-                        memberBuffer, record.{{memberName}},
-                        {{member_transfer_sizeof(member)}} * memberLength);
+                //* Data-only members (e.g. "data" in WriteBuffer and WriteTexture) can be large
+                //* and are serialized with NextData so that they can be gathered without a copy.
+                {% if member.json_data["wire_is_data_only"] %}
+                    WIRE_TRY(buffer->NextData(memberLength, record.{{memberName}}));
                 {% else %}
-                    //* This loop cannot overflow because it iterates up to |memberLength|. Even if
-                    //* memberLength were the maximum integer value, |i| would become equal to it
-                    //* just before exiting the loop, but not increment past or wrap around.
-                    for (decltype(memberLength) i = 0; i < memberLength; ++i) {
-                        {{serialize_member(member, "record." + memberName + "[i]", "memberBuffer[i]" )}}
-                    }
+                    {{member_transfer_type(member)}}* memberBuffer;
+                    WIRE_TRY(buffer->NextN(memberLength, &memberBuffer));
+
+                    {% if member.type.is_wire_transparent %}
+                        memcpy(
+                            memberBuffer, record.{{memberName}},
+                            {{member_transfer_sizeof(member)}} * memberLength);
+                    {% else %}
+                        //* This loop cannot overflow because it iterates up to |memberLength|. Even
+                        //* if memberLength were the maximum integer value, |i| would become equal
+                        //* to it just before exiting the loop, but not increment past or wrap
+                        //* around.
+                        for (decltype(memberLength) i = 0; i < memberLength; ++i) {
+                            {{serialize_member(member, "record." + memberName + "[i]", "memberBuffer[i]" )}}
+                        }
+                    {% endif %}
                 {% endif %}
             }
         {% endfor %}
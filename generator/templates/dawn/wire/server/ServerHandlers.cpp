@@ -115,7 +115,7 @@ namespace dawn::wire::server {
             if (result != WireResult::Success) {
                 return nullptr;
             }
-            mAllocator.Reset();
+            mAllocator.Reset(static_cast<uint32_t>(cmdId));
         }
 
         if (deserializeBuffer.AvailableSize() != 0) {
@@ -65,6 +65,30 @@ struct FeatureInfo {
     FeatureState featureState;
 };
 
+// A struct to record the value of one of the CPU counters of a device, see GetDeviceCounters.
+struct CounterInfo {
+    const char* name;
+    uint64_t value;
+};
+
+// Statistics of the staging memory a device uses to upload data, see GetStagingMemoryStats.
+struct StagingMemoryStats {
+    // The ring buffers small uploads are sub-allocated from, and the size of the new ones.
+    uint64_t ringBufferCount = 0;
+    uint64_t ringBufferBytes = 0;
+    uint64_t ringBufferSize = 0;
+    // The staging buffers dedicated to uploads that are not complete yet.
+    uint64_t pendingStagingBytes = 0;
+    // The dedicated staging buffers kept for reuse by the next large uploads.
+    uint64_t pooledStagingBufferCount = 0;
+    uint64_t pooledStagingBytes = 0;
+    // The number of staging buffers created, of large uploads that reused a pooled staging buffer,
+    // and of pooled staging buffers released, since the device was created.
+    uint64_t stagingBuffersCreated = 0;
+    uint64_t stagingBuffersReused = 0;
+    uint64_t stagingBuffersReleased = 0;
+};
+
 // An adapter is an object that represent on possibility of creating devices in the system.
 // Most of the time it will represent a combination of a physical GPU and an API. Not that the
 // same GPU can be represented by multiple adapters but on different APIs.
@@ -224,6 +248,20 @@ DAWN_NATIVE_EXPORT size_t GetLazyClearCountForTesting(WGPUDevice device);
 // Backdoor to get the number of deprecation warnings for testing
 DAWN_NATIVE_EXPORT size_t GetDeprecationWarningCountForTesting(WGPUDevice device);
 
+// Backdoor to get the number of command blocks the device had to allocate instead of reusing a
+// pooled one, for testing
+DAWN_NATIVE_EXPORT uint64_t GetAllocatedCommandBlockCountForTesting(WGPUDevice device);
+
+// Query a snapshot of the device's CPU counters: the objects created per type, the hits and misses
+// of the device's caches, the bytes of commands encoded and of data uploaded through the staging
+// buffers, and the time spent validating command buffers in Finish and Submit and compiling shaders
+// per stage.
+DAWN_NATIVE_EXPORT std::vector<CounterInfo> GetDeviceCounters(WGPUDevice device);
+
+// Query the statistics of the staging memory used by Queue::WriteBuffer, Queue::WriteTexture and
+// the lazy clears of the device.
+DAWN_NATIVE_EXPORT StagingMemoryStats GetStagingMemoryStats(WGPUDevice device);
+
 // Backdoor to get the number of physical devices an instance knows about for testing
 DAWN_NATIVE_EXPORT size_t GetPhysicalDeviceCountForTesting(WGPUInstance instance);
 
@@ -45,6 +45,8 @@ class DAWN_PLATFORM_EXPORT CachingInterface {
     virtual size_t LoadData(const void* key, size_t keySize, void* valueOut, size_t valueSize) = 0;
 
     // StoreData puts a |value| in the cache which corresponds to the |key|.
+    //
+    // LoadData and StoreData may be called concurrently from multiple threads.
     virtual void StoreData(const void* key,
                            size_t keySize,
                            const void* value,
@@ -65,12 +67,25 @@ class DAWN_PLATFORM_EXPORT WaitableEvent {
 
 using PostWorkerTaskCallback = void (*)(void* userdata);
 
+// Pipeline compilations should use High while opportunistic work like cache writes should use Low
+// so they don't delay work that the application is waiting on.
+enum class WorkerTaskPriority : uint32_t {
+    High = 0,
+    Normal = 1,
+    Low = 2,
+};
+
 class DAWN_PLATFORM_EXPORT WorkerTaskPool {
   public:
     WorkerTaskPool() = default;
     virtual ~WorkerTaskPool() = default;
     virtual std::unique_ptr<WaitableEvent> PostWorkerTask(PostWorkerTaskCallback,
                                                           void* userdata) = 0;
+    // Pools that don't support priorities run the task like PostWorkerTask().
+    virtual std::unique_ptr<WaitableEvent> PostWorkerTaskWithPriority(
+        PostWorkerTaskCallback callback,
+        void* userdata,
+        WorkerTaskPriority priority);
 };
 
 class DAWN_PLATFORM_EXPORT Platform {
@@ -15,6 +15,7 @@
 #ifndef INCLUDE_DAWN_WIRE_WIRE_H_
 #define INCLUDE_DAWN_WIRE_WIRE_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
@@ -23,6 +24,13 @@
 
 namespace dawn::wire {
 
+// A reference to a range of serialized command bytes, used to serialize commands without copying
+// their inline data.
+struct CommandPayload {
+    const void* data;
+    size_t size;
+};
+
 class DAWN_WIRE_EXPORT CommandSerializer {
   public:
     CommandSerializer();
@@ -38,6 +46,15 @@ class DAWN_WIRE_EXPORT CommandSerializer {
     virtual bool Flush() = 0;
     virtual size_t GetMaximumAllocationSize() const = 0;
     virtual void OnSerializeError();
+
+    // Serializes the concatenation of the |count| payloads, as if their bytes were written in
+    // successive GetCmdSpace allocations. This is used for commands larger than
+    // GetMaximumAllocationSize, and the payloads may point directly to application data like the
+    // contents of a Queue::WriteBuffer, so they are only valid for the duration of the call.
+    // The default implementation copies the payloads in chunks of GetMaximumAllocationSize bytes.
+    // Serializers that support vectored writes can override it to avoid the copy. Return false to
+    // indicate a fatal error.
+    virtual bool SerializeCommandPayloads(const CommandPayload* payloads, size_t count);
 };
 
 class DAWN_WIRE_EXPORT CommandHandler {
@@ -70,6 +70,12 @@ class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
     // them periodically to ensure progress on asynchronous work is made.
     bool IsDeviceKnown(WGPUDevice device) const;
 
+    // Counters of the memory allocated to deserialize commands, used for profiling. |commandId|
+    // is the id of a type of command on the wire.
+    uint64_t GetDeserializeAllocatedBytes() const;
+    uint64_t GetDeserializeAllocatedBytes(uint32_t commandId) const;
+    uint64_t GetDeserializeHeapAllocationCount() const;
+
   private:
     std::unique_ptr<server::Server> mImpl;
 };
@@ -15,7 +15,10 @@
 #ifndef SRC_DAWN_COMMON_CONTENTLESSOBJECTCACHE_H_
 #define SRC_DAWN_COMMON_CONTENTLESSOBJECTCACHE_H_
 
+#include <array>
+#include <cstdint>
 #include <mutex>
+#include <shared_mutex>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
@@ -141,6 +144,10 @@ struct ContentLessObjectCacheKeyFuncs {
 
 }  // namespace detail
 
+// The cache is split in shards selected by the content hash of the objects, each with its own
+// reader-writer lock. Threads looking up different blueprints don't contend with each other, and
+// lookups of the same blueprint, which are the common case once the cache is warm, only take the
+// lock in shared mode.
 template <typename RefCountedT>
 class ContentLessObjectCache {
     static_assert(std::is_base_of_v<detail::ContentLessObjectCacheableBase, RefCountedT>,
@@ -157,10 +164,12 @@ class ContentLessObjectCache {
     // inserted or existing object, and the second is a bool that is true if we inserted
     // `object` and false otherwise.
     std::pair<Ref<RefCountedT>, bool> Insert(RefCountedT* obj) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        detail::WeakRefAndHash<RefCountedT> weakref =
-            std::make_pair(GetWeakRef(obj), typename RefCountedT::HashFunc()(obj));
-        auto [it, inserted] = mCache.insert(weakref);
+        const size_t hash = typename RefCountedT::HashFunc()(obj);
+        Shard& shard = GetShard(hash);
+
+        std::lock_guard<std::shared_mutex> lock(shard.mutex);
+        detail::WeakRefAndHash<RefCountedT> weakref = std::make_pair(GetWeakRef(obj), hash);
+        auto [it, inserted] = shard.cache.insert(weakref);
         if (inserted) {
             obj->mCache = this;
             return {obj, inserted};
@@ -172,8 +181,8 @@ class ContentLessObjectCache {
             if (ref != nullptr) {
                 return {ref, false};
             } else {
-                mCache.erase(it);
-                auto result = mCache.insert(weakref);
+                shard.cache.erase(it);
+                auto result = shard.cache.insert(weakref);
                 ASSERT(result.second);
                 obj->mCache = this;
                 return {obj, true};
@@ -183,9 +192,12 @@ class ContentLessObjectCache {
 
     // Returns a valid Ref<T> if we can Promote the underlying WeakRef. Returns nullptr otherwise.
     Ref<RefCountedT> Find(RefCountedT* blueprint) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto it = mCache.find(blueprint);
-        if (it != mCache.end()) {
+        Shard& shard = GetShard(typename RefCountedT::HashFunc()(blueprint));
+
+        // Promoting WeakRefs is thread-safe so lookups only need to exclude modifications.
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.cache.find(blueprint);
+        if (it != shard.cache.end()) {
             return std::get<detail::WeakRefAndHash<RefCountedT>>(*it).first.Promote();
         }
         return nullptr;
@@ -194,27 +206,50 @@ class ContentLessObjectCache {
     // Erases the object from the cache if it exists and are pointer equal. Otherwise does not
     // modify the cache.
     void Erase(RefCountedT* obj) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto it = mCache.find(detail::ForErase<RefCountedT>(obj));
-        if (it == mCache.end()) {
+        Shard& shard = GetShard(typename RefCountedT::HashFunc()(obj));
+
+        std::lock_guard<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.cache.find(detail::ForErase<RefCountedT>(obj));
+        if (it == shard.cache.end()) {
             return;
         }
         obj->mCache = nullptr;
-        mCache.erase(it);
+        shard.cache.erase(it);
     }
 
     // Returns true iff the cache is empty.
     bool Empty() {
-        std::lock_guard<std::mutex> lock(mMutex);
-        return mCache.empty();
+        for (Shard& shard : mShards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            if (!shard.cache.empty()) {
+                return false;
+            }
+        }
+        return true;
     }
 
   private:
-    std::mutex mMutex;
-    std::unordered_set<detail::ContentLessObjectCacheKey<RefCountedT>,
-                       typename detail::ContentLessObjectCacheKeyFuncs<RefCountedT>::HashFunc,
-                       typename detail::ContentLessObjectCacheKeyFuncs<RefCountedT>::EqualityFunc>
-        mCache;
+    static constexpr uint32_t kShardCountLog2 = 4;
+
+    // Each shard is aligned to avoid false sharing between the locks of neighboring shards.
+    struct alignas(64) Shard {
+        std::shared_mutex mutex;
+        std::unordered_set<
+            detail::ContentLessObjectCacheKey<RefCountedT>,
+            typename detail::ContentLessObjectCacheKeyFuncs<RefCountedT>::HashFunc,
+            typename detail::ContentLessObjectCacheKeyFuncs<RefCountedT>::EqualityFunc>
+            cache;
+    };
+
+    Shard& GetShard(size_t hash) {
+        // Use the high bits of a multiplicative hash so that the shard index isn't correlated
+        // with the bucket index inside the shard's set.
+        constexpr uint64_t kGoldenRatio = 0x9E3779B97F4A7C15ull;
+        uint64_t mixed = static_cast<uint64_t>(hash) * kGoldenRatio;
+        return mShards[mixed >> (64 - kShardCountLog2)];
+    }
+
+    std::array<Shard, 1u << kShardCountLog2> mShards;
 };
 
 }  // namespace dawn
@@ -15,6 +15,7 @@
 #include "dawn/common/SlabAllocator.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <limits>
 #include <new>
@@ -24,6 +25,16 @@
 
 namespace dawn {
 
+// SlabAllocatorStats
+
+double SlabAllocatorStats::GetFragmentation() const {
+    if (totalBlocks == 0) {
+        return 0.0;
+    }
+    size_t usedBlocks = blocksInUse - cachedBlocks;
+    return static_cast<double>(totalBlocks - usedBlocks) / static_cast<double>(totalBlocks);
+}
+
 // IndexLinkNode
 
 SlabAllocatorImpl::IndexLinkNode::IndexLinkNode(Index index, Index nextIndex)
@@ -80,6 +91,9 @@ SlabAllocatorImpl::SlabAllocatorImpl(SlabAllocatorImpl&& rhs)
       mBlockStride(rhs.mBlockStride),
       mBlocksPerSlab(rhs.mBlocksPerSlab),
       mTotalAllocationSize(rhs.mTotalAllocationSize),
+      mSlabCount(rhs.mSlabCount),
+      mBlocksInUse(rhs.mBlocksInUse),
+      mPeakBlocksInUse(rhs.mPeakBlocksInUse),
       mAvailableSlabs(std::move(rhs.mAvailableSlabs)),
       mFullSlabs(std::move(rhs.mFullSlabs)),
       mRecycledSlabs(std::move(rhs.mRecycledSlabs)) {}
@@ -171,7 +185,40 @@ void SlabAllocatorImpl::Slab::Splice() {
 
 void* SlabAllocatorImpl::Allocate() {
     std::lock_guard<std::mutex> lock(mMutex);
+    return AllocateLocked();
+}
+
+void SlabAllocatorImpl::Deallocate(void* ptr) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    DeallocateLocked(ptr);
+}
 
+void SlabAllocatorImpl::AllocateBatch(void** ptrs, size_t count) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (size_t i = 0; i < count; ++i) {
+        ptrs[i] = AllocateLocked();
+    }
+}
+
+void SlabAllocatorImpl::DeallocateBatch(void* const* ptrs, size_t count) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (size_t i = 0; i < count; ++i) {
+        DeallocateLocked(ptrs[i]);
+    }
+}
+
+SlabAllocatorStats SlabAllocatorImpl::GetStats() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    SlabAllocatorStats stats;
+    stats.slabCount = mSlabCount;
+    stats.totalBlocks = mSlabCount * mBlocksPerSlab;
+    stats.blocksInUse = mBlocksInUse;
+    stats.peakBlocksInUse = mPeakBlocksInUse;
+    stats.totalBytes = mSlabCount * mTotalAllocationSize;
+    return stats;
+}
+
+void* SlabAllocatorImpl::AllocateLocked() {
     if (mAvailableSlabs.next == nullptr) {
         GetNewSlab();
     }
@@ -186,10 +233,13 @@ void* SlabAllocatorImpl::Allocate() {
         mFullSlabs.Prepend(slab);
     }
 
+    mBlocksInUse++;
+    mPeakBlocksInUse = std::max(mPeakBlocksInUse, mBlocksInUse);
+
     return ObjectFromNode(node);
 }
 
-void SlabAllocatorImpl::Deallocate(void* ptr) {
+void SlabAllocatorImpl::DeallocateLocked(void* ptr) {
     IndexLinkNode* node = NodeFromObject(ptr);
 
     ASSERT(node->index < mBlocksPerSlab);
@@ -197,7 +247,6 @@ void SlabAllocatorImpl::Deallocate(void* ptr) {
     Slab* slab = reinterpret_cast<Slab*>(static_cast<char*>(firstAllocation) - mSlabBlocksOffset);
     ASSERT(slab != nullptr);
 
-    std::lock_guard<std::mutex> lock(mMutex);
     bool slabWasFull = slab->blocksInUse == mBlocksPerSlab;
     ASSERT(slab->blocksInUse != 0);
     PushFront(slab, node);
@@ -209,6 +258,9 @@ void SlabAllocatorImpl::Deallocate(void* ptr) {
         mRecycledSlabs.Prepend(slab);
     }
 
+    ASSERT(mBlocksInUse != 0);
+    mBlocksInUse--;
+
     // TODO(crbug.com/dawn/825): Occasionally prune slabs if |blocksInUse == 0|.
     // Doing so eagerly hurts performance.
 }
@@ -244,6 +296,138 @@ void SlabAllocatorImpl::GetNewSlab() {
     lastNode->nextIndex = kInvalidIndex;
 
     mAvailableSlabs.Prepend(new (alignedPtr) Slab(allocation, node));
+    mSlabCount++;
+}
+
+// MagazineSlabAllocatorImpl
+
+namespace {
+
+// Each thread gets a sequential id on first use so that the threads of the application spread
+// evenly over the shards of all the MagazineSlabAllocators.
+std::atomic<uint32_t> sNextThreadId{0};
+thread_local uint32_t tThreadId = sNextThreadId.fetch_add(1, std::memory_order_relaxed);
+
+}  // anonymous namespace
+
+MagazineSlabAllocatorImpl::MagazineSlabAllocatorImpl(Index blocksPerSlab,
+                                                     uint32_t objectSize,
+                                                     uint32_t objectAlignment,
+                                                     uint32_t magazineSize,
+                                                     uint32_t shardCount)
+    : SlabAllocatorImpl(blocksPerSlab, objectSize, objectAlignment),
+      mMagazineSize(magazineSize),
+      mShardCount(shardCount),
+      mShards(std::make_unique<Shard[]>(shardCount)) {
+    ASSERT(mMagazineSize > 0);
+    ASSERT(IsPowerOfTwo(mShardCount));
+}
+
+MagazineSlabAllocatorImpl::MagazineSlabAllocatorImpl(MagazineSlabAllocatorImpl&& rhs)
+    : SlabAllocatorImpl(std::move(rhs)),
+      mMagazineSize(rhs.mMagazineSize),
+      mShardCount(rhs.mShardCount),
+      mShards(std::move(rhs.mShards)),
+      mFullMagazines(std::move(rhs.mFullMagazines)),
+      mEmptyMagazines(std::move(rhs.mEmptyMagazines)) {}
+
+MagazineSlabAllocatorImpl::~MagazineSlabAllocatorImpl() {
+    // Give all the cached blocks back to the slabs so that they are all free when they get deleted.
+    if (mShards != nullptr) {
+        for (uint32_t i = 0; i < mShardCount; ++i) {
+            Shard& shard = mShards[i];
+            DeallocateBatch(shard.loaded.data(), shard.loaded.size());
+            DeallocateBatch(shard.previous.data(), shard.previous.size());
+        }
+    }
+    for (const Magazine& magazine : mFullMagazines) {
+        DeallocateBatch(magazine.data(), magazine.size());
+    }
+}
+
+SlabAllocatorStats MagazineSlabAllocatorImpl::GetStats() {
+    size_t cachedBlocks = 0;
+    for (uint32_t i = 0; i < mShardCount; ++i) {
+        Shard& shard = mShards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        cachedBlocks += shard.loaded.size() + shard.previous.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mDepotMutex);
+        cachedBlocks += mFullMagazines.size() * mMagazineSize;
+    }
+
+    SlabAllocatorStats stats = SlabAllocatorImpl::GetStats();
+    stats.cachedBlocks = std::min(cachedBlocks, stats.blocksInUse);
+    return stats;
+}
+
+void* MagazineSlabAllocatorImpl::Allocate() {
+    Shard* shard = GetCurrentThreadShard();
+    std::lock_guard<std::mutex> lock(shard->mutex);
+
+    if (shard->loaded.empty()) {
+        if (!shard->previous.empty()) {
+            std::swap(shard->loaded, shard->previous);
+        } else {
+            bool gotFullMagazine = false;
+            {
+                std::lock_guard<std::mutex> depotLock(mDepotMutex);
+                if (!mFullMagazines.empty()) {
+                    mEmptyMagazines.push_back(std::move(shard->loaded));
+                    shard->loaded = std::move(mFullMagazines.back());
+                    mFullMagazines.pop_back();
+                    gotFullMagazine = true;
+                }
+            }
+
+            if (!gotFullMagazine) {
+                shard->loaded.resize(mMagazineSize);
+                AllocateBatch(shard->loaded.data(), mMagazineSize);
+            }
+        }
+    }
+
+    ASSERT(!shard->loaded.empty());
+    void* ptr = shard->loaded.back();
+    shard->loaded.pop_back();
+    return ptr;
+}
+
+void MagazineSlabAllocatorImpl::Deallocate(void* ptr) {
+    Shard* shard = GetCurrentThreadShard();
+    std::lock_guard<std::mutex> lock(shard->mutex);
+
+    if (shard->loaded.size() == mMagazineSize) {
+        if (shard->previous.size() != mMagazineSize) {
+            ASSERT(shard->previous.empty());
+            std::swap(shard->loaded, shard->previous);
+        } else {
+            // Both magazines are full, hand the previous one back to the depot in bulk.
+            std::lock_guard<std::mutex> depotLock(mDepotMutex);
+            mFullMagazines.push_back(std::move(shard->previous));
+            shard->previous = std::move(shard->loaded);
+            shard->loaded = TakeEmptyMagazineLocked();
+        }
+    }
+
+    shard->loaded.push_back(ptr);
+}
+
+MagazineSlabAllocatorImpl::Shard* MagazineSlabAllocatorImpl::GetCurrentThreadShard() {
+    return &mShards[tThreadId & (mShardCount - 1)];
+}
+
+MagazineSlabAllocatorImpl::Magazine MagazineSlabAllocatorImpl::TakeEmptyMagazineLocked() {
+    Magazine magazine;
+    if (!mEmptyMagazines.empty()) {
+        magazine = std::move(mEmptyMagazines.back());
+        mEmptyMagazines.pop_back();
+        magazine.clear();
+    } else {
+        magazine.reserve(mMagazineSize);
+    }
+    return magazine;
 }
 
 }  // namespace dawn
@@ -15,16 +15,34 @@
 #ifndef SRC_DAWN_COMMON_SLABALLOCATOR_H_
 #define SRC_DAWN_COMMON_SLABALLOCATOR_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "dawn/common/Numeric.h"
 #include "dawn/common/PlacementAllocated.h"
 
 namespace dawn {
 
+// Usage statistics of a SlabAllocator. Blocks are counted as in use from the point of view of the
+// slabs, so for a MagazineSlabAllocator they include the |cachedBlocks| held in magazines.
+struct SlabAllocatorStats {
+    size_t slabCount = 0;
+    size_t totalBlocks = 0;
+    size_t blocksInUse = 0;
+    size_t peakBlocksInUse = 0;
+    size_t cachedBlocks = 0;
+    size_t totalBytes = 0;
+
+    // The ratio of the blocks of all the slabs that are not in use by the application, between 0
+    // and 1.
+    double GetFragmentation() const;
+};
+
 // The SlabAllocator allocates objects out of one or more fixed-size contiguous "slabs" of memory.
 // This makes it very quick to allocate and deallocate fixed-size objects because the allocator only
 // needs to index an offset into pre-allocated memory. It is similar to a pool-allocator that
@@ -66,6 +84,8 @@ class SlabAllocatorImpl {
 
     SlabAllocatorImpl(SlabAllocatorImpl&& rhs);
 
+    SlabAllocatorStats GetStats();
+
   protected:
     // This is essentially a singly linked list using indices instead of pointers,
     // so we store the index of "this" in |this->index|.
@@ -102,7 +122,14 @@ class SlabAllocatorImpl {
     // Deallocate a block of memory.
     void Deallocate(void* ptr);
 
+    // Allocate or deallocate |count| blocks of memory at once, taking the lock a single time.
+    void AllocateBatch(void** ptrs, size_t count);
+    void DeallocateBatch(void* const* ptrs, size_t count);
+
   private:
+    void* AllocateLocked();
+    void DeallocateLocked(void* ptr);
+
     // The maximum value is reserved to indicate the end of the list.
     static Index kInvalidIndex;
 
@@ -160,6 +187,9 @@ class SlabAllocatorImpl {
     };
 
     std::mutex mMutex;
+    size_t mSlabCount = 0;
+    size_t mBlocksInUse = 0;
+    size_t mPeakBlocksInUse = 0;
     SentinelSlab mAvailableSlabs;  // Available slabs to service allocations.
     SentinelSlab mFullSlabs;       // Full slabs. Stored here so we can skip checking them.
     SentinelSlab mRecycledSlabs;   // Recycled slabs. Not immediately added to |mAvailableSlabs| so
@@ -183,6 +213,82 @@ class SlabAllocator : public SlabAllocatorImpl {
     void Deallocate(T* object) { SlabAllocatorImpl::Deallocate(object); }
 };
 
+// An opt-in variant of the SlabAllocator for objects that are allocated and deallocated from many
+// threads at once, which would all serialize on the lock of the SlabAllocator.
+//
+// Each thread is assigned one of several shards that caches free blocks in "magazines", fixed-size
+// stacks of pointers. Most allocations and deallocations only touch the shard's magazines, under a
+// lock that is rarely contended. When a shard runs out of blocks, it gets a full magazine from a
+// shared depot or allocates a whole magazine from the slabs at once. When a shard has too many free
+// blocks, it hands a full magazine back to the depot.
+//
+// Each shard has two magazines, "loaded" and "previous", so that a thread alternating between
+// allocations and deallocations at a magazine boundary doesn't go to the depot every time.
+class MagazineSlabAllocatorImpl : public SlabAllocatorImpl {
+  public:
+    MagazineSlabAllocatorImpl(MagazineSlabAllocatorImpl&& rhs);
+
+    SlabAllocatorStats GetStats();
+
+  protected:
+    MagazineSlabAllocatorImpl(Index blocksPerSlab,
+                              uint32_t objectSize,
+                              uint32_t objectAlignment,
+                              uint32_t magazineSize,
+                              uint32_t shardCount);
+    ~MagazineSlabAllocatorImpl();
+
+    void* Allocate();
+    void Deallocate(void* ptr);
+
+  private:
+    using Magazine = std::vector<void*>;
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        Magazine loaded;
+        Magazine previous;
+    };
+
+    // |mShardCount| is a power of two so that the shard of a thread is found with a mask.
+    Shard* GetCurrentThreadShard();
+    Magazine TakeEmptyMagazineLocked();
+
+    const uint32_t mMagazineSize;
+    const uint32_t mShardCount;
+    std::unique_ptr<Shard[]> mShards;
+
+    std::mutex mDepotMutex;
+    std::vector<Magazine> mFullMagazines;
+    std::vector<Magazine> mEmptyMagazines;
+};
+
+template <typename T>
+class MagazineSlabAllocator : public MagazineSlabAllocatorImpl {
+  public:
+    static constexpr uint32_t kDefaultMagazineSize = 32;
+    static constexpr uint32_t kDefaultShardCount = 8;
+
+    MagazineSlabAllocator(size_t totalObjectBytes,
+                          uint32_t magazineSize = kDefaultMagazineSize,
+                          uint32_t shardCount = kDefaultShardCount,
+                          uint32_t objectSize = u32_sizeof<T>,
+                          uint32_t objectAlignment = u32_alignof<T>)
+        : MagazineSlabAllocatorImpl(totalObjectBytes / objectSize,
+                                    objectSize,
+                                    objectAlignment,
+                                    magazineSize,
+                                    shardCount) {}
+
+    template <typename... Args>
+    T* Allocate(Args&&... args) {
+        void* ptr = MagazineSlabAllocatorImpl::Allocate();
+        return new (ptr) T(std::forward<Args>(args)...);
+    }
+
+    void Deallocate(T* object) { MagazineSlabAllocatorImpl::Deallocate(object); }
+};
+
 }  // namespace dawn
 
 #endif  // SRC_DAWN_COMMON_SLABALLOCATOR_H_
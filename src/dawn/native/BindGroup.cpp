@@ -466,7 +466,7 @@ BindGroupBase::BindGroupBase(DeviceBase* device,
                                                     mBindingData.bufferData[bindingIndex].size;
                                             });
 
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 BindGroupBase::~BindGroupBase() = default;
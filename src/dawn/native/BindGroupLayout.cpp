@@ -25,7 +25,7 @@ BindGroupLayoutBase::BindGroupLayoutBase(DeviceBase* device,
     : ApiObjectBase(device, label),
       mInternalLayout(internal),
       mPipelineCompatibilityToken(pipelineCompatibilityToken) {
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 BindGroupLayoutBase::BindGroupLayoutBase(DeviceBase* device,
@@ -493,6 +493,8 @@ BindGroupLayoutInternalBase::BindGroupLayoutInternalBase(
     DeviceBase* device,
     const BindGroupLayoutDescriptor* descriptor)
     : BindGroupLayoutInternalBase(device, descriptor, kUntrackedByDevice) {
+    // Only track the layout: the BindGroupLayoutBase that wraps it is the object counted as
+    // created, since both have the BindGroupLayout type.
     GetObjectTrackingList()->Track(this);
 }
 
@@ -15,6 +15,8 @@
 #include "dawn/native/BlobCache.h"
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Version_autogen.h"
@@ -24,48 +26,171 @@
 
 namespace dawn::native {
 
-BlobCache::BlobCache(dawn::platform::CachingInterface* cachingInterface)
-    : mCache(cachingInterface) {}
+namespace {
+
+// Returns a Blob that references the data of |blob| and keeps it alive.
+Blob ShareBlob(std::shared_ptr<const Blob> blob) {
+    if (blob == nullptr) {
+        return Blob();
+    }
+    // The shared data is never written to, the const_cast is only needed by Blob's interface.
+    uint8_t* data = const_cast<uint8_t*>(blob->Data());
+    size_t size = blob->Size();
+    return Blob::UnsafeCreateWithDeleter(data, size, [blob = std::move(blob)] {});
+}
+
+}  // anonymous namespace
+
+BlobCache::BlobCache(dawn::platform::CachingInterface* cachingInterface,
+                     dawn::platform::WorkerTaskPool* writerTaskPool)
+    : mCache(cachingInterface), mWriterTaskPool(writerTaskPool) {}
+
+BlobCache::~BlobCache() {
+    Flush();
+}
 
 Blob BlobCache::Load(const CacheKey& key) {
-    std::lock_guard<std::mutex> lock(mMutex);
-    return LoadInternal(key);
+    ASSERT(ValidateCacheKey(key));
+    if (mCache == nullptr) {
+        return Blob();
+    }
+
+    std::string keyString(key.begin(), key.end());
+    Shard& shard = GetShard(keyString);
+
+    std::shared_ptr<InFlightLoad> load;
+    bool isFirstLoad = false;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto pendingStore = shard.pendingStores.find(keyString);
+        if (pendingStore != shard.pendingStores.end()) {
+            return ShareBlob(pendingStore->second);
+        }
+
+        auto [it, inserted] = shard.inFlightLoads.try_emplace(keyString);
+        if (inserted) {
+            it->second = std::make_shared<InFlightLoad>();
+        }
+        load = it->second;
+        isFirstLoad = inserted;
+    }
+
+    if (!isFirstLoad) {
+        std::unique_lock<std::mutex> lock(load->mutex);
+        load->condition.wait(lock, [&load] { return load->done; });
+        return ShareBlob(load->result);
+    }
+
+    Blob blob = LoadFromCachingInterface(key);
+    SharedBlob result = blob.Empty() ? nullptr : std::make_shared<const Blob>(std::move(blob));
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.inFlightLoads.erase(keyString);
+    }
+    {
+        std::lock_guard<std::mutex> lock(load->mutex);
+        load->result = result;
+        load->done = true;
+    }
+    load->condition.notify_all();
+    return ShareBlob(std::move(result));
 }
 
 void BlobCache::Store(const CacheKey& key, size_t valueSize, const void* value) {
-    std::lock_guard<std::mutex> lock(mMutex);
-    StoreInternal(key, valueSize, value);
+    ASSERT(ValidateCacheKey(key));
+    ASSERT(value != nullptr);
+    ASSERT(valueSize > 0);
+    if (mCache == nullptr) {
+        return;
+    }
+    if (mWriterTaskPool == nullptr) {
+        mCache->StoreData(key.data(), key.size(), value, valueSize);
+        return;
+    }
+
+    // The value is only written later so it needs to be copied.
+    Blob copy = CreateBlob(valueSize);
+    memcpy(copy.Data(), value, valueSize);
+    SharedBlob pendingStore = std::make_shared<const Blob>(std::move(copy));
+
+    std::string keyString(key.begin(), key.end());
+    {
+        Shard& shard = GetShard(keyString);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.pendingStores[keyString] = pendingStore;
+    }
+
+    std::lock_guard<std::mutex> lock(mWriteMutex);
+    mWriteQueue.emplace_back(std::move(keyString), std::move(pendingStore));
+    if (!mWriteTaskPosted) {
+        mWriteTaskPosted = true;
+        mWriterTaskPool->PostWorkerTaskWithPriority(WritePendingStores, this,
+                                                    dawn::platform::WorkerTaskPriority::Low);
+    }
 }
 
 void BlobCache::Store(const CacheKey& key, const Blob& value) {
     Store(key, value.Size(), value.Data());
 }
 
-Blob BlobCache::LoadInternal(const CacheKey& key) {
-    ASSERT(ValidateCacheKey(key));
-    if (mCache == nullptr) {
-        return Blob();
-    }
+void BlobCache::Flush() {
+    std::unique_lock<std::mutex> lock(mWriteMutex);
+    mWriteCondition.wait(lock, [this] { return !mWriteTaskPosted; });
+}
+
+BlobCache::Shard& BlobCache::GetShard(const std::string& key) {
+    return mShards[std::hash<std::string>()(key) % kShardCount];
+}
+
+Blob BlobCache::LoadFromCachingInterface(const CacheKey& key) {
     const size_t expectedSize = mCache->LoadData(key.data(), key.size(), nullptr, 0);
     if (expectedSize > 0) {
         // Need to put this inside to trigger copy elision.
         Blob result = CreateBlob(expectedSize);
         const size_t actualSize =
             mCache->LoadData(key.data(), key.size(), result.Data(), expectedSize);
-        ASSERT(expectedSize == actualSize);
-        return result;
+        // The entry may have been evicted or replaced in between, for example by another process
+        // sharing the cache.
+        if (actualSize == expectedSize) {
+            return result;
+        }
     }
     return Blob();
 }
 
-void BlobCache::StoreInternal(const CacheKey& key, size_t valueSize, const void* value) {
-    ASSERT(ValidateCacheKey(key));
-    ASSERT(value != nullptr);
-    ASSERT(valueSize > 0);
-    if (mCache == nullptr) {
-        return;
+// static
+void BlobCache::WritePendingStores(void* userdata) {
+    BlobCache* self = static_cast<BlobCache*>(userdata);
+
+    std::vector<std::pair<std::string, SharedBlob>> batch;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(self->mWriteMutex);
+            if (self->mWriteQueue.empty()) {
+                // Notify while holding the lock since Flush may destroy the BlobCache as soon as
+                // it can take the lock.
+                self->mWriteTaskPosted = false;
+                self->mWriteCondition.notify_all();
+                return;
+            }
+            batch.swap(self->mWriteQueue);
+        }
+
+        for (auto& [key, value] : batch) {
+            self->mCache->StoreData(key.data(), key.size(), value->Data(), value->Size());
+
+            // The entry is removed from the pending stores only once it is in the CachingInterface
+            // so that concurrent loads always find it in one of them. It may have been replaced by
+            // a newer store in the meantime that is still queued.
+            Shard& shard = self->GetShard(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.pendingStores.find(key);
+            if (it != shard.pendingStores.end() && it->second == value) {
+                shard.pendingStores.erase(it);
+            }
+        }
+        batch.clear();
     }
-    mCache->StoreData(key.data(), key.size(), value, valueSize);
 }
 
 bool BlobCache::ValidateCacheKey(const CacheKey& key) {
@@ -15,7 +15,14 @@
 #ifndef SRC_DAWN_NATIVE_BLOBCACHE_H_
 #define SRC_DAWN_NATIVE_BLOBCACHE_H_
 
+#include <array>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "dawn/common/Platform.h"
 #include "dawn/native/Blob.h"
@@ -23,7 +30,8 @@
 
 namespace dawn::platform {
 class CachingInterface;
-}
+class WorkerTaskPool;
+}  // namespace dawn::platform
 
 namespace dawn::native {
 
@@ -31,10 +39,20 @@ class CacheKey;
 class InstanceBase;
 
 // This class should always be thread-safe because it may be called asynchronously. Its purpose
-// is to wrap the CachingInterface provided via a platform.
+// is to wrap the CachingInterface provided via a platform, which must be thread-safe as well.
+//
+// Loads of different keys call into the CachingInterface in parallel, only taking the lock of
+// the shard of their key for a short time. Concurrent loads of the same key are deduplicated so
+// that only the first one queries the CachingInterface while the others wait for its result.
+//
+// When a |writerTaskPool| is given, stores are copied and written to the CachingInterface in
+// batches on a task of that pool instead of on the calling thread. Stores that are not written
+// yet are still returned by Load.
 class BlobCache {
   public:
-    explicit BlobCache(dawn::platform::CachingInterface* cachingInterface = nullptr);
+    explicit BlobCache(dawn::platform::CachingInterface* cachingInterface = nullptr,
+                       dawn::platform::WorkerTaskPool* writerTaskPool = nullptr);
+    ~BlobCache();
 
     // Returns empty blob if the key is not found in the cache.
     Blob Load(const CacheKey& key);
@@ -52,19 +70,49 @@ class BlobCache {
         }
     }
 
+    // Waits until all the deferred stores are written to the CachingInterface.
+    void Flush();
+
   private:
-    // Non-thread safe internal implementations of load and store. Exposed callers that use
-    // these helpers need to make sure that these are entered with `mMutex` held.
-    Blob LoadInternal(const CacheKey& key);
-    void StoreInternal(const CacheKey& key, size_t valueSize, const void* value);
+    // The blobs shared between concurrent loads, and between deferred stores and loads, are
+    // immutable once created.
+    using SharedBlob = std::shared_ptr<const Blob>;
+
+    // A load of the CachingInterface that other loads of the same key wait on.
+    struct InFlightLoad {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool done = false;
+        SharedBlob result;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<InFlightLoad>> inFlightLoads;
+        std::unordered_map<std::string, SharedBlob> pendingStores;
+    };
+    static constexpr size_t kShardCount = 16;
+
+    Shard& GetShard(const std::string& key);
+
+    Blob LoadFromCachingInterface(const CacheKey& key);
+
+    // The task posted on the writer task pool, writes the pending stores until there are none.
+    static void WritePendingStores(void* userdata);
 
     // Validates the cache key for this version of Dawn. At the moment, this is naively checking
     // that the cache key contains the dawn version string in it.
     bool ValidateCacheKey(const CacheKey& key);
 
-    // Protects thread safety of access to mCache.
-    std::mutex mMutex;
     dawn::platform::CachingInterface* mCache;
+    dawn::platform::WorkerTaskPool* mWriterTaskPool;
+    std::array<Shard, kShardCount> mShards;
+
+    // The stores waiting to be written by the writer task, in the order they were made.
+    std::mutex mWriteMutex;
+    std::condition_variable mWriteCondition;
+    std::vector<std::pair<std::string, SharedBlob>> mWriteQueue;
+    bool mWriteTaskPosted = false;
 };
 
 }  // namespace dawn::native
@@ -81,7 +81,7 @@ class ErrorBuffer final : public BufferBase {
             }
             // Since error buffers in this case may allocate memory, we need to track them
             // for destruction on the device.
-            GetObjectTrackingList()->Track(this);
+            TrackInDevice();
         }
     }
 
@@ -182,7 +182,7 @@ BufferBase::BufferBase(DeviceBase* device, const BufferDescriptor* descriptor)
         }
     }
 
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 BufferBase::BufferBase(DeviceBase* device,
@@ -26,6 +26,7 @@
 #include "dawn/native/CacheKey.h"
 #include "dawn/native/CacheResult.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/VisitableMembers.h"
 #include "dawn/platform/metrics/HistogramMacros.h"
@@ -124,11 +125,13 @@ class CacheRequestImpl {
             if constexpr (!detail::IsResultOrError<CacheHitReturnType>::value) {
                 // If the result type is not a ResultOrError, return it.
                 cacheTimer.RecordMicroseconds(cacheHitMetricName.c_str());
+                device->GetCounters()->AddCacheHit(CounterCache::Blob);
                 return ReturnType(CacheResultType::CacheHit(std::move(key), std::move(result)));
             } else {
                 // Otherwise, if the value is a success, also return it.
                 if (DAWN_LIKELY(result.IsSuccess())) {
                     cacheTimer.RecordMicroseconds(cacheHitMetricName.c_str());
+                    device->GetCounters()->AddCacheHit(CounterCache::Blob);
                     return ReturnType(
                         CacheResultType::CacheHit(std::move(key), result.AcquireSuccess()));
                 }
@@ -137,6 +140,7 @@ class CacheRequestImpl {
             }
         }
         // Cache miss, or the CacheHitFn failed.
+        device->GetCounters()->AddCacheMiss(CounterCache::Blob);
         cacheTimer.Reset();
         auto result = cacheMissFn(std::move(r));
         std::string cacheMissMetricName = cacheMetricName + ".CacheMiss";
@@ -24,6 +24,79 @@
 
 namespace dawn::native {
 
+namespace {
+
+void FreeBlocks(CommandBlockPool* pool, CommandBlocks* blocks) {
+    if (pool != nullptr) {
+        pool->ReleaseBlocks(blocks);
+        return;
+    }
+    for (BlockDef& block : *blocks) {
+        free(block.block);
+    }
+    blocks->clear();
+}
+
+}  // anonymous namespace
+
+CommandBlockPool::CommandBlockPool(size_t budget) : mBudget(budget) {}
+
+CommandBlockPool::~CommandBlockPool() {
+    for (std::vector<uint8_t*>& blocks : mFreeBlocks) {
+        for (uint8_t* block : blocks) {
+            free(block);
+        }
+    }
+}
+
+uint8_t* CommandBlockPool::AcquireBlock(size_t size) {
+    size_t sizeClass = GetSizeClass(size);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (sizeClass < kSizeClassCount && !mFreeBlocks[sizeClass].empty()) {
+            uint8_t* block = mFreeBlocks[sizeClass].back();
+            mFreeBlocks[sizeClass].pop_back();
+            mStats.pooledBytes -= size;
+            mStats.reusedBlockCount++;
+            return block;
+        }
+        mStats.allocatedBlockCount++;
+    }
+    return static_cast<uint8_t*>(malloc(size));
+}
+
+void CommandBlockPool::ReleaseBlocks(CommandBlocks* blocks) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (BlockDef& block : *blocks) {
+        size_t sizeClass = GetSizeClass(block.size);
+        if (sizeClass < kSizeClassCount && mStats.pooledBytes + block.size <= mBudget) {
+            mFreeBlocks[sizeClass].push_back(block.block);
+            mStats.pooledBytes += block.size;
+        } else {
+            free(block.block);
+        }
+    }
+    blocks->clear();
+}
+
+CommandBlockPool::Stats CommandBlockPool::GetStats() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mStats;
+}
+
+// static
+size_t CommandBlockPool::GetSizeClass(size_t size) {
+    // The pooled sizes are the sizes CommandAllocator::GetNewBlock doubles through.
+    static_assert(kMinPooledBlockSize == 2 * CommandAllocator::kDefaultBaseAllocationSize);
+    static_assert((kMinPooledBlockSize << (kSizeClassCount - 1)) ==
+                  CommandAllocator::kMaxDefaultAllocationSize);
+
+    if (size < kMinPooledBlockSize || !IsPowerOfTwo(size)) {
+        return kSizeClassCount;
+    }
+    return std::min(size_t(Log2(uint64_t(size / kMinPooledBlockSize))), kSizeClassCount);
+}
+
 // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
 CommandIterator::CommandIterator() {
@@ -34,7 +107,7 @@ CommandIterator::~CommandIterator() {
     ASSERT(IsEmpty());
 }
 
-CommandIterator::CommandIterator(CommandIterator&& other) {
+CommandIterator::CommandIterator(CommandIterator&& other) : mPool(other.mPool) {
     if (!other.IsEmpty()) {
         mBlocks = std::move(other.mBlocks);
         other.Reset();
@@ -44,6 +117,7 @@ CommandIterator::CommandIterator(CommandIterator&& other) {
 
 CommandIterator& CommandIterator::operator=(CommandIterator&& other) {
     ASSERT(IsEmpty());
+    mPool = other.mPool;
     if (!other.IsEmpty()) {
         mBlocks = std::move(other.mBlocks);
         other.Reset();
@@ -52,7 +126,8 @@ CommandIterator& CommandIterator::operator=(CommandIterator&& other) {
     return *this;
 }
 
-CommandIterator::CommandIterator(CommandAllocator allocator) : mBlocks(allocator.AcquireBlocks()) {
+CommandIterator::CommandIterator(CommandAllocator allocator)
+    : mBlocks(allocator.AcquireBlocks()), mPool(allocator.mPool) {
     Reset();
 }
 
@@ -60,6 +135,9 @@ void CommandIterator::AcquireCommandBlocks(std::vector<CommandAllocator> allocat
     ASSERT(IsEmpty());
     mBlocks.clear();
     for (CommandAllocator& allocator : allocators) {
+        // All the blocks are freed together so they must come from the same pool.
+        ASSERT(mBlocks.empty() || mPool == allocator.mPool);
+        mPool = allocator.mPool;
         CommandBlocks blocks = allocator.AcquireBlocks();
         if (!blocks.empty()) {
             mBlocks.reserve(mBlocks.size() + blocks.size());
@@ -102,10 +180,7 @@ void CommandIterator::MakeEmptyAsDataWasDestroyed() {
         return;
     }
 
-    for (BlockDef& block : mBlocks) {
-        free(block.block);
-    }
-    mBlocks.clear();
+    FreeBlocks(mPool, &mBlocks);
     Reset();
     ASSERT(IsEmpty());
 }
@@ -114,6 +189,18 @@ bool CommandIterator::IsEmpty() const {
     return mBlocks[0].block == reinterpret_cast<const uint8_t*>(&mEndOfBlock);
 }
 
+size_t CommandIterator::GetAllocatedSize() const {
+    if (IsEmpty()) {
+        return 0;
+    }
+
+    size_t size = 0;
+    for (const BlockDef& block : mBlocks) {
+        size += block.size;
+    }
+    return size;
+}
+
 // Potential TODO(crbug.com/dawn/835):
 //  - Host the size and pointer to next block in the block itself to avoid having an allocation
 //    in the vector
@@ -128,12 +215,18 @@ CommandAllocator::CommandAllocator() {
     ResetPointers();
 }
 
+CommandAllocator::CommandAllocator(CommandBlockPool* pool) : mPool(pool) {
+    ResetPointers();
+}
+
 CommandAllocator::~CommandAllocator() {
     Reset();
 }
 
 CommandAllocator::CommandAllocator(CommandAllocator&& other)
-    : mBlocks(std::move(other.mBlocks)), mLastAllocationSize(other.mLastAllocationSize) {
+    : mBlocks(std::move(other.mBlocks)),
+      mPool(other.mPool),
+      mLastAllocationSize(other.mLastAllocationSize) {
     other.mBlocks.clear();
     if (!other.IsEmpty()) {
         mCurrentPtr = other.mCurrentPtr;
@@ -146,6 +239,7 @@ CommandAllocator::CommandAllocator(CommandAllocator&& other)
 
 CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
     Reset();
+    mPool = other.mPool;
     if (!other.IsEmpty()) {
         std::swap(mBlocks, other.mBlocks);
         mLastAllocationSize = other.mLastAllocationSize;
@@ -157,10 +251,7 @@ CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
 }
 
 void CommandAllocator::Reset() {
-    for (BlockDef& block : mBlocks) {
-        free(block.block);
-    }
-    mBlocks.clear();
+    FreeBlocks(mPool, &mBlocks);
     mLastAllocationSize = kDefaultBaseAllocationSize;
     ResetPointers();
 }
@@ -205,9 +296,11 @@ uint8_t* CommandAllocator::AllocateInNewBlock(uint32_t commandId,
 
 bool CommandAllocator::GetNewBlock(size_t minimumSize) {
     // Allocate blocks doubling sizes each time, to a maximum of 16k (or at least minimumSize).
-    mLastAllocationSize = std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
+    mLastAllocationSize =
+        std::max(minimumSize, std::min(mLastAllocationSize * 2, kMaxDefaultAllocationSize));
 
-    uint8_t* block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
+    uint8_t* block = mPool != nullptr ? mPool->AcquireBlock(mLastAllocationSize)
+                                      : static_cast<uint8_t*>(malloc(mLastAllocationSize));
     if (DAWN_UNLIKELY(block == nullptr)) {
         return false;
     }
@@ -15,9 +15,11 @@
 #ifndef SRC_DAWN_NATIVE_COMMANDALLOCATOR_H_
 #define SRC_DAWN_NATIVE_COMMANDALLOCATOR_H_
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <mutex>
 #include <vector>
 
 #include "dawn/common/Assert.h"
@@ -61,6 +63,47 @@ struct BlockDef {
 };
 using CommandBlocks = std::vector<BlockDef>;
 
+// Recycles the blocks of CommandAllocators once the commands they contain are destroyed, so that
+// encoding the same kind of commands every frame doesn't need to allocate new blocks. Only blocks
+// of the sizes the CommandAllocator grows through are pooled, and the pool keeps at most |budget|
+// bytes of blocks alive; other blocks are freed immediately. The pool is shared by all the
+// encoders of a device and is thread-safe.
+class CommandBlockPool : public NonCopyable {
+  public:
+    static constexpr size_t kDefaultBudget = 1024 * 1024;
+
+    explicit CommandBlockPool(size_t budget = kDefaultBudget);
+    ~CommandBlockPool();
+
+    // Returns a block of |size| bytes, reusing a pooled block if possible. Returns nullptr if the
+    // allocation failed.
+    uint8_t* AcquireBlock(size_t size);
+
+    // Takes ownership of the blocks and clears |blocks|.
+    void ReleaseBlocks(CommandBlocks* blocks);
+
+    struct Stats {
+        size_t pooledBytes = 0;
+        uint64_t allocatedBlockCount = 0;
+        uint64_t reusedBlockCount = 0;
+    };
+    Stats GetStats() const;
+
+  private:
+    static constexpr size_t kMinPooledBlockSize = 4096;
+    static constexpr size_t kSizeClassCount = 3;
+
+    // Returns the index in mFreeBlocks of the blocks of |size| bytes, or kSizeClassCount if they
+    // are not pooled.
+    static size_t GetSizeClass(size_t size);
+
+    const size_t mBudget;
+
+    mutable std::mutex mMutex;
+    std::array<std::vector<uint8_t*>, kSizeClassCount> mFreeBlocks;
+    Stats mStats;
+};
+
 namespace detail {
 constexpr uint32_t kEndOfBlock = std::numeric_limits<uint32_t>::max();
 constexpr uint32_t kAdditionalData = std::numeric_limits<uint32_t>::max() - 1;
@@ -102,6 +145,9 @@ class CommandIterator : public NonCopyable {
     // commands have been submitted and they are no longer valid.
     void MakeEmptyAsDataWasDestroyed();
 
+    // Returns the total size of the blocks holding the commands.
+    size_t GetAllocatedSize() const;
+
   private:
     bool IsEmpty() const;
 
@@ -141,6 +187,8 @@ class CommandIterator : public NonCopyable {
     }
 
     CommandBlocks mBlocks;
+    // The pool of the allocators the blocks came from, if any.
+    CommandBlockPool* mPool = nullptr;
     uint8_t* mCurrentPtr = nullptr;
     size_t mCurrentBlock = 0;
     // Used to avoid a special case for empty iterators.
@@ -150,9 +198,11 @@ class CommandIterator : public NonCopyable {
 class CommandAllocator : public NonCopyable {
   public:
     CommandAllocator();
+    // Blocks are acquired from and returned to |pool| when it is not nullptr.
+    explicit CommandAllocator(CommandBlockPool* pool);
     ~CommandAllocator();
 
-    // NOTE: A moved-from CommandAllocator is reset to its initial empty state.
+    // NOTE: A moved-from CommandAllocator is reset to its initial empty state but keeps its pool.
     CommandAllocator(CommandAllocator&&);
     CommandAllocator& operator=(CommandAllocator&&);
 
@@ -200,8 +250,11 @@ class CommandAllocator : public NonCopyable {
 
     // The default value of mLastAllocationSize.
     static constexpr size_t kDefaultBaseAllocationSize = 2048;
+    // The size blocks stop doubling at, unless a command needs a larger block.
+    static constexpr size_t kMaxDefaultAllocationSize = 16384;
 
     friend CommandIterator;
+    friend CommandBlockPool;
     CommandBlocks&& AcquireBlocks();
 
     DAWN_FORCE_INLINE uint8_t* Allocate(uint32_t commandId,
@@ -253,6 +306,7 @@ class CommandAllocator : public NonCopyable {
     void ResetPointers();
 
     CommandBlocks mBlocks;
+    CommandBlockPool* mPool = nullptr;
     size_t mLastAllocationSize = kDefaultBaseAllocationSize;
 
     // Data used for the block range at initialization so that the first call to Allocate sees
@@ -19,6 +19,9 @@
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/CommandValidation.h"
 #include "dawn/native/Commands.h"
+#include "dawn/native/Device.h"
+#include "dawn/native/DeviceCounters.h"
+#include "dawn/native/ErrorData.h"
 #include "dawn/native/Format.h"
 #include "dawn/native/ObjectType_autogen.h"
 #include "dawn/native/Texture.h"
@@ -31,7 +34,7 @@ CommandBufferBase::CommandBufferBase(CommandEncoder* encoder,
       mCommands(encoder->AcquireCommands()),
       mResourceUsages(encoder->AcquireResourceUsages()),
       mEncoderLabel(encoder->GetLabel()) {
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 CommandBufferBase::CommandBufferBase(DeviceBase* device,
@@ -74,10 +77,47 @@ MaybeError CommandBufferBase::ValidateCanUseInSubmitNow() const {
     ASSERT(!IsError());
 
     DAWN_INVALID_IF(!IsAlive(), "%s cannot be submitted more than once.", this);
+    DAWN_INVALID_IF(mDeferredValidationFailed, "%s is invalid.", this);
+    return {};
+}
+
+void CommandBufferBase::StartDeferredValidation() {
+    ASSERT(mDeferredValidationEvent == nullptr);
+    mDeferredValidationEvent =
+        GetDevice()->GetWorkerTaskPool()->PostWorkerTask(RunDeferredValidation, this);
+}
+
+// static
+void CommandBufferBase::RunDeferredValidation(void* userdata) {
+    CommandBufferBase* commandBuffer = static_cast<CommandBufferBase*>(userdata);
+    ScopedCounterTimer timer(commandBuffer->GetDevice()->GetCounters(),
+                             TimeCounter::SubmitValidation);
+    MaybeError result = ValidatePassResourceUsages(commandBuffer->mResourceUsages.renderPasses,
+                                                   commandBuffer->mResourceUsages.computePasses);
+    if (result.IsError()) {
+        commandBuffer->mDeferredValidationError = result.AcquireError();
+    }
+}
+
+void CommandBufferBase::WaitForDeferredValidation() {
+    if (mDeferredValidationEvent != nullptr) {
+        mDeferredValidationEvent->Wait();
+        mDeferredValidationEvent = nullptr;
+    }
+}
+
+MaybeError CommandBufferBase::ResolveDeferredValidation() {
+    WaitForDeferredValidation();
+    if (mDeferredValidationError != nullptr) {
+        mDeferredValidationFailed = true;
+        return std::move(mDeferredValidationError);
+    }
     return {};
 }
 
 void CommandBufferBase::DestroyImpl() {
+    // The deferred validation reads the resource usages.
+    WaitForDeferredValidation();
     FreeCommands(&mCommands);
     mResourceUsages = {};
 }
@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_COMMANDBUFFER_H_
 #define SRC_DAWN_NATIVE_COMMANDBUFFER_H_
 
+#include <memory>
 #include <string>
 
 #include "dawn/native/dawn_platform.h"
@@ -25,6 +26,7 @@
 #include "dawn/native/ObjectBase.h"
 #include "dawn/native/PassResourceUsage.h"
 #include "dawn/native/Texture.h"
+#include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native {
 
@@ -46,6 +48,13 @@ class CommandBufferBase : public ApiObjectBase {
 
     MaybeError ValidateCanUseInSubmitNow() const;
 
+    // With the AsyncCommandBufferValidation toggle, the resource usages of the command buffer are
+    // validated on the device's worker pool after Finish returns. ResolveDeferredValidation waits
+    // for that validation and returns its error the first time it is called. The device calls it
+    // before the error scopes change, so the error is reported where Finish would have reported it.
+    void StartDeferredValidation();
+    MaybeError ResolveDeferredValidation();
+
     const CommandBufferResourceUsage& GetResourceUsages() const;
 
     CommandIterator* GetCommandIteratorForTesting();
@@ -58,8 +67,15 @@ class CommandBufferBase : public ApiObjectBase {
   private:
     CommandBufferBase(DeviceBase* device, ObjectBase::ErrorTag tag, const char* label);
 
+    static void RunDeferredValidation(void* userdata);
+    void WaitForDeferredValidation();
+
     CommandBufferResourceUsage mResourceUsages;
 
+    std::unique_ptr<platform::WaitableEvent> mDeferredValidationEvent;
+    std::unique_ptr<ErrorData> mDeferredValidationError;
+    bool mDeferredValidationFailed = false;
+
     std::string mEncoderLabel;
 };
 
@@ -14,6 +14,7 @@
 
 #include "dawn/native/CommandBufferStateTracker.h"
 
+#include <algorithm>
 #include <limits>
 #include <optional>
 #include <type_traits>
@@ -509,6 +510,12 @@ void CommandBufferStateTracker::RecomputeLazyAspects(ValidationAspects aspects)
         bool matches = true;
 
         for (BindGroupIndex i : IterateBitSet(mLastPipelineLayout->GetBindGroupLayoutsMask())) {
+            ValidatedBindGroup& validated = mValidatedBindGroups[i];
+            if (mBindgroups[i] != nullptr && validated.bindGroup == mBindgroups[i] &&
+                validated.pipeline == mLastPipeline) {
+                continue;
+            }
+
             if (mBindgroups[i] == nullptr ||
                 mLastPipelineLayout->GetBindGroupLayout(i)->GetInternalBindGroupLayout() !=
                     mBindgroups[i]->GetLayout()->GetInternalBindGroupLayout() ||
@@ -518,9 +525,12 @@ void CommandBufferStateTracker::RecomputeLazyAspects(ValidationAspects aspects)
                 matches = false;
                 break;
             }
+
+            validated.pipeline = mLastPipeline;
+            validated.bindGroup = mBindgroups[i];
         }
 
-        if (matches) {
+        if (matches && mPipelineMayHaveBindingAliasing) {
             // Continue checking if there is writable storage buffer binding aliasing or not
             if (FindStorageBufferBindingAliasing<bool>(mLastPipelineLayout, mBindgroups,
                                                        mDynamicOffsets)) {
@@ -755,12 +765,43 @@ void CommandBufferStateTracker::SetIndexBuffer(wgpu::IndexFormat format, uint64_
 void CommandBufferStateTracker::UnsetVertexBuffer(VertexBufferSlot slot) {
     mVertexBufferSlotsUsed.set(slot, false);
     mVertexBufferSizes[slot] = 0;
+    mVertexBuffers[slot] = nullptr;
+    mVertexBufferOffsets[slot] = 0;
     mAspects.reset(VALIDATION_ASPECT_VERTEX_BUFFERS);
 }
 
-void CommandBufferStateTracker::SetVertexBuffer(VertexBufferSlot slot, uint64_t size) {
+void CommandBufferStateTracker::SetVertexBuffer(VertexBufferSlot slot,
+                                                BufferBase* buffer,
+                                                uint64_t offset,
+                                                uint64_t size) {
     mVertexBufferSlotsUsed.set(slot);
     mVertexBufferSizes[slot] = size;
+    mVertexBuffers[slot] = buffer;
+    mVertexBufferOffsets[slot] = offset;
+}
+
+bool CommandBufferStateTracker::IsSamePipeline(const PipelineBase* pipeline) const {
+    return pipeline != nullptr && mLastPipeline == pipeline;
+}
+
+bool CommandBufferStateTracker::IsSameBindGroup(BindGroupIndex index,
+                                                const BindGroupBase* bindgroup,
+                                                uint32_t dynamicOffsetCount,
+                                                const uint32_t* dynamicOffsets) const {
+    if (bindgroup == nullptr || mBindgroups[index] != bindgroup) {
+        return false;
+    }
+    const std::vector<uint32_t>& currentOffsets = mDynamicOffsets[index];
+    return currentOffsets.size() == dynamicOffsetCount &&
+           std::equal(currentOffsets.begin(), currentOffsets.end(), dynamicOffsets);
+}
+
+bool CommandBufferStateTracker::IsSameVertexBuffer(VertexBufferSlot slot,
+                                                   const BufferBase* buffer,
+                                                   uint64_t offset,
+                                                   uint64_t size) const {
+    return buffer != nullptr && mVertexBufferSlotsUsed[slot] && mVertexBuffers[slot] == buffer &&
+           mVertexBufferOffsets[slot] == offset && mVertexBufferSizes[slot] == size;
 }
 
 void CommandBufferStateTracker::SetPipelineCommon(PipelineBase* pipeline) {
@@ -768,6 +809,21 @@ void CommandBufferStateTracker::SetPipelineCommon(PipelineBase* pipeline) {
     mLastPipelineLayout = pipeline != nullptr ? pipeline->GetLayout() : nullptr;
     mMinBufferSizes = pipeline != nullptr ? &pipeline->GetMinBufferSizes() : nullptr;
 
+    // Per-stage counts include read-only storage buffers and count bindings visible to several
+    // stages more than once, so this is conservative.
+    uint32_t storageBindingCount = 0;
+    if (mLastPipelineLayout != nullptr) {
+        for (BindGroupIndex i : IterateBitSet(mLastPipelineLayout->GetBindGroupLayoutsMask())) {
+            const BindingCounts& counts =
+                mLastPipelineLayout->GetBindGroupLayout(i)->GetBindingCountInfo();
+            for (SingleShaderStage stage : IterateStages(kAllStages)) {
+                storageBindingCount += counts.perStage[stage].storageBufferCount +
+                                       counts.perStage[stage].storageTextureCount;
+            }
+        }
+    }
+    mPipelineMayHaveBindingAliasing = storageBindingCount >= 2;
+
     mAspects.set(VALIDATION_ASPECT_PIPELINE);
 
     // Reset lazy aspects so they get recomputed on the next operation.
@@ -56,7 +56,20 @@ class CommandBufferStateTracker {
                       const uint32_t* dynamicOffsets);
     void SetIndexBuffer(wgpu::IndexFormat format, uint64_t size);
     void UnsetVertexBuffer(VertexBufferSlot slot);
-    void SetVertexBuffer(VertexBufferSlot slot, uint64_t size);
+    void SetVertexBuffer(VertexBufferSlot slot, BufferBase* buffer, uint64_t offset, uint64_t size);
+
+    // Returns whether setting the state again would be a no-op, so that encoders can skip
+    // recording redundant commands. A backend's state only changes when a command is recorded, so
+    // they stay in sync as long as the tracker isn't reset.
+    bool IsSamePipeline(const PipelineBase* pipeline) const;
+    bool IsSameBindGroup(BindGroupIndex index,
+                         const BindGroupBase* bindgroup,
+                         uint32_t dynamicOffsetCount,
+                         const uint32_t* dynamicOffsets) const;
+    bool IsSameVertexBuffer(VertexBufferSlot slot,
+                            const BufferBase* buffer,
+                            uint64_t offset,
+                            uint64_t size) const;
 
     static constexpr size_t kNumAspects = 4;
     using ValidationAspects = std::bitset<kNumAspects>;
@@ -87,11 +100,28 @@ class CommandBufferStateTracker {
     uint64_t mIndexBufferSize = 0;
 
     ityp::array<VertexBufferSlot, uint64_t, kMaxVertexBuffers> mVertexBufferSizes = {};
+    ityp::array<VertexBufferSlot, const BufferBase*, kMaxVertexBuffers> mVertexBuffers = {};
+    ityp::array<VertexBufferSlot, uint64_t, kMaxVertexBuffers> mVertexBufferOffsets = {};
 
     PipelineLayoutBase* mLastPipelineLayout = nullptr;
     PipelineBase* mLastPipeline = nullptr;
 
     const RequiredBufferSizes* mMinBufferSizes = nullptr;
+
+    // The layout compatibility and minimum buffer sizes of a bind group only depend on the bind
+    // group and the pipeline, not on the dynamic offsets. Remember the last (pipeline, bind group)
+    // pair validated at each index so that draws which only change dynamic offsets skip them.
+    // Objects used by the encoder are kept alive by the recorded commands, so the pointers can't
+    // be reused for other objects while the tracker is alive.
+    struct ValidatedBindGroup {
+        const PipelineBase* pipeline = nullptr;
+        const BindGroupBase* bindGroup = nullptr;
+    };
+    ityp::array<BindGroupIndex, ValidatedBindGroup, kMaxBindGroups> mValidatedBindGroups = {};
+
+    // Writable binding aliasing is only possible if the pipeline layout has at least two storage
+    // bindings. Computed when the pipeline is set.
+    bool mPipelineMayHaveBindingAliasing = false;
 };
 
 }  // namespace dawn::native
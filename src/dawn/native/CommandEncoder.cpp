@@ -34,6 +34,7 @@
 #include "dawn/native/Commands.h"
 #include "dawn/native/ComputePassEncoder.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/ErrorData.h"
 #include "dawn/native/ObjectType_autogen.h"
 #include "dawn/native/QueryHelper.h"
@@ -850,7 +851,7 @@ CommandEncoder* CommandEncoder::MakeError(DeviceBase* device, const char* label)
 
 CommandEncoder::CommandEncoder(DeviceBase* device, const CommandEncoderDescriptor* descriptor)
     : ApiObjectBase(device, descriptor->label), mEncodingContext(device, this) {
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 
     const DawnEncoderInternalUsageDescriptor* internalUsageDesc = nullptr;
     FindInChain(descriptor->nextInChain, &internalUsageDesc);
@@ -1961,24 +1962,25 @@ ResultOrError<Ref<CommandBufferBase>> CommandEncoder::Finish(
         descriptor = &defaultDescriptor;
     }
 
-    return device->CreateCommandBuffer(this, descriptor);
+    Ref<CommandBufferBase> commandBuffer;
+    DAWN_TRY_ASSIGN(commandBuffer, device->CreateCommandBuffer(this, descriptor));
+    if (device->IsValidationEnabled() &&
+        device->IsToggleEnabled(Toggle::AsyncCommandBufferValidation)) {
+        device->DeferCommandBufferValidation(commandBuffer);
+    }
+    return commandBuffer;
 }
 
 // Implementation of the command buffer validation that can be precomputed before submit
 MaybeError CommandEncoder::ValidateFinish() const {
     TRACE_EVENT0(GetDevice()->GetPlatform(), Validation, "CommandEncoder::ValidateFinish");
+    ScopedCounterTimer timer(GetDevice()->GetCounters(), TimeCounter::SubmitValidation);
     DAWN_TRY(GetDevice()->ValidateObject(this));
 
-    for (const RenderPassResourceUsage& passUsage : mEncodingContext.GetRenderPassUsages()) {
-        DAWN_TRY_CONTEXT(ValidateSyncScopeResourceUsage(passUsage),
-                         "validating render pass usage.");
-    }
-
-    for (const ComputePassResourceUsage& passUsage : mEncodingContext.GetComputePassUsages()) {
-        for (const SyncScopeResourceUsage& scope : passUsage.dispatchUsages) {
-            DAWN_TRY_CONTEXT(ValidateSyncScopeResourceUsage(scope),
-                             "validating compute pass usage.");
-        }
+    // With AsyncCommandBufferValidation, the usages are validated by the command buffer instead.
+    if (!GetDevice()->IsToggleEnabled(Toggle::AsyncCommandBufferValidation)) {
+        DAWN_TRY(ValidatePassResourceUsages(mEncodingContext.GetRenderPassUsages(),
+                                            mEncodingContext.GetComputePassUsages()));
     }
 
     DAWN_INVALID_IF(
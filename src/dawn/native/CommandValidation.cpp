@@ -79,6 +79,22 @@ MaybeError ValidateSyncScopeResourceUsage(const SyncScopeResourceUsage& scope) {
     return {};
 }
 
+MaybeError ValidatePassResourceUsages(const std::vector<RenderPassResourceUsage>& renderPasses,
+                                      const std::vector<ComputePassResourceUsage>& computePasses) {
+    for (const RenderPassResourceUsage& passUsage : renderPasses) {
+        DAWN_TRY_CONTEXT(ValidateSyncScopeResourceUsage(passUsage),
+                         "validating render pass usage.");
+    }
+
+    for (const ComputePassResourceUsage& passUsage : computePasses) {
+        for (const SyncScopeResourceUsage& scope : passUsage.dispatchUsages) {
+            DAWN_TRY_CONTEXT(ValidateSyncScopeResourceUsage(scope),
+                             "validating compute pass usage.");
+        }
+    }
+    return {};
+}
+
 MaybeError ValidateTimestampQuery(const DeviceBase* device,
                                   const QuerySetBase* querySet,
                                   uint32_t queryIndex,
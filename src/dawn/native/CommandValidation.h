@@ -30,11 +30,17 @@ namespace dawn::native {
 enum class BufferSizeType { Size, AllocatedSize };
 
 class QuerySetBase;
+struct ComputePassResourceUsage;
+struct RenderPassResourceUsage;
 struct SyncScopeResourceUsage;
 struct TexelBlockInfo;
 
 MaybeError ValidateSyncScopeResourceUsage(const SyncScopeResourceUsage& usage);
 
+// Validates the synchronization scopes of all the passes of a command buffer.
+MaybeError ValidatePassResourceUsages(const std::vector<RenderPassResourceUsage>& renderPasses,
+                                      const std::vector<ComputePassResourceUsage>& computePasses);
+
 MaybeError ValidateTimestampQuery(const DeviceBase* device,
                                   const QuerySetBase* querySet,
                                   uint32_t queryIndex,
@@ -19,7 +19,10 @@
 #include "dawn/common/Log.h"
 #include "dawn/native/BindGroupLayout.h"
 #include "dawn/native/Buffer.h"
+#include "dawn/native/CommandAllocator.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/DeviceCounters.h"
+#include "dawn/native/DynamicUploader.h"
 #include "dawn/native/Instance.h"
 #include "dawn/native/Texture.h"
 #include "dawn/platform/DawnPlatform.h"
@@ -245,6 +248,21 @@ size_t GetDeprecationWarningCountForTesting(WGPUDevice device) {
     return FromAPI(device)->GetDeprecationWarningCountForTesting();
 }
 
+uint64_t GetAllocatedCommandBlockCountForTesting(WGPUDevice device) {
+    return FromAPI(device)->GetCommandBlockPool()->GetStats().allocatedBlockCount;
+}
+
+std::vector<CounterInfo> GetDeviceCounters(WGPUDevice device) {
+    return FromAPI(device)->GetCounters()->GetSnapshot();
+}
+
+StagingMemoryStats GetStagingMemoryStats(WGPUDevice device) {
+    DeviceBase* deviceBase = FromAPI(device);
+    auto deviceLock(deviceBase->GetScopedLock());
+    DynamicUploader* uploader = deviceBase->GetDynamicUploader();
+    return uploader != nullptr ? uploader->GetStats() : StagingMemoryStats{};
+}
+
 size_t GetPhysicalDeviceCountForTesting(WGPUInstance instance) {
     return FromAPI(instance)->GetPhysicalDeviceCountForTesting();
 }
@@ -29,10 +29,12 @@
 #include "dawn/native/BlobCache.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/ChainUtils.h"
+#include "dawn/native/CommandAllocator.h"
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/CompilationMessages.h"
 #include "dawn/native/CreatePipelineAsyncTask.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/DynamicUploader.h"
 #include "dawn/native/ErrorData.h"
 #include "dawn/native/ErrorInjector.h"
@@ -75,14 +77,18 @@ struct DeviceBase::Caches {
 template <typename RefCountedT, typename CreateFn>
 auto GetOrCreate(ContentLessObjectCache<RefCountedT>& cache,
                  RefCountedT* blueprint,
+                 DeviceCounters* counters,
+                 CounterCache counterCache,
                  CreateFn createFn) {
     using ReturnType = decltype(createFn());
 
     // If we find the blueprint in the cache we can just return it.
     Ref<RefCountedT> result = cache.Find(blueprint);
     if (result != nullptr) {
+        counters->AddCacheHit(counterCache);
         return ReturnType(result);
     }
+    counters->AddCacheMiss(counterCache);
 
     using UnwrappedReturnType = typename detail::UnwrapResultOrError<ReturnType>::type;
     static_assert(std::is_same_v<UnwrappedReturnType, Ref<RefCountedT>>,
@@ -218,6 +224,8 @@ DeviceBase::DeviceBase(AdapterBase* adapter,
     }
 
     mFormatTable = BuildFormatTable(this);
+    mCommandBlockPool = std::make_unique<CommandBlockPool>();
+    mCounters = std::make_unique<DeviceCounters>(!IsToggleEnabled(Toggle::DisableDeviceCounters));
 
     if (descriptor->label != nullptr && strlen(descriptor->label) != 0) {
         mLabel = descriptor->label;
@@ -233,6 +241,8 @@ DeviceBase::DeviceBase(AdapterBase* adapter,
 DeviceBase::DeviceBase() : mState(State::Alive), mToggles(ToggleStage::Device) {
     GetDefaultLimits(&mLimits.v1);
     mFormatTable = BuildFormatTable(this);
+    mCommandBlockPool = std::make_unique<CommandBlockPool>();
+    mCounters = std::make_unique<DeviceCounters>();
 }
 
 DeviceBase::~DeviceBase() {
@@ -446,6 +456,7 @@ void DeviceBase::Destroy() {
 
         // Call all the callbacks immediately as the device is about to shut down.
         // TODO(crbug.com/dawn/826): Cancel the tasks that are in flight if possible.
+        ResolveDeferredCommandBufferValidations();
         mAsyncTaskManager->WaitAllPendingTasks();
         mCallbackTaskManager->HandleShutDown();
     }
@@ -522,6 +533,10 @@ void DeviceBase::APIDestroy() {
 void DeviceBase::HandleError(std::unique_ptr<ErrorData> error,
                              InternalErrorType additionalAllowedErrors,
                              WGPUDeviceLostReason lost_reason) {
+    // Report the errors of the command buffers finished before this error first, so that the
+    // error scopes and the uncaptured error callback see the errors in the order of the calls.
+    ResolveDeferredCommandBufferValidations();
+
     AppendDebugLayerMessages(error.get());
     InternalErrorType allowedErrors =
         InternalErrorType::Validation | InternalErrorType::DeviceLost | additionalAllowedErrors;
@@ -655,6 +670,7 @@ void DeviceBase::APISetDeviceLostCallback(wgpu::DeviceLostCallback callback, voi
 }
 
 void DeviceBase::APIPushErrorScope(wgpu::ErrorFilter filter) {
+    ResolveDeferredCommandBufferValidations();
     if (ConsumedError(ValidateErrorFilter(filter))) {
         return;
     }
@@ -676,6 +692,7 @@ void DeviceBase::APIPopErrorScope(wgpu::ErrorCallback callback, void* userdata)
             std::bind(callback, WGPUErrorType_Unknown, "No error scopes to pop", userdata));
         return;
     }
+    ResolveDeferredCommandBufferValidations();
     ErrorScope scope = mErrorScopeStack->Pop();
     mCallbackTaskManager->AddCallbackTask(
         [callback, errorType = static_cast<WGPUErrorType>(scope.GetErrorType()),
@@ -805,14 +822,15 @@ ResultOrError<Ref<BindGroupLayoutBase>> DeviceBase::GetOrCreateBindGroupLayout(
     blueprint.SetContentHash(blueprintHash);
 
     Ref<BindGroupLayoutInternalBase> internal;
-    DAWN_TRY_ASSIGN(internal, GetOrCreate(mCaches->bindGroupLayouts, &blueprint,
-                                          [&]() -> ResultOrError<Ref<BindGroupLayoutInternalBase>> {
-                                              Ref<BindGroupLayoutInternalBase> result;
-                                              DAWN_TRY_ASSIGN(
-                                                  result, CreateBindGroupLayoutImpl(descriptor));
-                                              result->SetContentHash(blueprintHash);
-                                              return result;
-                                          }));
+    DAWN_TRY_ASSIGN(internal,
+                    GetOrCreate(mCaches->bindGroupLayouts, &blueprint, mCounters.get(),
+                                CounterCache::BindGroupLayout,
+                                [&]() -> ResultOrError<Ref<BindGroupLayoutInternalBase>> {
+                                    Ref<BindGroupLayoutInternalBase> result;
+                                    DAWN_TRY_ASSIGN(result, CreateBindGroupLayoutImpl(descriptor));
+                                    result->SetContentHash(blueprintHash);
+                                    return result;
+                                }));
     return AcquireRef(
         new BindGroupLayoutBase(this, descriptor->label, internal, pipelineCompatibilityToken));
 }
@@ -846,12 +864,26 @@ PipelineLayoutBase* DeviceBase::GetEmptyPipelineLayout() {
 
 Ref<ComputePipelineBase> DeviceBase::GetCachedComputePipeline(
     ComputePipelineBase* uninitializedComputePipeline) {
-    return mCaches->computePipelines.Find(uninitializedComputePipeline);
+    Ref<ComputePipelineBase> cachedPipeline =
+        mCaches->computePipelines.Find(uninitializedComputePipeline);
+    if (cachedPipeline != nullptr) {
+        mCounters->AddCacheHit(CounterCache::ComputePipeline);
+    } else {
+        mCounters->AddCacheMiss(CounterCache::ComputePipeline);
+    }
+    return cachedPipeline;
 }
 
 Ref<RenderPipelineBase> DeviceBase::GetCachedRenderPipeline(
     RenderPipelineBase* uninitializedRenderPipeline) {
-    return mCaches->renderPipelines.Find(uninitializedRenderPipeline);
+    Ref<RenderPipelineBase> cachedPipeline =
+        mCaches->renderPipelines.Find(uninitializedRenderPipeline);
+    if (cachedPipeline != nullptr) {
+        mCounters->AddCacheHit(CounterCache::RenderPipeline);
+    } else {
+        mCounters->AddCacheMiss(CounterCache::RenderPipeline);
+    }
+    return cachedPipeline;
 }
 
 Ref<ComputePipelineBase> DeviceBase::AddOrGetCachedComputePipeline(
@@ -929,7 +961,8 @@ ResultOrError<Ref<PipelineLayoutBase>> DeviceBase::GetOrCreatePipelineLayout(
     const size_t blueprintHash = blueprint.ComputeContentHash();
     blueprint.SetContentHash(blueprintHash);
 
-    return GetOrCreate(mCaches->pipelineLayouts, &blueprint,
+    return GetOrCreate(mCaches->pipelineLayouts, &blueprint, mCounters.get(),
+                       CounterCache::PipelineLayout,
                        [&]() -> ResultOrError<Ref<PipelineLayoutBase>> {
                            Ref<PipelineLayoutBase> result;
                            DAWN_TRY_ASSIGN(result, CreatePipelineLayoutImpl(descriptor));
@@ -945,12 +978,13 @@ ResultOrError<Ref<SamplerBase>> DeviceBase::GetOrCreateSampler(
     const size_t blueprintHash = blueprint.ComputeContentHash();
     blueprint.SetContentHash(blueprintHash);
 
-    return GetOrCreate(mCaches->samplers, &blueprint, [&]() -> ResultOrError<Ref<SamplerBase>> {
-        Ref<SamplerBase> result;
-        DAWN_TRY_ASSIGN(result, CreateSamplerImpl(descriptor));
-        result->SetContentHash(blueprintHash);
-        return result;
-    });
+    return GetOrCreate(mCaches->samplers, &blueprint, mCounters.get(), CounterCache::Sampler,
+                       [&]() -> ResultOrError<Ref<SamplerBase>> {
+                           Ref<SamplerBase> result;
+                           DAWN_TRY_ASSIGN(result, CreateSamplerImpl(descriptor));
+                           result->SetContentHash(blueprintHash);
+                           return result;
+                       });
 }
 
 ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreateShaderModule(
@@ -965,7 +999,8 @@ ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreateShaderModule(
     blueprint.SetContentHash(blueprintHash);
 
     return GetOrCreate(
-        mCaches->shaderModules, &blueprint, [&]() -> ResultOrError<Ref<ShaderModuleBase>> {
+        mCaches->shaderModules, &blueprint, mCounters.get(), CounterCache::ShaderModule,
+        [&]() -> ResultOrError<Ref<ShaderModuleBase>> {
             if (!parseResult->HasParsedShader()) {
                 // We skip the parse on creation if validation isn't enabled which let's us quickly
                 // lookup in the cache without validating and parsing. We need the parsed module
@@ -990,9 +1025,10 @@ ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreateShaderModule(
 }
 
 Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(AttachmentState* blueprint) {
-    return GetOrCreate(mCaches->attachmentStates, blueprint, [&]() -> Ref<AttachmentState> {
-        return AcquireRef(new AttachmentState(*blueprint));
-    });
+    return GetOrCreate(mCaches->attachmentStates, blueprint, mCounters.get(),
+                       CounterCache::AttachmentState, [&]() -> Ref<AttachmentState> {
+                           return AcquireRef(new AttachmentState(*blueprint));
+                       });
 }
 
 Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(
@@ -1313,6 +1349,7 @@ bool DeviceBase::APITick() {
 }
 
 MaybeError DeviceBase::Tick() {
+    ResolveDeferredCommandBufferValidations();
     if (IsLost() || !HasScheduledCommands()) {
         return {};
     }
@@ -1794,6 +1831,14 @@ DynamicUploader* DeviceBase::GetDynamicUploader() const {
     return mDynamicUploader.get();
 }
 
+CommandBlockPool* DeviceBase::GetCommandBlockPool() const {
+    return mCommandBlockPool.get();
+}
+
+DeviceCounters* DeviceBase::GetCounters() const {
+    return mCounters.get();
+}
+
 // The Toggle device facility
 
 std::vector<const char*> DeviceBase::GetTogglesUsed() const {
@@ -1844,6 +1889,30 @@ dawn::platform::WorkerTaskPool* DeviceBase::GetWorkerTaskPool() const {
     return mWorkerTaskPool.get();
 }
 
+void DeviceBase::DeferCommandBufferValidation(Ref<CommandBufferBase> commandBuffer) {
+    commandBuffer->StartDeferredValidation();
+    std::lock_guard<std::mutex> lock(mDeferredValidationMutex);
+    mCommandBuffersWithDeferredValidation.push_back(std::move(commandBuffer));
+}
+
+void DeviceBase::ResolveDeferredCommandBufferValidations() {
+    std::vector<Ref<CommandBufferBase>> commandBuffers;
+    {
+        std::lock_guard<std::mutex> lock(mDeferredValidationMutex);
+        if (mCommandBuffersWithDeferredValidation.empty()) {
+            return;
+        }
+        commandBuffers = std::move(mCommandBuffersWithDeferredValidation);
+        mCommandBuffersWithDeferredValidation.clear();
+    }
+
+    // Report the errors in the order the command buffers were finished.
+    for (Ref<CommandBufferBase>& commandBuffer : commandBuffers) {
+        DAWN_UNUSED(ConsumedError(commandBuffer->ResolveDeferredValidation(),
+                                  "finishing %s.", commandBuffer.Get()));
+    }
+}
+
 void DeviceBase::AddComputePipelineAsyncCallbackTask(
     std::unique_ptr<ErrorData> error,
     const char* label,
@@ -16,6 +16,7 @@
 #define SRC_DAWN_NATIVE_DEVICE_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -52,6 +53,8 @@ class AttachmentStateBlueprint;
 class Blob;
 class BlobCache;
 class CallbackTaskManager;
+class CommandBlockPool;
+class DeviceCounters;
 class DynamicUploader;
 class ErrorScopeStack;
 class OwnedCompilationMessages;
@@ -322,6 +325,8 @@ class DeviceBase : public RefCountedWithExternalCount, public ExecutionQueueBase
                                         const Extent3D& copySizePixels);
 
     DynamicUploader* GetDynamicUploader() const;
+    CommandBlockPool* GetCommandBlockPool() const;
+    DeviceCounters* GetCounters() const;
 
     // The device state which is a combination of creation state and loss state.
     //
@@ -396,6 +401,14 @@ class DeviceBase : public RefCountedWithExternalCount, public ExecutionQueueBase
     CallbackTaskManager* GetCallbackTaskManager() const;
     dawn::platform::WorkerTaskPool* GetWorkerTaskPool() const;
 
+    // Starts the deferred validation of a command buffer created with the
+    // AsyncCommandBufferValidation toggle and keeps track of it until it is resolved.
+    void DeferCommandBufferValidation(Ref<CommandBufferBase> commandBuffer);
+    // Waits for the deferred validations of the command buffers and reports their errors. It must
+    // be called before any operation that changes which error scopes the errors are reported to,
+    // and before any other error is reported.
+    void ResolveDeferredCommandBufferValidations();
+
     // Enqueue a successfully-create async pipeline creation callback.
     void AddComputePipelineAsyncCallbackTask(Ref<ComputePipelineBase> pipeline,
                                              WGPUCreateComputePipelineAsyncCallback callback,
@@ -562,6 +575,9 @@ class DeviceBase : public RefCountedWithExternalCount, public ExecutionQueueBase
 
     std::unique_ptr<DynamicUploader> mDynamicUploader;
     std::unique_ptr<AsyncTaskManager> mAsyncTaskManager;
+    // Recycles the blocks of the command buffers and render bundles encoded on this device.
+    std::unique_ptr<CommandBlockPool> mCommandBlockPool;
+    std::unique_ptr<DeviceCounters> mCounters;
     Ref<QueueBase> mQueue;
 
     struct DeprecationWarnings;
@@ -588,6 +604,10 @@ class DeviceBase : public RefCountedWithExternalCount, public ExecutionQueueBase
 
     Ref<CallbackTaskManager> mCallbackTaskManager;
     std::unique_ptr<dawn::platform::WorkerTaskPool> mWorkerTaskPool;
+
+    // Finish may be called on multiple threads so the list has its own lock.
+    std::mutex mDeferredValidationMutex;
+    std::vector<Ref<CommandBufferBase>> mCommandBuffersWithDeferredValidation;
     std::string mLabel;
     CacheKey mDeviceCacheKey;
 
@@ -0,0 +1,210 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/DeviceCounters.h"
+
+#include <string>
+
+#include "dawn/common/Assert.h"
+
+namespace dawn::native {
+
+namespace {
+
+const char* CounterCacheAsString(CounterCache cache) {
+    switch (cache) {
+        case CounterCache::AttachmentState:
+            return "AttachmentState";
+        case CounterCache::BindGroupLayout:
+            return "BindGroupLayout";
+        case CounterCache::ComputePipeline:
+            return "ComputePipeline";
+        case CounterCache::PipelineLayout:
+            return "PipelineLayout";
+        case CounterCache::RenderPipeline:
+            return "RenderPipeline";
+        case CounterCache::Sampler:
+            return "Sampler";
+        case CounterCache::ShaderModule:
+            return "ShaderModule";
+        case CounterCache::Blob:
+            return "Blob";
+        case CounterCache::EnumCount:
+            break;
+    }
+    UNREACHABLE();
+}
+
+const char* TimeCounterAsString(TimeCounter counter) {
+    switch (counter) {
+        case TimeCounter::SubmitValidation:
+            return "SubmitValidationTimeNS";
+        case TimeCounter::VertexShaderCompilation:
+            return "VertexShaderCompilationTimeNS";
+        case TimeCounter::FragmentShaderCompilation:
+            return "FragmentShaderCompilationTimeNS";
+        case TimeCounter::ComputeShaderCompilation:
+            return "ComputeShaderCompilationTimeNS";
+        case TimeCounter::EnumCount:
+            break;
+    }
+    UNREACHABLE();
+}
+
+// Threads are assigned shards round-robin the first time they update any device's counters.
+uint32_t GetCurrentThreadShardIndex(uint32_t shardCount) {
+    static std::atomic<uint32_t> sNextThreadIndex{0};
+    thread_local uint32_t threadIndex = sNextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    return threadIndex % shardCount;
+}
+
+}  // anonymous namespace
+
+TimeCounter ShaderCompilationTimeCounter(SingleShaderStage stage) {
+    switch (stage) {
+        case SingleShaderStage::Vertex:
+            return TimeCounter::VertexShaderCompilation;
+        case SingleShaderStage::Fragment:
+            return TimeCounter::FragmentShaderCompilation;
+        case SingleShaderStage::Compute:
+            return TimeCounter::ComputeShaderCompilation;
+    }
+    UNREACHABLE();
+}
+
+DeviceCounters::DeviceCounters(bool enabled) : mEnabled(enabled) {
+    for (Shard& shard : mShards) {
+        for (std::atomic<uint64_t>& value : shard.values) {
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+DeviceCounters::~DeviceCounters() = default;
+
+bool DeviceCounters::IsEnabled() const {
+    return mEnabled;
+}
+
+void DeviceCounters::AddObjectCreated(ObjectType type) {
+    Add(kObjectsCreatedSlotsBegin + static_cast<uint32_t>(type), 1);
+}
+
+void DeviceCounters::AddCacheHit(CounterCache cache) {
+    Add(kCacheHitSlotsBegin + static_cast<uint32_t>(cache), 1);
+}
+
+void DeviceCounters::AddCacheMiss(CounterCache cache) {
+    Add(kCacheMissSlotsBegin + static_cast<uint32_t>(cache), 1);
+}
+
+void DeviceCounters::AddCommandBytesEncoded(uint64_t bytes) {
+    Add(kCommandBytesEncodedSlot, bytes);
+}
+
+void DeviceCounters::AddUploaderBytes(uint64_t bytes) {
+    Add(kUploaderBytesSlot, bytes);
+}
+
+void DeviceCounters::AddTime(TimeCounter counter, uint64_t nanoseconds) {
+    Add(kTimeSlotsBegin + static_cast<uint32_t>(counter), nanoseconds);
+}
+
+uint64_t DeviceCounters::GetObjectsCreated(ObjectType type) const {
+    return Get(kObjectsCreatedSlotsBegin + static_cast<uint32_t>(type));
+}
+
+uint64_t DeviceCounters::GetCacheHits(CounterCache cache) const {
+    return Get(kCacheHitSlotsBegin + static_cast<uint32_t>(cache));
+}
+
+uint64_t DeviceCounters::GetCacheMisses(CounterCache cache) const {
+    return Get(kCacheMissSlotsBegin + static_cast<uint32_t>(cache));
+}
+
+uint64_t DeviceCounters::GetCommandBytesEncoded() const {
+    return Get(kCommandBytesEncodedSlot);
+}
+
+uint64_t DeviceCounters::GetUploaderBytes() const {
+    return Get(kUploaderBytesSlot);
+}
+
+uint64_t DeviceCounters::GetTime(TimeCounter counter) const {
+    return Get(kTimeSlotsBegin + static_cast<uint32_t>(counter));
+}
+
+std::vector<CounterInfo> DeviceCounters::GetSnapshot() const {
+    // The names are built once since CounterInfo only points to them.
+    static const std::array<std::string, kCounterSlotCount> kNames = [] {
+        std::array<std::string, kCounterSlotCount> names;
+        names[kCommandBytesEncodedSlot] = "CommandBytesEncoded";
+        names[kUploaderBytesSlot] = "UploaderBytes";
+        for (uint32_t i = 0; i < kTimeCounterCount; ++i) {
+            names[kTimeSlotsBegin + i] = TimeCounterAsString(static_cast<TimeCounter>(i));
+        }
+        for (uint32_t i = 0; i < kCounterCacheCount; ++i) {
+            const char* cache = CounterCacheAsString(static_cast<CounterCache>(i));
+            names[kCacheHitSlotsBegin + i] = std::string("CacheHits.") + cache;
+            names[kCacheMissSlotsBegin + i] = std::string("CacheMisses.") + cache;
+        }
+        for (uint32_t i = 0; i < kObjectTypeCount; ++i) {
+            names[kObjectsCreatedSlotsBegin + i] =
+                std::string("ObjectsCreated.") + ObjectTypeAsString(static_cast<ObjectType>(i));
+        }
+        return names;
+    }();
+
+    std::vector<CounterInfo> snapshot(kCounterSlotCount);
+    for (uint32_t slot = 0; slot < kCounterSlotCount; ++slot) {
+        snapshot[slot] = {kNames[slot].c_str(), Get(slot)};
+    }
+    return snapshot;
+}
+
+void DeviceCounters::Add(uint32_t slot, uint64_t value) {
+    ASSERT(slot < kCounterSlotCount);
+    if (!mEnabled) {
+        return;
+    }
+    mShards[GetCurrentThreadShardIndex(kShardCount)].values[slot].fetch_add(
+        value, std::memory_order_relaxed);
+}
+
+uint64_t DeviceCounters::Get(uint32_t slot) const {
+    ASSERT(slot < kCounterSlotCount);
+    uint64_t value = 0;
+    for (const Shard& shard : mShards) {
+        value += shard.values[slot].load(std::memory_order_relaxed);
+    }
+    return value;
+}
+
+ScopedCounterTimer::ScopedCounterTimer(DeviceCounters* counters, TimeCounter counter)
+    : mCounters(counters), mCounter(counter) {
+    // Don't read the clock when the time won't be added.
+    if (mCounters->IsEnabled()) {
+        mStart = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedCounterTimer::~ScopedCounterTimer() {
+    if (!mCounters->IsEnabled()) {
+        return;
+    }
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - mStart;
+    mCounters->AddTime(mCounter, static_cast<uint64_t>(elapsed.count()));
+}
+
+}  // namespace dawn::native
@@ -0,0 +1,129 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_DEVICECOUNTERS_H_
+#define SRC_DAWN_NATIVE_DEVICECOUNTERS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "dawn/common/NonCopyable.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/native/ObjectType_autogen.h"
+#include "dawn/native/PerStage.h"
+
+namespace dawn::native {
+
+// The caches that count their hits and misses in DeviceCounters.
+enum class CounterCache : uint32_t {
+    AttachmentState,
+    BindGroupLayout,
+    ComputePipeline,
+    PipelineLayout,
+    RenderPipeline,
+    Sampler,
+    ShaderModule,
+    Blob,
+
+    EnumCount,
+};
+static constexpr uint32_t kCounterCacheCount = static_cast<uint32_t>(CounterCache::EnumCount);
+
+// The counters of CPU time spent in parts of Dawn, in nanoseconds.
+enum class TimeCounter : uint32_t {
+    // The validation of the command buffers done by CommandEncoder::Finish, including the part
+    // deferred to the worker pool, and by Queue::Submit.
+    SubmitValidation,
+    VertexShaderCompilation,
+    FragmentShaderCompilation,
+    ComputeShaderCompilation,
+
+    EnumCount,
+};
+static constexpr uint32_t kTimeCounterCount = static_cast<uint32_t>(TimeCounter::EnumCount);
+
+TimeCounter ShaderCompilationTimeCounter(SingleShaderStage stage);
+
+// Always-enabled CPU counters of a device, cheap enough to be updated on hot paths. Each thread
+// adds to its own shard of counters with relaxed atomics, so that updates from different threads
+// don't contend on the same cache line, and the shards are summed when the counters are read.
+// Threads share a shard only if there are more threads than shards, which stays correct.
+class DeviceCounters : public NonCopyable {
+  public:
+    // Disabled counters ignore all updates and stay at 0.
+    explicit DeviceCounters(bool enabled = true);
+    ~DeviceCounters();
+
+    bool IsEnabled() const;
+
+    void AddObjectCreated(ObjectType type);
+    void AddCacheHit(CounterCache cache);
+    void AddCacheMiss(CounterCache cache);
+    void AddCommandBytesEncoded(uint64_t bytes);
+    void AddUploaderBytes(uint64_t bytes);
+    void AddTime(TimeCounter counter, uint64_t nanoseconds);
+
+    uint64_t GetObjectsCreated(ObjectType type) const;
+    uint64_t GetCacheHits(CounterCache cache) const;
+    uint64_t GetCacheMisses(CounterCache cache) const;
+    uint64_t GetCommandBytesEncoded() const;
+    uint64_t GetUploaderBytes() const;
+    uint64_t GetTime(TimeCounter counter) const;
+
+    // Returns the value of every counter. Counters updated concurrently with the snapshot may or
+    // may not include these updates.
+    std::vector<CounterInfo> GetSnapshot() const;
+
+  private:
+    void Add(uint32_t slot, uint64_t value);
+    uint64_t Get(uint32_t slot) const;
+
+    // The counters are stored in a flat array of slots, in this order.
+    static constexpr uint32_t kObjectTypeCount =
+        static_cast<uint32_t>(PerObjectType<uint8_t>().size());
+    static constexpr uint32_t kCommandBytesEncodedSlot = 0;
+    static constexpr uint32_t kUploaderBytesSlot = 1;
+    static constexpr uint32_t kTimeSlotsBegin = 2;
+    static constexpr uint32_t kCacheHitSlotsBegin = kTimeSlotsBegin + kTimeCounterCount;
+    static constexpr uint32_t kCacheMissSlotsBegin = kCacheHitSlotsBegin + kCounterCacheCount;
+    static constexpr uint32_t kObjectsCreatedSlotsBegin = kCacheMissSlotsBegin + kCounterCacheCount;
+    static constexpr uint32_t kCounterSlotCount = kObjectsCreatedSlotsBegin + kObjectTypeCount;
+
+    static constexpr uint32_t kShardCount = 16;
+
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, kCounterSlotCount> values;
+    };
+    std::array<Shard, kShardCount> mShards;
+    const bool mEnabled;
+};
+
+// Adds the time spent in its scope to a time counter.
+class ScopedCounterTimer : public NonCopyable {
+  public:
+    ScopedCounterTimer(DeviceCounters* counters, TimeCounter counter);
+    ~ScopedCounterTimer();
+
+  private:
+    DeviceCounters* mCounters;
+    TimeCounter mCounter;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_DEVICECOUNTERS_H_
@@ -14,48 +14,99 @@
 
 #include "dawn/native/DynamicUploader.h"
 
+#include <algorithm>
+#include <thread>
 #include <utility>
 
 #include "dawn/common/Math.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/DeviceCounters.h"
 
 namespace dawn::native {
 
 DynamicUploader::DynamicUploader(DeviceBase* device) : mDevice(device) {
     mRingBuffers.emplace_back(
-        std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+        std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, RingBufferAllocator(mRingBufferSize)}));
 }
 
+DynamicUploader::~DynamicUploader() = default;
+
 void DynamicUploader::ReleaseStagingBuffer(Ref<BufferBase> stagingBuffer) {
+    mReleasedStagingBytes += stagingBuffer->GetSize();
     mReleasedStagingBuffers.Enqueue(std::move(stagingBuffer), mDevice->GetPendingCommandSerial());
 }
 
-ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocationSize,
-                                                              ExecutionSerial serial) {
-    // Disable further sub-allocation should the request be too large.
-    if (allocationSize > kRingBufferSize) {
-        BufferDescriptor bufferDesc = {};
-        bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
-        bufferDesc.size = Align(allocationSize, 4);
-        bufferDesc.mappedAtCreation = true;
-        bufferDesc.label = "Dawn_DynamicUploaderStaging";
+// static
+uint64_t DynamicUploader::GetStagingBufferSizeClass(uint64_t size) {
+    ASSERT(size > 0);
+    uint64_t step = std::max(uint64_t(1) << Log2(size), uint64_t(16)) / 4;
+    return Align(size, step);
+}
+
+ResultOrError<Ref<BufferBase>> DynamicUploader::CreateStagingBuffer(uint64_t size) {
+    // Make room for the new buffer by releasing the pooled buffers, least recently pooled first.
+    while (!mPooledStagingBuffers.empty() &&
+           GetInUseSize() + mPooledStagingBytes + size > kMemoryBudget) {
+        ReleasePooledStagingBuffer(0);
+    }
+
+    BufferDescriptor bufferDesc = {};
+    bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
+    bufferDesc.size = Align(size, 4);
+    bufferDesc.mappedAtCreation = true;
+    bufferDesc.label = "Dawn_DynamicUploaderStaging";
 
-        IgnoreLazyClearCountScope scope(mDevice);
-        Ref<BufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
+    IgnoreLazyClearCountScope scope(mDevice);
+    Ref<BufferBase> stagingBuffer;
+    DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
+    mStagingBuffersCreated++;
+    return stagingBuffer;
+}
 
-        UploadHandle uploadHandle;
-        uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
-        uploadHandle.stagingBuffer = stagingBuffer.Get();
+ResultOrError<UploadHandle> DynamicUploader::AllocateDedicated(uint64_t allocationSize) {
+    uint64_t sizeClass = GetStagingBufferSizeClass(allocationSize);
+    Ref<BufferBase> stagingBuffer;
 
-        ReleaseStagingBuffer(std::move(stagingBuffer));
-        return uploadHandle;
+    // Reuse the most recently pooled buffer of the size class, which is the most likely to still
+    // be resident.
+    for (size_t i = mPooledStagingBuffers.size(); i > 0; --i) {
+        if (mPooledStagingBuffers[i - 1].buffer->GetSize() == sizeClass) {
+            stagingBuffer = std::move(mPooledStagingBuffers[i - 1].buffer);
+            mPooledStagingBytes -= sizeClass;
+            mPooledStagingBuffers.erase(mPooledStagingBuffers.begin() + (i - 1));
+            mStagingBuffersReused++;
+            break;
+        }
+    }
+    if (stagingBuffer == nullptr) {
+        DAWN_TRY_ASSIGN(stagingBuffer, CreateStagingBuffer(sizeClass));
     }
 
+    UploadHandle uploadHandle;
+    uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
+    uploadHandle.stagingBuffer = stagingBuffer.Get();
+
+    mPendingDedicatedStagingBytes += stagingBuffer->GetSize();
+    mPendingDedicatedStagingBuffers.Enqueue(std::move(stagingBuffer),
+                                            mDevice->GetPendingCommandSerial());
+    return uploadHandle;
+}
+
+void DynamicUploader::ReleasePooledStagingBuffer(size_t index) {
+    mPooledStagingBytes -= mPooledStagingBuffers[index].buffer->GetSize();
+    mPooledStagingBuffers.erase(mPooledStagingBuffers.begin() + index);
+    mStagingBuffersReleased++;
+}
+
+ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocationSize,
+                                                              ExecutionSerial serial) {
+    ASSERT(allocationSize <= mRingBufferSize);
+
     // Note: Validation ensures size is already aligned.
     // First-fit: find next smallest buffer large enough to satisfy the allocation request.
-    RingBuffer* targetRingBuffer = mRingBuffers.back().get();
+    RingBuffer* targetRingBuffer = nullptr;
+    uint64_t startOffset = RingBufferAllocator::kInvalidOffset;
     for (auto& ringBuffer : mRingBuffers) {
         const RingBufferAllocator& ringBufferAllocator = ringBuffer->mAllocator;
         // Prevent overflow.
@@ -63,21 +114,19 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
         const uint64_t remainingSize =
             ringBufferAllocator.GetSize() - ringBufferAllocator.GetUsedSize();
         if (allocationSize <= remainingSize) {
-            targetRingBuffer = ringBuffer.get();
-            break;
+            startOffset = ringBuffer->mAllocator.Allocate(allocationSize, serial);
+            if (startOffset != RingBufferAllocator::kInvalidOffset) {
+                targetRingBuffer = ringBuffer.get();
+                break;
+            }
         }
     }
 
-    uint64_t startOffset = RingBufferAllocator::kInvalidOffset;
-    if (targetRingBuffer != nullptr) {
-        startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
-    }
-
     // Upon failure, append a newly created ring buffer to fulfill the
     // request.
     if (startOffset == RingBufferAllocator::kInvalidOffset) {
         mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
-            new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+            new RingBuffer{nullptr, RingBufferAllocator(mRingBufferSize)}));
 
         targetRingBuffer = mRingBuffers.back().get();
         startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
@@ -88,19 +137,12 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
     // Allocate the staging buffer backing the ringbuffer.
     // Note: the first ringbuffer will be lazily created.
     if (targetRingBuffer->mStagingBuffer == nullptr) {
-        BufferDescriptor bufferDesc = {};
-        bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
-        bufferDesc.size = Align(targetRingBuffer->mAllocator.GetSize(), 4);
-        bufferDesc.mappedAtCreation = true;
-        bufferDesc.label = "Dawn_DynamicUploaderStaging";
-
-        IgnoreLazyClearCountScope scope(mDevice);
-        Ref<BufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
-        targetRingBuffer->mStagingBuffer = std::move(stagingBuffer);
+        DAWN_TRY_ASSIGN(targetRingBuffer->mStagingBuffer,
+                        CreateStagingBuffer(targetRingBuffer->mAllocator.GetSize()));
     }
 
     ASSERT(targetRingBuffer->mStagingBuffer != nullptr);
+    mRingBytesSinceLastTick += allocationSize;
 
     UploadHandle uploadHandle;
     uploadHandle.stagingBuffer = targetRingBuffer->mStagingBuffer.Get();
@@ -111,19 +153,81 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
     return uploadHandle;
 }
 
+void DynamicUploader::UpdateRingBufferSize() {
+    // Smooth the bytes uploaded per tick so that a single burst doesn't resize the ring buffers.
+    mAverageRingBytesPerTick = (mAverageRingBytesPerTick * 3 + mRingBytesSinceLastTick) / 4;
+    mRingBytesSinceLastTick = 0;
+
+    uint64_t size = uint64_t(1) << Log2Ceil(std::max(mAverageRingBytesPerTick, uint64_t(1)));
+    mRingBufferSize = std::clamp(size, kMinRingBufferSize, kMaxRingBufferSize);
+}
+
 void DynamicUploader::Deallocate(ExecutionSerial lastCompletedSerial) {
+    mTickCount++;
+    UpdateRingBufferSize();
+    ReclaimCompletedUploads(lastCompletedSerial);
+
+    while (!mPooledStagingBuffers.empty() &&
+           (GetInUseSize() + mPooledStagingBytes > kMemoryBudget ||
+            mTickCount - mPooledStagingBuffers.front().pooledTick >
+                kMaxPooledStagingBufferIdleTicks)) {
+        ReleasePooledStagingBuffer(0);
+    }
+}
+
+void DynamicUploader::ReclaimCompletedUploads(ExecutionSerial lastCompletedSerial) {
     // Reclaim memory within the ring buffers by ticking (or removing requests no longer
     // in-flight).
-    for (size_t i = 0; i < mRingBuffers.size(); ++i) {
-        mRingBuffers[i]->mAllocator.Deallocate(lastCompletedSerial);
+    for (auto& ringBuffer : mRingBuffers) {
+        ringBuffer->mAllocator.Deallocate(lastCompletedSerial);
+    }
 
-        // Never erase the last buffer as to prevent re-creating smaller buffers
-        // again. The last buffer is the largest.
-        if (mRingBuffers[i]->mAllocator.Empty() && i < mRingBuffers.size() - 1) {
-            mRingBuffers.erase(mRingBuffers.begin() + i);
+    // Never erase the last buffer of the current size as to prevent re-creating it again. Empty
+    // buffers of another size are replaced lazily by buffers of the current size.
+    for (size_t i = mRingBuffers.size(); i > 0; --i) {
+        const RingBufferAllocator& allocator = mRingBuffers[i - 1]->mAllocator;
+        bool isLastOfCurrentSize =
+            i == mRingBuffers.size() && allocator.GetSize() == mRingBufferSize;
+        if (allocator.Empty() && !isLastOfCurrentSize) {
+            mRingBuffers.erase(mRingBuffers.begin() + (i - 1));
         }
     }
+
+    for (const Ref<BufferBase>& buffer : mReleasedStagingBuffers.IterateUpTo(lastCompletedSerial)) {
+        mReleasedStagingBytes -= buffer->GetSize();
+    }
     mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
+
+    // Pool the dedicated staging buffers of the completed uploads. They stay mapped so they can
+    // be written to again directly.
+    for (Ref<BufferBase>& buffer :
+         mPendingDedicatedStagingBuffers.IterateUpTo(lastCompletedSerial)) {
+        mPendingDedicatedStagingBytes -= buffer->GetSize();
+        mPooledStagingBytes += buffer->GetSize();
+        mPooledStagingBuffers.push_back({std::move(buffer), mTickCount});
+    }
+    mPendingDedicatedStagingBuffers.ClearUpTo(lastCompletedSerial);
+}
+
+MaybeError DynamicUploader::WaitForStagingMemory(uint64_t size) {
+    // Apply backpressure when the staging memory of the uploads in flight would go over budget:
+    // wait for the submitted uploads to complete and reclaim their staging memory.
+    while (GetInUseSize() + size > kMemoryBudget &&
+           mDevice->GetCompletedCommandSerial() < mDevice->GetLastSubmittedCommandSerial()) {
+        DAWN_TRY(mDevice->CheckPassedSerials());
+        ReclaimCompletedUploads(mDevice->GetCompletedCommandSerial());
+        if (mDevice->GetCompletedCommandSerial() < mDevice->GetLastSubmittedCommandSerial()) {
+            std::this_thread::yield();
+        }
+    }
+
+    // The rest of the staging memory is used by uploads that are not submitted yet. They can't be
+    // submitted from here since the backend may be in the middle of recording commands, so they
+    // are submitted at the next tick instead.
+    if (GetInUseSize() + size > kMemoryBudget) {
+        mDevice->ForceEventualFlushOfCommands();
+    }
+    return {};
 }
 
 // TODO(dawn:512): Optimize this function so that it doesn't allocate additional memory
@@ -133,7 +237,16 @@ ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize,
                                                       uint64_t offsetAlignment) {
     ASSERT(offsetAlignment > 0);
     UploadHandle uploadHandle;
-    DAWN_TRY_ASSIGN(uploadHandle, AllocateInternal(allocationSize + offsetAlignment - 1, serial));
+    // Disable further sub-allocation should the request be too large. Dedicated staging buffers
+    // are used from offset 0, which is aligned to any |offsetAlignment|, so they are not padded.
+    uint64_t paddedAllocationSize = allocationSize + offsetAlignment - 1;
+    DAWN_TRY(WaitForStagingMemory(paddedAllocationSize));
+    if (paddedAllocationSize > mRingBufferSize) {
+        DAWN_TRY_ASSIGN(uploadHandle, AllocateDedicated(allocationSize));
+    } else {
+        DAWN_TRY_ASSIGN(uploadHandle, AllocateInternal(paddedAllocationSize, serial));
+    }
+    mDevice->GetCounters()->AddUploaderBytes(allocationSize);
     uint64_t additionalOffset =
         Align(uploadHandle.startOffset, offsetAlignment) - uploadHandle.startOffset;
     uploadHandle.mappedBuffer = static_cast<uint8_t*>(uploadHandle.mappedBuffer) + additionalOffset;
@@ -142,17 +255,14 @@ ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize,
 }
 
 bool DynamicUploader::ShouldFlush() {
-    uint64_t kTotalAllocatedSizeThreshold = 64 * 1024 * 1024;
-    // We use total allocated size instead of pending-upload size to prevent Dawn from allocating
-    // too much GPU memory so that the risk of OOM can be minimized.
-    return GetTotalAllocatedSize() > kTotalAllocatedSizeThreshold;
+    // We use the in-use size instead of pending-upload size to prevent Dawn from allocating
+    // too much GPU memory so that the risk of OOM can be minimized. Pooled staging buffers are not
+    // counted since they are released first when over budget.
+    return GetInUseSize() > kFlushThreshold;
 }
 
-uint64_t DynamicUploader::GetTotalAllocatedSize() {
-    uint64_t size = 0;
-    for (const auto& buffer : mReleasedStagingBuffers.IterateAll()) {
-        size += buffer->GetSize();
-    }
+uint64_t DynamicUploader::GetInUseSize() const {
+    uint64_t size = mReleasedStagingBytes + mPendingDedicatedStagingBytes;
     for (const auto& buffer : mRingBuffers) {
         if (buffer->mStagingBuffer != nullptr) {
             size += buffer->mStagingBuffer->GetSize();
@@ -161,4 +271,22 @@ uint64_t DynamicUploader::GetTotalAllocatedSize() {
     return size;
 }
 
+StagingMemoryStats DynamicUploader::GetStats() const {
+    StagingMemoryStats stats;
+    for (const auto& buffer : mRingBuffers) {
+        if (buffer->mStagingBuffer != nullptr) {
+            stats.ringBufferCount++;
+            stats.ringBufferBytes += buffer->mStagingBuffer->GetSize();
+        }
+    }
+    stats.ringBufferSize = mRingBufferSize;
+    stats.pendingStagingBytes = mReleasedStagingBytes + mPendingDedicatedStagingBytes;
+    stats.pooledStagingBufferCount = mPooledStagingBuffers.size();
+    stats.pooledStagingBytes = mPooledStagingBytes;
+    stats.stagingBuffersCreated = mStagingBuffersCreated;
+    stats.stagingBuffersReused = mStagingBuffersReused;
+    stats.stagingBuffersReleased = mStagingBuffersReleased;
+    return stats;
+}
+
 }  // namespace dawn::native
@@ -19,6 +19,8 @@
 #include <vector>
 
 #include "dawn/common/Ref.h"
+#include "dawn/common/SerialQueue.h"
+#include "dawn/native/DawnNative.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/Forward.h"
 #include "dawn/native/IntegerTypes.h"
@@ -36,10 +38,18 @@ struct UploadHandle {
     BufferBase* stagingBuffer = nullptr;
 };
 
+// Staging buffers bigger than the ring buffers are dedicated to a single upload. Instead of being
+// destroyed once the upload completes, they are pooled by size class for the next large uploads,
+// and released when they stay unused for a while or when the staging memory goes over budget.
+// When the staging memory of the uploads in flight would go over budget, the upload waits for the
+// submitted uploads to complete. Uploads that are not submitted yet can't be waited on, so the
+// budget can still be exceeded by uploads recorded between two submits.
+// The size of the new ring buffers adapts to the amount of data uploaded between two ticks, so
+// that streaming uploads are done from a single ring buffer per tick.
 class DynamicUploader {
   public:
     explicit DynamicUploader(DeviceBase* device);
-    ~DynamicUploader() = default;
+    ~DynamicUploader();
 
     // We add functions to Release StagingBuffers to the DynamicUploader as there's
     // currently no place to track the allocated staging buffers such that they're freed after
@@ -54,19 +64,65 @@ class DynamicUploader {
 
     bool ShouldFlush();
 
+    StagingMemoryStats GetStats() const;
+
   private:
-    static constexpr uint64_t kRingBufferSize = 4 * 1024 * 1024;
-    uint64_t GetTotalAllocatedSize();
+    static constexpr uint64_t kMinRingBufferSize = 4 * 1024 * 1024;
+    static constexpr uint64_t kMaxRingBufferSize = 32 * 1024 * 1024;
+    // The staging memory used by pending uploads above which commands are flushed so that the
+    // staging memory can be reclaimed sooner.
+    static constexpr uint64_t kFlushThreshold = 64 * 1024 * 1024;
+    // The staging memory, including the pooled staging buffers, above which pooled staging
+    // buffers are released before creating new ones. Uploads that would take the staging memory of
+    // the uploads in flight over it first wait for the submitted uploads to complete.
+    static constexpr uint64_t kMemoryBudget = 256 * 1024 * 1024;
+    // The number of ticks after which an unused pooled staging buffer is released.
+    static constexpr uint64_t kMaxPooledStagingBufferIdleTicks = 64;
 
     struct RingBuffer {
         Ref<BufferBase> mStagingBuffer;
         RingBufferAllocator mAllocator;
     };
 
+    struct PooledStagingBuffer {
+        Ref<BufferBase> buffer;
+        uint64_t pooledTick;
+    };
+
+    // Rounds dedicated staging buffer sizes up to a quarter of a power of two so that uploads of
+    // slightly different sizes can reuse the same staging buffers.
+    static uint64_t GetStagingBufferSizeClass(uint64_t size);
+
     ResultOrError<UploadHandle> AllocateInternal(uint64_t allocationSize, ExecutionSerial serial);
+    ResultOrError<UploadHandle> AllocateDedicated(uint64_t allocationSize);
+    ResultOrError<Ref<BufferBase>> CreateStagingBuffer(uint64_t size);
+    void ReleasePooledStagingBuffer(size_t index);
+    void ReclaimCompletedUploads(ExecutionSerial lastCompletedSerial);
+    MaybeError WaitForStagingMemory(uint64_t size);
+    void UpdateRingBufferSize();
+
+    // The staging memory used by ring buffers and pending uploads, excluding pooled buffers.
+    uint64_t GetInUseSize() const;
 
     std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
     SerialQueue<ExecutionSerial, Ref<BufferBase>> mReleasedStagingBuffers;
+    SerialQueue<ExecutionSerial, Ref<BufferBase>> mPendingDedicatedStagingBuffers;
+    uint64_t mReleasedStagingBytes = 0;
+    uint64_t mPendingDedicatedStagingBytes = 0;
+
+    // Ordered from the least to the most recently pooled.
+    std::vector<PooledStagingBuffer> mPooledStagingBuffers;
+    uint64_t mPooledStagingBytes = 0;
+
+    uint64_t mRingBufferSize = kMinRingBufferSize;
+    uint64_t mRingBytesSinceLastTick = 0;
+    uint64_t mAverageRingBytesPerTick = 0;
+    uint64_t mTickCount = 0;
+
+    uint64_t mStagingBuffersCreated = 0;
+    uint64_t mStagingBuffersReused = 0;
+    uint64_t mStagingBuffersReleased = 0;
+
     DeviceBase* mDevice;
 };
 }  // namespace dawn::native
@@ -18,6 +18,7 @@
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/Commands.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/ErrorData.h"
 #include "dawn/native/IndirectDrawValidationEncoder.h"
 #include "dawn/native/RenderBundleEncoder.h"
@@ -28,6 +29,7 @@ EncodingContext::EncodingContext(DeviceBase* device, const ApiObjectBase* initia
     : mDevice(device),
       mTopLevelEncoder(initialEncoder),
       mCurrentEncoder(initialEncoder),
+      mPendingCommands(device->GetCommandBlockPool()),
       mDestroyed(device->IsLost()) {}
 
 EncodingContext::~EncodingContext() {
@@ -54,6 +56,7 @@ CommandIterator EncodingContext::AcquireCommands() {
     MoveToIterator();
     ASSERT(!mWereCommandsAcquired);
     mWereCommandsAcquired = true;
+    mDevice->GetCounters()->AddCommandBytesEncoded(mIterator.GetAllocatedSize());
     return std::move(mIterator);
 }
 
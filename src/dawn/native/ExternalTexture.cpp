@@ -134,7 +134,7 @@ ExternalTextureBase::ExternalTextureBase(DeviceBase* device,
       mVisibleOrigin(descriptor->visibleOrigin),
       mVisibleSize(descriptor->visibleSize),
       mState(ExternalTextureState::Active) {
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 // Error external texture cannot be used in bind group.
@@ -509,7 +509,15 @@ void InstanceBase::SetPlatform(dawn::platform::Platform* platform) {
     } else {
         mPlatform = platform;
     }
-    mBlobCache = std::make_unique<BlobCache>(GetCachingInterface(platform));
+
+    // The previous blob cache writes its deferred stores on its task pool when destroyed.
+    mBlobCache = nullptr;
+    mBlobCacheWriterTaskPool = nullptr;
+    if (mToggles.IsEnabled(Toggle::DeferBlobCacheStores)) {
+        mBlobCacheWriterTaskPool = mPlatform->CreateWorkerTaskPool();
+    }
+    mBlobCache = std::make_unique<BlobCache>(GetCachingInterface(platform),
+                                             mBlobCacheWriterTaskPool.get());
 }
 
 void InstanceBase::SetPlatformForTesting(dawn::platform::Platform* platform) {
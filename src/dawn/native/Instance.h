@@ -188,6 +188,8 @@ class InstanceBase final : public RefCountedWithExternalCount {
 
     dawn::platform::Platform* mPlatform = nullptr;
     std::unique_ptr<dawn::platform::Platform> mDefaultPlatform;
+    // Used to write the stores of mBlobCache when the DeferBlobCacheStores toggle is enabled.
+    std::unique_ptr<dawn::platform::WorkerTaskPool> mBlobCacheWriterTaskPool;
     std::unique_ptr<BlobCache> mBlobCache;
     BlobCache mPassthroughBlobCache;
 
@@ -17,6 +17,7 @@
 
 #include "absl/strings/str_format.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/ObjectBase.h"
 #include "dawn/native/ObjectType_autogen.h"
 
@@ -134,6 +135,12 @@ ApiObjectList* ApiObjectBase::GetObjectTrackingList() {
     return GetDevice()->GetObjectTrackingList(GetType());
 }
 
+void ApiObjectBase::TrackInDevice() {
+    ASSERT(GetDevice() != nullptr);
+    GetDevice()->GetCounters()->AddObjectCreated(GetType());
+    GetObjectTrackingList()->Track(this);
+}
+
 void ApiObjectBase::Destroy() {
     if (!IsAlive()) {
         return;
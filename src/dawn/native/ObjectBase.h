@@ -123,6 +123,10 @@ class ApiObjectBase : public ObjectBase, public LinkNode<ApiObjectBase> {
     //   i.e. Device -[tracks]-> Texture -[tracks]-> TextureView.
     virtual ApiObjectList* GetObjectTrackingList();
 
+    // Tracks the object in its tracking list and counts its creation in the device's counters.
+    // Must be called by the constructor of the class that implements GetType().
+    void TrackInDevice();
+
     // Sub-classes may override this function multiple times. Whenever overriding this function,
     // however, users should be sure to call their parent's version in the new override to make
     // sure that all destroy functionality is kept. This function is guaranteed to only be
@@ -14,6 +14,8 @@
 
 #include "dawn/native/PassResourceUsageTracker.h"
 
+#include <algorithm>
+#include <functional>
 #include <utility>
 
 #include "dawn/native/BindGroup.h"
@@ -26,6 +28,180 @@
 
 namespace dawn::native {
 
+namespace {
+
+// Scopes with at most this many resources of a kind don't build a hash table for them.
+constexpr size_t kMaxLinearSearchCount = 16;
+
+constexpr size_t kMinTableCapacity = 64;
+constexpr size_t kMaxLoadNumerator = 3;
+constexpr size_t kMaxLoadDenominator = 4;
+
+size_t HashResource(const void* resource) {
+    // Resources are heap pointers whose low bits are always zero, mix all the bits in the high
+    // ones with a multiplicative hash and fold them back down.
+    uint64_t bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(resource));
+    bits *= 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(bits ^ (bits >> 32));
+}
+
+// Sorts |resources| by address and applies the same permutation to |usages|. This is the order in
+// which the resources were produced when they were tracked in std::maps, which keeps the order of
+// barriers and validation errors stable.
+template <typename T, typename Usage>
+void SortByAddress(std::vector<T*>* resources, std::vector<Usage>* usages) {
+    ASSERT(resources->size() == usages->size());
+    if (std::is_sorted(resources->begin(), resources->end(), std::less<T*>())) {
+        return;
+    }
+
+    std::vector<size_t> order(resources->size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return std::less<T*>()((*resources)[a], (*resources)[b]);
+    });
+
+    std::vector<T*> sortedResources;
+    std::vector<Usage> sortedUsages;
+    sortedResources.reserve(order.size());
+    sortedUsages.reserve(order.size());
+    for (size_t i : order) {
+        sortedResources.push_back((*resources)[i]);
+        sortedUsages.push_back(std::move((*usages)[i]));
+    }
+    *resources = std::move(sortedResources);
+    *usages = std::move(sortedUsages);
+}
+
+// Merges |addedResources|, sorted by address, and their |addedUsages| into |resources| and
+// |usages|. These are sorted by address first so that both lists are walked once. Resources that
+// weren't in |resources| yet start with the usage returned by |createUsage|, and |mergeUsage| then
+// adds the usage of the added resource to the usage of the resource in the scope.
+template <typename T, typename Usage, typename CreateUsage, typename MergeUsage>
+void MergeSortedUsages(std::vector<T*>* resources,
+                       std::vector<Usage>* usages,
+                       const std::vector<T*>& addedResources,
+                       const std::vector<Usage>& addedUsages,
+                       CreateUsage createUsage,
+                       MergeUsage mergeUsage) {
+    ASSERT(addedResources.size() == addedUsages.size());
+    ASSERT(std::is_sorted(addedResources.begin(), addedResources.end(), std::less<T*>()));
+    SortByAddress(resources, usages);
+
+    std::vector<T*> mergedResources;
+    std::vector<Usage> mergedUsages;
+    mergedResources.reserve(resources->size() + addedResources.size());
+    mergedUsages.reserve(resources->size() + addedResources.size());
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < resources->size() || j < addedResources.size()) {
+        if (j == addedResources.size() ||
+            (i < resources->size() && std::less<T*>()((*resources)[i], addedResources[j]))) {
+            mergedResources.push_back((*resources)[i]);
+            mergedUsages.push_back(std::move((*usages)[i]));
+            i++;
+            continue;
+        }
+
+        if (i < resources->size() && (*resources)[i] == addedResources[j]) {
+            mergedResources.push_back((*resources)[i]);
+            mergedUsages.push_back(std::move((*usages)[i]));
+            i++;
+        } else {
+            mergedResources.push_back(addedResources[j]);
+            mergedUsages.push_back(createUsage(addedResources[j]));
+        }
+        mergeUsage(&mergedUsages.back(), addedUsages[j]);
+        j++;
+    }
+
+    *resources = std::move(mergedResources);
+    *usages = std::move(mergedUsages);
+}
+
+}  // anonymous namespace
+
+template <typename T>
+size_t SyncScopeUsageTracker::ResourceIndex<T>::FindOrAppend(T* resource,
+                                                              std::vector<T*>* resources,
+                                                              bool* appended) {
+    ASSERT(resource != nullptr);
+
+    if (mSlots.empty()) {
+        for (size_t i = 0; i < resources->size(); ++i) {
+            if ((*resources)[i] == resource) {
+                *appended = false;
+                return i;
+            }
+        }
+
+        *appended = true;
+        resources->push_back(resource);
+        if (resources->size() > kMaxLinearSearchCount) {
+            Rebuild(*resources);
+        }
+        return resources->size() - 1;
+    }
+
+    Slot& slot = mSlots[FindSlot(resource)];
+    if (slot.key == resource) {
+        *appended = false;
+        return slot.index;
+    }
+
+    *appended = true;
+    slot.key = resource;
+    slot.index = resources->size();
+    resources->push_back(resource);
+    if (resources->size() * kMaxLoadDenominator > mSlots.size() * kMaxLoadNumerator) {
+        Rebuild(*resources);
+    }
+    return resources->size() - 1;
+}
+
+template <typename T>
+void SyncScopeUsageTracker::ResourceIndex<T>::Clear() {
+    // Keep the capacity of the slots so that reusing the tracker doesn't allocate again.
+    mSlots.clear();
+}
+
+template <typename T>
+void SyncScopeUsageTracker::ResourceIndex<T>::Reset(const std::vector<T*>& resources) {
+    Clear();
+    if (resources.size() > kMaxLinearSearchCount) {
+        Rebuild(resources);
+    }
+}
+
+template <typename T>
+size_t SyncScopeUsageTracker::ResourceIndex<T>::FindSlot(T* key) const {
+    // There is always at least one empty slot because of the maximum load factor.
+    const size_t mask = mSlots.size() - 1;
+    size_t index = HashResource(key) & mask;
+    while (mSlots[index].key != nullptr && mSlots[index].key != key) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+template <typename T>
+void SyncScopeUsageTracker::ResourceIndex<T>::Rebuild(const std::vector<T*>& resources) {
+    size_t capacity = std::max(kMinTableCapacity, mSlots.size());
+    while (resources.size() * kMaxLoadDenominator > capacity * kMaxLoadNumerator) {
+        capacity *= 2;
+    }
+    mSlots.assign(capacity, Slot{});
+
+    for (size_t i = 0; i < resources.size(); ++i) {
+        Slot& slot = mSlots[FindSlot(resources[i])];
+        slot.key = resources[i];
+        slot.index = i;
+    }
+}
+
 SyncScopeUsageTracker::SyncScopeUsageTracker() = default;
 
 SyncScopeUsageTracker::SyncScopeUsageTracker(SyncScopeUsageTracker&&) = default;
@@ -35,22 +211,29 @@ SyncScopeUsageTracker::~SyncScopeUsageTracker() = default;
 SyncScopeUsageTracker& SyncScopeUsageTracker::operator=(SyncScopeUsageTracker&&) = default;
 
 void SyncScopeUsageTracker::BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage) {
-    // std::map's operator[] will create the key and return 0 if the key didn't exist
-    // before.
-    mBufferUsages[buffer] |= usage;
+    bool appended;
+    size_t index = mBufferIndex.FindOrAppend(buffer, &mBuffers, &appended);
+    if (appended) {
+        mBufferUsages.push_back(wgpu::BufferUsage::None);
+    }
+    mBufferUsages[index] |= usage;
+}
+
+TextureSubresourceUsage& SyncScopeUsageTracker::GetOrCreateTextureUsage(TextureBase* texture) {
+    // Create a new TextureSubresourceUsage for that texture (initially filled with
+    // wgpu::TextureUsage::None) if it wasn't used in the scope yet.
+    bool appended;
+    size_t index = mTextureIndex.FindOrAppend(texture, &mTextures, &appended);
+    if (appended) {
+        mTextureUsages.emplace_back(texture->GetFormat().aspects, texture->GetArrayLayers(),
+                                    texture->GetNumMipLevels(), wgpu::TextureUsage::None);
+    }
+    return mTextureUsages[index];
 }
 
 void SyncScopeUsageTracker::TextureViewUsedAs(TextureViewBase* view, wgpu::TextureUsage usage) {
-    TextureBase* texture = view->GetTexture();
     const SubresourceRange& range = view->GetSubresourceRange();
-
-    // Get or create a new TextureSubresourceUsage for that texture (initially filled with
-    // wgpu::TextureUsage::None)
-    auto it = mTextureUsages.emplace(
-        std::piecewise_construct, std::forward_as_tuple(texture),
-        std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                              texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-    TextureSubresourceUsage& textureUsage = it.first->second;
+    TextureSubresourceUsage& textureUsage = GetOrCreateTextureUsage(view->GetTexture());
 
     textureUsage.Update(range, [usage](const SubresourceRange&, wgpu::TextureUsage* storedUsage) {
         // TODO(crbug.com/dawn/1001): Consider optimizing to have fewer
@@ -67,23 +250,29 @@ void SyncScopeUsageTracker::TextureViewUsedAs(TextureViewBase* view, wgpu::Textu
     });
 }
 
-void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
-    TextureBase* texture,
-    const TextureSubresourceUsage& textureUsage) {
-    // Get or create a new TextureSubresourceUsage for that texture (initially filled with
-    // wgpu::TextureUsage::None)
-    auto it = mTextureUsages.emplace(
-        std::piecewise_construct, std::forward_as_tuple(texture),
-        std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                              texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-    TextureSubresourceUsage* passTextureUsage = &it.first->second;
-
-    passTextureUsage->Merge(textureUsage,
-                            [](const SubresourceRange&, wgpu::TextureUsage* storedUsage,
-                               const wgpu::TextureUsage& addedUsage) {
-                                ASSERT((addedUsage & wgpu::TextureUsage::RenderAttachment) == 0);
-                                *storedUsage |= addedUsage;
-                            });
+void SyncScopeUsageTracker::AddRenderBundleUsage(const SyncScopeResourceUsage& bundleUsage) {
+    MergeSortedUsages(
+        &mBuffers, &mBufferUsages, bundleUsage.buffers, bundleUsage.bufferUsages,
+        [](BufferBase*) { return wgpu::BufferUsage::None; },
+        [](wgpu::BufferUsage* storedUsage, wgpu::BufferUsage addedUsage) {
+            *storedUsage |= addedUsage;
+        });
+    mBufferIndex.Reset(mBuffers);
+
+    MergeSortedUsages(
+        &mTextures, &mTextureUsages, bundleUsage.textures, bundleUsage.textureUsages,
+        [](TextureBase* texture) {
+            return TextureSubresourceUsage(texture->GetFormat().aspects, texture->GetArrayLayers(),
+                                           texture->GetNumMipLevels(), wgpu::TextureUsage::None);
+        },
+        [](TextureSubresourceUsage* storedUsage, const TextureSubresourceUsage& addedUsage) {
+            storedUsage->Merge(addedUsage, [](const SubresourceRange&, wgpu::TextureUsage* stored,
+                                              const wgpu::TextureUsage& added) {
+                ASSERT((added & wgpu::TextureUsage::RenderAttachment) == 0);
+                *stored |= added;
+            });
+        });
+    mTextureIndex.Reset(mTextures);
 }
 
 void SyncScopeUsageTracker::AddBindGroup(BindGroupBase* group) {
@@ -148,34 +337,33 @@ void SyncScopeUsageTracker::AddBindGroup(BindGroupBase* group) {
     }
 
     for (const Ref<ExternalTextureBase>& externalTexture : group->GetBoundExternalTextures()) {
-        mExternalTextureUsages.insert(externalTexture.Get());
+        bool appended;
+        mExternalTextureIndex.FindOrAppend(externalTexture.Get(), &mExternalTextures, &appended);
     }
 }
 
 SyncScopeResourceUsage SyncScopeUsageTracker::AcquireSyncScopeUsage() {
-    SyncScopeResourceUsage result;
-    result.buffers.reserve(mBufferUsages.size());
-    result.bufferUsages.reserve(mBufferUsages.size());
-    result.textures.reserve(mTextureUsages.size());
-    result.textureUsages.reserve(mTextureUsages.size());
-
-    for (auto& [buffer, usage] : mBufferUsages) {
-        result.buffers.push_back(buffer);
-        result.bufferUsages.push_back(usage);
-    }
+    mBufferIndex.Clear();
+    mTextureIndex.Clear();
+    mExternalTextureIndex.Clear();
 
-    for (auto& [texture, usage] : mTextureUsages) {
-        result.textures.push_back(texture);
-        result.textureUsages.push_back(std::move(usage));
-    }
+    SortByAddress(&mBuffers, &mBufferUsages);
+    SortByAddress(&mTextures, &mTextureUsages);
+    std::sort(mExternalTextures.begin(), mExternalTextures.end(),
+              std::less<ExternalTextureBase*>());
 
-    for (auto* const it : mExternalTextureUsages) {
-        result.externalTextures.push_back(it);
-    }
+    SyncScopeResourceUsage result;
+    result.buffers = std::move(mBuffers);
+    result.bufferUsages = std::move(mBufferUsages);
+    result.textures = std::move(mTextures);
+    result.textureUsages = std::move(mTextureUsages);
+    result.externalTextures = std::move(mExternalTextures);
 
+    mBuffers.clear();
     mBufferUsages.clear();
+    mTextures.clear();
     mTextureUsages.clear();
-    mExternalTextureUsages.clear();
+    mExternalTextures.clear();
 
     return result;
 }
@@ -16,7 +16,6 @@
 #define SRC_DAWN_NATIVE_PASSRESOURCEUSAGETRACKER_H_
 
 #include <map>
-#include <set>
 #include <vector>
 
 #include "dawn/native/PassResourceUsage.h"
@@ -44,8 +43,9 @@ class SyncScopeUsageTracker {
 
     void BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage);
     void TextureViewUsedAs(TextureViewBase* texture, wgpu::TextureUsage usage);
-    void AddRenderBundleTextureUsage(TextureBase* texture,
-                                     const TextureSubresourceUsage& textureUsage);
+    // Merges the usages of a render bundle, that AcquireSyncScopeUsage produced sorted by address
+    // when the bundle was finished, into the scope in a single pass over both lists.
+    void AddRenderBundleUsage(const SyncScopeResourceUsage& bundleUsage);
 
     // Walks the bind groups and tracks all its resources.
     void AddBindGroup(BindGroupBase* group);
@@ -54,9 +54,45 @@ class SyncScopeUsageTracker {
     SyncScopeResourceUsage AcquireSyncScopeUsage();
 
   private:
-    std::map<BufferBase*, wgpu::BufferUsage> mBufferUsages;
-    std::map<TextureBase*, TextureSubresourceUsage> mTextureUsages;
-    std::set<ExternalTextureBase*> mExternalTextureUsages;
+    // Maps the resources of the scope to their position in the flat vectors below. Scopes with
+    // few resources are searched linearly, larger ones build an open-addressing table keyed by
+    // the resource pointers. The table keeps its storage when cleared.
+    template <typename T>
+    class ResourceIndex {
+      public:
+        // Returns the position of |resource| in |resources|, appending it and setting |appended|
+        // if it wasn't there already.
+        size_t FindOrAppend(T* resource, std::vector<T*>* resources, bool* appended);
+        void Clear();
+        // Indexes |resources| again after they were reordered.
+        void Reset(const std::vector<T*>& resources);
+
+      private:
+        struct Slot {
+            T* key = nullptr;
+            size_t index = 0;
+        };
+
+        size_t FindSlot(T* key) const;
+        void Rebuild(const std::vector<T*>& resources);
+
+        std::vector<Slot> mSlots;
+    };
+
+    TextureSubresourceUsage& GetOrCreateTextureUsage(TextureBase* texture);
+
+    // Each resource appears once in the vectors, in the order they were first used, except that
+    // merging a render bundle sorts them. They are sorted by address in AcquireSyncScopeUsage.
+    std::vector<BufferBase*> mBuffers;
+    std::vector<wgpu::BufferUsage> mBufferUsages;
+    ResourceIndex<BufferBase> mBufferIndex;
+
+    std::vector<TextureBase*> mTextures;
+    std::vector<TextureSubresourceUsage> mTextureUsages;
+    ResourceIndex<TextureBase> mTextureIndex;
+
+    std::vector<ExternalTextureBase*> mExternalTextures;
+    ResourceIndex<ExternalTextureBase> mExternalTextureIndex;
 };
 
 // Helper class to build ComputePassResourceUsages
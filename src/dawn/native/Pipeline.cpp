@@ -49,6 +49,10 @@ MaybeError ValidateProgrammableStage(DeviceBase* device,
 
     const EntryPointMetadata& metadata = module->GetEntryPoint(entryPoint);
 
+    DAWN_INVALID_IF(!metadata.reflectionError.empty(),
+                    "Reflection of entry point \"%s\" failed: %s", entryPoint,
+                    metadata.reflectionError);
+
     if (!metadata.infringedLimitErrors.empty()) {
         std::ostringstream limitList;
         for (const std::string& limit : metadata.infringedLimitErrors) {
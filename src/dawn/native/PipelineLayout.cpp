@@ -73,7 +73,7 @@ PipelineLayoutBase::PipelineLayoutBase(DeviceBase* device,
 PipelineLayoutBase::PipelineLayoutBase(DeviceBase* device,
                                        const PipelineLayoutDescriptor* descriptor)
     : PipelineLayoutBase(device, descriptor, kUntrackedByDevice) {
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 PipelineLayoutBase::PipelineLayoutBase(DeviceBase* device,
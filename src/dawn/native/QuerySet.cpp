@@ -108,7 +108,7 @@ QuerySetBase::QuerySetBase(DeviceBase* device, const QuerySetDescriptor* descrip
     }
 
     mQueryAvailability.resize(descriptor->count);
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 QuerySetBase::QuerySetBase(DeviceBase* device,
@@ -28,6 +28,7 @@
 #include "dawn/native/Commands.h"
 #include "dawn/native/CopyTextureForBrowserHelper.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/DynamicUploader.h"
 #include "dawn/native/ExternalTexture.h"
 #include "dawn/native/ObjectType_autogen.h"
@@ -449,6 +450,7 @@ MaybeError QueueBase::CopyExternalTextureForBrowserInternal(
 MaybeError QueueBase::ValidateSubmit(uint32_t commandCount,
                                      CommandBufferBase* const* commands) const {
     TRACE_EVENT0(GetDevice()->GetPlatform(), Validation, "Queue::ValidateSubmit");
+    ScopedCounterTimer timer(GetDevice()->GetCounters(), TimeCounter::SubmitValidation);
     DAWN_TRY(GetDevice()->ValidateObject(this));
 
     for (uint32_t i = 0; i < commandCount; ++i) {
@@ -557,6 +559,7 @@ MaybeError QueueBase::SubmitInternal(uint32_t commandCount, CommandBufferBase* c
 
     TRACE_EVENT0(device->GetPlatform(), General, "Queue::Submit");
     if (device->IsValidationEnabled()) {
+        device->ResolveDeferredCommandBufferValidations();
         DAWN_TRY(ValidateSubmit(commandCount, commands));
     }
     ASSERT(!IsError());
@@ -41,7 +41,7 @@ RenderBundleBase::RenderBundleBase(RenderBundleEncoder* encoder,
       mDrawCount(encoder->GetDrawCount()),
       mResourceUsage(std::move(resourceUsage)),
       mEncoderLabel(encoder->GetLabel()) {
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 void RenderBundleBase::DestroyImpl() {
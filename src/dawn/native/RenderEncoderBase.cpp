@@ -316,6 +316,12 @@ void RenderEncoderBase::APISetPipeline(RenderPipelineBase* pipeline) {
                                 this);
             }
 
+            // Redundant state changes are validated but not recorded, which keeps the command
+            // buffers smaller and avoids replaying them in the backends.
+            if (mCommandBufferState.IsSamePipeline(pipeline)) {
+                return {};
+            }
+
             mCommandBufferState.SetRenderPipeline(pipeline);
 
             SetRenderPipelineCmd* cmd =
@@ -435,10 +441,14 @@ void RenderEncoderBase::APISetVertexBuffer(uint32_t slot,
             }
 
             VertexBufferSlot vbSlot = VertexBufferSlot(static_cast<uint8_t>(slot));
+            if (mCommandBufferState.IsSameVertexBuffer(vbSlot, buffer, offset, size)) {
+                return {};
+            }
+
             if (buffer == nullptr) {
                 mCommandBufferState.UnsetVertexBuffer(vbSlot);
             } else {
-                mCommandBufferState.SetVertexBuffer(vbSlot, size);
+                mCommandBufferState.SetVertexBuffer(vbSlot, buffer, offset, size);
 
                 SetVertexBufferCmd* cmd =
                     allocator->Allocate<SetVertexBufferCmd>(Command::SetVertexBuffer);
@@ -468,6 +478,11 @@ void RenderEncoderBase::APISetBindGroup(uint32_t groupIndexIn,
                     ValidateSetBindGroup(groupIndex, group, dynamicOffsetCount, dynamicOffsets));
             }
 
+            if (mCommandBufferState.IsSameBindGroup(groupIndex, group, dynamicOffsetCount,
+                                                    dynamicOffsets)) {
+                return {};
+            }
+
             if (group == nullptr) {
                 mCommandBufferState.UnsetBindGroup(groupIndex);
             } else {
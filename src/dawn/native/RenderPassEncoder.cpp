@@ -78,7 +78,7 @@ RenderPassEncoder::RenderPassEncoder(DeviceBase* device,
     if (maxDrawCountInfo) {
         mMaxDrawCount = maxDrawCountInfo->maxDrawCount;
     }
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 // static
@@ -330,22 +330,16 @@ void RenderPassEncoder::APIExecuteBundles(uint32_t count, RenderBundleBase* cons
             Ref<RenderBundleBase>* bundles = allocator->AllocateData<Ref<RenderBundleBase>>(count);
             for (uint32_t i = 0; i < count; ++i) {
                 bundles[i] = renderBundles[i];
+                mDrawCount += bundles[i]->GetDrawCount();
 
-                const RenderPassResourceUsage& usages = bundles[i]->GetResourceUsage();
-                for (uint32_t j = 0; j < usages.buffers.size(); ++j) {
-                    mUsageTracker.BufferUsedAs(usages.buffers[j], usages.bufferUsages[j]);
-                }
-
-                for (uint32_t j = 0; j < usages.textures.size(); ++j) {
-                    mUsageTracker.AddRenderBundleTextureUsage(usages.textures[j],
-                                                              usages.textureUsages[j]);
+                if (!mExecutedBundles.insert(renderBundles[i]).second) {
+                    continue;
                 }
 
+                mUsageTracker.AddRenderBundleUsage(bundles[i]->GetResourceUsage());
                 if (IsValidationEnabled()) {
                     mIndirectDrawMetadata.AddBundle(renderBundles[i]);
                 }
-
-                mDrawCount += bundles[i]->GetDrawCount();
             }
 
             return {};
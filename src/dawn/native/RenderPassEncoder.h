@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_RENDERPASSENCODER_H_
 #define SRC_DAWN_NATIVE_RENDERPASSENCODER_H_
 
+#include <unordered_set>
 #include <vector>
 
 #include "dawn/native/Error.h"
@@ -107,6 +108,10 @@ class RenderPassEncoder final : public RenderEncoderBase {
     // This is the hardcoded value in the WebGPU spec.
     uint64_t mMaxDrawCount = 50000000;
 
+    // The bundles already executed in the pass. Executing them again doesn't add any new usage
+    // or indirect draw validation, so it only needs to be recorded.
+    std::unordered_set<RenderBundleBase*> mExecutedBundles;
+
     std::function<void()> mEndCallback;
 };
 
@@ -811,7 +811,7 @@ RenderPipelineBase::RenderPipelineBase(DeviceBase* device,
     }
 
     SetContentHash(ComputeContentHash());
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 
     // Initialize the cache key to include the cache type and device information.
     StreamIn(&mCacheKey, CacheKey::Type::RenderPipeline, device->GetCacheKey());
@@ -86,7 +86,7 @@ SamplerBase::SamplerBase(DeviceBase* device,
 
 SamplerBase::SamplerBase(DeviceBase* device, const SamplerDescriptor* descriptor)
     : SamplerBase(device, descriptor, kUntrackedByDevice) {
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 SamplerBase::SamplerBase(DeviceBase* device, ObjectBase::ErrorTag tag, const char* label)
@@ -15,6 +15,8 @@
 #include "dawn/native/ShaderModule.h"
 
 #include <algorithm>
+#include <chrono>
+#include <optional>
 #include <sstream>
 
 #include "absl/strings/str_format.h"
@@ -29,6 +31,8 @@
 #include "dawn/native/PipelineLayout.h"
 #include "dawn/native/RenderPipeline.h"
 #include "dawn/native/TintUtils.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
 
 #include "tint/tint.h"
 
@@ -737,11 +741,6 @@ ResultOrError<std::unique_ptr<EntryPointMetadata>> ReflectEntryPointUsingTint(
                 info.storageTexture.viewDimension =
                     TintTextureDimensionToTextureViewDimension(resource.dim);
 
-                DAWN_INVALID_IF(info.storageTexture.format == wgpu::TextureFormat::BGRA8Unorm &&
-                                    !device->HasFeature(Feature::BGRA8UnormStorage),
-                                "BGRA8Unorm storage textures are not supported if optional feature "
-                                "bgra8unorm-storage is not supported.");
-
                 break;
             case BindingInfoType::ExternalTexture:
                 break;
@@ -830,21 +829,68 @@ MaybeError ReflectShaderUsingTint(const DeviceBase* device,
     }
     DAWN_TRY(ValidateWGSLProgramExtension(device, enabledWGSLExtensions, compilationMessages));
 
-    std::vector<tint::inspector::EntryPoint> entryPoints = inspector.GetEntryPoints();
+    // Storage texture formats that require a feature are validated for the whole module since
+    // the entry points are only reflected when they are used.
+    for (tint::inspector::ResourceBinding::TexelFormat format :
+         inspector.GetStorageTextureTexelFormats()) {
+        DAWN_INVALID_IF(TintImageFormatToTextureFormat(format) == wgpu::TextureFormat::BGRA8Unorm &&
+                            !device->HasFeature(Feature::BGRA8UnormStorage),
+                        "BGRA8Unorm storage textures are not supported if optional feature "
+                        "bgra8unorm-storage is not supported.");
+    }
+
+    std::vector<std::string> entryPointNames = inspector.GetEntryPointNames();
     DAWN_INVALID_IF(inspector.has_error(), "Tint Reflection failure: Inspector: %s\n",
                     inspector.error());
 
-    for (const tint::inspector::EntryPoint& entryPoint : entryPoints) {
-        std::unique_ptr<EntryPointMetadata> metadata;
-        DAWN_TRY_ASSIGN_CONTEXT(metadata,
-                                ReflectEntryPointUsingTint(device, &inspector, entryPoint),
-                                "processing entry point \"%s\".", entryPoint.name);
-
-        ASSERT(entryPointMetadataTable->count(entryPoint.name) == 0);
-        (*entryPointMetadataTable)[entryPoint.name] = std::move(metadata);
+    for (std::string& name : entryPointNames) {
+        ASSERT(entryPointMetadataTable->count(name) == 0);
+        (*entryPointMetadataTable)[std::move(name)] = std::make_unique<LazyEntryPointMetadata>();
     }
     return {};
 }
+
+// Reflects a single entry point after the creation of the shader module. Errors are stored in the
+// returned metadata and reported when the entry point is used in a pipeline.
+std::unique_ptr<EntryPointMetadata> LazilyReflectEntryPointUsingTint(
+    const DeviceBase* device,
+    const tint::Program* program,
+    const std::string& entryPointName) {
+    tint::inspector::Inspector inspector(program);
+    tint::inspector::EntryPoint entryPoint = inspector.GetEntryPoint(entryPointName);
+
+    std::string reflectionError;
+    if (inspector.has_error()) {
+        reflectionError = "Tint Reflection failure: Inspector: " + inspector.error();
+    } else {
+        ResultOrError<std::unique_ptr<EntryPointMetadata>> result =
+            ReflectEntryPointUsingTint(device, &inspector, entryPoint);
+        if (!result.IsError()) {
+            return result.AcquireSuccess();
+        }
+        reflectionError = result.AcquireError()->GetFormattedMessage();
+    }
+
+    std::unique_ptr<EntryPointMetadata> metadata = std::make_unique<EntryPointMetadata>();
+    metadata->reflectionError = std::move(reflectionError);
+    return metadata;
+}
+
+// Records an instant trace event for each transform recorded by the profiler, with the time it
+// took and the changes it made to the size of the program.
+void TraceTransformProfile(dawn::platform::Platform* platform,
+                           const tint::ast::transform::Profiler& profiler) {
+    for (const auto& entry : profiler.Entries()) {
+        uint64_t timeUs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(entry.time).count());
+        std::string program = absl::StrFormat(
+            "astNodes: %u -> %u, nodeBytes: %u -> %u%s", entry.ast_nodes_before,
+            entry.ast_nodes_after, entry.node_bytes_before, entry.node_bytes_after,
+            entry.skipped ? ", skipped" : "");
+        TRACE_EVENT_COPY_INSTANT2(platform, General, entry.name.c_str(), "timeUs", timeUs,
+                                  "program", program);
+    }
+}
 }  // anonymous namespace
 
 ResultOrError<Extent3D> ValidateComputeStageWorkgroupSize(
@@ -1019,9 +1065,20 @@ ResultOrError<tint::Program> RunTransforms(tint::ast::transform::Manager* transf
                                            const tint::Program* program,
                                            const tint::ast::transform::DataMap& inputs,
                                            tint::ast::transform::DataMap* outputs,
-                                           OwnedCompilationMessages* outMessages) {
+                                           OwnedCompilationMessages* outMessages,
+                                           dawn::platform::Platform* platform) {
+    // Only profile the transforms when the platform records the trace events.
+    std::optional<tint::ast::transform::Profiler> profiler;
+    if (*dawn::platform::tracing::GetTraceCategoryEnabledFlag(
+            platform, dawn::platform::TraceCategory::General)) {
+        profiler.emplace();
+    }
+
     tint::ast::transform::DataMap transform_outputs;
     tint::Program result = transformManager->Run(program, inputs, transform_outputs);
+    if (profiler.has_value()) {
+        TraceTransformProfile(platform, *profiler);
+    }
     if (outMessages != nullptr) {
         DAWN_TRY(outMessages->AddMessages(result.Diagnostics()));
     }
@@ -1115,7 +1172,7 @@ ShaderModuleBase::ShaderModuleBase(DeviceBase* device,
 
 ShaderModuleBase::ShaderModuleBase(DeviceBase* device, const ShaderModuleDescriptor* descriptor)
     : ShaderModuleBase(device, descriptor, kUntrackedByDevice) {
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 ShaderModuleBase::ShaderModuleBase(DeviceBase* device, ObjectBase::ErrorTag tag, const char* label)
@@ -1142,7 +1199,12 @@ bool ShaderModuleBase::HasEntryPoint(const std::string& entryPoint) const {
 
 const EntryPointMetadata& ShaderModuleBase::GetEntryPoint(const std::string& entryPoint) const {
     ASSERT(HasEntryPoint(entryPoint));
-    return *mEntryPoints.at(entryPoint);
+    LazyEntryPointMetadata* lazyMetadata = mEntryPoints.at(entryPoint).get();
+    std::call_once(lazyMetadata->reflected, [&] {
+        lazyMetadata->metadata =
+            LazilyReflectEntryPointUsingTint(GetDevice(), mTintProgram.get(), entryPoint);
+    });
+    return *lazyMetadata->metadata;
 }
 
 size_t ShaderModuleBase::ComputeContentHash() {
@@ -18,6 +18,7 @@
 #include <bitset>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -54,6 +55,10 @@ class VertexPulling;
 
 }  // namespace tint
 
+namespace dawn::platform {
+class Platform;
+}  // namespace dawn::platform
+
 namespace dawn::native {
 
 using WGSLExtensionSet = std::unordered_set<std::string>;
@@ -83,9 +88,16 @@ enum class InterpolationSampling {
 // Use map to make sure constant keys are sorted for creating shader cache keys
 using PipelineConstantEntries = std::map<std::string, double>;
 
+// The EntryPointMetadata of an entry point is only reflected the first time the entry point is
+// used, since shader modules may contain many entry points that are never used in a pipeline.
+struct LazyEntryPointMetadata {
+    std::once_flag reflected;
+    std::unique_ptr<EntryPointMetadata> metadata;
+};
+
 // A map from name to EntryPointMetadata.
 using EntryPointMetadataTable =
-    std::unordered_map<std::string, std::unique_ptr<EntryPointMetadata>>;
+    std::unordered_map<std::string, std::unique_ptr<LazyEntryPointMetadata>>;
 
 // Source for a tint program
 class TintSource;
@@ -123,7 +135,8 @@ ResultOrError<tint::Program> RunTransforms(tint::ast::transform::Manager* transf
                                            const tint::Program* program,
                                            const tint::ast::transform::DataMap& inputs,
                                            tint::ast::transform::DataMap* outputs,
-                                           OwnedCompilationMessages* messages);
+                                           OwnedCompilationMessages* messages,
+                                           dawn::platform::Platform* platform);
 
 // Mirrors wgpu::SamplerBindingLayout but instead stores a single boolean
 // for isComparison instead of a wgpu::SamplerBindingType enum.
@@ -178,6 +191,10 @@ struct EntryPointMetadata {
     // tries to use the entry point.
     std::vector<std::string> infringedLimitErrors;
 
+    // Reflection happens lazily, after the creation of the shader module, so its errors are also
+    // stored here to be returned when the entry point is used in a pipeline.
+    std::string reflectionError;
+
     // bindings[G][B] is the reflection data for the binding defined with
     // @group(G) @binding(B) in WGSL / SPIRV.
     BindingInfoArray bindings;
@@ -268,8 +285,8 @@ class ShaderModuleBase : public ApiObjectBase,
     // Return true iff the program has an entrypoint called `entryPoint`.
     bool HasEntryPoint(const std::string& entryPoint) const;
 
-    // Return the metadata for the given `entryPoint`. HasEntryPoint with the same argument
-    // must be true.
+    // Return the metadata for the given `entryPoint`, reflecting it the first time it is called.
+    // HasEntryPoint with the same argument must be true. This is thread-safe.
     const EntryPointMetadata& GetEntryPoint(const std::string& entryPoint) const;
 
     // Functions necessary for the unordered_set<ShaderModuleBase*>-based cache.
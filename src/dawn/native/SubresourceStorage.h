@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_SUBRESOURCESTORAGE_H_
 #define SRC_DAWN_NATIVE_SUBRESOURCESTORAGE_H_
 
+#include <algorithm>
 #include <array>
 #include <limits>
 #include <memory>
@@ -29,6 +30,13 @@
 
 namespace dawn::native {
 
+// Whether Update() and Merge() should try to recompress the subresources they touched. Callers
+// that know the data will be decompressed again soon can disable it to skip the comparisons.
+enum class SubresourceRecompression {
+    Enabled,
+    Disabled,
+};
+
 // SubresourceStorage<T> acts like a simple map from subresource (aspect, layer, level) to a
 // value of type T except that it tries to compress similar subresources so that algorithms
 // can act on a whole range of subresources at once if they have the same state.
@@ -54,27 +62,28 @@ namespace dawn::native {
 //      // `data`.
 //   });
 //
-// SubresourceStorage internally tracks compression state per aspect and then per layer of each
-// aspect. This means that a 2-aspect texture can have the following compression state:
+// SubresourceStorage internally tracks compression state per aspect and then per run of layers
+// of each aspect. This means that a 2-aspect texture can have the following compression state:
 //
 //  - Aspect 0 is fully compressed.
 //  - Aspect 1 is partially compressed:
 //    - Aspect 1 layer 3 is decompressed.
-//    - Aspect 1 layer 0-2 and 4-42 are compressed.
+//    - Aspect 1 layers 0-2 are compressed with one value and layers 4-42 with another.
 //
 // A useful model to reason about SubresourceStorage is to represent is as a tree:
 //
 //  - SubresourceStorage is the root.
 //    |-> Nodes 1 deep represent each aspect. If an aspect is compressed, its node doesn't have
 //       any children because the data is constant across all of the subtree.
-//      |-> Nodes 2 deep represent layers (for uncompressed aspects). If a layer is compressed,
-//         its node doesn't have any children because the data is constant across all of the
-//         subtree.
+//      |-> Nodes 2 deep represent runs of consecutive layers (for uncompressed aspects). If a
+//         run is compressed, its node doesn't have any children because the data is constant
+//         across all of the subtree. Otherwise the run is a single layer.
 //        |-> Nodes 3 deep represent individial mip levels (for uncompressed layers).
 //
 // The concept of recompression is the removal of all child nodes of a non-leaf node when the
-// data is constant across them. Decompression is the addition of child nodes to a leaf node
-// and copying of its data to all its children.
+// data is constant across them, and the coalescing of adjacent compressed runs with the same
+// data. Decompression is the addition of child nodes to a leaf node and copying of its data to
+// all its children.
 //
 // The choice of having secondary compression for array layers is to optimize for the cases
 // where transfer operations are used to update specific layers of texture with render or
@@ -82,11 +91,16 @@ namespace dawn::native {
 // would be operations that touch all Nth mips of a 2D array texture without touching the
 // others.
 //
+// Storing the layers as runs keeps the cost of the common operations proportional to the number
+// of distinct states rather than to the number of layers, which matters for texture arrays with
+// thousands of layers where only a cluster of layers is updated at a time.
+//
 // There are several hot code paths that create new SubresourceStorage like the tracking of
 // resource usage per-pass. We don't want to allocate a container for the decompressed data
 // unless we have to because it would dramatically lower performance. Instead
-// SubresourceStorage contains an inline array that contains the per-aspect compressed data
-// and only allocates a per-subresource on aspect decompression.
+// SubresourceStorage contains an inline array that contains the per-aspect compressed data,
+// a list of runs on aspect decompression, and only allocates a per-subresource array on the
+// first layer decompression.
 //
 // T must be a copyable type that supports equality comparison with ==.
 //
@@ -102,9 +116,6 @@ namespace dawn::native {
        "out/coverage/dawn_unittests --gtest_filter=SubresourceStorage\*" -f \
        third_party/dawn/src/dawn/native
 */
-//
-// TODO(crbug.com/dawn/836): Make the recompression optional, the calling code should know
-// if recompression can happen or not in Update() and Merge()
 template <typename T>
 class SubresourceStorage {
   public:
@@ -157,7 +168,9 @@ class SubresourceStorage {
     // your code is likely to break when compression happens. Range should only be used for
     // side effects like using it to compute a Vulkan pipeline barrier.
     template <typename F>
-    void Update(const SubresourceRange& range, F&& updateFunc);
+    void Update(const SubresourceRange& range,
+                F&& updateFunc,
+                SubresourceRecompression recompression = SubresourceRecompression::Enabled);
 
     // Given a mergeFunc that's a function or a function-like object that can be called with
     // arguments of type (const SubresourceRange& range, T* data, const U& otherData) and
@@ -174,7 +187,9 @@ class SubresourceStorage {
     // your code is likely to break when compression happens. Range should only be used for
     // side effects like using it to compute a Vulkan pipeline barrier.
     template <typename U, typename F>
-    void Merge(const SubresourceStorage<U>& other, F&& mergeFunc);
+    void Merge(const SubresourceStorage<U>& other,
+               F&& mergeFunc,
+               SubresourceRecompression recompression = SubresourceRecompression::Enabled);
 
     // Other operations to consider:
     //
@@ -186,48 +201,69 @@ class SubresourceStorage {
     uint32_t GetMipLevelCountForTesting() const;
     bool IsAspectCompressedForTesting(Aspect aspect) const;
     bool IsLayerCompressedForTesting(Aspect aspect, uint32_t layer) const;
+    size_t GetLayerRunCountForTesting(Aspect aspect) const;
 
   private:
     template <typename U>
     friend class SubresourceStorage;
 
+    struct LayerRun {
+        uint32_t firstLayer;
+        bool compressed;
+        // The data of all the subresources of the run, only valid if the run is compressed.
+        T data;
+    };
+
     void DecompressAspect(uint32_t aspectIndex);
-    void RecompressAspect(uint32_t aspectIndex);
 
-    void DecompressLayer(uint32_t aspectIndex, uint32_t layer);
-    void RecompressLayer(uint32_t aspectIndex, uint32_t layer);
+    // Returns the index of the run that contains the layer.
+    size_t FindLayerRun(uint32_t aspectIndex, uint32_t layer) const;
+    uint32_t GetLayerRunEnd(uint32_t aspectIndex, size_t runIndex) const;
 
-    SubresourceRange GetFullLayerRange(Aspect aspect, uint32_t layer) const;
+    // Splits the run containing the layer such that a run starts at the layer, and returns the
+    // index of that run. Returns the number of runs if the layer is the array layer count.
+    size_t SplitLayerRun(uint32_t aspectIndex, uint32_t layer);
 
-    // LayerCompressed should never be called when the aspect is compressed otherwise it would
-    // need to check that mLayerCompressed is not null before indexing it.
-    bool& LayerCompressed(uint32_t aspectIndex, uint32_t layerIndex);
-    bool LayerCompressed(uint32_t aspectIndex, uint32_t layerIndex) const;
+    // Turns a compressed run into a decompressed run per layer.
+    void DecompressLayerRun(uint32_t aspectIndex, size_t runIndex);
+    void RecompressLayer(uint32_t aspectIndex, size_t runIndex);
 
-    // Return references to the data for a compressed plane / layer or subresource.
-    // Each variant should be called exactly under the correct compression level.
+    // Merges the compressed runs with the same data among the runs that overlap the layers, and
+    // their neighbors. Recompresses the aspect if a single compressed run is left.
+    void RecompressLayerRuns(uint32_t aspectIndex, uint32_t layerBegin, uint32_t layerEnd);
+
+    // Calls the updateFunc on the levels of the layers [layerBegin, layerEnd), once per run if
+    // the levels are all the levels.
+    template <typename F>
+    void UpdateLayers(Aspect aspect,
+                      uint32_t layerBegin,
+                      uint32_t layerEnd,
+                      uint32_t baseMipLevel,
+                      uint32_t levelCount,
+                      SubresourceRecompression recompression,
+                      F&& updateFunc);
+
+    // Return references to the data for a compressed aspect or a subresource of a decompressed
+    // layer. Each variant should be called exactly under the correct compression level.
     T& DataInline(uint32_t aspectIndex);
-    T& Data(uint32_t aspectIndex, uint32_t layer, uint32_t level = 0);
+    T& LevelData(uint32_t aspectIndex, uint32_t layer, uint32_t level);
     const T& DataInline(uint32_t aspectIndex) const;
-    const T& Data(uint32_t aspectIndex, uint32_t layer, uint32_t level = 0) const;
+    const T& LevelData(uint32_t aspectIndex, uint32_t layer, uint32_t level) const;
 
     Aspect mAspects;
     uint8_t mMipLevelCount;
     uint16_t mArrayLayerCount;
 
-    // Invariant: if an aspect is marked compressed, then all it's layers are marked as
-    // compressed.
+    // Invariant: if an aspect is marked compressed, then its runs are not used. Otherwise its
+    // runs cover all its layers, sorted by their first layer.
     static constexpr size_t kMaxAspects = 2;
     std::array<bool, kMaxAspects> mAspectCompressed;
     std::array<T, kMaxAspects> mInlineAspectData;
+    std::array<std::vector<LayerRun>, kMaxAspects> mLayerRuns;
 
-    // Indexed as mLayerCompressed[aspectIndex * mArrayLayerCount + layer].
-    std::unique_ptr<bool[]> mLayerCompressed;
-
-    // Indexed as mData[(aspectIndex * mArrayLayerCount + layer) * mMipLevelCount + level].
-    // The data for a compressed aspect is stored in the slot for (aspect, 0, 0). Similarly
-    // the data for a compressed layer of aspect if in the slot for (aspect, layer, 0).
-    std::unique_ptr<T[]> mData;
+    // Indexed as mLevelData[(aspectIndex * mArrayLayerCount + layer) * mMipLevelCount + level].
+    // Only the data of the decompressed layers is valid.
+    std::unique_ptr<T[]> mLevelData;
 };
 
 template <typename T>
@@ -250,7 +286,9 @@ SubresourceStorage<T>::SubresourceStorage(Aspect aspects,
 
 template <typename T>
 template <typename F>
-void SubresourceStorage<T>::Update(const SubresourceRange& range, F&& updateFunc) {
+void SubresourceStorage<T>::Update(const SubresourceRange& range,
+                                   F&& updateFunc,
+                                   SubresourceRecompression recompression) {
     ASSERT(range.baseArrayLayer < mArrayLayerCount &&
            range.baseArrayLayer + range.layerCount <= mArrayLayerCount);
     ASSERT(range.baseMipLevel < mMipLevelCount &&
@@ -264,7 +302,7 @@ void SubresourceStorage<T>::Update(const SubresourceRange& range, F&& updateFunc
         uint32_t aspectIndex = GetAspectIndex(aspect);
 
         // Call the updateFunc once for the whole aspect if possible or decompress and fallback
-        // to per-layer handling.
+        // to per-run handling.
         if (mAspectCompressed[aspectIndex]) {
             if (fullAspects) {
                 SubresourceRange updateRange =
@@ -276,44 +314,68 @@ void SubresourceStorage<T>::Update(const SubresourceRange& range, F&& updateFunc
         }
 
         uint32_t layerEnd = range.baseArrayLayer + range.layerCount;
-        for (uint32_t layer = range.baseArrayLayer; layer < layerEnd; layer++) {
-            // Call the updateFunc once for the whole layer if possible or decompress and
-            // fallback to per-level handling.
-            if (LayerCompressed(aspectIndex, layer)) {
-                if (fullLayers) {
-                    SubresourceRange updateRange = GetFullLayerRange(aspect, layer);
-                    updateFunc(updateRange, &Data(aspectIndex, layer));
-                    continue;
-                }
-                DecompressLayer(aspectIndex, layer);
-            }
+        UpdateLayers(aspect, range.baseArrayLayer, layerEnd, range.baseMipLevel, range.levelCount,
+                     recompression, updateFunc);
 
-            // Worst case: call updateFunc per level.
-            uint32_t levelEnd = range.baseMipLevel + range.levelCount;
-            for (uint32_t level = range.baseMipLevel; level < levelEnd; level++) {
-                SubresourceRange updateRange = SubresourceRange::MakeSingle(aspect, layer, level);
-                updateFunc(updateRange, &Data(aspectIndex, layer, level));
-            }
+        if (recompression == SubresourceRecompression::Enabled) {
+            RecompressLayerRuns(aspectIndex, range.baseArrayLayer, layerEnd);
+        }
+    }
+}
 
-            // If the range has fullLayers then it is likely we can recompress after the calls
-            // to updateFunc (this branch is skipped if updateFunc was called for the whole
-            // layer).
+template <typename T>
+template <typename F>
+void SubresourceStorage<T>::UpdateLayers(Aspect aspect,
+                                         uint32_t layerBegin,
+                                         uint32_t layerEnd,
+                                         uint32_t baseMipLevel,
+                                         uint32_t levelCount,
+                                         SubresourceRecompression recompression,
+                                         F&& updateFunc) {
+    uint32_t aspectIndex = GetAspectIndex(aspect);
+    ASSERT(!mAspectCompressed[aspectIndex]);
+    std::vector<LayerRun>& runs = mLayerRuns[aspectIndex];
+    bool fullLayers = baseMipLevel == 0 && levelCount == mMipLevelCount;
+
+    // Split the runs at the bounds of the layers so that they are covered by whole runs.
+    SplitLayerRun(aspectIndex, layerEnd);
+    for (size_t i = SplitLayerRun(aspectIndex, layerBegin);
+         i < runs.size() && runs[i].firstLayer < layerEnd; i++) {
+        // Call the updateFunc once for the whole run if possible or decompress and fallback to
+        // per-level handling.
+        if (runs[i].compressed) {
             if (fullLayers) {
-                RecompressLayer(aspectIndex, layer);
+                uint32_t firstLayer = runs[i].firstLayer;
+                SubresourceRange updateRange(
+                    aspect, {firstLayer, GetLayerRunEnd(aspectIndex, i) - firstLayer},
+                    {0, mMipLevelCount});
+                updateFunc(updateRange, &runs[i].data);
+                continue;
             }
+            DecompressLayerRun(aspectIndex, i);
+        }
+
+        // Worst case: call updateFunc per level.
+        uint32_t layer = runs[i].firstLayer;
+        uint32_t levelEnd = baseMipLevel + levelCount;
+        for (uint32_t level = baseMipLevel; level < levelEnd; level++) {
+            SubresourceRange updateRange = SubresourceRange::MakeSingle(aspect, layer, level);
+            updateFunc(updateRange, &LevelData(aspectIndex, layer, level));
         }
 
-        // If the range has fullAspects then it is likely we can recompress after the calls to
-        // updateFunc (this branch is skipped if updateFunc was called for the whole aspect).
-        if (fullAspects) {
-            RecompressAspect(aspectIndex);
+        // If the range has fullLayers then it is likely we can recompress after the calls
+        // to updateFunc (this branch is skipped if updateFunc was called for the whole run).
+        if (fullLayers && recompression == SubresourceRecompression::Enabled) {
+            RecompressLayer(aspectIndex, i);
         }
     }
 }
 
 template <typename T>
 template <typename U, typename F>
-void SubresourceStorage<T>::Merge(const SubresourceStorage<U>& other, F&& mergeFunc) {
+void SubresourceStorage<T>::Merge(const SubresourceStorage<U>& other,
+                                  F&& mergeFunc,
+                                  SubresourceRecompression recompression) {
     ASSERT(mAspects == other.mAspects);
     ASSERT(mArrayLayerCount == other.mArrayLayerCount);
     ASSERT(mMipLevelCount == other.mMipLevelCount);
@@ -326,44 +388,59 @@ void SubresourceStorage<T>::Merge(const SubresourceStorage<U>& other, F&& mergeF
         // the aspect. For code simplicity this can be done with a call to Update().
         if (other.mAspectCompressed[aspectIndex]) {
             const U& otherData = other.DataInline(aspectIndex);
-            Update(SubresourceRange::MakeFull(aspect, mArrayLayerCount, mMipLevelCount),
-                   [&](const SubresourceRange& subrange, T* data) {
-                       mergeFunc(subrange, data, otherData);
-                   });
+            Update(
+                SubresourceRange::MakeFull(aspect, mArrayLayerCount, mMipLevelCount),
+                [&](const SubresourceRange& subrange, T* data) {
+                    mergeFunc(subrange, data, otherData);
+                },
+                recompression);
             continue;
         }
 
-        // Other doesn't have the aspect compressed so we must do at least per-layer merging.
+        // Other doesn't have the aspect compressed so we must do at least per-run merging.
         if (mAspectCompressed[aspectIndex]) {
             DecompressAspect(aspectIndex);
         }
 
-        for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
-            // Similarly to above, use a fast path if other's layer is compressed.
-            if (other.LayerCompressed(aspectIndex, layer)) {
-                const U& otherData = other.Data(aspectIndex, layer);
-                Update(GetFullLayerRange(aspect, layer),
-                       [&](const SubresourceRange& subrange, T* data) {
-                           mergeFunc(subrange, data, otherData);
-                       });
+        // Walk other's runs, which splits this's runs only at the bounds of other's runs.
+        const auto& otherRuns = other.mLayerRuns[aspectIndex];
+        for (size_t otherRun = 0; otherRun < otherRuns.size(); otherRun++) {
+            uint32_t layerBegin = otherRuns[otherRun].firstLayer;
+            uint32_t layerEnd = other.GetLayerRunEnd(aspectIndex, otherRun);
+
+            // Similarly to above, use a fast path if other's run is compressed.
+            if (otherRuns[otherRun].compressed) {
+                const U& otherData = otherRuns[otherRun].data;
+                UpdateLayers(aspect, layerBegin, layerEnd, 0, mMipLevelCount, recompression,
+                             [&](const SubresourceRange& subrange, T* data) {
+                                 mergeFunc(subrange, data, otherData);
+                             });
                 continue;
             }
 
             // Sad case, other is decompressed for this layer, do per-level merging.
-            if (LayerCompressed(aspectIndex, layer)) {
-                DecompressLayer(aspectIndex, layer);
+            ASSERT(layerEnd == layerBegin + 1);
+            SplitLayerRun(aspectIndex, layerEnd);
+            size_t runIndex = SplitLayerRun(aspectIndex, layerBegin);
+            if (mLayerRuns[aspectIndex][runIndex].compressed) {
+                DecompressLayerRun(aspectIndex, runIndex);
             }
 
             for (uint32_t level = 0; level < mMipLevelCount; level++) {
-                SubresourceRange updateRange = SubresourceRange::MakeSingle(aspect, layer, level);
-                mergeFunc(updateRange, &Data(aspectIndex, layer, level),
-                          other.Data(aspectIndex, layer, level));
+                SubresourceRange updateRange =
+                    SubresourceRange::MakeSingle(aspect, layerBegin, level);
+                mergeFunc(updateRange, &LevelData(aspectIndex, layerBegin, level),
+                          other.LevelData(aspectIndex, layerBegin, level));
             }
 
-            RecompressLayer(aspectIndex, layer);
+            if (recompression == SubresourceRecompression::Enabled) {
+                RecompressLayer(aspectIndex, runIndex);
+            }
         }
 
-        RecompressAspect(aspectIndex);
+        if (recompression == SubresourceRecompression::Enabled) {
+            RecompressLayerRuns(aspectIndex, 0, mArrayLayerCount);
+        }
     }
 }
 
@@ -389,25 +466,29 @@ R SubresourceStorage<T>::Iterate(F&& iterateFunc) const {
             continue;
         }
 
-        for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
-            // Fast path, call iterateFunc on the whole array layer at once.
-            if (LayerCompressed(aspectIndex, layer)) {
-                SubresourceRange range = GetFullLayerRange(aspect, layer);
+        const std::vector<LayerRun>& runs = mLayerRuns[aspectIndex];
+        for (size_t i = 0; i < runs.size(); i++) {
+            // Fast path, call iterateFunc on the whole run of array layers at once.
+            uint32_t firstLayer = runs[i].firstLayer;
+            if (runs[i].compressed) {
+                SubresourceRange range(aspect,
+                                       {firstLayer, GetLayerRunEnd(aspectIndex, i) - firstLayer},
+                                       {0, mMipLevelCount});
                 if constexpr (mayError) {
-                    DAWN_TRY(iterateFunc(range, Data(aspectIndex, layer)));
+                    DAWN_TRY(iterateFunc(range, runs[i].data));
                 } else {
-                    iterateFunc(range, Data(aspectIndex, layer));
+                    iterateFunc(range, runs[i].data);
                 }
                 continue;
             }
 
             // Slow path, call iterateFunc for each mip level.
             for (uint32_t level = 0; level < mMipLevelCount; level++) {
-                SubresourceRange range = SubresourceRange::MakeSingle(aspect, layer, level);
+                SubresourceRange range = SubresourceRange::MakeSingle(aspect, firstLayer, level);
                 if constexpr (mayError) {
-                    DAWN_TRY(iterateFunc(range, Data(aspectIndex, layer, level)));
+                    DAWN_TRY(iterateFunc(range, LevelData(aspectIndex, firstLayer, level)));
                 } else {
-                    iterateFunc(range, Data(aspectIndex, layer, level));
+                    iterateFunc(range, LevelData(aspectIndex, firstLayer, level));
                 }
             }
         }
@@ -429,12 +510,13 @@ const T& SubresourceStorage<T>::Get(Aspect aspect, uint32_t arrayLayer, uint32_t
         return DataInline(aspectIndex);
     }
 
-    // Fast path, the array layer is compressed.
-    if (LayerCompressed(aspectIndex, arrayLayer)) {
-        return Data(aspectIndex, arrayLayer);
+    // Fast path, the array layer is in a compressed run.
+    const LayerRun& run = mLayerRuns[aspectIndex][FindLayerRun(aspectIndex, arrayLayer)];
+    if (run.compressed) {
+        return run.data;
     }
 
-    return Data(aspectIndex, arrayLayer, mipLevel);
+    return LevelData(aspectIndex, arrayLayer, mipLevel);
 }
 
 template <typename T>
@@ -459,101 +541,140 @@ bool SubresourceStorage<T>::IsAspectCompressedForTesting(Aspect aspect) const {
 
 template <typename T>
 bool SubresourceStorage<T>::IsLayerCompressedForTesting(Aspect aspect, uint32_t layer) const {
-    return mAspectCompressed[GetAspectIndex(aspect)] ||
-           mLayerCompressed[GetAspectIndex(aspect) * mArrayLayerCount + layer];
+    uint32_t aspectIndex = GetAspectIndex(aspect);
+    return mAspectCompressed[aspectIndex] ||
+           mLayerRuns[aspectIndex][FindLayerRun(aspectIndex, layer)].compressed;
+}
+
+template <typename T>
+size_t SubresourceStorage<T>::GetLayerRunCountForTesting(Aspect aspect) const {
+    uint32_t aspectIndex = GetAspectIndex(aspect);
+    return mAspectCompressed[aspectIndex] ? 1 : mLayerRuns[aspectIndex].size();
 }
 
 template <typename T>
 void SubresourceStorage<T>::DecompressAspect(uint32_t aspectIndex) {
     ASSERT(mAspectCompressed[aspectIndex]);
-    const T& aspectData = DataInline(aspectIndex);
+    mLayerRuns[aspectIndex].assign(1, LayerRun{0, true, DataInline(aspectIndex)});
     mAspectCompressed[aspectIndex] = false;
+}
 
-    // Extra allocations are only needed when aspects are decompressed. Create them lazily.
-    if (mData == nullptr) {
-        ASSERT(mLayerCompressed == nullptr);
+template <typename T>
+size_t SubresourceStorage<T>::FindLayerRun(uint32_t aspectIndex, uint32_t layer) const {
+    ASSERT(!mAspectCompressed[aspectIndex]);
+    ASSERT(layer < mArrayLayerCount);
+    const std::vector<LayerRun>& runs = mLayerRuns[aspectIndex];
+    auto it = std::upper_bound(
+        runs.begin(), runs.end(), layer,
+        [](uint32_t layer, const LayerRun& run) { return layer < run.firstLayer; });
+    ASSERT(it != runs.begin());
+    return static_cast<size_t>(it - runs.begin()) - 1;
+}
 
-        uint32_t aspectCount = GetAspectCount(mAspects);
-        mLayerCompressed = std::make_unique<bool[]>(aspectCount * mArrayLayerCount);
-        mData = std::make_unique<T[]>(aspectCount * mArrayLayerCount * mMipLevelCount);
+template <typename T>
+uint32_t SubresourceStorage<T>::GetLayerRunEnd(uint32_t aspectIndex, size_t runIndex) const {
+    const std::vector<LayerRun>& runs = mLayerRuns[aspectIndex];
+    return runIndex + 1 < runs.size() ? runs[runIndex + 1].firstLayer : mArrayLayerCount;
+}
 
-        for (uint32_t layerIndex = 0; layerIndex < aspectCount * mArrayLayerCount; layerIndex++) {
-            mLayerCompressed[layerIndex] = true;
-        }
+template <typename T>
+size_t SubresourceStorage<T>::SplitLayerRun(uint32_t aspectIndex, uint32_t layer) {
+    std::vector<LayerRun>& runs = mLayerRuns[aspectIndex];
+    if (layer == mArrayLayerCount) {
+        return runs.size();
     }
 
-    ASSERT(LayerCompressed(aspectIndex, 0));
-    for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
-        Data(aspectIndex, layer) = aspectData;
-        ASSERT(LayerCompressed(aspectIndex, layer));
+    size_t runIndex = FindLayerRun(aspectIndex, layer);
+    if (runs[runIndex].firstLayer == layer) {
+        return runIndex;
     }
+
+    // Only compressed runs can have more than one layer.
+    ASSERT(runs[runIndex].compressed);
+    LayerRun secondHalf = {layer, true, runs[runIndex].data};
+    runs.insert(runs.begin() + runIndex + 1, std::move(secondHalf));
+    return runIndex + 1;
 }
 
 template <typename T>
-void SubresourceStorage<T>::RecompressAspect(uint32_t aspectIndex) {
-    ASSERT(!mAspectCompressed[aspectIndex]);
-    // All layers of the aspect must be compressed for the aspect to possibly recompress.
-    for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
-        if (!LayerCompressed(aspectIndex, layer)) {
-            return;
-        }
+void SubresourceStorage<T>::DecompressLayerRun(uint32_t aspectIndex, size_t runIndex) {
+    std::vector<LayerRun>& runs = mLayerRuns[aspectIndex];
+    ASSERT(runs[runIndex].compressed);
+
+    // Extra allocations are only needed when layers are decompressed. Create them lazily.
+    if (mLevelData == nullptr) {
+        uint32_t aspectCount = GetAspectCount(mAspects);
+        mLevelData = std::make_unique<T[]>(aspectCount * mArrayLayerCount * mMipLevelCount);
     }
 
-    T layer0Data = Data(aspectIndex, 0);
-    for (uint32_t layer = 1; layer < mArrayLayerCount; layer++) {
-        if (!(Data(aspectIndex, layer) == layer0Data)) {
-            return;
+    uint32_t firstLayer = runs[runIndex].firstLayer;
+    uint32_t layerEnd = GetLayerRunEnd(aspectIndex, runIndex);
+    const T runData = runs[runIndex].data;
+    for (uint32_t layer = firstLayer; layer < layerEnd; layer++) {
+        for (uint32_t level = 0; level < mMipLevelCount; level++) {
+            LevelData(aspectIndex, layer, level) = runData;
         }
     }
 
-    mAspectCompressed[aspectIndex] = true;
-    DataInline(aspectIndex) = layer0Data;
-}
-
-template <typename T>
-void SubresourceStorage<T>::DecompressLayer(uint32_t aspectIndex, uint32_t layer) {
-    ASSERT(LayerCompressed(aspectIndex, layer));
-    ASSERT(!mAspectCompressed[aspectIndex]);
-    const T& layerData = Data(aspectIndex, layer);
-    LayerCompressed(aspectIndex, layer) = false;
-
-    // We assume that (aspect, layer, 0) is stored at the same place as (aspect, layer) which
-    // allows starting the iteration at level 1.
-    for (uint32_t level = 1; level < mMipLevelCount; level++) {
-        Data(aspectIndex, layer, level) = layerData;
+    runs[runIndex].compressed = false;
+    if (layerEnd - firstLayer > 1) {
+        runs.insert(runs.begin() + runIndex + 1, layerEnd - firstLayer - 1,
+                    LayerRun{0, false, runData});
+        for (uint32_t layer = firstLayer + 1; layer < layerEnd; layer++) {
+            runs[runIndex + layer - firstLayer].firstLayer = layer;
+        }
     }
 }
 
 template <typename T>
-void SubresourceStorage<T>::RecompressLayer(uint32_t aspectIndex, uint32_t layer) {
-    ASSERT(!LayerCompressed(aspectIndex, layer));
-    ASSERT(!mAspectCompressed[aspectIndex]);
-    const T& level0Data = Data(aspectIndex, layer, 0);
+void SubresourceStorage<T>::RecompressLayer(uint32_t aspectIndex, size_t runIndex) {
+    LayerRun& run = mLayerRuns[aspectIndex][runIndex];
+    ASSERT(!run.compressed);
+    const T& level0Data = LevelData(aspectIndex, run.firstLayer, 0);
 
     for (uint32_t level = 1; level < mMipLevelCount; level++) {
-        if (!(Data(aspectIndex, layer, level) == level0Data)) {
+        if (!(LevelData(aspectIndex, run.firstLayer, level) == level0Data)) {
             return;
         }
     }
 
-    LayerCompressed(aspectIndex, layer) = true;
+    run.compressed = true;
+    run.data = level0Data;
 }
 
 template <typename T>
-SubresourceRange SubresourceStorage<T>::GetFullLayerRange(Aspect aspect, uint32_t layer) const {
-    return {aspect, {layer, 1}, {0, mMipLevelCount}};
-}
-
-template <typename T>
-bool& SubresourceStorage<T>::LayerCompressed(uint32_t aspectIndex, uint32_t layer) {
+void SubresourceStorage<T>::RecompressLayerRuns(uint32_t aspectIndex,
+                                                uint32_t layerBegin,
+                                                uint32_t layerEnd) {
     ASSERT(!mAspectCompressed[aspectIndex]);
-    return mLayerCompressed[aspectIndex * mArrayLayerCount + layer];
-}
+    ASSERT(layerBegin < layerEnd);
+    std::vector<LayerRun>& runs = mLayerRuns[aspectIndex];
+
+    // The runs on each side of the layers could be merged with the runs of the layers.
+    size_t runBegin = FindLayerRun(aspectIndex, layerBegin);
+    runBegin = runBegin > 0 ? runBegin - 1 : 0;
+    size_t runEnd = layerEnd < mArrayLayerCount ? FindLayerRun(aspectIndex, layerEnd) + 1
+                                                : runs.size();
+
+    // Compact the runs in place, merging each compressed run into the previous one if they have
+    // the same data.
+    size_t lastRun = runBegin;
+    for (size_t i = runBegin + 1; i < runEnd; i++) {
+        if (runs[lastRun].compressed && runs[i].compressed && runs[i].data == runs[lastRun].data) {
+            continue;
+        }
+        lastRun++;
+        if (lastRun != i) {
+            runs[lastRun] = std::move(runs[i]);
+        }
+    }
+    runs.erase(runs.begin() + lastRun + 1, runs.begin() + runEnd);
 
-template <typename T>
-bool SubresourceStorage<T>::LayerCompressed(uint32_t aspectIndex, uint32_t layer) const {
-    ASSERT(!mAspectCompressed[aspectIndex]);
-    return mLayerCompressed[aspectIndex * mArrayLayerCount + layer];
+    if (runs.size() == 1 && runs[0].compressed) {
+        mAspectCompressed[aspectIndex] = true;
+        DataInline(aspectIndex) = std::move(runs[0].data);
+        runs.clear();
+    }
 }
 
 template <typename T>
@@ -562,10 +683,9 @@ T& SubresourceStorage<T>::DataInline(uint32_t aspectIndex) {
     return mInlineAspectData[aspectIndex];
 }
 template <typename T>
-T& SubresourceStorage<T>::Data(uint32_t aspectIndex, uint32_t layer, uint32_t level) {
-    ASSERT(level == 0 || !LayerCompressed(aspectIndex, layer));
+T& SubresourceStorage<T>::LevelData(uint32_t aspectIndex, uint32_t layer, uint32_t level) {
     ASSERT(!mAspectCompressed[aspectIndex]);
-    return mData[(aspectIndex * mArrayLayerCount + layer) * mMipLevelCount + level];
+    return mLevelData[(aspectIndex * mArrayLayerCount + layer) * mMipLevelCount + level];
 }
 template <typename T>
 const T& SubresourceStorage<T>::DataInline(uint32_t aspectIndex) const {
@@ -573,10 +693,11 @@ const T& SubresourceStorage<T>::DataInline(uint32_t aspectIndex) const {
     return mInlineAspectData[aspectIndex];
 }
 template <typename T>
-const T& SubresourceStorage<T>::Data(uint32_t aspectIndex, uint32_t layer, uint32_t level) const {
-    ASSERT(level == 0 || !LayerCompressed(aspectIndex, layer));
+const T& SubresourceStorage<T>::LevelData(uint32_t aspectIndex,
+                                          uint32_t layer,
+                                          uint32_t level) const {
     ASSERT(!mAspectCompressed[aspectIndex]);
-    return mData[(aspectIndex * mArrayLayerCount + layer) * mMipLevelCount + level];
+    return mLevelData[(aspectIndex * mArrayLayerCount + layer) * mMipLevelCount + level];
 }
 
 }  // namespace dawn::native
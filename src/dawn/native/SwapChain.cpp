@@ -110,7 +110,7 @@ SwapChainBase::SwapChainBase(DeviceBase* device,
       mUsage(descriptor->usage),
       mPresentMode(descriptor->presentMode),
       mSurface(surface) {
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 SwapChainBase::~SwapChainBase() {
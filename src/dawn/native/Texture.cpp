@@ -623,7 +623,7 @@ TextureBase::TextureBase(DeviceBase* device,
     if (internalUsageDesc != nullptr) {
         mInternalUsage |= internalUsageDesc->internalUsage;
     }
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 
     // dawn:1569: If a texture with multiple array layers or mip levels is specified as a
     // texture attachment when this toggle is active, it needs to be given CopyDst usage
@@ -942,7 +942,7 @@ TextureViewBase::TextureViewBase(TextureBase* texture, const TextureViewDescript
       mRange({ConvertViewAspect(mFormat, descriptor->aspect),
               {descriptor->baseArrayLayer, descriptor->arrayLayerCount},
               {descriptor->baseMipLevel, descriptor->mipLevelCount}}) {
-    GetObjectTrackingList()->Track(this);
+    TrackInDevice();
 }
 
 TextureViewBase::TextureViewBase(DeviceBase* device, ObjectBase::ErrorTag tag, const char* label)
@@ -445,6 +445,24 @@ static constexpr ToggleEnumAndInfoList kToggleNameAndInfoList = {{
       "separate render pass per resolve target. "
       "This workaround is enabled by default on ARM Mali drivers.",
       "https://crbug.com/dawn/1550", ToggleStage::Device}},
+    {Toggle::DeferBlobCacheStores,
+     {"defer_blob_cache_stores",
+      "Writes the stores to the blob cache in batches on a worker thread instead of on the thread "
+      "that creates the object, for example the pipeline. Stores that are not written yet are "
+      "still visible to the loads of the blob cache.",
+      "https://crbug.com/dawn/549", ToggleStage::Instance}},
+    {Toggle::AsyncCommandBufferValidation,
+     {"async_command_buffer_validation",
+      "Validates the resource usages of command buffers on a worker thread after Finish returns. "
+      "The validation is waited on before the command buffer is submitted, before error scopes "
+      "are pushed or popped and before any other error is reported, so that its errors are "
+      "reported to the same error scopes and in the same order.",
+      "https://crbug.com/dawn/1618", ToggleStage::Device}},
+    {Toggle::DisableDeviceCounters,
+     {"disable_device_counters",
+      "Disables the updates of the device counters, so that their cost can be measured by "
+      "comparing the same workload with and without this toggle. The counters then stay at 0.",
+      "https://crbug.com/dawn/1618", ToggleStage::Device}},
     {Toggle::NoWorkaroundSampleMaskBecomesZeroForAllButLastColorTarget,
      {"no_workaround_sample_mask_becomes_zero_for_all_but_last_color_target",
       "MacOS 12.0+ Intel has a bug where the sample mask is only applied for the last color "
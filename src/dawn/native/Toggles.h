@@ -103,6 +103,9 @@ enum class Toggle {
     VulkanUseBufferRobustAccess2,
     D3D12Use64KBAlignedMSAATexture,
     ResolveMultipleAttachmentInSeparatePasses,
+    DeferBlobCacheStores,
+    AsyncCommandBufferValidation,
+    DisableDeviceCounters,
 
     // Unresolved issues.
     NoWorkaroundSampleMaskBecomesZeroForAllButLastColorTarget,
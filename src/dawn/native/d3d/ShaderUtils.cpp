@@ -177,7 +177,7 @@ MaybeError TranslateToHLSL(d3d::HlslCompilationRequest r,
         TRACE_EVENT0(tracePlatform.UnsafeGetValue(), General, "RunTransforms");
         DAWN_TRY_ASSIGN(transformedProgram,
                         RunTransforms(&transformManager, r.inputProgram, transformInputs,
-                                      &transformOutputs, nullptr));
+                                      &transformOutputs, nullptr, tracePlatform.UnsafeGetValue()));
     }
 
     if (auto* data = transformOutputs.Get<tint::ast::transform::Renamer::Data>()) {
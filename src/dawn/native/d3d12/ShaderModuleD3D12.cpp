@@ -20,6 +20,7 @@
 #include "dawn/common/Assert.h"
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/common/Log.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/Pipeline.h"
 #include "dawn/native/TintUtils.h"
 #include "dawn/native/d3d/D3DCompilationRequest.h"
@@ -67,6 +68,7 @@ ResultOrError<d3d::CompiledShader> ShaderModule::Compile(
     const std::bitset<kMaxInterStageShaderVariables>* usedInterstageVariables) {
     Device* device = ToBackend(GetDevice());
     TRACE_EVENT0(device->GetPlatform(), General, "ShaderModuleD3D12::Compile");
+    ScopedCounterTimer timer(device->GetCounters(), ShaderCompilationTimeCounter(stage));
     ASSERT(!IsError());
 
     ScopedTintICEHandler scopedICEHandler(device);
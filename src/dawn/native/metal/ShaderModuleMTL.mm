@@ -16,6 +16,7 @@
 
 #include "dawn/native/BindGroupLayout.h"
 #include "dawn/native/CacheRequest.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/Serializable.h"
 #include "dawn/native/TintUtils.h"
 #include "dawn/native/metal/DeviceMTL.h"
@@ -244,7 +245,8 @@ ResultOrError<CacheResult<MslCompilation>> TranslateToMSL(
                 TRACE_EVENT0(r.platform.UnsafeGetValue(), General, "RunTransforms");
                 DAWN_TRY_ASSIGN(program,
                                 RunTransforms(&transformManager, r.inputProgram, transformInputs,
-                                              &transformOutputs, nullptr));
+                                              &transformOutputs, nullptr,
+                                              r.platform.UnsafeGetValue()));
             }
 
             std::string remappedEntryPointName;
@@ -326,6 +328,7 @@ MaybeError ShaderModule::CreateFunction(SingleShaderStage stage,
                                         uint32_t sampleMask,
                                         const RenderPipeline* renderPipeline) {
     TRACE_EVENT0(GetDevice()->GetPlatform(), General, "ShaderModuleMTL::CreateFunction");
+    ScopedCounterTimer timer(GetDevice()->GetCounters(), ShaderCompilationTimeCounter(stage));
 
     ASSERT(!IsError());
     ASSERT(out);
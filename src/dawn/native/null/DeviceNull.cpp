@@ -19,6 +19,7 @@
 
 #include "dawn/native/BackendConnection.h"
 #include "dawn/native/Commands.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/ErrorData.h"
 #include "dawn/native/Instance.h"
 #include "dawn/native/Surface.h"
@@ -396,6 +397,7 @@ MaybeError Queue::WriteBufferImpl(BufferBase* buffer,
 // ComputePipeline
 MaybeError ComputePipeline::Initialize() {
     const ProgrammableStage& computeStage = GetStage(SingleShaderStage::Compute);
+    ScopedCounterTimer timer(GetDevice()->GetCounters(), TimeCounter::ComputeShaderCompilation);
 
     tint::Program transformedProgram;
     const tint::Program* program;
@@ -416,7 +418,7 @@ MaybeError ComputePipeline::Initialize() {
 
     DAWN_TRY_ASSIGN(transformedProgram,
                     RunTransforms(&transformManager, computeStage.module->GetTintProgram(),
-                                  transformInputs, nullptr, nullptr));
+                                  transformInputs, nullptr, nullptr, GetDevice()->GetPlatform()));
 
     program = &transformedProgram;
 
@@ -19,6 +19,7 @@
 
 #include "dawn/native/BindGroupLayout.h"
 #include "dawn/native/CacheRequest.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/Pipeline.h"
 #include "dawn/native/TintUtils.h"
 #include "dawn/native/opengl/DeviceGL.h"
@@ -147,6 +148,7 @@ ResultOrError<GLuint> ShaderModule::CompileShader(const OpenGLFunctions& gl,
                                                   const PipelineLayout* layout,
                                                   bool* needsPlaceholderSampler) const {
     TRACE_EVENT0(GetDevice()->GetPlatform(), General, "TranslateToGLSL");
+    ScopedCounterTimer timer(GetDevice()->GetCounters(), ShaderCompilationTimeCounter(stage));
 
     const OpenGLVersion& version = ToBackend(GetDevice())->GetGL().GetVersion();
 
@@ -212,8 +214,9 @@ ResultOrError<GLuint> ShaderModule::CompileShader(const OpenGLFunctions& gl,
             }
 
             tint::Program program;
-            DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, r.inputProgram,
-                                                   transformInputs, nullptr, nullptr));
+            DAWN_TRY_ASSIGN(program,
+                            RunTransforms(&transformManager, r.inputProgram, transformInputs,
+                                          nullptr, nullptr, r.platform.UnsafeGetValue()));
 
             if (r.stage == SingleShaderStage::Compute) {
                 // Validate workgroup size after program runs transforms.
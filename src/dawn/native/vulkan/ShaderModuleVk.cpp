@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "dawn/native/CacheRequest.h"
+#include "dawn/native/DeviceCounters.h"
 #include "dawn/native/Serializable.h"
 #include "dawn/native/SpirvValidation.h"
 #include "dawn/native/TintUtils.h"
@@ -190,6 +191,7 @@ ResultOrError<ShaderModule::ModuleAndSpirv> ShaderModule::GetHandleAndSpirv(
     const PipelineLayout* layout,
     bool clampFragDepth) {
     TRACE_EVENT0(GetDevice()->GetPlatform(), General, "ShaderModuleVk::GetHandleAndSpirv");
+    ScopedCounterTimer timer(GetDevice()->GetCounters(), ShaderCompilationTimeCounter(stage));
 
     // If the shader was destroyed, we should never call this function.
     ASSERT(IsAlive());
@@ -309,7 +311,8 @@ ResultOrError<ShaderModule::ModuleAndSpirv> ShaderModule::GetHandleAndSpirv(
                 TRACE_EVENT0(r.platform.UnsafeGetValue(), General, "RunTransforms");
                 DAWN_TRY_ASSIGN(program,
                                 RunTransforms(&transformManager, r.inputProgram, transformInputs,
-                                              &transformOutputs, nullptr));
+                                              &transformOutputs, nullptr,
+                                              r.platform.UnsafeGetValue()));
             }
 
             // Get the entry point name after the renamer pass.
@@ -0,0 +1,450 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/platform/FileCachingInterface.h"
+
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+namespace dawn::platform {
+
+#if DAWN_PLATFORM_IS(POSIX)
+namespace {
+
+constexpr uint32_t kEntryMagic = 0x434E5744;  // "DWNC"
+constexpr uint32_t kEntryVersion = 1;
+
+// Files are named with 16 hexadecimal digits of the hash of their key. Temporary files are named
+// with the entry name followed by this suffix, the process id and a counter.
+constexpr size_t kEntryNameLength = 16;
+constexpr char kTemporarySuffix[] = ".tmp.";
+
+// Temporary files older than this were left by a process that stopped while storing an entry.
+constexpr int64_t kStaleTemporaryFileAgeNs = int64_t(3600) * 1'000'000'000;
+
+// Eviction removes entries until their total size is below this percentage of the maximum size,
+// so that it doesn't need to run again on the next stores.
+constexpr uint64_t kEvictionTargetPercent = 75;
+
+constexpr uint64_t kKeyHashSeed = 0x9E3779B97F4A7C15;
+constexpr uint64_t kValueHashSeed = 0xC2B2AE3D27D4EB4F;
+
+struct EntryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t keySize;
+    uint64_t valueSize;
+    uint64_t valueHash;
+};
+
+uint64_t Mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCD;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53;
+    value ^= value >> 33;
+    return value;
+}
+
+// A fast non-cryptographic hash. The key of the entries is also stored in their file so a
+// collision only causes a cache miss.
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = Mix(seed ^ size);
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        hash = (hash ^ Mix(word)) * 0x9FB21C651E98DF25;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, bytes, size);
+    return Mix(hash ^ tail);
+}
+
+std::string GetEntryName(uint64_t keyHash) {
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+    std::string name(kEntryNameLength, '0');
+    for (size_t i = 0; i < kEntryNameLength; ++i) {
+        name[kEntryNameLength - 1 - i] = kHexDigits[(keyHash >> (4 * i)) & 0xF];
+    }
+    return name;
+}
+
+bool ParseEntryName(const char* name, uint64_t* keyHash) {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < kEntryNameLength; ++i) {
+        char c = name[i];
+        if (c >= '0' && c <= '9') {
+            hash = (hash << 4) | uint64_t(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            hash = (hash << 4) | uint64_t(c - 'a' + 10);
+        } else {
+            return false;
+        }
+    }
+    if (name[kEntryNameLength] != '\0') {
+        return false;
+    }
+    *keyHash = hash;
+    return true;
+}
+
+int64_t ToNanoseconds(const timespec& time) {
+    return int64_t(time.tv_sec) * 1'000'000'000 + time.tv_nsec;
+}
+
+// Returns the last modification time of a file, in nanoseconds since the epoch.
+int64_t GetModificationTimeNs(const struct stat& info) {
+#if DAWN_PLATFORM_IS(APPLE)
+    return ToNanoseconds(info.st_mtimespec);
+#else
+    return ToNanoseconds(info.st_mtim);
+#endif
+}
+
+int64_t GetCurrentTimeNs() {
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return ToNanoseconds(now);
+}
+
+bool WriteAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= size_t(written);
+    }
+    return true;
+}
+
+class ScopedFd {
+  public:
+    explicit ScopedFd(int fd) : mFd(fd) {}
+    ~ScopedFd() {
+        if (mFd >= 0) {
+            close(mFd);
+        }
+    }
+    ScopedFd(const ScopedFd&) = delete;
+    ScopedFd& operator=(const ScopedFd&) = delete;
+
+    int Get() const { return mFd; }
+
+  private:
+    int mFd;
+};
+
+class ScopedMapping {
+  public:
+    ScopedMapping(int fd, size_t size)
+        : mData(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)), mSize(size) {}
+    ~ScopedMapping() {
+        if (mData != MAP_FAILED) {
+            munmap(mData, mSize);
+        }
+    }
+    ScopedMapping(const ScopedMapping&) = delete;
+    ScopedMapping& operator=(const ScopedMapping&) = delete;
+
+    const uint8_t* Get() const {
+        return mData == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(mData);
+    }
+
+  private:
+    void* mData;
+    size_t mSize;
+};
+
+enum class LoadResult {
+    Success,
+    NotFound,
+    // The file exists but isn't a valid entry, and should be removed.
+    Corrupted,
+};
+
+class FileCachingInterfaceImpl final : public FileCachingInterface {
+  public:
+    FileCachingInterfaceImpl(std::string directory, uint64_t maxSize)
+        : mDirectory(std::move(directory)), mMaxSize(maxSize) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ScanDirectory();
+    }
+
+    ~FileCachingInterfaceImpl() override = default;
+
+    size_t LoadData(const void* key, size_t keySize, void* valueOut, size_t valueSize) override {
+        uint64_t keyHash = HashBytes(key, keySize, kKeyHashSeed);
+        std::string path = mDirectory + GetEntryName(keyHash);
+
+        size_t loadedSize = 0;
+        LoadResult result = LoadEntry(path, key, keySize, valueOut, valueSize, &loadedSize);
+        if (result == LoadResult::Corrupted) {
+            unlink(path.c_str());
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (result != LoadResult::Success) {
+            mStats.missCount++;
+            if (result == LoadResult::Corrupted) {
+                RemoveEntry(keyHash);
+            }
+            return 0;
+        }
+        // Only count the loads that return the value as hits, since BlobCache first queries the
+        // size of the value and then loads it.
+        if (valueOut != nullptr) {
+            mStats.hitCount++;
+            auto it = mEntries.find(keyHash);
+            if (it != mEntries.end()) {
+                it->second.lastUse = GetCurrentTimeNs();
+            }
+        }
+        return loadedSize;
+    }
+
+    void StoreData(const void* key, size_t keySize, const void* value, size_t valueSize) override {
+        uint64_t keyHash = HashBytes(key, keySize, kKeyHashSeed);
+        std::string name = GetEntryName(keyHash);
+        std::string temporaryPath = mDirectory + name + kTemporarySuffix +
+                                    std::to_string(getpid()) + "." +
+                                    std::to_string(mTemporaryFileCounter.fetch_add(1));
+
+        int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return;
+        }
+        EntryHeader header = {};
+        header.magic = kEntryMagic;
+        header.version = kEntryVersion;
+        header.keySize = keySize;
+        header.valueSize = valueSize;
+        header.valueHash = HashBytes(value, valueSize, kValueHashSeed);
+        bool success = WriteAll(fd, &header, sizeof(header)) && WriteAll(fd, key, keySize) &&
+                       WriteAll(fd, value, valueSize);
+        success = close(fd) == 0 && success;
+
+        // The rename atomically replaces any previous version of the entry, so concurrent loads,
+        // including from other processes, see either the old or the new file.
+        std::string path = mDirectory + name;
+        if (!success || rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            unlink(temporaryPath.c_str());
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        Entry& entry = mEntries[keyHash];
+        mStats.totalSize = mStats.totalSize - entry.size + sizeof(header) + keySize + valueSize;
+        entry.size = sizeof(header) + keySize + valueSize;
+        entry.lastUse = GetCurrentTimeNs();
+        mStats.storeCount++;
+
+        if (mStats.totalSize > mMaxSize) {
+            Evict();
+        }
+    }
+
+    FileCachingInterfaceStats GetStats() const override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStats;
+    }
+
+  private:
+    struct Entry {
+        uint64_t size = 0;
+        int64_t lastUse = 0;
+    };
+
+    static LoadResult LoadEntry(const std::string& path,
+                                const void* key,
+                                size_t keySize,
+                                void* valueOut,
+                                size_t valueSize,
+                                size_t* loadedSize) {
+        ScopedFd fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+        if (fd.Get() < 0) {
+            return LoadResult::NotFound;
+        }
+        struct stat info;
+        if (fstat(fd.Get(), &info) != 0) {
+            return LoadResult::NotFound;
+        }
+        size_t fileSize = size_t(info.st_size);
+        if (fileSize < sizeof(EntryHeader)) {
+            return LoadResult::Corrupted;
+        }
+
+        ScopedMapping mapping(fd.Get(), fileSize);
+        if (mapping.Get() == nullptr) {
+            return LoadResult::NotFound;
+        }
+        EntryHeader header;
+        memcpy(&header, mapping.Get(), sizeof(header));
+        if (header.magic != kEntryMagic || header.version != kEntryVersion ||
+            header.keySize > fileSize - sizeof(header) ||
+            header.valueSize != fileSize - sizeof(header) - header.keySize) {
+            return LoadResult::Corrupted;
+        }
+        // A different key with the same hash.
+        const uint8_t* storedKey = mapping.Get() + sizeof(header);
+        if (header.keySize != keySize || memcmp(storedKey, key, keySize) != 0) {
+            return LoadResult::NotFound;
+        }
+
+        if (valueOut == nullptr) {
+            *loadedSize = header.valueSize;
+            return LoadResult::Success;
+        }
+        if (valueSize != header.valueSize) {
+            return LoadResult::NotFound;
+        }
+        const uint8_t* value = storedKey + keySize;
+        if (HashBytes(value, valueSize, kValueHashSeed) != header.valueHash) {
+            return LoadResult::Corrupted;
+        }
+        memcpy(valueOut, value, valueSize);
+
+        // Mark the entry as recently used for the eviction done by any process.
+        futimens(fd.Get(), nullptr);
+        *loadedSize = valueSize;
+        return LoadResult::Success;
+    }
+
+    // The following methods must be called with |mMutex| held.
+
+    void RemoveEntry(uint64_t keyHash) {
+        auto it = mEntries.find(keyHash);
+        if (it != mEntries.end()) {
+            mStats.totalSize -= it->second.size;
+            mEntries.erase(it);
+        }
+    }
+
+    // Rebuilds the entries from the content of the directory, which may have been modified by
+    // other processes, and removes stale temporary files.
+    void ScanDirectory() {
+        mEntries.clear();
+        mStats.totalSize = 0;
+
+        DIR* dir = opendir(mDirectory.c_str());
+        if (dir == nullptr) {
+            return;
+        }
+        const int64_t now = GetCurrentTimeNs();
+        while (dirent* dirEntry = readdir(dir)) {
+            const char* name = dirEntry->d_name;
+            struct stat info;
+            if (fstatat(dirfd(dir), name, &info, 0) != 0 || !S_ISREG(info.st_mode)) {
+                continue;
+            }
+            uint64_t keyHash;
+            if (ParseEntryName(name, &keyHash)) {
+                mEntries[keyHash] = {uint64_t(info.st_size), GetModificationTimeNs(info)};
+                mStats.totalSize += uint64_t(info.st_size);
+            } else if (strstr(name, kTemporarySuffix) != nullptr &&
+                       now - GetModificationTimeNs(info) > kStaleTemporaryFileAgeNs) {
+                unlinkat(dirfd(dir), name, 0);
+            }
+        }
+        closedir(dir);
+    }
+
+    void Evict() {
+        ScanDirectory();
+
+        std::vector<std::pair<int64_t, uint64_t>> entriesByLastUse;
+        entriesByLastUse.reserve(mEntries.size());
+        for (const auto& [keyHash, entry] : mEntries) {
+            entriesByLastUse.emplace_back(entry.lastUse, keyHash);
+        }
+        std::sort(entriesByLastUse.begin(), entriesByLastUse.end());
+
+        const uint64_t targetSize = mMaxSize / 100 * kEvictionTargetPercent;
+        for (const auto& [lastUse, keyHash] : entriesByLastUse) {
+            if (mStats.totalSize <= targetSize) {
+                break;
+            }
+            // The file may have already been evicted by another process.
+            std::string path = mDirectory + GetEntryName(keyHash);
+            if (unlink(path.c_str()) == 0 || errno == ENOENT) {
+                RemoveEntry(keyHash);
+                mStats.evictionCount++;
+            }
+        }
+    }
+
+    const std::string mDirectory;
+    const uint64_t mMaxSize;
+    std::atomic<uint64_t> mTemporaryFileCounter{0};
+
+    mutable std::mutex mMutex;
+    std::unordered_map<uint64_t, Entry> mEntries;
+    FileCachingInterfaceStats mStats;
+};
+
+}  // anonymous namespace
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+FileCachingInterface::FileCachingInterface() = default;
+
+FileCachingInterface::~FileCachingInterface() = default;
+
+// static
+std::unique_ptr<FileCachingInterface> FileCachingInterface::Create(const char* directory,
+                                                                   uint64_t maxSize) {
+#if DAWN_PLATFORM_IS(POSIX)
+    std::string path = directory;
+    if (path.empty()) {
+        return nullptr;
+    }
+    if (path.back() != '/') {
+        path += '/';
+    }
+    if (mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+        return nullptr;
+    }
+    if (access(path.c_str(), R_OK | W_OK | X_OK) != 0) {
+        return nullptr;
+    }
+    return std::make_unique<FileCachingInterfaceImpl>(std::move(path), maxSize);
+#else
+    return nullptr;
+#endif  // DAWN_PLATFORM_IS(POSIX)
+}
+
+}  // namespace dawn::platform
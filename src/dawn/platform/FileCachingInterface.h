@@ -0,0 +1,58 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_PLATFORM_FILECACHINGINTERFACE_H_
+#define SRC_DAWN_PLATFORM_FILECACHINGINTERFACE_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "dawn/platform/DawnPlatform.h"
+
+namespace dawn::platform {
+
+struct FileCachingInterfaceStats {
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+    uint64_t storeCount = 0;
+    uint64_t evictionCount = 0;
+    // The size of the entries on disk, including the ones stored by other processes that were
+    // seen when the directory was last scanned.
+    uint64_t totalSize = 0;
+};
+
+// A CachingInterface that stores each entry in its own file, named after the hash of its key, in
+// a directory that can be shared by multiple processes. Entries are written to a temporary file
+// that is renamed in place so that readers never see partial entries, and are read by mapping the
+// file. When the total size of the entries is larger than the maximum size, the least recently
+// used entries are evicted based on the modification time of their files, which is updated on
+// each hit.
+class DAWN_PLATFORM_EXPORT FileCachingInterface : public CachingInterface {
+  public:
+    // Creates the cache in |directory|, which is created if it doesn't exist but whose parent
+    // must exist. Returns nullptr if the directory can't be used, or if the platform isn't
+    // supported.
+    static std::unique_ptr<FileCachingInterface> Create(const char* directory, uint64_t maxSize);
+
+    ~FileCachingInterface() override;
+
+    virtual FileCachingInterfaceStats GetStats() const = 0;
+
+  protected:
+    FileCachingInterface();
+};
+
+}  // namespace dawn::platform
+
+#endif  // SRC_DAWN_PLATFORM_FILECACHINGINTERFACE_H_
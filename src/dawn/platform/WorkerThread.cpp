@@ -14,40 +14,72 @@
 
 #include "dawn/platform/WorkerThread.h"
 
-#include <condition_variable>
-#include <functional>
+#include <algorithm>
+#include <array>
+#include <deque>
 #include <thread>
+#include <utility>
 
 #include "dawn/common/Assert.h"
 
 namespace {
 
+// Used when std::thread::hardware_concurrency() is unable to report the number of threads.
+constexpr uint32_t kFallbackWorkerCount = 4;
+// Caps the default number of workers on machines with a very large number of cores, where the
+// pipeline compilations would be bound by memory bandwidth way before using all the threads.
+constexpr uint32_t kMaxDefaultWorkerCount = 32;
+
+uint32_t GetDefaultWorkerCount() {
+    uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+    if (hardwareThreadCount == 0) {
+        return kFallbackWorkerCount;
+    }
+    return std::min(hardwareThreadCount, kMaxDefaultWorkerCount);
+}
+
+// The completion state is an atomic so that IsComplete() and the Wait() fast path never take a
+// lock. The mutex and condition variable are only used to park threads that have to block, and
+// MarkAsComplete() only touches them when there is such a waiter.
 class AsyncWaitableEventImpl {
   public:
-    AsyncWaitableEventImpl() : mIsComplete(false) {}
+    AsyncWaitableEventImpl() = default;
 
     void Wait() {
-        std::unique_lock<std::mutex> lock(mMutex);
-        mCondition.wait(lock, [this] { return mIsComplete; });
-    }
+        if (IsComplete()) {
+            return;
+        }
 
-    bool IsComplete() {
-        std::lock_guard<std::mutex> lock(mMutex);
-        return mIsComplete;
+        // The waiter is registered before checking the completion under the lock, and the
+        // completion is published before checking for waiters, so either the waiter sees the
+        // completion or MarkAsComplete() sees the waiter and notifies it.
+        mWaiterCount.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return IsComplete(); });
+        }
+        mWaiterCount.fetch_sub(1);
     }
 
+    bool IsComplete() { return mIsComplete.load(std::memory_order_acquire); }
+
     void MarkAsComplete() {
-        {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mIsComplete = true;
+        mIsComplete.store(true);
+        if (mWaiterCount.load() == 0) {
+            return;
         }
+
+        // Taking the lock makes sure the waiter is either before its predicate check or inside
+        // the wait, so that the notification cannot be lost.
+        { std::lock_guard<std::mutex> lock(mMutex); }
         mCondition.notify_all();
     }
 
   private:
+    std::atomic<bool> mIsComplete{false};
+    std::atomic<uint32_t> mWaiterCount{0};
     std::mutex mMutex;
     std::condition_variable mCondition;
-    bool mIsComplete;
 };
 
 class AsyncWaitableEvent final : public dawn::platform::WaitableEvent {
@@ -70,21 +102,188 @@ class AsyncWaitableEvent final : public dawn::platform::WaitableEvent {
 
 namespace dawn::platform {
 
+struct AsyncWorkerThreadPool::Task {
+    dawn::platform::PostWorkerTaskCallback callback = nullptr;
+    void* userdata = nullptr;
+    std::shared_ptr<AsyncWaitableEventImpl> waitableEventImpl;
+};
+
+struct AsyncWorkerThreadPool::Worker {
+    // Each worker has its own lock so that posting and picking tasks only contends with the
+    // workers stealing from the same deque instead of with the whole pool.
+    std::mutex mutex;
+    std::array<std::deque<Task>, kWorkerTaskPriorityCount> queues;
+    std::thread thread;
+};
+
+namespace {
+
+// The pool and worker index of the current thread, if it is a worker thread. Tasks posted from a
+// worker are pushed on its own deques, since they are likely to use data that is hot in its cache.
+thread_local const AsyncWorkerThreadPool* tCurrentPool = nullptr;
+thread_local uint32_t tCurrentWorkerIndex = 0;
+
+}  // anonymous namespace
+
+AsyncWorkerThreadPool::AsyncWorkerThreadPool(uint32_t maxWorkerCount) {
+    if (maxWorkerCount == 0) {
+        maxWorkerCount = GetDefaultWorkerCount();
+    }
+
+    mWorkers.reserve(maxWorkerCount);
+    for (uint32_t i = 0; i < maxWorkerCount; ++i) {
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+}
+
+AsyncWorkerThreadPool::~AsyncWorkerThreadPool() {
+    // Workers drain all the queued tasks before exiting so that all the WaitableEvents that were
+    // returned are eventually completed.
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mShuttingDown = true;
+    }
+    mSleepCondition.notify_all();
+
+    // Stop growing the pool, but don't hold the lock while joining since workers that are
+    // draining the tasks might post new ones.
+    uint32_t startedWorkerCount;
+    {
+        std::lock_guard<std::mutex> lock(mStartWorkerMutex);
+        mCanStartWorkers = false;
+        startedWorkerCount = mStartedWorkerCount.load();
+    }
+    for (uint32_t i = 0; i < startedWorkerCount; ++i) {
+        mWorkers[i]->thread.join();
+    }
+}
+
 std::unique_ptr<dawn::platform::WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
     dawn::platform::PostWorkerTaskCallback callback,
     void* userdata) {
+    return PostWorkerTaskWithPriority(callback, userdata, WorkerTaskPriority::Normal);
+}
+
+std::unique_ptr<dawn::platform::WaitableEvent> AsyncWorkerThreadPool::PostWorkerTaskWithPriority(
+    dawn::platform::PostWorkerTaskCallback callback,
+    void* userdata,
+    WorkerTaskPriority priority) {
     std::unique_ptr<AsyncWaitableEvent> waitableEvent = std::make_unique<AsyncWaitableEvent>();
 
-    std::function<void()> doTask = [callback, userdata,
-                                    waitableEventImpl = waitableEvent->GetWaitableEventImpl()] {
-        callback(userdata);
-        waitableEventImpl->MarkAsComplete();
-    };
+    Task task;
+    task.callback = callback;
+    task.userdata = userdata;
+    task.waitableEventImpl = waitableEvent->GetWaitableEventImpl();
+
+    StartWorkerIfNeeded();
+
+    uint32_t workerIndex;
+    if (tCurrentPool == this) {
+        workerIndex = tCurrentWorkerIndex;
+    } else {
+        workerIndex = mNextWorker.fetch_add(1, std::memory_order_relaxed) %
+                      mStartedWorkerCount.load(std::memory_order_acquire);
+    }
+
+    mQueuedTaskCount.fetch_add(1);
+    {
+        Worker* worker = mWorkers[workerIndex].get();
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->queues[static_cast<uint32_t>(priority)].push_back(std::move(task));
+    }
 
-    std::thread thread(doTask);
-    thread.detach();
+    // Same as for AsyncWaitableEventImpl, the task is published before checking for sleeping
+    // workers, and sleeping workers check for tasks under the lock after registering themselves.
+    if (mSleepingWorkerCount.load() != 0) {
+        { std::lock_guard<std::mutex> lock(mSleepMutex); }
+        mSleepCondition.notify_one();
+    }
 
     return waitableEvent;
 }
 
+uint32_t AsyncWorkerThreadPool::GetMaxWorkerCount() const {
+    return static_cast<uint32_t>(mWorkers.size());
+}
+
+uint32_t AsyncWorkerThreadPool::GetStartedWorkerCount() const {
+    return mStartedWorkerCount.load(std::memory_order_acquire);
+}
+
+void AsyncWorkerThreadPool::StartWorkerIfNeeded() {
+    // Only grow the pool when none of the started workers is idle.
+    uint32_t startedWorkerCount = mStartedWorkerCount.load(std::memory_order_acquire);
+    if (startedWorkerCount == mWorkers.size() ||
+        (startedWorkerCount != 0 && mSleepingWorkerCount.load() != 0)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mStartWorkerMutex);
+    startedWorkerCount = mStartedWorkerCount.load(std::memory_order_relaxed);
+    if (!mCanStartWorkers || startedWorkerCount == mWorkers.size()) {
+        return;
+    }
+
+    mWorkers[startedWorkerCount]->thread =
+        std::thread([this, startedWorkerCount] { WorkerLoop(startedWorkerCount); });
+    mStartedWorkerCount.store(startedWorkerCount + 1, std::memory_order_release);
+}
+
+void AsyncWorkerThreadPool::WorkerLoop(uint32_t workerIndex) {
+    tCurrentPool = this;
+    tCurrentWorkerIndex = workerIndex;
+
+    while (true) {
+        Task task;
+        if (TryPopTask(workerIndex, &task)) {
+            task.callback(task.userdata);
+            task.waitableEventImpl->MarkAsComplete();
+            continue;
+        }
+
+        mSleepingWorkerCount.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            mSleepCondition.wait(lock,
+                                 [this] { return mShuttingDown || mQueuedTaskCount.load() != 0; });
+            if (mShuttingDown && mQueuedTaskCount.load() == 0) {
+                mSleepingWorkerCount.fetch_sub(1);
+                break;
+            }
+        }
+        mSleepingWorkerCount.fetch_sub(1);
+    }
+
+    tCurrentPool = nullptr;
+}
+
+bool AsyncWorkerThreadPool::TryPopTask(uint32_t workerIndex, Task* task) {
+    uint32_t startedWorkerCount = mStartedWorkerCount.load(std::memory_order_acquire);
+    ASSERT(workerIndex < startedWorkerCount);
+
+    for (uint32_t priority = 0; priority < kWorkerTaskPriorityCount; ++priority) {
+        // Look at our own deque first, then try to steal from the back of the other workers'
+        // deques, starting with our neighbor so that thieves spread over the victims.
+        for (uint32_t i = 0; i < startedWorkerCount; ++i) {
+            Worker* worker = mWorkers[(workerIndex + i) % startedWorkerCount].get();
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            std::deque<Task>& queue = worker->queues[priority];
+            if (queue.empty()) {
+                continue;
+            }
+
+            if (i == 0) {
+                *task = std::move(queue.front());
+                queue.pop_front();
+            } else {
+                *task = std::move(queue.back());
+                queue.pop_back();
+            }
+            mQueuedTaskCount.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
 }  // namespace dawn::platform
@@ -15,18 +15,70 @@
 #ifndef SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 #define SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "dawn/common/NonCopyable.h"
 #include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::platform {
 
-class AsyncWorkerThreadPool : public dawn::platform::WorkerTaskPool, public NonCopyable {
+static constexpr uint32_t kWorkerTaskPriorityCount = 3;
+
+// A bounded pool of persistent worker threads. Each worker owns one deque per priority lane that
+// it consumes in FIFO order, and steals from the other workers' deques when its own are empty.
+// Tasks in a higher priority lane are always picked before tasks of a lower priority lane, by any
+// worker.
+// Worker threads are started lazily, up to the maximum worker count, when tasks are posted and no
+// worker is idle.
+class DAWN_PLATFORM_EXPORT AsyncWorkerThreadPool : public dawn::platform::WorkerTaskPool,
+                                                   public NonCopyable {
   public:
+    // A |maxWorkerCount| of 0 picks a count based on the number of hardware threads.
+    explicit AsyncWorkerThreadPool(uint32_t maxWorkerCount = 0);
+    ~AsyncWorkerThreadPool() override;
+
     std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
         dawn::platform::PostWorkerTaskCallback callback,
         void* userdata) override;
+
+    std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTaskWithPriority(
+        dawn::platform::PostWorkerTaskCallback callback,
+        void* userdata,
+        WorkerTaskPriority priority) override;
+
+    uint32_t GetMaxWorkerCount() const;
+    uint32_t GetStartedWorkerCount() const;
+
+  private:
+    struct Task;
+    struct Worker;
+
+    void StartWorkerIfNeeded();
+    void WorkerLoop(uint32_t workerIndex);
+    bool TryPopTask(uint32_t workerIndex, Task* task);
+
+    // All the Worker structures are allocated up front so that their addresses are stable while
+    // other workers steal from them. Only the first |mStartedWorkerCount| have a running thread.
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::atomic<uint32_t> mStartedWorkerCount{0};
+    std::atomic<uint32_t> mNextWorker{0};
+    std::mutex mStartWorkerMutex;
+    bool mCanStartWorkers = true;
+
+    // The number of tasks that are queued but not picked by a worker yet. It is incremented before
+    // a task is pushed so that it never underflows.
+    std::atomic<uint64_t> mQueuedTaskCount{0};
+
+    // Used to park idle workers. Posting a task only takes |mSleepMutex| when a worker is asleep.
+    std::atomic<uint32_t> mSleepingWorkerCount{0};
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepCondition;
+    bool mShuttingDown = false;
 };
 
 }  // namespace dawn::platform
@@ -0,0 +1,483 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/platform/tracing/ChromeTracingPlatform.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/platform/tracing/TraceEvent.h"
+
+namespace dawn::platform {
+namespace {
+
+constexpr uint32_t kTraceCategoryCount = 4;
+static_assert(static_cast<uint32_t>(TraceCategory::General) == 0);
+static_assert(static_cast<uint32_t>(TraceCategory::Validation) == 1);
+static_assert(static_cast<uint32_t>(TraceCategory::Recording) == 2);
+static_assert(static_cast<uint32_t>(TraceCategory::GPUWork) == 3);
+
+constexpr const char* kTraceCategoryNames[kTraceCategoryCount] = {
+    "General",
+    "Validation",
+    "Recording",
+    "GPUWork",
+};
+
+// The trace macros cache the enabled flag of their category at each call site, so the flags are
+// shared by all the platforms instead of being per platform.
+unsigned char gCategoryEnabled[kTraceCategoryCount] = {1, 1, 1, 1};
+
+// The trace macros pass at most two arguments.
+constexpr int kMaxArgCount = 2;
+
+struct RecordedEvent {
+    const char* name;
+    const char* argNames[kMaxArgCount];
+    uint64_t argValues[kMaxArgCount];
+    uint64_t id;
+    double timestamp;
+    unsigned char argTypes[kMaxArgCount];
+    unsigned char flags;
+    char phase;
+    uint8_t category;
+    uint8_t argCount;
+};
+
+// A single-producer single-consumer ring buffer of the events of one thread. Only its thread
+// pushes events and only the flush, which is serialized, drains them, so the buffer only needs
+// the two indices to be atomic.
+//
+// A slot is kept for the END event of each scope open in the buffer so that their END is never
+// dropped. When a BEGIN event is dropped, all the events until its END are dropped as well, so
+// that the scopes of a thread are always correctly nested.
+class ThreadEventBuffer {
+  public:
+    ThreadEventBuffer(uint32_t capacity, std::thread::id thread, uint32_t threadIndex)
+        : mEvents(new RecordedEvent[capacity]),
+          mCapacity(capacity),
+          mThread(thread),
+          mThreadIndex(threadIndex) {}
+
+    // Returns whether the event was recorded. |reachedHalfCapacity| is set when the buffer
+    // becomes half full with this event.
+    bool Push(const RecordedEvent& event, bool* reachedHalfCapacity) {
+        switch (event.phase) {
+            case TRACE_EVENT_PHASE_BEGIN:
+                if (mDroppedScopeDepth == 0 &&
+                    TryPush(event, mOpenScopeCount + 1, reachedHalfCapacity)) {
+                    mOpenScopeCount++;
+                    return true;
+                }
+                mDroppedScopeDepth++;
+                return false;
+
+            case TRACE_EVENT_PHASE_END:
+                if (mDroppedScopeDepth > 0) {
+                    mDroppedScopeDepth--;
+                    return false;
+                }
+                // An END without a BEGIN in the buffer, like when its category was enabled in
+                // the middle of the scope, would break the nesting of the thread's scopes.
+                if (mOpenScopeCount == 0) {
+                    return false;
+                }
+                mOpenScopeCount--;
+                return TryPush(event, 0, reachedHalfCapacity);
+
+            default:
+                if (mDroppedScopeDepth > 0) {
+                    return false;
+                }
+                return TryPush(event, mOpenScopeCount, reachedHalfCapacity);
+        }
+    }
+
+    template <typename F>
+    void Drain(F&& writeEvent) {
+        uint64_t readIndex = mReadIndex.load(std::memory_order_relaxed);
+        uint64_t writeIndex = mWriteIndex.load(std::memory_order_acquire);
+        for (uint64_t i = readIndex; i < writeIndex; ++i) {
+            writeEvent(mEvents[i % mCapacity]);
+        }
+        mReadIndex.store(writeIndex, std::memory_order_release);
+    }
+
+    std::thread::id GetThread() const { return mThread; }
+    uint32_t GetThreadIndex() const { return mThreadIndex; }
+
+  private:
+    bool TryPush(const RecordedEvent& event, uint64_t reservedSlots, bool* reachedHalfCapacity) {
+        uint64_t writeIndex = mWriteIndex.load(std::memory_order_relaxed);
+        uint64_t size = writeIndex - mReadIndex.load(std::memory_order_acquire);
+        if (size + reservedSlots >= mCapacity) {
+            return false;
+        }
+        mEvents[writeIndex % mCapacity] = event;
+        mWriteIndex.store(writeIndex + 1, std::memory_order_release);
+        *reachedHalfCapacity = size + 1 == mCapacity / 2;
+        return true;
+    }
+
+    std::unique_ptr<RecordedEvent[]> mEvents;
+    const uint64_t mCapacity;
+    const std::thread::id mThread;
+    const uint32_t mThreadIndex;
+
+    // On separate cache lines since they are written by different threads.
+    alignas(64) std::atomic<uint64_t> mWriteIndex{0};
+    alignas(64) std::atomic<uint64_t> mReadIndex{0};
+
+    // Only used by the buffer's thread.
+    uint64_t mOpenScopeCount = 0;
+    uint64_t mDroppedScopeDepth = 0;
+};
+
+void AppendJSONString(std::string* out, const char* value) {
+    out->push_back('"');
+    for (const char* c = value; *c != '\0'; ++c) {
+        switch (*c) {
+            case '"':
+                out->append("\\\"");
+                break;
+            case '\\':
+                out->append("\\\\");
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+                    out->append(escaped);
+                } else {
+                    out->push_back(*c);
+                }
+                break;
+        }
+    }
+    out->push_back('"');
+}
+
+// Returns false if the argument can't be written, which is the case for copied strings since
+// their storage is gone by the time the event is written.
+bool AppendJSONArgValue(std::string* out, unsigned char type, uint64_t value) {
+    char formatted[32];
+    switch (type) {
+        case TRACE_VALUE_TYPE_BOOL:
+            out->append(value != 0 ? "true" : "false");
+            return true;
+        case TRACE_VALUE_TYPE_UINT:
+            snprintf(formatted, sizeof(formatted), "%" PRIu64, value);
+            break;
+        case TRACE_VALUE_TYPE_INT:
+            snprintf(formatted, sizeof(formatted), "%" PRId64, static_cast<int64_t>(value));
+            break;
+        case TRACE_VALUE_TYPE_DOUBLE: {
+            double asDouble;
+            memcpy(&asDouble, &value, sizeof(double));
+            if (!std::isfinite(asDouble)) {
+                // JSON doesn't have NaN and infinities.
+                out->append("null");
+                return true;
+            }
+            snprintf(formatted, sizeof(formatted), "%.17g", asDouble);
+            break;
+        }
+        case TRACE_VALUE_TYPE_POINTER:
+            snprintf(formatted, sizeof(formatted), "\"0x%" PRIx64 "\"", value);
+            break;
+        case TRACE_VALUE_TYPE_STRING: {
+            const char* asString = reinterpret_cast<const char*>(static_cast<uintptr_t>(value));
+            AppendJSONString(out, asString != nullptr ? asString : "");
+            return true;
+        }
+        default:
+            return false;
+    }
+    out->append(formatted);
+    return true;
+}
+
+class ChromeTracingPlatformImpl final : public ChromeTracingPlatform {
+  public:
+    ChromeTracingPlatformImpl(FILE* file, const ChromeTracingPlatformOptions& options)
+        : mInstanceId(sNextInstanceId.fetch_add(1, std::memory_order_relaxed)),
+          mEventsPerThread(std::max(options.eventsPerThread, 2u)),
+          mOrigin(std::chrono::steady_clock::now()),
+          mFile(file),
+          mHasFlushThread(options.flushIntervalMs != 0) {
+        fputs("{\"traceEvents\":[", mFile);
+
+        if (mHasFlushThread) {
+            mFlushThread = std::thread([this, interval = options.flushIntervalMs] {
+                FlushThreadLoop(std::chrono::milliseconds(interval));
+            });
+        }
+    }
+
+    ~ChromeTracingPlatformImpl() override {
+        if (mHasFlushThread) {
+            {
+                std::lock_guard<std::mutex> lock(mFlushThreadMutex);
+                mStopFlushThread = true;
+            }
+            mFlushThreadCondition.notify_one();
+            mFlushThread.join();
+        }
+
+        std::lock_guard<std::mutex> lock(mFlushMutex);
+        WriteBufferedEvents();
+        fputs("\n]}\n", mFile);
+        fclose(mFile);
+    }
+
+    const unsigned char* GetTraceCategoryEnabledFlag(TraceCategory category) override {
+        ASSERT(static_cast<uint32_t>(category) < kTraceCategoryCount);
+        return &gCategoryEnabled[static_cast<uint32_t>(category)];
+    }
+
+    double MonotonicallyIncreasingTime() override {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mOrigin;
+        return elapsed.count();
+    }
+
+    uint64_t AddTraceEvent(char phase,
+                           const unsigned char* categoryGroupEnabled,
+                           const char* name,
+                           uint64_t id,
+                           double timestamp,
+                           int numArgs,
+                           const char** argNames,
+                           const unsigned char* argTypes,
+                           const uint64_t* argValues,
+                           unsigned char flags) override {
+        // The call site may have cached the flag of another platform before this one was used.
+        uint32_t category = 0;
+        while (category < kTraceCategoryCount &&
+               categoryGroupEnabled != &gCategoryEnabled[category]) {
+            category++;
+        }
+        if (category == kTraceCategoryCount) {
+            mDroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+
+        ThreadEventBuffer* buffer = GetCurrentThreadBuffer();
+
+        RecordedEvent event;
+        event.name = name;
+        event.id = id;
+        event.timestamp = timestamp;
+        event.flags = flags;
+        event.phase = phase;
+        event.category = static_cast<uint8_t>(category);
+        event.argCount = static_cast<uint8_t>(std::min(numArgs, kMaxArgCount));
+        for (uint32_t i = 0; i < event.argCount; ++i) {
+            event.argNames[i] = argNames[i];
+            event.argTypes[i] = argTypes[i];
+            event.argValues[i] = argValues[i];
+        }
+
+        // Copied names would have to be stored in the buffer. Dawn doesn't use them so they are
+        // replaced by a placeholder.
+        if ((flags & TRACE_EVENT_FLAG_COPY) != 0) {
+            event.name = nullptr;
+        }
+
+        bool reachedHalfCapacity = false;
+        if (!buffer->Push(event, &reachedHalfCapacity)) {
+            mDroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        } else if (reachedHalfCapacity && mHasFlushThread) {
+            mFlushRequested.store(true, std::memory_order_relaxed);
+            mFlushThreadCondition.notify_one();
+        }
+        return 0;
+    }
+
+    void Flush() override {
+        std::lock_guard<std::mutex> lock(mFlushMutex);
+        WriteBufferedEvents();
+    }
+
+    uint64_t GetDroppedEventCount() const override {
+        return mDroppedEventCount.load(std::memory_order_relaxed);
+    }
+
+  private:
+    ThreadEventBuffer* GetCurrentThreadBuffer() {
+        // Cache the buffer of the last platform used by the thread. Platforms are identified by
+        // an id instead of their address since a new platform could reuse it.
+        struct CachedBuffer {
+            uint64_t instanceId = 0;
+            ThreadEventBuffer* buffer = nullptr;
+        };
+        thread_local CachedBuffer tCachedBuffer;
+        if (tCachedBuffer.instanceId == mInstanceId) {
+            return tCachedBuffer.buffer;
+        }
+
+        std::thread::id thread = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(mBuffersMutex);
+        ThreadEventBuffer* buffer = nullptr;
+        for (const std::unique_ptr<ThreadEventBuffer>& existing : mBuffers) {
+            if (existing->GetThread() == thread) {
+                buffer = existing.get();
+                break;
+            }
+        }
+        if (buffer == nullptr) {
+            uint32_t threadIndex = static_cast<uint32_t>(mBuffers.size()) + 1;
+            mBuffers.push_back(
+                std::make_unique<ThreadEventBuffer>(mEventsPerThread, thread, threadIndex));
+            buffer = mBuffers.back().get();
+        }
+        tCachedBuffer = {mInstanceId, buffer};
+        return buffer;
+    }
+
+    void FlushThreadLoop(std::chrono::milliseconds interval) {
+        std::unique_lock<std::mutex> lock(mFlushThreadMutex);
+        while (!mStopFlushThread) {
+            mFlushThreadCondition.wait_for(lock, interval, [this] {
+                return mStopFlushThread || mFlushRequested.load(std::memory_order_relaxed);
+            });
+            mFlushRequested.store(false, std::memory_order_relaxed);
+            if (!mStopFlushThread) {
+                lock.unlock();
+                Flush();
+                lock.lock();
+            }
+        }
+    }
+
+    // Must be called with mFlushMutex held since the buffers only support a single consumer.
+    void WriteBufferedEvents() {
+        std::vector<ThreadEventBuffer*> buffers;
+        {
+            std::lock_guard<std::mutex> lock(mBuffersMutex);
+            for (const std::unique_ptr<ThreadEventBuffer>& buffer : mBuffers) {
+                buffers.push_back(buffer.get());
+            }
+        }
+
+        mScratch.clear();
+        for (ThreadEventBuffer* buffer : buffers) {
+            buffer->Drain([&](const RecordedEvent& event) {
+                AppendEvent(event, buffer->GetThreadIndex());
+            });
+        }
+        fwrite(mScratch.data(), 1, mScratch.size(), mFile);
+        fflush(mFile);
+    }
+
+    // Appends the event on its own line.
+    void AppendEvent(const RecordedEvent& event, uint32_t threadIndex) {
+        mScratch.append(mWroteFirstEvent ? ",\n{\"name\":" : "\n{\"name\":");
+        mWroteFirstEvent = true;
+        AppendJSONString(&mScratch, event.name != nullptr ? event.name : "<copied name>");
+
+        char formatted[128];
+        snprintf(formatted, sizeof(formatted),
+                 ",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":0,\"tid\":%" PRIu32,
+                 kTraceCategoryNames[event.category], event.phase, event.timestamp * 1'000'000.0,
+                 threadIndex);
+        mScratch.append(formatted);
+        if ((event.flags & TRACE_EVENT_FLAG_HAS_ID) != 0) {
+            snprintf(formatted, sizeof(formatted), ",\"id\":\"0x%" PRIx64 "\"", event.id);
+            mScratch.append(formatted);
+        }
+
+        if (event.argCount > 0) {
+            mScratch.append(",\"args\":{");
+            bool firstArg = true;
+            for (uint32_t i = 0; i < event.argCount; ++i) {
+                size_t argStart = mScratch.size();
+                if (!firstArg) {
+                    mScratch.push_back(',');
+                }
+                AppendJSONString(&mScratch, event.argNames[i]);
+                mScratch.push_back(':');
+                if (AppendJSONArgValue(&mScratch, event.argTypes[i], event.argValues[i])) {
+                    firstArg = false;
+                } else {
+                    mScratch.resize(argStart);
+                }
+            }
+            mScratch.push_back('}');
+        }
+        mScratch.push_back('}');
+    }
+
+    static std::atomic<uint64_t> sNextInstanceId;
+
+    const uint64_t mInstanceId;
+    const uint32_t mEventsPerThread;
+    const std::chrono::steady_clock::time_point mOrigin;
+    std::atomic<uint64_t> mDroppedEventCount{0};
+
+    // The buffers are only destroyed with the platform.
+    std::mutex mBuffersMutex;
+    std::vector<std::unique_ptr<ThreadEventBuffer>> mBuffers;
+
+    // Serializes the writes to the file, which are the only consumers of the buffers.
+    std::mutex mFlushMutex;
+    FILE* mFile;
+    bool mWroteFirstEvent = false;
+    std::string mScratch;
+
+    const bool mHasFlushThread;
+    std::mutex mFlushThreadMutex;
+    std::condition_variable mFlushThreadCondition;
+    bool mStopFlushThread = false;
+    std::atomic<bool> mFlushRequested{false};
+    std::thread mFlushThread;
+};
+
+std::atomic<uint64_t> ChromeTracingPlatformImpl::sNextInstanceId{1};
+
+}  // anonymous namespace
+
+ChromeTracingPlatform::ChromeTracingPlatform() = default;
+
+ChromeTracingPlatform::~ChromeTracingPlatform() = default;
+
+// static
+void ChromeTracingPlatform::SetCategoryEnabled(TraceCategory category, bool enabled) {
+    ASSERT(static_cast<uint32_t>(category) < kTraceCategoryCount);
+    // Like in Chrome, the flag is read by the trace macros without synchronization.
+    gCategoryEnabled[static_cast<uint32_t>(category)] = enabled ? 1 : 0;
+}
+
+// static
+std::unique_ptr<ChromeTracingPlatform> ChromeTracingPlatform::Create(
+    const char* path,
+    const ChromeTracingPlatformOptions& options) {
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+        return nullptr;
+    }
+    return std::make_unique<ChromeTracingPlatformImpl>(file, options);
+}
+
+}  // namespace dawn::platform
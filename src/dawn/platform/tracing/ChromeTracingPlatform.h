@@ -0,0 +1,71 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_PLATFORM_TRACING_CHROMETRACINGPLATFORM_H_
+#define SRC_DAWN_PLATFORM_TRACING_CHROMETRACINGPLATFORM_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "dawn/platform/DawnPlatform.h"
+
+namespace dawn::platform {
+
+struct ChromeTracingPlatformOptions {
+    // The number of events that each thread can buffer before they are written to the file. When
+    // a thread's buffer is full, its new events are dropped, along with the events nested in a
+    // dropped scope so that the written scopes stay correctly nested.
+    uint32_t eventsPerThread = 16 * 1024;
+    // How often a background thread writes the buffered events to the file. It is also woken up
+    // early when a thread's buffer is half full. If 0, there is no background thread and events
+    // are only written by Flush and on destruction.
+    uint32_t flushIntervalMs = 100;
+};
+
+// A Platform that records trace events in the Chrome trace event JSON format, which can be
+// loaded in chrome://tracing or Perfetto. Each thread records its events in its own lock-free
+// ring buffer, and the buffers are drained to the file by a background thread so that recording
+// an event never blocks on file IO. The file is completed when the platform is destroyed.
+//
+// Event names and string arguments must have a static lifetime: the names of events recorded
+// with TRACE_EVENT_FLAG_COPY are replaced by a placeholder and copied string arguments are
+// omitted.
+class DAWN_PLATFORM_EXPORT ChromeTracingPlatform : public Platform {
+  public:
+    // Returns nullptr if the file at |path| can't be created.
+    static std::unique_ptr<ChromeTracingPlatform> Create(
+        const char* path,
+        const ChromeTracingPlatformOptions& options = {});
+
+    ~ChromeTracingPlatform() override;
+
+    // Enables or disables recording the events of a category, for all the ChromeTracingPlatforms
+    // since the trace macros cache the category flags. All categories are enabled by default.
+    // Scopes that are open when their category is disabled are left unterminated in the trace.
+    static void SetCategoryEnabled(TraceCategory category, bool enabled);
+
+    // Writes all the events recorded until now to the file.
+    virtual void Flush() = 0;
+
+    // The number of events that were dropped because a thread's buffer was full, or because they
+    // couldn't be recorded.
+    virtual uint64_t GetDroppedEventCount() const = 0;
+
+  protected:
+    ChromeTracingPlatform();
+};
+
+}  // namespace dawn::platform
+
+#endif  // SRC_DAWN_PLATFORM_TRACING_CHROMETRACINGPLATFORM_H_
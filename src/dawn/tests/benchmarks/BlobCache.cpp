@@ -0,0 +1,147 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/native/Blob.h"
+#include "dawn/native/CacheKey.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/native/Device.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/FileCachingInterface.h"
+
+namespace dawn {
+namespace {
+
+constexpr uint32_t kPipelineCount = 500;
+// Roughly the size of a compiled pipeline in the backends' caches.
+constexpr size_t kPipelineBlobSize = 32 * 1024;
+constexpr uint64_t kMaxCacheSize = 64 * 1024 * 1024;
+
+class FileCachePlatform : public platform::Platform {
+  public:
+    explicit FileCachePlatform(platform::CachingInterface* cache) : mCache(cache) {}
+
+    platform::CachingInterface* GetCachingInterface() override { return mCache; }
+
+  private:
+    platform::CachingInterface* mCache;
+};
+
+void RemoveFiles(const std::string& directory) {
+    DIR* dir = opendir(directory.c_str());
+    while (dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+            unlink((directory + "/" + name).c_str());
+        }
+    }
+    closedir(dir);
+}
+
+// Starts Dawn on the null backend with a file cache in |directory| and loads the blobs of
+// |kPipelineCount| pipelines, storing the ones that are missing like after compiling them.
+platform::FileCachingInterfaceStats RunColdStart(const std::string& directory,
+                                                 const std::vector<uint8_t>& pipelineData) {
+    auto cache = platform::FileCachingInterface::Create(directory.c_str(), kMaxCacheSize);
+    ASSERT(cache != nullptr);
+    FileCachePlatform platform(cache.get());
+
+    wgpu::DawnInstanceDescriptor dawnInstanceDesc;
+    dawnInstanceDesc.platform = &platform;
+    wgpu::InstanceDescriptor instanceDesc;
+    instanceDesc.nextInChain = &dawnInstanceDesc;
+    native::Instance instance(reinterpret_cast<const WGPUInstanceDescriptor*>(&instanceDesc));
+
+    wgpu::RequestAdapterOptions options = {};
+    options.backendType = wgpu::BackendType::Null;
+    native::Adapter adapter = instance.EnumerateAdapters(&options)[0];
+    wgpu::Device device = wgpu::Device::Acquire(adapter.CreateDevice());
+    native::DeviceBase* deviceBase = native::FromAPI(device.Get());
+
+    for (uint32_t i = 0; i < kPipelineCount; ++i) {
+        native::CacheKey key = deviceBase->GetCacheKey();
+        StreamIn(&key, i);
+
+        native::Blob blob = deviceBase->LoadCachedBlob(key);
+        if (blob.Empty()) {
+            std::vector<uint8_t> compiled = pipelineData;
+            compiled[0] = uint8_t(i);
+            deviceBase->StoreCachedBlob(key, native::CreateBlob(std::move(compiled)));
+        }
+        benchmark::DoNotOptimize(blob.Data());
+    }
+
+    device = nullptr;
+    return cache->GetStats();
+}
+
+// Measures the startup of an application that creates |kPipelineCount| pipelines, with an empty
+// (Arg 0) or a warm (Arg 1) file cache. The null backend doesn't compile pipelines, so only the
+// cost of the cache itself is measured.
+void BM_BlobCache_ColdStart(benchmark::State& state) {
+    const bool warm = state.range(0) != 0;
+
+    char directoryTemplate[] = "/tmp/dawn_blob_cache_XXXXXX";
+    if (mkdtemp(directoryTemplate) == nullptr) {
+        state.SkipWithError("Could not create the cache directory");
+        return;
+    }
+    const std::string directory = directoryTemplate;
+
+    std::vector<uint8_t> pipelineData(kPipelineBlobSize);
+    for (size_t i = 0; i < pipelineData.size(); ++i) {
+        pipelineData[i] = uint8_t(i * 7);
+    }
+    if (warm) {
+        RunColdStart(directory, pipelineData);
+    }
+
+    platform::FileCachingInterfaceStats totalStats;
+    for (auto _ : state) {
+        if (!warm) {
+            state.PauseTiming();
+            RemoveFiles(directory);
+            state.ResumeTiming();
+        }
+        platform::FileCachingInterfaceStats stats = RunColdStart(directory, pipelineData);
+        totalStats.hitCount += stats.hitCount;
+        totalStats.missCount += stats.missCount;
+        totalStats.evictionCount += stats.evictionCount;
+    }
+
+    RemoveFiles(directory);
+    rmdir(directory.c_str());
+
+    state.SetItemsProcessed(state.iterations() * kPipelineCount);
+    state.counters["hits"] =
+        benchmark::Counter(totalStats.hitCount, benchmark::Counter::kAvgIterations);
+    state.counters["misses"] =
+        benchmark::Counter(totalStats.missCount, benchmark::Counter::kAvgIterations);
+    state.counters["evictions"] =
+        benchmark::Counter(totalStats.evictionCount, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_BlobCache_ColdStart)->ArgName("warm")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace dawn
@@ -0,0 +1,157 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+
+#include "dawn/native/CommandBuffer.h"
+#include "dawn/native/Commands.h"
+#include "dawn/native/dawn_platform.h"
+#include "dawn/tests/benchmarks/NullDeviceSetup.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr uint32_t kDrawCount = 1000000;
+constexpr uint32_t kUniformCount = 256;
+
+class CommandEncoding : public NullDeviceBenchmarkFixture {
+  public:
+    void SetUp(const benchmark::State& state) override {
+        NullDeviceBenchmarkFixture::SetUp(state);
+
+        utils::DynamicOffsetPipeline dynamicOffsetPipeline =
+            utils::CreateDynamicOffsetPipeline(device);
+        pipeline = dynamicOffsetPipeline.pipeline;
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 256 * kUniformCount;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        wgpu::Buffer uniformBuffer = device.CreateBuffer(&bufferDesc);
+        bindGroup = utils::MakeBindGroup(device, dynamicOffsetPipeline.bindGroupLayout,
+                                         {{0, uniformBuffer, 0, 16}});
+
+        bufferDesc.size = 3 * 4 * sizeof(float);
+        bufferDesc.usage = wgpu::BufferUsage::Vertex;
+        vertexBuffer = device.CreateBuffer(&bufferDesc);
+
+        wgpu::TextureDescriptor textureDesc;
+        textureDesc.size = {1, 1, 1};
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        attachment = device.CreateTexture(&textureDesc).CreateView();
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        pipeline = nullptr;
+        bindGroup = nullptr;
+        vertexBuffer = nullptr;
+        attachment = nullptr;
+        NullDeviceBenchmarkFixture::TearDown(state);
+    }
+
+  protected:
+    // Encodes kDrawCount draws that each use a different dynamic offset. If |redundantState| is
+    // true, the pipeline and vertex buffer are set again before every draw like engines that
+    // don't filter redundant state changes do. Returns the number of API calls in the pass.
+    uint64_t EncodeDraws(wgpu::CommandBuffer* commandBuffer, bool redundantState) {
+        uint64_t apiCallCount = 0;
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        utils::ComboRenderPassDescriptor renderPass({attachment});
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        for (uint32_t i = 0; i < kDrawCount; ++i) {
+            if (i == 0 || redundantState) {
+                pass.SetPipeline(pipeline);
+                pass.SetVertexBuffer(0, vertexBuffer);
+                apiCallCount += 2;
+            }
+            uint32_t dynamicOffset = (i % kUniformCount) * 256;
+            pass.SetBindGroup(0, bindGroup, 1, &dynamicOffset);
+            pass.Draw(3);
+            apiCallCount += 2;
+        }
+        pass.End();
+        *commandBuffer = encoder.Finish();
+
+        return apiCallCount;
+    }
+
+    wgpu::RenderPipeline pipeline;
+    wgpu::BindGroup bindGroup;
+    wgpu::Buffer vertexBuffer;
+    wgpu::TextureView attachment;
+
+  private:
+    wgpu::DeviceDescriptor GetDeviceDescriptor() const override { return {}; }
+};
+
+// Measures encoding a render pass with a million draws, and the size of the resulting command
+// stream for each API call. Redundant state changes are validated but not recorded.
+BENCHMARK_DEFINE_F(CommandEncoding, EncodeDraws)
+(benchmark::State& state) {
+    const bool redundantState = state.range(0) != 0;
+
+    uint64_t apiCallCount = 0;
+    size_t allocatedSize = 0;
+    for (auto _ : state) {
+        wgpu::CommandBuffer commandBuffer;
+        apiCallCount = EncodeDraws(&commandBuffer, redundantState);
+
+        state.PauseTiming();
+        native::CommandBufferBase* nativeCommandBuffer = native::FromAPI(commandBuffer.Get());
+        allocatedSize = nativeCommandBuffer->GetCommandIteratorForTesting()->GetAllocatedSize();
+        commandBuffer = nullptr;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * apiCallCount);
+    state.counters["bytesPerCall"] = static_cast<double>(allocatedSize) / apiCallCount;
+}
+BENCHMARK_REGISTER_F(CommandEncoding, EncodeDraws)
+    ->ArgName("redundantState")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+// Measures iterating over the recorded commands like the backends do when replaying them.
+BENCHMARK_DEFINE_F(CommandEncoding, IterateDraws)
+(benchmark::State& state) {
+    wgpu::CommandBuffer commandBuffer;
+    EncodeDraws(&commandBuffer, state.range(0) != 0);
+    native::CommandIterator* commands =
+        native::FromAPI(commandBuffer.Get())->GetCommandIteratorForTesting();
+
+    uint64_t commandCount = 0;
+    for (auto _ : state) {
+        commandCount = 0;
+        native::Command type;
+        while (commands->NextCommandId(&type)) {
+            native::SkipCommand(commands, type);
+            commandCount++;
+        }
+        commands->Reset();
+    }
+    state.SetItemsProcessed(state.iterations() * commandCount);
+    state.counters["bytesPerCommand"] =
+        static_cast<double>(commands->GetAllocatedSize()) / commandCount;
+}
+BENCHMARK_REGISTER_F(CommandEncoding, IterateDraws)
+    ->ArgName("redundantState")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace dawn
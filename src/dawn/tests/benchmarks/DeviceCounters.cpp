@@ -0,0 +1,139 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <atomic>
+#include <memory>
+
+#include "dawn/native/DeviceCounters.h"
+#include "dawn/tests/benchmarks/NullDeviceSetup.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+// Counts with one std::atomic that every thread adds to, so its cache line bounces between the
+// cores when several threads create objects at once.
+class SharedAtomicCounter {
+  public:
+    void AddObjectCreated(native::ObjectType) { mValue.fetch_add(1, std::memory_order_relaxed); }
+
+  private:
+    std::atomic<uint64_t> mValue{0};
+};
+
+// Measures the cost of a counter update when every thread updates the same counter, like when
+// multiple threads create objects on the same device.
+template <typename Counters>
+void BM_DeviceCounters_Add(benchmark::State& state) {
+    static std::unique_ptr<Counters> counters;
+    if (state.thread_index() == 0) {
+        counters = std::make_unique<Counters>();
+    }
+
+    for (auto _ : state) {
+        counters->AddObjectCreated(native::ObjectType::Buffer);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        counters = nullptr;
+    }
+}
+BENCHMARK_TEMPLATE(BM_DeviceCounters_Add, SharedAtomicCounter)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_DeviceCounters_Add, native::DeviceCounters)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+constexpr uint32_t kDrawsPerFrame = 16;
+
+// Encodes and submits a small frame, which is the cheapest work that updates the counters. Arg 0
+// runs it with the counters enabled, Arg 1 with the disable_device_counters toggle, so the
+// difference between the two is the overhead of the counters, ScopedCounterTimer clock reads
+// included.
+class DeviceCountersOverhead : public NullDeviceBenchmarkFixture {
+  public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() == 0) {
+            mTogglesDesc.enabledToggles = &kDisableCountersToggle;
+            mTogglesDesc.enabledTogglesCount = state.range(0) != 0 ? 1 : 0;
+        }
+        NullDeviceBenchmarkFixture::SetUp(state);
+
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @vertex fn main() -> @builtin(position) vec4f {
+                return vec4f(0.0);
+            })");
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @fragment fn main() -> @location(0) vec4f {
+                return vec4f(1.0);
+            })");
+        pipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        wgpu::TextureDescriptor textureDesc;
+        textureDesc.size = {1, 1, 1};
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        attachment = device.CreateTexture(&textureDesc).CreateView();
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        pipeline = nullptr;
+        attachment = nullptr;
+        NullDeviceBenchmarkFixture::TearDown(state);
+    }
+
+  protected:
+    wgpu::RenderPipeline pipeline;
+    wgpu::TextureView attachment;
+
+  private:
+    wgpu::DeviceDescriptor GetDeviceDescriptor() const override {
+        wgpu::DeviceDescriptor deviceDesc = {};
+        deviceDesc.nextInChain = &mTogglesDesc;
+        return deviceDesc;
+    }
+
+    static constexpr const char* kDisableCountersToggle = "disable_device_counters";
+
+    wgpu::DawnTogglesDescriptor mTogglesDesc;
+};
+
+BENCHMARK_DEFINE_F(DeviceCountersOverhead, SmallFrame)
+(benchmark::State& state) {
+    wgpu::Queue queue = device.GetQueue();
+    for (auto _ : state) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        utils::ComboRenderPassDescriptor renderPass({attachment});
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        for (uint32_t i = 0; i < kDrawsPerFrame; ++i) {
+            pass.Draw(3);
+        }
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+}
+BENCHMARK_REGISTER_F(DeviceCountersOverhead, SmallFrame)
+    ->ArgName("countersDisabled")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace dawn
@@ -15,9 +15,21 @@
 #include <benchmark/benchmark.h>
 #include <dawn/webgpu_cpp.h>
 #include <array>
+#include <cstring>
+#include <map>
+#include <shared_mutex>
+#include <string>
 #include <vector>
 
+#include "dawn/common/Assert.h"
 #include "dawn/common/Log.h"
+#include "dawn/native/Adapter.h"
+#include "dawn/native/Blob.h"
+#include "dawn/native/CacheKey.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/native/Device.h"
+#include "dawn/native/Instance.h"
+#include "dawn/platform/DawnPlatform.h"
 #include "dawn/tests/benchmarks/NullDeviceSetup.h"
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
 #include "dawn/utils/WGPUHelpers.h"
@@ -25,7 +37,8 @@
 namespace dawn {
 namespace {
 
-// Benchmarks for creation and recreation of objects in Dawn.
+// Benchmarks for creation and recreation of objects in Dawn. The objects that are deduplicated
+// through the device's caches are benchmarked from 1 to 64 threads to show how the cache scales.
 class ObjectCreation : public NullDeviceBenchmarkFixture {
   protected:
     ObjectCreation() {
@@ -66,12 +79,7 @@ BENCHMARK_DEFINE_F(ObjectCreation, SameBindGroupLayout)
         bgls.push_back(device.CreateBindGroupLayout(&bglDesc));
     }
 }
-BENCHMARK_REGISTER_F(ObjectCreation, SameBindGroupLayout)
-    ->Arg(1)
-    ->Arg(12)
-    ->Threads(1)
-    ->Threads(4)
-    ->Threads(16);
+BENCHMARK_REGISTER_F(ObjectCreation, SameBindGroupLayout)->Arg(1)->Arg(12)->ThreadRange(1, 64);
 
 BENCHMARK_DEFINE_F(ObjectCreation, UniqueBindGroupLayout)
 (benchmark::State& state) {
@@ -107,11 +115,7 @@ BENCHMARK_DEFINE_F(ObjectCreation, UniqueBindGroupLayout)
         bgls.push_back(device.CreateBindGroupLayout(&bglDesc));
     }
 }
-BENCHMARK_REGISTER_F(ObjectCreation, UniqueBindGroupLayout)
-    ->Arg(12)
-    ->Threads(1)
-    ->Threads(4)
-    ->Threads(16);
+BENCHMARK_REGISTER_F(ObjectCreation, UniqueBindGroupLayout)->Arg(12)->ThreadRange(1, 64);
 
 BENCHMARK_DEFINE_F(ObjectCreation, SameSampler)
 (benchmark::State& state) {
@@ -122,7 +126,7 @@ BENCHMARK_DEFINE_F(ObjectCreation, SameSampler)
         samplers.push_back(device.CreateSampler());
     }
 }
-BENCHMARK_REGISTER_F(ObjectCreation, SameSampler)->Threads(1)->Threads(4)->Threads(16);
+BENCHMARK_REGISTER_F(ObjectCreation, SameSampler)->ThreadRange(1, 64);
 
 BENCHMARK_DEFINE_F(ObjectCreation, UniqueSampler)
 (benchmark::State& state) {
@@ -139,7 +143,7 @@ BENCHMARK_DEFINE_F(ObjectCreation, UniqueSampler)
         samplers.push_back(device.CreateSampler(&samplerDesc));
     }
 }
-BENCHMARK_REGISTER_F(ObjectCreation, UniqueSampler)->Threads(1)->Threads(4)->Threads(16);
+BENCHMARK_REGISTER_F(ObjectCreation, UniqueSampler)->ThreadRange(1, 64);
 
 BENCHMARK_DEFINE_F(ObjectCreation, SameComputePipeline)
 (benchmark::State& state) {
@@ -238,5 +242,84 @@ BENCHMARK_DEFINE_F(ObjectCreation, UniqueRenderPipeline)
 }
 BENCHMARK_REGISTER_F(ObjectCreation, UniqueRenderPipeline)->Threads(1)->Threads(4)->Threads(16);
 
+// An in-memory CachingInterface that lets loads run in parallel, like the embedders' caches, so
+// that the benchmark below measures the BlobCache and not the CachingInterface.
+class InMemoryCachingInterface : public platform::CachingInterface {
+  public:
+    size_t LoadData(const void* key, size_t keySize, void* value, size_t valueSize) override {
+        std::shared_lock<std::shared_mutex> lock(mMutex);
+        auto it = mEntries.find(std::string(static_cast<const char*>(key), keySize));
+        if (it == mEntries.end()) {
+            return 0;
+        }
+        if (value != nullptr) {
+            ASSERT(valueSize == it->second.size());
+            memcpy(value, it->second.data(), it->second.size());
+        }
+        return it->second.size();
+    }
+
+    void StoreData(const void* key, size_t keySize, const void* value, size_t valueSize) override {
+        std::unique_lock<std::shared_mutex> lock(mMutex);
+        mEntries[std::string(static_cast<const char*>(key), keySize)] =
+            std::string(static_cast<const char*>(value), valueSize);
+    }
+
+  private:
+    std::shared_mutex mMutex;
+    std::map<std::string, std::string> mEntries;
+};
+
+class CachingPlatform : public platform::Platform {
+  public:
+    platform::CachingInterface* GetCachingInterface() override { return &mCachingInterface; }
+
+  private:
+    InMemoryCachingInterface mCachingInterface;
+};
+
+// Loads compiled pipelines from the device's BlobCache, like when many threads create pipelines
+// that are already in the persistent cache. The null backend doesn't compile or cache pipelines,
+// so the blobs are loaded directly.
+BENCHMARK_DEFINE_F(ObjectCreation, CachedPipeline)
+(benchmark::State& state) {
+    constexpr uint32_t kPipelineCount = 256;
+    constexpr size_t kPipelineBlobSize = 16 * 1024;
+
+    static CachingPlatform platform;
+    static std::vector<native::CacheKey> keys;
+    native::DeviceBase* deviceBase = native::FromAPI(device.Get());
+    native::InstanceBase* instance = deviceBase->GetAdapter()->APIGetInstance();
+    if (state.thread_index() == 0) {
+        instance->SetPlatformForTesting(&platform);
+        keys.clear();
+        for (uint32_t i = 0; i < kPipelineCount; ++i) {
+            native::CacheKey key = deviceBase->GetCacheKey();
+            StreamIn(&key, i);
+            deviceBase->StoreCachedBlob(
+                key, native::CreateBlob(std::vector<uint8_t>(kPipelineBlobSize, uint8_t(i))));
+            keys.push_back(std::move(key));
+        }
+    }
+
+    uint32_t i = state.thread_index();
+    for (auto _ : state) {
+        native::Blob blob = deviceBase->LoadCachedBlob(keys[i % kPipelineCount]);
+        ASSERT(blob.Size() == kPipelineBlobSize);
+        benchmark::DoNotOptimize(blob.Data());
+        i += 7;
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        instance->SetPlatformForTesting(nullptr);
+    }
+}
+BENCHMARK_REGISTER_F(ObjectCreation, CachedPipeline)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16)
+    ->UseRealTime();
+
 }  // namespace
 }  // namespace dawn
@@ -0,0 +1,129 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "dawn/wire/server/ObjectStorage.h"
+
+namespace dawn::wire::server {
+namespace {
+
+// The previous implementation of ObjectIdLookupTable, a std::map from native handle to ObjectId.
+// Every lookup walks a red-black tree of heap nodes.
+template <typename T>
+class MapObjectIdLookupTable {
+  public:
+    void Store(T key, ObjectId id) { mTable[key] = id; }
+
+    ObjectId Get(T key) const {
+        const auto it = mTable.find(key);
+        if (it != mTable.end()) {
+            return it->second;
+        }
+        return 0;
+    }
+
+    void Remove(T key) {
+        auto it = mTable.find(key);
+        if (it != mTable.end()) {
+            mTable.erase(it);
+        }
+    }
+
+  private:
+    std::map<T, ObjectId> mTable;
+};
+
+// Uses real heap allocations as the native handles so that the keys have the same distribution as
+// in the wire server, then shuffles them so that lookups don't happen in allocation order.
+class FakeHandles {
+  public:
+    explicit FakeHandles(size_t count) {
+        mStorage.reserve(count);
+        mHandles.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            mStorage.push_back(std::make_unique<uint64_t>(i));
+            mHandles.push_back(reinterpret_cast<WGPUTexture>(mStorage.back().get()));
+        }
+        std::shuffle(mHandles.begin(), mHandles.end(), std::mt19937(42));
+    }
+
+    const std::vector<WGPUTexture>& Get() const { return mHandles; }
+
+  private:
+    std::vector<std::unique_ptr<uint64_t>> mStorage;
+    std::vector<WGPUTexture> mHandles;
+};
+
+// Measures the reverse lookups done when the server returns objects to the client.
+template <typename Table>
+void BM_ObjectIdLookupTable_Get(benchmark::State& state) {
+    FakeHandles handles(state.range(0));
+    Table table;
+    for (size_t i = 0; i < handles.Get().size(); ++i) {
+        table.Store(handles.Get()[i], static_cast<ObjectId>(i + 1));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.Get(handles.Get()[i]));
+        i = (i + 1) % handles.Get().size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Measures the churn of objects being created and destroyed while the table has a steady size.
+template <typename Table>
+void BM_ObjectIdLookupTable_StoreRemove(benchmark::State& state) {
+    FakeHandles handles(state.range(0));
+    Table table;
+    const size_t halfSize = handles.Get().size() / 2;
+    for (size_t i = 0; i < halfSize; ++i) {
+        table.Store(handles.Get()[i], static_cast<ObjectId>(i + 1));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        table.Remove(handles.Get()[i]);
+        table.Store(handles.Get()[(i + halfSize) % handles.Get().size()],
+                    static_cast<ObjectId>(i + 1));
+        i = (i + 1) % handles.Get().size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_ObjectIdLookupTable_Get, MapObjectIdLookupTable<WGPUTexture>)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_ObjectIdLookupTable_Get, ObjectIdLookupTable<WGPUTexture>)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_ObjectIdLookupTable_StoreRemove, MapObjectIdLookupTable<WGPUTexture>)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_ObjectIdLookupTable_StoreRemove, ObjectIdLookupTable<WGPUTexture>)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+}  // namespace
+}  // namespace dawn::wire::server
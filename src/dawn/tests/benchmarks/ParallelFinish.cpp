@@ -0,0 +1,133 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <vector>
+
+#include "dawn/tests/benchmarks/NullDeviceSetup.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr uint32_t kPassCount = 8;
+constexpr uint32_t kBindGroupsPerPass = 64;
+constexpr size_t kCommandBuffersPerSubmit = 8;
+
+// Benchmarks encoding and finishing large command buffers on several threads at once, like a
+// renderer that records the passes of a frame in parallel. Arg 0 validates the resource usages in
+// Finish on the encoding thread, Arg 1 enables the async_command_buffer_validation toggle to
+// validate them on the device's worker pool instead. Submitting the command buffers isn't timed.
+class ParallelFinish : public NullDeviceBenchmarkFixture {
+  public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() == 0) {
+            mTogglesDesc.enabledToggles = &kAsyncValidationToggle;
+            mTogglesDesc.enabledTogglesCount = state.range(0) != 0 ? 1 : 0;
+        }
+        NullDeviceBenchmarkFixture::SetUp(state);
+    }
+
+  private:
+    wgpu::DeviceDescriptor GetDeviceDescriptor() const override {
+        wgpu::DeviceDescriptor deviceDesc = {};
+        deviceDesc.nextInChain = &mTogglesDesc;
+        deviceDesc.requiredFeatures = &kImplicitDeviceSynchronization;
+        deviceDesc.requiredFeaturesCount = 1;
+        return deviceDesc;
+    }
+
+    static constexpr const char* kAsyncValidationToggle = "async_command_buffer_validation";
+    static constexpr wgpu::FeatureName kImplicitDeviceSynchronization =
+        wgpu::FeatureName::ImplicitDeviceSynchronization;
+
+    wgpu::DawnTogglesDescriptor mTogglesDesc;
+};
+
+BENCHMARK_DEFINE_F(ParallelFinish, EncodeAndFinish)
+(benchmark::State& state) {
+    utils::ComboRenderPipelineDescriptor pipelineDesc;
+    pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+        @vertex fn main() -> @builtin(position) vec4f {
+            return vec4f(0.0, 0.0, 0.0, 1.0);
+        })");
+    pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<uniform> color : vec4f;
+        @group(0) @binding(1) var tex : texture_2d<f32>;
+        @fragment fn main() -> @location(0) vec4f {
+            return color + textureLoad(tex, vec2i(0), 0);
+        })");
+    wgpu::RenderPipeline pipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+    // Each thread uses its own resources, so every pass has kBindGroupsPerPass buffers and
+    // textures to validate.
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = 16;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform;
+
+    wgpu::TextureDescriptor textureDesc;
+    textureDesc.size = {1, 1, 1};
+    textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    textureDesc.usage = wgpu::TextureUsage::TextureBinding;
+
+    std::vector<wgpu::BindGroup> bindGroups;
+    for (uint32_t i = 0; i < kBindGroupsPerPass; ++i) {
+        wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+        wgpu::Texture texture = device.CreateTexture(&textureDesc);
+        bindGroups.push_back(utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0),
+                                                  {{0, buffer}, {1, texture.CreateView()}}));
+    }
+
+    textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+    wgpu::TextureView attachment = device.CreateTexture(&textureDesc).CreateView();
+    wgpu::Queue queue = device.GetQueue();
+
+    std::vector<wgpu::CommandBuffer> commandBuffers;
+    commandBuffers.reserve(kCommandBuffersPerSubmit);
+    for (auto _ : state) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (uint32_t pass = 0; pass < kPassCount; ++pass) {
+            utils::ComboRenderPassDescriptor renderPass({attachment});
+            wgpu::RenderPassEncoder passEncoder = encoder.BeginRenderPass(&renderPass);
+            passEncoder.SetPipeline(pipeline);
+            for (const wgpu::BindGroup& bindGroup : bindGroups) {
+                passEncoder.SetBindGroup(0, bindGroup);
+                passEncoder.Draw(3);
+            }
+            passEncoder.End();
+        }
+        commandBuffers.push_back(encoder.Finish());
+
+        if (commandBuffers.size() == kCommandBuffersPerSubmit) {
+            state.PauseTiming();
+            queue.Submit(commandBuffers.size(), commandBuffers.data());
+            commandBuffers.clear();
+            state.ResumeTiming();
+        }
+    }
+    queue.Submit(commandBuffers.size(), commandBuffers.data());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(ParallelFinish, EncodeAndFinish)
+    ->ArgName("asyncValidation")
+    ->Arg(0)
+    ->Arg(1)
+    ->ThreadRange(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace dawn
@@ -0,0 +1,86 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <sstream>
+#include <string>
+
+#include "dawn/tests/benchmarks/NullDeviceSetup.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+class ShaderModuleCreation : public NullDeviceBenchmarkFixture {
+  private:
+    wgpu::DeviceDescriptor GetDeviceDescriptor() const override { return {}; }
+};
+
+// Returns a shader library with |entryPointCount| compute entry points that each use a few
+// resources, like the shader modules of engines that put all their kernels in a single module.
+std::string MakeShaderLibrary(uint32_t entryPointCount) {
+    std::ostringstream wgsl;
+    wgsl << R"(
+        struct Params {
+            scale : f32,
+            count : u32,
+        }
+        @group(0) @binding(0) var<uniform> params : Params;
+        @group(0) @binding(1) var<storage, read> input : array<f32>;
+        @group(0) @binding(2) var<storage, read_write> output : array<f32>;
+        @group(0) @binding(3) var inputTexture : texture_2d<f32>;
+        @group(0) @binding(4) var inputSampler : sampler;
+    )";
+    for (uint32_t i = 0; i < entryPointCount; ++i) {
+        wgsl << "@compute @workgroup_size(64) fn main" << i
+             << "(@builtin(global_invocation_id) id : vec3u) {\n"
+             << "    if (id.x >= params.count) { return; }\n"
+             << "    let texel = textureSampleLevel(inputTexture, inputSampler, vec2f(0.5), 0.0);\n"
+             << "    output[id.x] = input[id.x] * params.scale + texel.x + " << i << ".0;\n"
+             << "}\n";
+    }
+    return wgsl.str();
+}
+
+// Creates shader modules with range(0) entry points and, if range(1) is 1, a pipeline that uses
+// one of them. Each module is unique so that it isn't deduplicated by the device's cache.
+BENCHMARK_DEFINE_F(ShaderModuleCreation, ShaderLibrary)
+(benchmark::State& state) {
+    const std::string library = MakeShaderLibrary(state.range(0));
+    const bool createPipeline = state.range(1) != 0;
+
+    uint64_t moduleIndex = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::string wgsl = "// " + std::to_string(moduleIndex++) + library;
+        state.ResumeTiming();
+
+        wgpu::ShaderModule module = utils::CreateShaderModule(device, wgsl.c_str());
+        if (createPipeline) {
+            wgpu::ComputePipelineDescriptor desc;
+            desc.compute.module = module;
+            desc.compute.entryPoint = "main0";
+            benchmark::DoNotOptimize(device.CreateComputePipeline(&desc).Get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(ShaderModuleCreation, ShaderLibrary)
+    ->ArgNames({"entryPoints", "pipeline"})
+    ->ArgsProduct({{1, 16, 128}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace dawn
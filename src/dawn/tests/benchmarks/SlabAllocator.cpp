@@ -0,0 +1,71 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+#include "dawn/common/PlacementAllocated.h"
+#include "dawn/common/SlabAllocator.h"
+
+namespace dawn {
+namespace {
+
+// Roughly the size of the small objects backed by slab allocators, like bind groups.
+struct SmallObject : public PlacementAllocated {
+    explicit SmallObject(uint64_t value) : values{value} {}
+    uint64_t values[8];
+};
+
+constexpr size_t kObjectsPerIteration = 64;
+constexpr size_t kSlabSize = 64 * sizeof(SmallObject);
+
+// Allocates and frees batches of objects on every thread using a single shared allocator, like
+// when multiple threads create and release bind groups with the same layout.
+template <typename Allocator>
+void BM_SlabAllocator_AllocateDeallocate(benchmark::State& state) {
+    static std::unique_ptr<Allocator> allocator;
+    if (state.thread_index() == 0) {
+        allocator = std::make_unique<Allocator>(kSlabSize);
+    }
+
+    std::vector<SmallObject*> objects(kObjectsPerIteration);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kObjectsPerIteration; ++i) {
+            objects[i] = allocator->Allocate(i);
+        }
+        benchmark::ClobberMemory();
+        for (SmallObject* object : objects) {
+            allocator->Deallocate(object);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kObjectsPerIteration);
+
+    if (state.thread_index() == 0) {
+        SlabAllocatorStats stats = allocator->GetStats();
+        state.counters["peakBlocks"] = stats.peakBlocksInUse;
+        state.counters["slabBytes"] = stats.totalBytes;
+        allocator = nullptr;
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_SlabAllocator_AllocateDeallocate, SlabAllocator<SmallObject>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SlabAllocator_AllocateDeallocate, MagazineSlabAllocator<SmallObject>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace dawn
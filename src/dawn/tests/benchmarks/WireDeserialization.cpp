@@ -0,0 +1,270 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu.h>
+#include <memory>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/dawn_proc_table.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn {
+namespace {
+
+// Records the commands serialized by a wire client so that they can be replayed on a server.
+class CommandRecorder : public wire::CommandSerializer {
+  public:
+    size_t GetMaximumAllocationSize() const override { return 1024 * 1024; }
+
+    void* GetCmdSpace(size_t size) override {
+        size_t offset = mCommands.size();
+        mCommands.resize(offset + size);
+        return mCommands.data() + offset;
+    }
+
+    bool Flush() override { return true; }
+
+    std::vector<char> TakeCommands() { return std::move(mCommands); }
+
+  private:
+    std::vector<char> mCommands;
+};
+
+// Procs for the wire server that do nothing, so that the benchmarks measure the deserialization
+// of the commands and not the creation of the objects.
+template <typename T>
+T CreateFakeObject(WGPUDevice, const void*) {
+    static uint64_t fakeObject;
+    return reinterpret_cast<T>(&fakeObject);
+}
+
+template <typename T>
+void ReleaseFakeObject(T) {}
+
+DawnProcTable GetStubProcs() {
+    DawnProcTable procs = {};
+    procs.deviceReference = [](WGPUDevice) {};
+    procs.deviceRelease = [](WGPUDevice) {};
+    procs.deviceSetUncapturedErrorCallback = [](WGPUDevice, WGPUErrorCallback, void*) {};
+    procs.deviceSetLoggingCallback = [](WGPUDevice, WGPULoggingCallback, void*) {};
+    procs.deviceSetDeviceLostCallback = [](WGPUDevice, WGPUDeviceLostCallback, void*) {};
+
+    procs.deviceCreateBindGroup = [](WGPUDevice device, const WGPUBindGroupDescriptor* desc) {
+        return CreateFakeObject<WGPUBindGroup>(device, desc);
+    };
+    procs.deviceCreateBindGroupLayout = [](WGPUDevice device,
+                                           const WGPUBindGroupLayoutDescriptor* desc) {
+        return CreateFakeObject<WGPUBindGroupLayout>(device, desc);
+    };
+    procs.deviceCreateRenderPipeline = [](WGPUDevice device,
+                                          const WGPURenderPipelineDescriptor* desc) {
+        return CreateFakeObject<WGPURenderPipeline>(device, desc);
+    };
+    procs.deviceCreateSampler = [](WGPUDevice device, const WGPUSamplerDescriptor* desc) {
+        return CreateFakeObject<WGPUSampler>(device, desc);
+    };
+    procs.deviceCreateShaderModule = [](WGPUDevice device,
+                                        const WGPUShaderModuleDescriptor* desc) {
+        return CreateFakeObject<WGPUShaderModule>(device, desc);
+    };
+    procs.bindGroupRelease = ReleaseFakeObject<WGPUBindGroup>;
+    procs.bindGroupLayoutRelease = ReleaseFakeObject<WGPUBindGroupLayout>;
+    procs.renderPipelineRelease = ReleaseFakeObject<WGPURenderPipeline>;
+    procs.samplerRelease = ReleaseFakeObject<WGPUSampler>;
+    procs.shaderModuleRelease = ReleaseFakeObject<WGPUShaderModule>;
+    return procs;
+}
+
+enum class CommandKind {
+    BindGroupLayout,
+    BindGroup,
+    RenderPipeline,
+};
+
+constexpr size_t kCommandsPerStream = 1000;
+constexpr uint32_t kEntryCount = 64;
+constexpr uint32_t kVertexBufferCount = 8;
+constexpr uint32_t kAttributesPerBuffer = 4;
+constexpr uint32_t kColorTargetCount = 4;
+
+// The commands recorded from a wire client: |setup| creates the objects used by |commands|, and
+// |commands| creates and releases |kCommandsPerStream| objects of the benchmarked kind.
+struct RecordedStream {
+    std::vector<char> setup;
+    std::vector<char> commands;
+    uint32_t deviceId;
+    uint32_t deviceGeneration;
+};
+
+RecordedStream RecordStream(CommandKind kind) {
+    CommandRecorder recorder;
+    wire::WireClientDescriptor clientDesc = {};
+    clientDesc.serializer = &recorder;
+    wire::WireClient client(clientDesc);
+    const DawnProcTable& procs = wire::client::GetProcs();
+
+    RecordedStream stream;
+    wire::ReservedDevice reservation = client.ReserveDevice();
+    WGPUDevice device = reservation.device;
+    stream.deviceId = reservation.id;
+    stream.deviceGeneration = reservation.generation;
+
+    std::vector<WGPUBindGroupLayoutEntry> layoutEntries(kEntryCount);
+    for (uint32_t i = 0; i < kEntryCount; ++i) {
+        layoutEntries[i] = {};
+        layoutEntries[i].binding = i;
+        layoutEntries[i].visibility = WGPUShaderStage_Fragment;
+        layoutEntries[i].sampler.type = WGPUSamplerBindingType_Filtering;
+    }
+    WGPUBindGroupLayoutDescriptor layoutDesc = {};
+    layoutDesc.label = "bind group layout";
+    layoutDesc.entryCount = layoutEntries.size();
+    layoutDesc.entries = layoutEntries.data();
+
+    WGPUSamplerDescriptor samplerDesc = {};
+    WGPUSampler sampler = procs.deviceCreateSampler(device, &samplerDesc);
+    WGPUBindGroupLayout layout = procs.deviceCreateBindGroupLayout(device, &layoutDesc);
+    std::vector<WGPUBindGroupEntry> entries(kEntryCount);
+    for (uint32_t i = 0; i < kEntryCount; ++i) {
+        entries[i] = {};
+        entries[i].binding = i;
+        entries[i].sampler = sampler;
+    }
+    WGPUBindGroupDescriptor bindGroupDesc = {};
+    bindGroupDesc.label = "bind group";
+    bindGroupDesc.layout = layout;
+    bindGroupDesc.entryCount = entries.size();
+    bindGroupDesc.entries = entries.data();
+
+    WGPUShaderModuleWGSLDescriptor wgslDesc = {};
+    wgslDesc.chain.sType = WGPUSType_ShaderModuleWGSLDescriptor;
+    wgslDesc.code = "@vertex fn vs() -> @builtin(position) vec4f { return vec4f(); }";
+    WGPUShaderModuleDescriptor moduleDesc = {};
+    moduleDesc.nextInChain = &wgslDesc.chain;
+    WGPUShaderModule module = procs.deviceCreateShaderModule(device, &moduleDesc);
+
+    std::vector<WGPUVertexAttribute> attributes(kVertexBufferCount * kAttributesPerBuffer);
+    std::vector<WGPUVertexBufferLayout> buffers(kVertexBufferCount);
+    for (uint32_t i = 0; i < kVertexBufferCount; ++i) {
+        for (uint32_t j = 0; j < kAttributesPerBuffer; ++j) {
+            WGPUVertexAttribute& attribute = attributes[i * kAttributesPerBuffer + j];
+            attribute.format = WGPUVertexFormat_Float32x4;
+            attribute.offset = j * 16;
+            attribute.shaderLocation = i * kAttributesPerBuffer + j;
+        }
+        buffers[i].arrayStride = kAttributesPerBuffer * 16;
+        buffers[i].stepMode = WGPUVertexStepMode_Vertex;
+        buffers[i].attributeCount = kAttributesPerBuffer;
+        buffers[i].attributes = &attributes[i * kAttributesPerBuffer];
+    }
+    std::vector<WGPUColorTargetState> targets(kColorTargetCount);
+    for (WGPUColorTargetState& target : targets) {
+        target = {};
+        target.format = WGPUTextureFormat_RGBA8Unorm;
+        target.writeMask = WGPUColorWriteMask_All;
+    }
+    WGPUFragmentState fragment = {};
+    fragment.module = module;
+    fragment.entryPoint = "fs";
+    fragment.targetCount = targets.size();
+    fragment.targets = targets.data();
+    WGPURenderPipelineDescriptor pipelineDesc = {};
+    pipelineDesc.label = "render pipeline";
+    pipelineDesc.vertex.module = module;
+    pipelineDesc.vertex.entryPoint = "vs";
+    pipelineDesc.vertex.bufferCount = buffers.size();
+    pipelineDesc.vertex.buffers = buffers.data();
+    pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
+    pipelineDesc.multisample.count = 1;
+    pipelineDesc.multisample.mask = 0xFFFFFFFF;
+    pipelineDesc.fragment = &fragment;
+
+    stream.setup = recorder.TakeCommands();
+
+    for (size_t i = 0; i < kCommandsPerStream; ++i) {
+        switch (kind) {
+            case CommandKind::BindGroupLayout:
+                procs.bindGroupLayoutRelease(
+                    procs.deviceCreateBindGroupLayout(device, &layoutDesc));
+                break;
+            case CommandKind::BindGroup:
+                procs.bindGroupRelease(procs.deviceCreateBindGroup(device, &bindGroupDesc));
+                break;
+            case CommandKind::RenderPipeline:
+                procs.renderPipelineRelease(
+                    procs.deviceCreateRenderPipeline(device, &pipelineDesc));
+                break;
+        }
+    }
+    stream.commands = recorder.TakeCommands();
+
+    procs.samplerRelease(sampler);
+    procs.bindGroupLayoutRelease(layout);
+    procs.shaderModuleRelease(module);
+    procs.deviceRelease(device);
+    return stream;
+}
+
+// Measures the throughput of the wire server deserializing recorded streams of object creations
+// with large descriptors. A new server is used for each replay since the object ids of the stream
+// can only be used once.
+void BM_WireDeserialization_Replay(benchmark::State& state) {
+    const RecordedStream stream = RecordStream(static_cast<CommandKind>(state.range(0)));
+    const DawnProcTable procs = GetStubProcs();
+
+    uint64_t allocatedBytes = 0;
+    uint64_t heapAllocationCount = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        CommandRecorder serverSerializer;
+        wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &procs;
+        serverDesc.serializer = &serverSerializer;
+        auto server = std::make_unique<wire::WireServer>(serverDesc);
+        server->InjectDevice(CreateFakeObject<WGPUDevice>(nullptr, nullptr), stream.deviceId,
+                             stream.deviceGeneration);
+        bool success = server->HandleCommands(stream.setup.data(), stream.setup.size());
+        ASSERT(success);
+        uint64_t setupAllocatedBytes = server->GetDeserializeAllocatedBytes();
+        uint64_t setupHeapAllocationCount = server->GetDeserializeHeapAllocationCount();
+        state.ResumeTiming();
+
+        success = server->HandleCommands(stream.commands.data(), stream.commands.size());
+        ASSERT(success);
+
+        state.PauseTiming();
+        allocatedBytes += server->GetDeserializeAllocatedBytes() - setupAllocatedBytes;
+        heapAllocationCount +=
+            server->GetDeserializeHeapAllocationCount() - setupHeapAllocationCount;
+        server = nullptr;
+        state.ResumeTiming();
+    }
+
+    uint64_t commandCount = state.iterations() * kCommandsPerStream;
+    state.SetItemsProcessed(commandCount);
+    state.SetBytesProcessed(state.iterations() * stream.commands.size());
+    state.counters["allocatedBytesPerCommand"] = double(allocatedBytes) / commandCount;
+    state.counters["heapAllocationsPerCommand"] = double(heapAllocationCount) / commandCount;
+}
+BENCHMARK(BM_WireDeserialization_Replay)
+    ->ArgName("kind")
+    ->Arg(static_cast<int>(CommandKind::BindGroupLayout))
+    ->Arg(static_cast<int>(CommandKind::BindGroup))
+    ->Arg(static_cast<int>(CommandKind::RenderPipeline));
+
+}  // namespace
+}  // namespace dawn
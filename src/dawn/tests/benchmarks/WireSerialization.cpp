@@ -0,0 +1,103 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+#include "dawn/utils/BatchingCommandBuffer.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/wire/ChunkedCommandHandler.h"
+#include "dawn/wire/ChunkedCommandSerializer.h"
+
+namespace dawn::wire {
+namespace {
+
+// Data-only members are referenced in place by the deserialization so nothing is allocated.
+class NoAllocationDeserializeAllocator : public DeserializeAllocator {
+  public:
+    void* GetSpace(size_t) override { return nullptr; }
+};
+
+// Deserializes QueueWriteBuffer commands like the wire server would, without executing them.
+class WriteBufferSink : public ChunkedCommandHandler {
+  public:
+    uint64_t GetWrittenBytes() const { return mWrittenBytes; }
+
+  private:
+    const volatile char* HandleCommandsImpl(const volatile char* commands, size_t size) override {
+        DeserializeBuffer deserializeBuffer(commands, size);
+        while (deserializeBuffer.AvailableSize() >= sizeof(CmdHeader) + sizeof(WireCmd)) {
+            switch (HandleChunkedCommands(deserializeBuffer.Buffer(),
+                                          deserializeBuffer.AvailableSize())) {
+                case ChunkedCommandsResult::Consumed:
+                    return commands + size;
+                case ChunkedCommandsResult::Error:
+                    return nullptr;
+                case ChunkedCommandsResult::Passthrough:
+                    break;
+            }
+
+            QueueWriteBufferCmd cmd;
+            if (cmd.Deserialize(&deserializeBuffer, &mAllocator) != WireResult::Success) {
+                return nullptr;
+            }
+            benchmark::DoNotOptimize(cmd.data);
+            mWrittenBytes += cmd.size;
+        }
+        return commands + size;
+    }
+
+    NoAllocationDeserializeAllocator mAllocator;
+    uint64_t mWrittenBytes = 0;
+};
+
+// Measures the throughput of Queue::WriteBuffer commands of |range(1)| bytes going through an
+// in-process wire. Arg 0 uses TerribleCommandBuffer which copies commands larger than its buffer
+// in chunks. Arg 1 uses BatchingCommandBuffer which hands their data to the handler in place.
+void BM_WireSerialization_WriteBuffer(benchmark::State& state) {
+    const size_t writeSize = state.range(1);
+    std::vector<uint8_t> data(writeSize, 0x42);
+
+    WriteBufferSink sink;
+    std::unique_ptr<CommandSerializer> transport;
+    if (state.range(0) == 0) {
+        transport = std::make_unique<utils::TerribleCommandBuffer>(&sink);
+    } else {
+        transport = std::make_unique<utils::BatchingCommandBuffer>(
+            &sink, utils::BatchingCommandBuffer::kDefaultBatchSize);
+    }
+    ChunkedCommandSerializer serializer(transport.get());
+
+    QueueWriteBufferCmd cmd = {};
+    cmd.queueId = 1;
+    cmd.bufferId = 2;
+    cmd.data = data.data();
+    cmd.size = writeSize;
+
+    for (auto _ : state) {
+        serializer.SerializeCommand(cmd);
+    }
+    if (!transport->Flush() || sink.GetWrittenBytes() != state.iterations() * writeSize) {
+        state.SkipWithError("Commands were not all handled");
+    }
+    state.SetBytesProcessed(state.iterations() * writeSize);
+}
+BENCHMARK(BM_WireSerialization_WriteBuffer)
+    ->ArgNames({"gather", "bytes"})
+    ->RangeMultiplier(8)
+    ->Ranges({{0, 1}, {64, 64 << 20}});
+
+}  // namespace
+}  // namespace dawn::wire
@@ -0,0 +1,311 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "dawn/dawn_proc.h"
+#include "dawn/native/DawnNative.h"
+#include "dawn/utils/RingBufferCommandBuffer.h"
+#include "dawn/utils/SharedMemory.h"
+#include "dawn/utils/SharedMemoryTransferService.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn {
+namespace {
+
+constexpr size_t kControlSize = 4096;
+constexpr size_t kRingBufferSize = 32 * 1024 * 1024;
+constexpr size_t kTransferSize = 64 * 1024 * 1024;
+
+struct Control {
+    std::atomic<uint32_t> stop;
+};
+
+// A wire client in the benchmark process connected to a wire server on the null backend in a
+// forked process. The two processes share a single memfd region that contains a ring buffer in
+// each direction and, optionally, the arena of the shared memory transfer service. Failures are
+// reported by GetError() so that the benchmarks can be skipped in release builds too.
+class SharedMemoryWire {
+  public:
+    explicit SharedMemoryWire(bool useSharedMemoryTransfer) {
+        mRegion = utils::SharedMemoryRegion::Create(kControlSize + 2 * kRingBufferSize +
+                                                     kTransferSize);
+        if (mRegion == nullptr) {
+            mError = "Failed to create the shared memory region.";
+            return;
+        }
+        char* data = static_cast<char*>(mRegion->GetData());
+        mControl = new (data) Control();
+        void* c2sRing = data + kControlSize;
+        void* s2cRing = data + kControlSize + kRingBufferSize;
+        void* transfer = data + kControlSize + 2 * kRingBufferSize;
+
+        mC2sSerializer = std::make_unique<utils::RingBufferCommandSerializer>(c2sRing,
+                                                                              kRingBufferSize);
+        mS2cReader = std::make_unique<utils::RingBufferCommandReader>(s2cRing, kRingBufferSize);
+        if (useSharedMemoryTransfer) {
+            mClientTransfer =
+                utils::CreateSharedMemoryClientTransferService(transfer, kTransferSize);
+        }
+
+        wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = mC2sSerializer.get();
+        clientDesc.memoryTransferService = mClientTransfer.get();
+        mWireClient = std::make_unique<wire::WireClient>(clientDesc);
+        wire::ReservedInstance reservation = mWireClient->ReserveInstance();
+
+        mServerPid = fork();
+        if (mServerPid < 0) {
+            mError = "Failed to fork the wire server process.";
+            return;
+        }
+        if (mServerPid == 0) {
+            RunServer(c2sRing, s2cRing, useSharedMemoryTransfer ? transfer : nullptr,
+                      reservation.id, reservation.generation);
+        }
+
+        dawnProcSetProcs(&wire::client::GetProcs());
+        mInstance = wgpu::Instance::Acquire(reservation.instance);
+
+        wgpu::RequestAdapterOptions options = {};
+        options.backendType = wgpu::BackendType::Null;
+        mInstance.RequestAdapter(
+            &options,
+            [](WGPURequestAdapterStatus status, WGPUAdapter cAdapter, char const*, void* userdata) {
+                auto* self = static_cast<SharedMemoryWire*>(userdata);
+                if (status == WGPURequestAdapterStatus_Success) {
+                    self->mAdapter = wgpu::Adapter::Acquire(cAdapter);
+                }
+                self->mCallbackDone = true;
+            },
+            this);
+        if (!WaitForCallback() || !mAdapter) {
+            mError = "Failed to request the adapter through the wire.";
+            return;
+        }
+
+        mAdapter.RequestDevice(
+            nullptr,
+            [](WGPURequestDeviceStatus status, WGPUDevice cDevice, char const*, void* userdata) {
+                auto* self = static_cast<SharedMemoryWire*>(userdata);
+                if (status == WGPURequestDeviceStatus_Success) {
+                    self->mDevice = wgpu::Device::Acquire(cDevice);
+                }
+                self->mCallbackDone = true;
+            },
+            this);
+        if (!WaitForCallback() || !mDevice) {
+            mError = "Failed to request the device through the wire.";
+            return;
+        }
+    }
+
+    ~SharedMemoryWire() {
+        if (mServerPid <= 0) {
+            return;
+        }
+        mDevice = nullptr;
+        mAdapter = nullptr;
+        mInstance = nullptr;
+        mC2sSerializer->Flush();
+
+        mControl->stop.store(1, std::memory_order_release);
+        mS2cReader->Close();
+        waitpid(mServerPid, nullptr, 0);
+
+        mWireClient = nullptr;
+        dawnProcSetProcs(&native::GetProcs());
+    }
+
+    // Returns why the wire couldn't be set up, or nullptr if it was.
+    const char* GetError() const { return mError; }
+
+    const wgpu::Device& GetDevice() const { return mDevice; }
+
+    // Sends the pending commands to the server and handles the replies that it published. Returns
+    // false if the replies are invalid or the server process exited.
+    bool Pump() {
+        if (!mC2sSerializer->Flush()) {
+            return false;
+        }
+        if (mS2cReader->HasCommands()) {
+            return mS2cReader->HandleCommands(mWireClient.get());
+        }
+        if (waitpid(mServerPid, nullptr, WNOHANG) != 0) {
+            return false;
+        }
+        std::this_thread::yield();
+        return true;
+    }
+
+    // Pumps the wire until a callback sets mCallbackDone. Returns false if pumping failed first.
+    bool WaitForCallback() {
+        while (!mCallbackDone) {
+            if (!Pump()) {
+                return false;
+            }
+        }
+        mCallbackDone = false;
+        return true;
+    }
+
+  private:
+    [[noreturn]] void RunServer(void* c2sRing,
+                                void* s2cRing,
+                                void* transfer,
+                                uint32_t instanceId,
+                                uint32_t instanceGeneration) {
+        {
+            const DawnProcTable& procs = native::GetProcs();
+            auto instance = std::make_unique<native::Instance>();
+
+            utils::RingBufferCommandReader c2sReader(c2sRing, kRingBufferSize);
+            utils::RingBufferCommandSerializer s2cSerializer(s2cRing, kRingBufferSize);
+            std::unique_ptr<wire::server::MemoryTransferService> serverTransfer;
+            if (transfer != nullptr) {
+                serverTransfer = utils::CreateSharedMemoryServerTransferService(transfer,
+                                                                                kTransferSize);
+            }
+
+            wire::WireServerDescriptor serverDesc = {};
+            serverDesc.procs = &procs;
+            serverDesc.serializer = &s2cSerializer;
+            serverDesc.memoryTransferService = serverTransfer.get();
+            wire::WireServer server(serverDesc);
+            server.InjectInstance(instance->Get(), instanceId, instanceGeneration);
+
+            while (mControl->stop.load(std::memory_order_acquire) == 0) {
+                bool hasCommands = c2sReader.HasCommands();
+                if (hasCommands && !c2sReader.HandleCommands(&server)) {
+                    break;
+                }
+                procs.instanceProcessEvents(instance->Get());
+                if (!s2cSerializer.Flush()) {
+                    break;
+                }
+                if (!hasCommands) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        // Skip the destructors of the objects inherited from the benchmark process.
+        _exit(0);
+    }
+
+    std::unique_ptr<utils::SharedMemoryRegion> mRegion;
+    Control* mControl = nullptr;
+    std::unique_ptr<utils::RingBufferCommandSerializer> mC2sSerializer;
+    std::unique_ptr<utils::RingBufferCommandReader> mS2cReader;
+    std::unique_ptr<wire::client::MemoryTransferService> mClientTransfer;
+    std::unique_ptr<wire::WireClient> mWireClient;
+    pid_t mServerPid = -1;
+    const char* mError = nullptr;
+    bool mCallbackDone = false;
+
+    wgpu::Instance mInstance;
+    wgpu::Adapter mAdapter;
+    wgpu::Device mDevice;
+};
+
+// Maps |buffer| and waits for the mapping to complete. Returns false if it failed.
+bool MapAndWait(SharedMemoryWire* wire, const wgpu::Buffer& buffer, wgpu::MapMode mode) {
+    std::optional<WGPUBufferMapAsyncStatus> status;
+    buffer.MapAsync(
+        mode, 0, wgpu::kWholeMapSize,
+        [](WGPUBufferMapAsyncStatus status, void* userdata) {
+            *static_cast<std::optional<WGPUBufferMapAsyncStatus>*>(userdata) = status;
+        },
+        &status);
+    while (!status.has_value()) {
+        if (!wire->Pump()) {
+            return false;
+        }
+    }
+    return *status == WGPUBufferMapAsyncStatus_Success;
+}
+
+// Measures a round trip of mapping a buffer for writing, filling it and unmapping it, which sends
+// the contents to the server process. Arg 0 picks the inline transfer service that copies the data
+// through the ring buffer, Arg 1 the shared memory transfer service.
+void BM_WireSharedMemory_MapWrite(benchmark::State& state) {
+    SharedMemoryWire wire(state.range(0) != 0);
+    if (wire.GetError() != nullptr) {
+        state.SkipWithError(wire.GetError());
+        return;
+    }
+    const size_t size = state.range(1);
+
+    wgpu::BufferDescriptor desc = {};
+    desc.size = size;
+    desc.usage = wgpu::BufferUsage::MapWrite | wgpu::BufferUsage::CopySrc;
+    wgpu::Buffer buffer = wire.GetDevice().CreateBuffer(&desc);
+
+    uint8_t value = 0;
+    for (auto _ : state) {
+        if (!MapAndWait(&wire, buffer, wgpu::MapMode::Write)) {
+            state.SkipWithError("Failed to map the buffer for writing.");
+            break;
+        }
+        memset(buffer.GetMappedRange(), value++, size);
+        buffer.Unmap();
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_WireSharedMemory_MapWrite)
+    ->ArgNames({"shm", "bytes"})
+    ->ArgsProduct({{0, 1}, {4 * 1024, 256 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024}})
+    ->UseRealTime();
+
+// Measures a round trip of mapping a buffer for reading and reading its contents, which are sent
+// by the server process.
+void BM_WireSharedMemory_MapRead(benchmark::State& state) {
+    SharedMemoryWire wire(state.range(0) != 0);
+    if (wire.GetError() != nullptr) {
+        state.SkipWithError(wire.GetError());
+        return;
+    }
+    const size_t size = state.range(1);
+
+    wgpu::BufferDescriptor desc = {};
+    desc.size = size;
+    desc.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer buffer = wire.GetDevice().CreateBuffer(&desc);
+
+    for (auto _ : state) {
+        if (!MapAndWait(&wire, buffer, wgpu::MapMode::Read)) {
+            state.SkipWithError("Failed to map the buffer for reading.");
+            break;
+        }
+        const uint8_t* data = static_cast<const uint8_t*>(buffer.GetConstMappedRange());
+        benchmark::DoNotOptimize(data[size - 1]);
+        buffer.Unmap();
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_WireSharedMemory_MapRead)
+    ->ArgNames({"shm", "bytes"})
+    ->ArgsProduct({{0, 1}, {4 * 1024, 256 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024}})
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace dawn
@@ -0,0 +1,164 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/WorkerThread.h"
+
+namespace dawn {
+namespace {
+
+// Starts a detached std::thread for every task, like AsyncWorkerThreadPool did before it kept a
+// set of persistent workers. Each task pays for the creation of a thread.
+class ThreadPerTaskPool : public platform::WorkerTaskPool {
+  public:
+    std::unique_ptr<platform::WaitableEvent> PostWorkerTask(
+        platform::PostWorkerTaskCallback callback,
+        void* userdata) override {
+        auto event = std::make_unique<Event>();
+        std::thread([callback, userdata, state = event->state] {
+            callback(userdata);
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->complete = true;
+            }
+            state->condition.notify_all();
+        }).detach();
+        return event;
+    }
+
+  private:
+    struct EventState {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool complete = false;
+    };
+
+    class Event : public platform::WaitableEvent {
+      public:
+        void Wait() override {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->condition.wait(lock, [this] { return state->complete; });
+        }
+        bool IsComplete() override {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            return state->complete;
+        }
+
+        std::shared_ptr<EventState> state = std::make_shared<EventState>();
+    };
+};
+
+std::unique_ptr<platform::WorkerTaskPool> CreatePool(bool persistent) {
+    if (persistent) {
+        return std::make_unique<platform::AsyncWorkerThreadPool>();
+    }
+    return std::make_unique<ThreadPerTaskPool>();
+}
+
+void DoNothing(void*) {}
+
+// Does a small amount of work, roughly the size of a tiny cache write.
+void DoSmallWork(void* userdata) {
+    auto* counter = static_cast<std::atomic<uint64_t>*>(userdata);
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        value = value * 31 + i;
+    }
+    benchmark::DoNotOptimize(value);
+    counter->fetch_add(1, std::memory_order_relaxed);
+}
+
+// Measures the time between posting a single task and seeing it complete. Arg 0 is the baseline
+// thread-per-task pool, Arg 1 is AsyncWorkerThreadPool.
+void BM_WorkerTaskPool_DispatchLatency(benchmark::State& state) {
+    std::unique_ptr<platform::WorkerTaskPool> pool = CreatePool(state.range(0) != 0);
+
+    for (auto _ : state) {
+        pool->PostWorkerTask(DoNothing, nullptr)->Wait();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorkerTaskPool_DispatchLatency)->ArgName("persistent")->Arg(0)->Arg(1);
+
+// Measures the throughput of posting a burst of |range(1)| small tasks and waiting for all of
+// them, like when warming up many pipelines with Create*PipelineAsync.
+void BM_WorkerTaskPool_Throughput(benchmark::State& state) {
+    std::unique_ptr<platform::WorkerTaskPool> pool = CreatePool(state.range(0) != 0);
+    const size_t taskCount = state.range(1);
+
+    std::atomic<uint64_t> counter{0};
+    std::vector<std::unique_ptr<platform::WaitableEvent>> events;
+    events.reserve(taskCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            events.push_back(pool->PostWorkerTask(DoSmallWork, &counter));
+        }
+        for (auto& event : events) {
+            event->Wait();
+        }
+        events.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * taskCount);
+}
+BENCHMARK(BM_WorkerTaskPool_Throughput)
+    ->ArgNames({"persistent", "tasks"})
+    ->Args({0, 64})
+    ->Args({1, 64})
+    ->Args({0, 1024})
+    ->Args({1, 1024})
+    ->UseRealTime();
+
+// Measures posting from many threads at once, which contends on the pool's queues.
+void BM_WorkerTaskPool_ConcurrentPost(benchmark::State& state) {
+    static std::unique_ptr<platform::WorkerTaskPool> pool;
+    if (state.thread_index() == 0) {
+        pool = CreatePool(state.range(0) != 0);
+    }
+
+    constexpr size_t kTaskCount = 64;
+    std::atomic<uint64_t> counter{0};
+    std::vector<std::unique_ptr<platform::WaitableEvent>> events;
+    events.reserve(kTaskCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kTaskCount; ++i) {
+            events.push_back(pool->PostWorkerTask(DoSmallWork, &counter));
+        }
+        for (auto& event : events) {
+            event->Wait();
+        }
+        events.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * kTaskCount);
+
+    if (state.thread_index() == 0) {
+        pool = nullptr;
+    }
+}
+BENCHMARK(BM_WorkerTaskPool_ConcurrentPost)
+    ->ArgName("persistent")
+    ->Arg(0)
+    ->Arg(1)
+    ->Threads(4)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace dawn
@@ -12,8 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <vector>
 
+#include "dawn/native/DawnNative.h"
 #include "dawn/tests/perf_tests/DawnPerfTest.h"
 #include "dawn/utils/WGPUHelpers.h"
 
@@ -21,10 +23,15 @@ namespace dawn {
 namespace {
 
 constexpr unsigned int kNumIterations = 50;
+// Large uploads do fewer iterations per step to bound the staging memory used by a step.
+constexpr uint64_t kMaxBytesPerStep = 1024 * 1024 * 1024;
 
 enum class UploadMethod {
     WriteBuffer,
     MappedAtCreation,
+    // Uploads the data to a texture, which goes through the staging buffers of the device on all
+    // the backends including the null backend.
+    WriteTexture,
 };
 
 // Perf delta exists between ranges [0, 1MB] vs [1MB, MAX_SIZE).
@@ -36,6 +43,10 @@ enum class UploadSize {
 
     BufferSize_4MB = 4 * 1024 * 1024,
     BufferSize_16MB = 16 * 1024 * 1024,
+
+    // Streaming workloads that upload data bigger than the staging ring buffers every frame.
+    BufferSize_32MB = 32 * 1024 * 1024,
+    BufferSize_64MB = 64 * 1024 * 1024,
 };
 
 struct BufferUploadParams : AdapterTestParam {
@@ -58,6 +69,9 @@ std::ostream& operator<<(std::ostream& ostream, const BufferUploadParams& param)
         case UploadMethod::MappedAtCreation:
             ostream << "_MappedAtCreation";
             break;
+        case UploadMethod::WriteTexture:
+            ostream << "_WriteTexture";
+            break;
     }
 
     switch (param.uploadSize) {
@@ -76,25 +90,43 @@ std::ostream& operator<<(std::ostream& ostream, const BufferUploadParams& param)
         case UploadSize::BufferSize_16MB:
             ostream << "_BufferSize_16MB";
             break;
+        case UploadSize::BufferSize_32MB:
+            ostream << "_BufferSize_32MB";
+            break;
+        case UploadSize::BufferSize_64MB:
+            ostream << "_BufferSize_64MB";
+            break;
     }
 
     return ostream;
 }
 
-// Test uploading |kBufferSize| bytes of data |kNumIterations| times.
+unsigned int GetIterationsPerStep(UploadSize uploadSize) {
+    uint64_t iterations = kMaxBytesPerStep / static_cast<uint64_t>(uploadSize);
+    return static_cast<unsigned int>(std::min(iterations, uint64_t(kNumIterations)));
+}
+
+// Test uploading |uploadSize| bytes of data up to |kNumIterations| times per step.
 class BufferUploadPerf : public DawnPerfTestWithParams<BufferUploadParams> {
   public:
     BufferUploadPerf()
-        : DawnPerfTestWithParams(kNumIterations, 1),
+        : DawnPerfTestWithParams(GetIterationsPerStep(GetParam().uploadSize), 1),
+          iterationsPerStep(GetIterationsPerStep(GetParam().uploadSize)),
           data(static_cast<size_t>(GetParam().uploadSize)) {}
     ~BufferUploadPerf() override = default;
 
     void SetUp() override;
 
+    // Returns the statistics of the staging memory of the device.
+    native::StagingMemoryStats GetStagingMemoryStats() const;
+
   private:
     void Step() override;
 
+    const unsigned int iterationsPerStep;
     wgpu::Buffer dst;
+    wgpu::Texture dstTexture;
+    wgpu::Extent3D textureSize;
     std::vector<uint8_t> data;
 };
 
@@ -106,12 +138,27 @@ void BufferUploadPerf::SetUp() {
     desc.usage = wgpu::BufferUsage::CopyDst;
 
     dst = device.CreateBuffer(&desc);
+
+    // An RGBA8 texture of the same size as the data, with rows of at most 16KB.
+    uint32_t texelCount = static_cast<uint32_t>(data.size() / 4);
+    textureSize = {std::min(texelCount, 4096u), 1};
+    textureSize.height = texelCount / textureSize.width;
+
+    wgpu::TextureDescriptor textureDesc = {};
+    textureDesc.size = textureSize;
+    textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    textureDesc.usage = wgpu::TextureUsage::CopyDst;
+    dstTexture = device.CreateTexture(&textureDesc);
+}
+
+native::StagingMemoryStats BufferUploadPerf::GetStagingMemoryStats() const {
+    return native::GetStagingMemoryStats(backendDevice);
 }
 
 void BufferUploadPerf::Step() {
     switch (GetParam().uploadMethod) {
         case UploadMethod::WriteBuffer: {
-            for (unsigned int i = 0; i < kNumIterations; ++i) {
+            for (unsigned int i = 0; i < iterationsPerStep; ++i) {
                 queue.WriteBuffer(dst, 0, data.data(), data.size());
             }
             // Make sure all WriteBuffer's are flushed.
@@ -127,7 +174,7 @@ void BufferUploadPerf::Step() {
 
             wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
 
-            for (unsigned int i = 0; i < kNumIterations; ++i) {
+            for (unsigned int i = 0; i < iterationsPerStep; ++i) {
                 wgpu::Buffer buffer = device.CreateBuffer(&desc);
                 memcpy(buffer.GetMappedRange(0, data.size()), data.data(), data.size());
                 buffer.Unmap();
@@ -138,19 +185,49 @@ void BufferUploadPerf::Step() {
             queue.Submit(1, &commands);
             break;
         }
+
+        case UploadMethod::WriteTexture: {
+            wgpu::ImageCopyTexture destination = utils::CreateImageCopyTexture(dstTexture);
+            wgpu::TextureDataLayout layout =
+                utils::CreateTextureDataLayout(0, textureSize.width * 4, textureSize.height);
+            for (unsigned int i = 0; i < iterationsPerStep; ++i) {
+                queue.WriteTexture(&destination, data.data(), data.size(), &layout,
+                                   &textureSize);
+            }
+            // Make sure all WriteTexture's are flushed.
+            queue.Submit(0, nullptr);
+            break;
+        }
     }
 }
 
 TEST_P(BufferUploadPerf, Run) {
+    native::StagingMemoryStats statsBefore = GetStagingMemoryStats();
     RunTest();
+    native::StagingMemoryStats statsAfter = GetStagingMemoryStats();
+
+    // How often large uploads reuse the staging buffers of the previous ones.
+    PrintResult("staging_buffers_created",
+                static_cast<unsigned int>(statsAfter.stagingBuffersCreated -
+                                          statsBefore.stagingBuffersCreated),
+                "count", false);
+    PrintResult("staging_buffers_reused",
+                static_cast<unsigned int>(statsAfter.stagingBuffersReused -
+                                          statsBefore.stagingBuffersReused),
+                "count", false);
+    PrintResult("staging_ring_buffer_size",
+                static_cast<unsigned int>(statsAfter.ringBufferSize), "bytes", false);
 }
 
 DAWN_INSTANTIATE_TEST_P(BufferUploadPerf,
-                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
-                        {UploadMethod::WriteBuffer, UploadMethod::MappedAtCreation},
+                        {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                         VulkanBackend()},
+                        {UploadMethod::WriteBuffer, UploadMethod::MappedAtCreation,
+                         UploadMethod::WriteTexture},
                         {UploadSize::BufferSize_1KB, UploadSize::BufferSize_64KB,
                          UploadSize::BufferSize_1MB, UploadSize::BufferSize_4MB,
-                         UploadSize::BufferSize_16MB});
+                         UploadSize::BufferSize_16MB, UploadSize::BufferSize_32MB,
+                         UploadSize::BufferSize_64MB});
 
 }  // anonymous namespace
 }  // namespace dawn
@@ -236,6 +236,7 @@ void DawnPerfTestBase::DoRunLoop(double maxRunTime) {
 
     mNumStepsPerformed = 0;
     mCpuTime = 0;
+    mEncodingTime.reset();
     mRunning = true;
 
     uint64_t finishedIterations = 0;
@@ -349,6 +350,9 @@ void DawnPerfTestBase::OutputResults() {
 
     PrintPerIterationResultFromSeconds("wall_time", mTimer->GetElapsedTime(), true);
     PrintPerIterationResultFromSeconds("cpu_time", mCpuTime, true);
+    if (mEncodingTime.has_value()) {
+        PrintPerIterationResultFromSeconds("encoding_time", *mEncodingTime, true);
+    }
     if (mGPUTime.has_value()) {
         PrintPerIterationResultFromSeconds("gpu_time", *mGPUTime, true);
     }
@@ -365,6 +369,10 @@ void DawnPerfTestBase::SetGPUTime(double GPUTime) {
     mGPUTime = GPUTime;
 }
 
+void DawnPerfTestBase::AddEncodingTime(double encodingTime) {
+    mEncodingTime = mEncodingTime.value_or(0.0) + encodingTime;
+}
+
 void DawnPerfTestBase::PrintPerIterationResultFromSeconds(const std::string& trace,
                                                           double valueInSeconds,
                                                           bool important) const {
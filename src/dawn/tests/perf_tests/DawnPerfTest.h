@@ -94,6 +94,10 @@ class DawnPerfTestBase {
                      bool important) const;
     void SetGPUTime(double GPUTime);
 
+    // Adds to the time spent encoding commands in the current run. Only the tests that call it
+    // report the encoding time, per iteration next to the CPU time of whole steps.
+    void AddEncodingTime(double encodingTime);
+
   private:
     void DoRunLoop(double maxRunTime);
     void OutputResults();
@@ -112,6 +116,7 @@ class DawnPerfTestBase {
     unsigned int mStepsToRun = 0;
     unsigned int mNumStepsPerformed = 0;
     double mCpuTime;
+    std::optional<double> mEncodingTime;
     std::unique_ptr<utils::Timer> mTimer;
     std::optional<double> mGPUTime;
 };
@@ -127,7 +132,10 @@ class DawnPerfTestWithParams : public DawnTestWithParams<Params>, public DawnPer
 
         wgpu::AdapterProperties properties;
         this->GetAdapter().GetProperties(&properties);
-        DAWN_TEST_UNSUPPORTED_IF(properties.adapterType == wgpu::AdapterType::CPU);
+        // Software adapters aren't representative of GPU performance, but the Null backend is
+        // useful to measure the CPU overhead of the frontend alone.
+        DAWN_TEST_UNSUPPORTED_IF(properties.adapterType == wgpu::AdapterType::CPU &&
+                                 properties.backendType != wgpu::BackendType::Null);
 
         if (mSupportsTimestampQuery) {
             InitializeGPUTimer();
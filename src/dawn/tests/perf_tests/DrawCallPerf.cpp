@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -20,6 +21,7 @@
 #include "dawn/common/Math.h"
 #include "dawn/tests/perf_tests/DawnPerfTest.h"
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/Timer.h"
 #include "dawn/utils/WGPUHelpers.h"
 
 namespace dawn {
@@ -29,6 +31,7 @@ constexpr unsigned int kNumDraws = 2000;
 
 constexpr uint32_t kTextureSize = 64;
 constexpr size_t kUniformSize = 3 * sizeof(float);
+constexpr uint32_t kNumDynamicBindGroups = 3;
 
 constexpr float kVertexData[12] = {
     0.0f, 0.5f, 0.0f, 1.0f, -0.5f, -0.5f, 0.0f, 1.0f, 0.5f, -0.5f, 0.0f, 1.0f,
@@ -55,6 +58,15 @@ constexpr char kFragmentShaderB[] = R"(
             return vec4f((constant_color + uniform_color) * (1.0 / 5000.0), 1.0);
         })";
 
+constexpr char kFragmentShaderC[] = R"(
+        @group(0) @binding(0) var<uniform> color0 : vec3f;
+        @group(1) @binding(0) var<uniform> color1 : vec3f;
+        @group(2) @binding(0) var<uniform> color2 : vec3f;
+
+        @fragment fn main() -> @location(0) vec4f {
+            return vec4f((color0 + color1 + color2) * (1.0 / 5000.0), 1.0);
+        })";
+
 enum class Pipeline {
     Static,     // Keep the same pipeline for all draws.
     Redundant,  // Use the same pipeline, but redundantly set it.
@@ -67,11 +79,12 @@ enum class UniformData {
 };
 
 enum class BindGroup {
-    NoChange,   // Use one bind group for all draws.
-    Redundant,  // Use the same bind group, but redundantly set it.
-    NoReuse,    // Create a new bind group every time.
-    Multiple,   // Use multiple static bind groups.
-    Dynamic,    // Use bind groups with dynamic offsets.
+    NoChange,         // Use one bind group for all draws.
+    Redundant,        // Use the same bind group, but redundantly set it.
+    NoReuse,          // Create a new bind group every time.
+    Multiple,         // Use multiple static bind groups.
+    Dynamic,          // Use bind groups with dynamic offsets.
+    MultipleDynamic,  // Keep several bind groups with dynamic offsets, only change the offsets.
 };
 
 enum class VertexBuffer {
@@ -175,6 +188,9 @@ std::ostream& operator<<(std::ostream& ostream, const DrawCallParamForTest& test
         case BindGroup::Dynamic:
             ostream << "_DynamicBindGroup";
             break;
+        case BindGroup::MultipleDynamic:
+            ostream << "_MultipleDynamicBindGroups";
+            break;
     }
 
     switch (param.uniformDataType) {
@@ -204,6 +220,8 @@ std::ostream& operator<<(std::ostream& ostream, const DrawCallParamForTest& test
 //   - Static/Multiple/Dynamic vertex buffers: Tests switching buffer bindings. This has
 //     a state tracking cost as well as a GPU driver cost.
 //   - Static/Multiple/Dynamic bind groups: Same rationale as vertex buffers
+//   - Multiple dynamic bind groups: Only the dynamic offsets change between draws, which is
+//     the common case for per-draw uniforms and should only revalidate the offsets.
 //   - Static/Dynamic pipelines: In addition to a change to GPU state, changing the pipeline
 //     layout incurs additional state tracking costs in Dawn.
 //   - With/Without render bundles: All of the above can have lower validation costs if
@@ -251,6 +269,8 @@ class DrawCallPerf : public DawnPerfTestWithParams<DrawCallParamForTest> {
     wgpu::TextureView mDepthStencilAttachment;
 
     wgpu::RenderBundle mRenderBundle;
+
+    std::unique_ptr<utils::Timer> mEncodingTimer{utils::CreateTimer()};
 };
 
 void DrawCallPerf::SetUp() {
@@ -322,6 +342,7 @@ void DrawCallPerf::SetUp() {
             break;
 
         case BindGroup::Dynamic:
+        case BindGroup::MultipleDynamic:
             mUniformBindGroupLayout = utils::MakeBindGroupLayout(
                 device,
                 {
@@ -343,15 +364,24 @@ void DrawCallPerf::SetUp() {
     renderPipelineDesc.EnableDepthStencil(wgpu::TextureFormat::Depth24PlusStencil8);
     renderPipelineDesc.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
 
-    // Create the pipeline layout for the first pipeline.
+    // Create the pipeline layout for the first pipeline. With multiple dynamic bind groups, the
+    // uniform bind group layout is used at every index.
+    wgpu::BindGroupLayout dynamicBindGroupLayouts[kNumDynamicBindGroups] = {
+        mUniformBindGroupLayout, mUniformBindGroupLayout, mUniformBindGroupLayout};
     wgpu::PipelineLayoutDescriptor pipelineLayoutDesc = {};
     pipelineLayoutDesc.bindGroupLayouts = &mUniformBindGroupLayout;
     pipelineLayoutDesc.bindGroupLayoutCount = 1;
+    if (GetParam().bindGroupType == BindGroup::MultipleDynamic) {
+        pipelineLayoutDesc.bindGroupLayouts = dynamicBindGroupLayouts;
+        pipelineLayoutDesc.bindGroupLayoutCount = kNumDynamicBindGroups;
+    }
     wgpu::PipelineLayout pipelineLayout = device.CreatePipelineLayout(&pipelineLayoutDesc);
 
     // Create the shaders for the first pipeline.
     wgpu::ShaderModule vsModule = utils::CreateShaderModule(device, kVertexShader);
-    wgpu::ShaderModule fsModule = utils::CreateShaderModule(device, kFragmentShaderA);
+    wgpu::ShaderModule fsModule = utils::CreateShaderModule(
+        device, GetParam().bindGroupType == BindGroup::MultipleDynamic ? kFragmentShaderC
+                                                                       : kFragmentShaderA);
 
     // Create the first pipeline.
     renderPipelineDesc.layout = pipelineLayout;
@@ -433,6 +463,18 @@ void DrawCallPerf::SetUp() {
             mUniformBindGroups[0] = utils::MakeBindGroup(
                 device, mUniformBindGroupLayout, {{0, mUniformBuffers[0], 0, kUniformSize}});
             break;
+
+        case BindGroup::MultipleDynamic:
+            mUniformBuffers[0] = utils::CreateBufferFromData(
+                device, mUniformBufferData.data(), mUniformBufferData.size() * sizeof(float),
+                wgpu::BufferUsage::Uniform);
+
+            for (uint32_t i = 0; i < kNumDynamicBindGroups; ++i) {
+                mUniformBindGroups[i] = utils::MakeBindGroup(
+                    device, mUniformBindGroupLayout, {{0, mUniformBuffers[0], 0, kUniformSize}});
+            }
+            break;
+
         default:
             UNREACHABLE();
             break;
@@ -473,6 +515,11 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
         pass.SetBindGroup(uniformBindGroupIndex, mUniformBindGroups[0]);
     }
 
+    if (GetParam().bindGroupType == BindGroup::MultipleDynamic) {
+        // The pipeline layout uses all the bind group indices.
+        ASSERT(GetParam().pipelineType == Pipeline::Static);
+    }
+
     for (unsigned int i = 0; i < kNumDraws; ++i) {
         switch (GetParam().pipelineType) {
             case Pipeline::Static:
@@ -534,6 +581,14 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
                 break;
             }
 
+            case BindGroup::MultipleDynamic: {
+                uint32_t dynamicOffset = static_cast<uint32_t>(i * mAlignedUniformSize);
+                for (uint32_t group = 0; group < kNumDynamicBindGroups; ++group) {
+                    pass.SetBindGroup(group, mUniformBindGroups[group], 1, &dynamicOffset);
+                }
+                break;
+            }
+
             default:
                 UNREACHABLE();
                 break;
@@ -563,12 +618,14 @@ void DrawCallPerf::Step() {
                 }
                 break;
             case BindGroup::Dynamic:
+            case BindGroup::MultipleDynamic:
                 queue.WriteBuffer(mUniformBuffers[0], 0, mUniformBufferData.data(),
                                   mUniformBufferData.size() * sizeof(float));
                 break;
         }
     }
 
+    double encodingStart = mEncodingTimer->GetAbsoluteTime();
     wgpu::CommandEncoder commands = device.CreateCommandEncoder();
     utils::ComboRenderPassDescriptor renderPass({mColorAttachment}, mDepthStencilAttachment);
     wgpu::RenderPassEncoder pass = commands.BeginRenderPass(&renderPass);
@@ -587,6 +644,8 @@ void DrawCallPerf::Step() {
 
     pass.End();
     wgpu::CommandBuffer commandBuffer = commands.Finish();
+    AddEncodingTime(mEncodingTimer->GetAbsoluteTime() - encodingStart);
+
     queue.Submit(1, &commandBuffer);
 }
 
@@ -596,7 +655,7 @@ TEST_P(DrawCallPerf, Run) {
 
 DAWN_INSTANTIATE_TEST_P(
     DrawCallPerf,
-    {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend(),
+    {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(), VulkanBackend(),
      VulkanBackend({"skip_validation"})},
     {
         // Baseline
@@ -607,9 +666,10 @@ DAWN_INSTANTIATE_TEST_P(
         MakeParam(VertexBuffer::Dynamic),   // Dynamic vertex buffer
 
         // Change bind group binding
-        MakeParam(BindGroup::Multiple),  // Multiple bind groups
-        MakeParam(BindGroup::Dynamic),   // Dynamic bind groups
-        MakeParam(BindGroup::NoReuse),   // New bind group per-draw
+        MakeParam(BindGroup::Multiple),         // Multiple bind groups
+        MakeParam(BindGroup::Dynamic),          // Dynamic bind groups
+        MakeParam(BindGroup::NoReuse),          // New bind group per-draw
+        MakeParam(BindGroup::MultipleDynamic),  // Only change dynamic offsets
 
         // Redundantly set pipeline / bind groups
         MakeParam(Pipeline::Redundant, BindGroup::Redundant),
@@ -0,0 +1,139 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kNumIterations = 10;
+
+// The number of render passes encoded in each frame.
+constexpr uint32_t kRenderPassesPerFrame = 4;
+
+struct FrameEncodingParams : AdapterTestParam {
+    FrameEncodingParams(const AdapterTestParam& param, uint32_t drawCountIn)
+        : AdapterTestParam(param), drawCount(drawCountIn) {}
+    uint32_t drawCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const FrameEncodingParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_draws_" << param.drawCount;
+    return ostream;
+}
+
+// Test the steady-state cost of encoding and submitting the same kind of frame over and over, like
+// a renderer does. Each frame is a command buffer with a few render passes that set a pipeline, a
+// vertex buffer and a bind group with a different dynamic offset for every draw. Next to the CPU
+// time, the test reports the number of command blocks allocated per frame after the first frame,
+// which should tend to zero as the device recycles the command blocks of the previous frames'
+// command buffers.
+class FrameEncodingPerf : public DawnPerfTestWithParams<FrameEncodingParams> {
+  public:
+    FrameEncodingPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~FrameEncodingPerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    // The command blocks allocated per frame, excluding the first frame.
+    double GetCommandBlockAllocationsPerFrame() const;
+
+  private:
+    void Step() override;
+
+    wgpu::RenderPipeline mPipeline;
+    wgpu::Buffer mVertexBuffer;
+    wgpu::BindGroup mBindGroup;
+    wgpu::TextureView mAttachment;
+
+    uint64_t mStepCount = 0;
+    uint64_t mInitialCommandBlockCount = 0;
+    uint64_t mCommandBlockCount = 0;
+};
+
+void FrameEncodingPerf::SetUp() {
+    DawnPerfTestWithParams<FrameEncodingParams>::SetUp();
+
+    utils::DynamicOffsetPipeline dynamicOffsetPipeline = utils::CreateDynamicOffsetPipeline(device);
+    mPipeline = dynamicOffsetPipeline.pipeline;
+
+    mVertexBuffer = utils::CreateBufferFromData(device, wgpu::BufferUsage::Vertex,
+                                                {0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
+                                                 0.0f, 1.0f, 0.0f, 1.0f});
+
+    wgpu::BufferDescriptor uniformDesc;
+    uniformDesc.size = 256 * 16;
+    uniformDesc.usage = wgpu::BufferUsage::Uniform;
+    wgpu::Buffer uniforms = device.CreateBuffer(&uniformDesc);
+    mBindGroup =
+        utils::MakeBindGroup(device, dynamicOffsetPipeline.bindGroupLayout, {{0, uniforms, 0, 16}});
+
+    wgpu::TextureDescriptor attachmentDesc;
+    attachmentDesc.size = {1, 1, 1};
+    attachmentDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    attachmentDesc.usage = wgpu::TextureUsage::RenderAttachment;
+    mAttachment = device.CreateTexture(&attachmentDesc).CreateView();
+}
+
+void FrameEncodingPerf::Step() {
+    // The first frame warms up the device's pools.
+    if (mStepCount == 1) {
+        mInitialCommandBlockCount = native::GetAllocatedCommandBlockCountForTesting(backendDevice);
+    }
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i < kRenderPassesPerFrame; ++i) {
+        utils::ComboRenderPassDescriptor renderPass({mAttachment});
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(mPipeline);
+        pass.SetVertexBuffer(0, mVertexBuffer);
+        for (uint32_t draw = 0; draw < GetParam().drawCount; ++draw) {
+            uint32_t dynamicOffset = (draw % 16) * 256;
+            pass.SetBindGroup(0, mBindGroup, 1, &dynamicOffset);
+            pass.Draw(3);
+        }
+        pass.End();
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+    commands = nullptr;
+
+    if (mStepCount > 0) {
+        mCommandBlockCount = native::GetAllocatedCommandBlockCountForTesting(backendDevice) -
+                             mInitialCommandBlockCount;
+    }
+    mStepCount++;
+}
+
+double FrameEncodingPerf::GetCommandBlockAllocationsPerFrame() const {
+    return mStepCount > 1 ? static_cast<double>(mCommandBlockCount) / (mStepCount - 1) : 0.0;
+}
+
+TEST_P(FrameEncodingPerf, Run) {
+    RunTest();
+    PrintResult("command_block_allocations_per_frame", GetCommandBlockAllocationsPerFrame(),
+                "count", true);
+}
+
+DAWN_INSTANTIATE_TEST_P(FrameEncodingPerf,
+                        {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                         VulkanBackend()},
+                        {16, 256});
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,125 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+struct PassResourceTrackingParams : AdapterTestParam {
+    PassResourceTrackingParams(const AdapterTestParam& param, uint32_t resourceCountIn)
+        : AdapterTestParam(param), resourceCount(resourceCountIn) {}
+    uint32_t resourceCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const PassResourceTrackingParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_resources_" << param.resourceCount;
+    return ostream;
+}
+
+// Test the performance of tracking the usage of many unique resources in a single render pass.
+// Half of the resources are uniform buffers and half are sampled textures, each bind group binds
+// one of each and is used for a single draw. This stresses the SyncScopeUsageTracker and the
+// validation of the pass usages in Finish and Submit, which dominate the CPU time of passes that
+// bind hundreds of resources.
+class PassResourceTrackingPerf : public DawnPerfTestWithParams<PassResourceTrackingParams> {
+  public:
+    static constexpr unsigned int kNumIterations = 50;
+
+    PassResourceTrackingPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~PassResourceTrackingPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<PassResourceTrackingParams>::SetUp();
+        const uint32_t bindGroupCount = GetParam().resourceCount / 2;
+
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @vertex fn main() -> @builtin(position) vec4f {
+                return vec4f(1.0, 0.0, 0.0, 1.0);
+            }
+        )");
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var<uniform> color : vec4f;
+            @group(0) @binding(1) var tex : texture_2d<f32>;
+            @fragment fn main() -> @location(0) vec4f {
+                return color + textureLoad(tex, vec2i(0), 0);
+            }
+        )");
+        mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 16;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+
+        wgpu::TextureDescriptor textureDesc;
+        textureDesc.size = {1, 1, 1};
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        textureDesc.usage = wgpu::TextureUsage::TextureBinding;
+
+        mBindGroups.reserve(bindGroupCount);
+        for (uint32_t i = 0; i < bindGroupCount; ++i) {
+            wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+            wgpu::Texture texture = device.CreateTexture(&textureDesc);
+            mBindGroups.push_back(utils::MakeBindGroup(device, mPipeline.GetBindGroupLayout(0),
+                                                       {{0, buffer}, {1, texture.CreateView()}}));
+        }
+
+        wgpu::TextureDescriptor attachmentDesc;
+        attachmentDesc.size = {1, 1, 1};
+        attachmentDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        attachmentDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        mAttachment = device.CreateTexture(&attachmentDesc).CreateView();
+    }
+
+  private:
+    void Step() override {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (unsigned int i = 0; i < kNumIterations; ++i) {
+            utils::ComboRenderPassDescriptor renderPass({mAttachment});
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+            pass.SetPipeline(mPipeline);
+            for (const wgpu::BindGroup& bindGroup : mBindGroups) {
+                pass.SetBindGroup(0, bindGroup);
+                pass.Draw(3);
+            }
+            pass.End();
+        }
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::RenderPipeline mPipeline;
+    std::vector<wgpu::BindGroup> mBindGroups;
+    wgpu::TextureView mAttachment;
+};
+
+TEST_P(PassResourceTrackingPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(PassResourceTrackingPerf,
+                        {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                         VulkanBackend()},
+                        {10, 100, 1000});
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,173 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/Timer.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kReplaysPerPass = 1000;
+constexpr uint32_t kDrawsPerReplay = 8;
+
+enum class Replay {
+    Bundle,  // Each replay executes one of the render bundles.
+    Direct,  // Each replay encodes the commands of one of the render bundles in the pass.
+};
+
+struct RenderBundleReplayParams : AdapterTestParam {
+    RenderBundleReplayParams(const AdapterTestParam& param, Replay replayIn, uint32_t bundleCountIn)
+        : AdapterTestParam(param), replay(replayIn), bundleCount(bundleCountIn) {}
+    Replay replay;
+    uint32_t bundleCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const RenderBundleReplayParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    switch (param.replay) {
+        case Replay::Bundle:
+            ostream << "_RenderBundle";
+            break;
+        case Replay::Direct:
+            ostream << "_Direct";
+            break;
+    }
+    ostream << "_bundles_" << param.bundleCount;
+    return ostream;
+}
+
+// Test the cost of replaying a small set of render bundles many times in a render pass, compared
+// to encoding the same commands directly. Each bundle sets a pipeline and does a few draws with
+// their own bind group. This is the pattern of renderers that prerecord the draws of static
+// geometry, and it stresses the merging of the bundles' resource usages into the pass.
+class RenderBundleReplayPerf : public DawnPerfTestWithParams<RenderBundleReplayParams> {
+  public:
+    RenderBundleReplayPerf() : DawnPerfTestWithParams(kReplaysPerPass, 1) {}
+    ~RenderBundleReplayPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    // Encodes the commands of the |index|-th bundle.
+    template <typename Encoder>
+    void EncodeReplay(Encoder encoder, uint32_t index);
+
+    wgpu::RenderPipeline mPipeline;
+    std::vector<wgpu::BindGroup> mBindGroups;
+    std::vector<wgpu::RenderBundle> mRenderBundles;
+    wgpu::TextureView mAttachment;
+
+    std::unique_ptr<utils::Timer> mEncodingTimer{utils::CreateTimer()};
+};
+
+void RenderBundleReplayPerf::SetUp() {
+    DawnPerfTestWithParams<RenderBundleReplayParams>::SetUp();
+    const RenderBundleReplayParams& params = GetParam();
+
+    utils::ComboRenderPipelineDescriptor pipelineDesc;
+    pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<uniform> position : vec4f;
+        @vertex fn main() -> @builtin(position) vec4f {
+            return position;
+        }
+    )");
+    pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+        @fragment fn main() -> @location(0) vec4f {
+            return vec4f(1.0, 0.0, 0.0, 1.0);
+        }
+    )");
+    pipelineDesc.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+    mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = 16;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform;
+    for (uint32_t i = 0; i < params.bundleCount * kDrawsPerReplay; ++i) {
+        wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+        mBindGroups.push_back(
+            utils::MakeBindGroup(device, mPipeline.GetBindGroupLayout(0), {{0, buffer}}));
+    }
+
+    if (params.replay == Replay::Bundle) {
+        wgpu::TextureFormat colorFormat = wgpu::TextureFormat::RGBA8Unorm;
+        wgpu::RenderBundleEncoderDescriptor bundleDesc;
+        bundleDesc.colorFormatsCount = 1;
+        bundleDesc.colorFormats = &colorFormat;
+        for (uint32_t i = 0; i < params.bundleCount; ++i) {
+            wgpu::RenderBundleEncoder encoder = device.CreateRenderBundleEncoder(&bundleDesc);
+            EncodeReplay(encoder, i);
+            mRenderBundles.push_back(encoder.Finish());
+        }
+    }
+
+    wgpu::TextureDescriptor attachmentDesc;
+    attachmentDesc.size = {1, 1, 1};
+    attachmentDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    attachmentDesc.usage = wgpu::TextureUsage::RenderAttachment;
+    mAttachment = device.CreateTexture(&attachmentDesc).CreateView();
+}
+
+template <typename Encoder>
+void RenderBundleReplayPerf::EncodeReplay(Encoder encoder, uint32_t index) {
+    encoder.SetPipeline(mPipeline);
+    for (uint32_t i = 0; i < kDrawsPerReplay; ++i) {
+        encoder.SetBindGroup(0, mBindGroups[index * kDrawsPerReplay + i]);
+        encoder.Draw(3);
+    }
+}
+
+void RenderBundleReplayPerf::Step() {
+    const RenderBundleReplayParams& params = GetParam();
+
+    double encodingStart = mEncodingTimer->GetAbsoluteTime();
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    utils::ComboRenderPassDescriptor renderPass({mAttachment});
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+    for (unsigned int i = 0; i < kReplaysPerPass; ++i) {
+        uint32_t index = i % params.bundleCount;
+        switch (params.replay) {
+            case Replay::Bundle:
+                pass.ExecuteBundles(1, &mRenderBundles[index]);
+                break;
+            case Replay::Direct:
+                EncodeReplay(pass, index);
+                break;
+        }
+    }
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    AddEncodingTime(mEncodingTimer->GetAbsoluteTime() - encodingStart);
+
+    queue.Submit(1, &commands);
+}
+
+TEST_P(RenderBundleReplayPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(RenderBundleReplayPerf,
+                        {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                         VulkanBackend()},
+                        {Replay::Bundle, Replay::Direct},
+                        {1, 8, 64});
+
+}  // anonymous namespace
+}  // namespace dawn
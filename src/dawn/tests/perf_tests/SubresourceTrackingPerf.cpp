@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include "dawn/tests/perf_tests/DawnPerfTest.h"
 
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
@@ -20,21 +22,40 @@
 namespace dawn {
 namespace {
 
+enum class Scenario {
+    // Uploads a single layer and generates its mipmaps.
+    SingleLayerMips,
+    // Uploads a cluster of layers that moves through the array each step, then samples the whole
+    // array, like streaming the pages of a large texture atlas.
+    StreamedCluster,
+};
+
 struct SubresourceTrackingParams : AdapterTestParam {
     SubresourceTrackingParams(const AdapterTestParam& param,
                               uint32_t arrayLayerCountIn,
-                              uint32_t mipLevelCountIn)
+                              uint32_t mipLevelCountIn,
+                              Scenario scenarioIn)
         : AdapterTestParam(param),
           arrayLayerCount(arrayLayerCountIn),
-          mipLevelCount(mipLevelCountIn) {}
+          mipLevelCount(mipLevelCountIn),
+          scenario(scenarioIn) {}
     uint32_t arrayLayerCount;
     uint32_t mipLevelCount;
+    Scenario scenario;
 };
 
 std::ostream& operator<<(std::ostream& ostream, const SubresourceTrackingParams& param) {
     ostream << static_cast<const AdapterTestParam&>(param);
     ostream << "_arrayLayer_" << param.arrayLayerCount;
     ostream << "_mipLevel_" << param.mipLevelCount;
+    switch (param.scenario) {
+        case Scenario::SingleLayerMips:
+            ostream << "_singleLayerMips";
+            break;
+        case Scenario::StreamedCluster:
+            ostream << "_streamedCluster";
+            break;
+    }
     return ostream;
 }
 
@@ -42,16 +63,26 @@ std::ostream& operator<<(std::ostream& ostream, const SubresourceTrackingParams&
 // difficult. It uses a 2D array texture with mipmaps and updates one of the layers with data from
 // another texture, then generates mipmaps for that layer. It is difficult because it requires
 // tracking the state of individual subresources in the middle of the subresources of that texture.
+// The StreamedCluster scenario instead stresses the tracking of runs of layers in large arrays.
 class SubresourceTrackingPerf : public DawnPerfTestWithParams<SubresourceTrackingParams> {
   public:
     static constexpr unsigned int kNumIterations = 50;
+    static constexpr uint32_t kClusterLayerCount = 16;
 
     SubresourceTrackingPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
     ~SubresourceTrackingPerf() override = default;
 
+    wgpu::RequiredLimits GetRequiredLimits(const wgpu::SupportedLimits& supported) override {
+        wgpu::RequiredLimits required = {};
+        required.limits.maxTextureArrayLayers = supported.limits.maxTextureArrayLayers;
+        return required;
+    }
+
     void SetUp() override {
         DawnPerfTestWithParams<SubresourceTrackingParams>::SetUp();
         const SubresourceTrackingParams& params = GetParam();
+        DAWN_TEST_UNSUPPORTED_IF(params.arrayLayerCount >
+                                 GetSupportedLimits().limits.maxTextureArrayLayers);
 
         wgpu::TextureDescriptor materialDesc;
         materialDesc.dimension = wgpu::TextureDimension::e2D;
@@ -64,7 +95,7 @@ class SubresourceTrackingPerf : public DawnPerfTestWithParams<SubresourceTrackin
         mMaterials = device.CreateTexture(&materialDesc);
 
         wgpu::TextureDescriptor uploadTexDesc = materialDesc;
-        uploadTexDesc.size.depthOrArrayLayers = 1;
+        uploadTexDesc.size.depthOrArrayLayers = GetUploadLayerCount();
         uploadTexDesc.mipLevelCount = 1;
         uploadTexDesc.usage = wgpu::TextureUsage::CopySrc;
         mUploadTexture = device.CreateTexture(&uploadTexDesc);
@@ -83,10 +114,44 @@ class SubresourceTrackingPerf : public DawnPerfTestWithParams<SubresourceTrackin
             }
         )");
         mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var materials : texture_2d_array<f32>;
+            @fragment fn main() -> @location(0) vec4f {
+                _ = materials;
+                return vec4f(1.0, 0.0, 0.0, 1.0);
+            }
+        )");
+        mArrayPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        wgpu::TextureDescriptor renderTargetDesc;
+        renderTargetDesc.size = {1, 1, 1};
+        renderTargetDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        renderTargetDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        mRenderTarget = device.CreateTexture(&renderTargetDesc);
     }
 
   private:
+    uint32_t GetUploadLayerCount() const {
+        const SubresourceTrackingParams& params = GetParam();
+        if (params.scenario == Scenario::StreamedCluster) {
+            return std::min(kClusterLayerCount, params.arrayLayerCount);
+        }
+        return 1;
+    }
+
     void Step() override {
+        switch (GetParam().scenario) {
+            case Scenario::SingleLayerMips:
+                StepSingleLayerMips();
+                break;
+            case Scenario::StreamedCluster:
+                StepStreamedCluster();
+                break;
+        }
+    }
+
+    void StepSingleLayerMips() {
         const SubresourceTrackingParams& params = GetParam();
 
         uint32_t layerUploaded = params.arrayLayerCount / 2;
@@ -137,9 +202,57 @@ class SubresourceTrackingPerf : public DawnPerfTestWithParams<SubresourceTrackin
         queue.Submit(1, &commands);
     }
 
+    void StepStreamedCluster() {
+        const SubresourceTrackingParams& params = GetParam();
+
+        uint32_t clusterLayerCount = GetUploadLayerCount();
+        uint32_t clusterCount = params.arrayLayerCount / clusterLayerCount;
+        uint32_t firstLayer = (mStepIndex++ % clusterCount) * clusterLayerCount;
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+
+        // Copy into the top level of the cluster of layers, the other levels keep their state.
+        {
+            wgpu::ImageCopyTexture sourceView;
+            sourceView.texture = mUploadTexture;
+
+            wgpu::ImageCopyTexture destView;
+            destView.texture = mMaterials;
+            destView.origin.z = firstLayer;
+
+            wgpu::Extent3D copySize = {1u << (params.mipLevelCount - 1),
+                                       1u << (params.mipLevelCount - 1), clusterLayerCount};
+
+            encoder.CopyTextureToTexture(&sourceView, &destView, &copySize);
+        }
+
+        // Sample the whole array, which transitions all the layers back to the same usage.
+        {
+            wgpu::TextureViewDescriptor sampleViewDesc;
+            sampleViewDesc.dimension = wgpu::TextureViewDimension::e2DArray;
+            wgpu::TextureView sampleView = mMaterials.CreateView(&sampleViewDesc);
+
+            wgpu::BindGroup bindgroup = utils::MakeBindGroup(
+                device, mArrayPipeline.GetBindGroupLayout(0), {{0, sampleView}});
+
+            utils::ComboRenderPassDescriptor renderPass({mRenderTarget.CreateView()});
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+            pass.SetPipeline(mArrayPipeline);
+            pass.SetBindGroup(0, bindgroup);
+            pass.Draw(3);
+            pass.End();
+        }
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
     wgpu::Texture mUploadTexture;
     wgpu::Texture mMaterials;
+    wgpu::Texture mRenderTarget;
     wgpu::RenderPipeline mPipeline;
+    wgpu::RenderPipeline mArrayPipeline;
+    uint32_t mStepIndex = 0;
 };
 
 TEST_P(SubresourceTrackingPerf, Run) {
@@ -147,9 +260,11 @@ TEST_P(SubresourceTrackingPerf, Run) {
 }
 
 DAWN_INSTANTIATE_TEST_P(SubresourceTrackingPerf,
-                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
-                        {1, 4, 16, 256},
-                        {2, 3, 8});
+                        {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                         VulkanBackend()},
+                        {1, 4, 16, 256, 2048},
+                        {2, 3, 8},
+                        {Scenario::SingleLayerMips, Scenario::StreamedCluster});
 
 }  // anonymous namespace
 }  // namespace dawn
@@ -25,6 +25,7 @@
 #include "dawn/common/NonCopyable.h"
 #include "dawn/native/AsyncTask.h"
 #include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/WorkerThread.h"
 #include "gtest/gtest.h"
 
 namespace dawn {
@@ -90,5 +91,35 @@ TEST_F(AsyncTaskTest, Basic) {
     ASSERT_TRUE(idset.empty());
 }
 
+// Test posting many more tasks than there are workers in the pool, including tasks that are
+// posted from the worker threads themselves.
+TEST_F(AsyncTaskTest, MoreTasksThanWorkers) {
+    platform::AsyncWorkerThreadPool pool(2);
+    native::AsyncTaskManager taskManager(&pool);
+    ConcurrentTaskResultQueue taskResultQueue;
+
+    constexpr uint32_t kTaskCount = 64u;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        taskManager.PostTask([&taskResultQueue, &taskManager, i] {
+            DoTask(&taskResultQueue, 2 * i);
+            taskManager.PostTask([&taskResultQueue, i] { DoTask(&taskResultQueue, 2 * i + 1); });
+        });
+    }
+
+    // The nested tasks are posted while the outer ones run, so wait until all of them are done.
+    while (taskManager.HasPendingTasks()) {
+        taskManager.WaitAllPendingTasks();
+    }
+
+    std::vector<std::unique_ptr<SimpleTaskResult>> results = taskResultQueue.GetAllResults();
+    ASSERT_EQ(2 * kTaskCount, results.size());
+    std::set<uint32_t> idset;
+    for (std::unique_ptr<SimpleTaskResult>& result : results) {
+        idset.insert(result->id);
+    }
+    ASSERT_EQ(2 * kTaskCount, idset.size());
+    EXPECT_LE(pool.GetStartedWorkerCount(), 2u);
+}
+
 }  // anonymous namespace
 }  // namespace dawn
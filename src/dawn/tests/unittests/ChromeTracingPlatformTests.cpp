@@ -0,0 +1,236 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dawn/platform/tracing/ChromeTracingPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
+#include "gtest/gtest.h"
+
+namespace dawn::platform {
+namespace {
+
+struct ParsedEvent {
+    std::string name;
+    std::string category;
+    char phase;
+    uint32_t tid;
+};
+
+// Returns the raw value of |key| in a single line event written by ChromeTracingPlatform.
+std::string GetField(const std::string& line, const std::string& key) {
+    std::string pattern = "\"" + key + "\":";
+    size_t start = line.find(pattern);
+    if (start == std::string::npos) {
+        return "";
+    }
+    start += pattern.size();
+    size_t end =
+        line[start] == '"' ? line.find('"', start + 1) + 1 : line.find_first_of(",}", start);
+    return line.substr(start, end - start);
+}
+
+std::string Unquote(const std::string& value) {
+    return value.size() >= 2 ? value.substr(1, value.size() - 2) : value;
+}
+
+class ChromeTracingPlatformTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        const testing::TestInfo* info = testing::UnitTest::GetInstance()->current_test_info();
+        mPath = testing::TempDir() + "dawn_chrome_trace_" + info->name() + ".json";
+    }
+
+    void TearDown() override { remove(mPath.c_str()); }
+
+    // Adds an event like the TRACE_EVENT macros do. The macros aren't used because they cache the
+    // category flags of the first platform used at each call site.
+    static void AddEvent(Platform* platform, char phase, TraceCategory category, const char* name) {
+        const unsigned char* categoryEnabled = platform->GetTraceCategoryEnabledFlag(category);
+        if (*categoryEnabled) {
+            platform->AddTraceEvent(phase, categoryEnabled, name, 0,
+                                    platform->MonotonicallyIncreasingTime(), 0, nullptr, nullptr,
+                                    nullptr, TRACE_EVENT_FLAG_NONE);
+        }
+    }
+
+    // Parses the trace file, checking that it is a well-formed JSON array of events.
+    std::vector<ParsedEvent> ReadEvents() {
+        std::ifstream file(mPath);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(line);
+        }
+
+        std::vector<ParsedEvent> events;
+        EXPECT_GE(lines.size(), 2u);
+        if (lines.size() < 2) {
+            return events;
+        }
+        EXPECT_EQ(lines.front(), "{\"traceEvents\":[");
+        EXPECT_EQ(lines.back(), "]}");
+        for (size_t i = 1; i + 1 < lines.size(); ++i) {
+            const std::string& line = lines[i];
+            bool isLast = i + 2 == lines.size();
+            EXPECT_EQ(line.front(), '{');
+            EXPECT_EQ(line.back(), isLast ? '}' : ',');
+
+            ParsedEvent event;
+            event.name = Unquote(GetField(line, "name"));
+            event.category = Unquote(GetField(line, "cat"));
+            std::string phase = Unquote(GetField(line, "ph"));
+            EXPECT_EQ(phase.size(), 1u);
+            event.phase = phase.empty() ? '\0' : phase[0];
+            event.tid = std::stoul(GetField(line, "tid"));
+            EXPECT_FALSE(GetField(line, "ts").empty());
+            events.push_back(event);
+        }
+        return events;
+    }
+
+    // Checks that the BEGIN and END events of each thread are correctly nested, and returns the
+    // number of complete scopes per thread.
+    static std::map<uint32_t, uint32_t> CheckNesting(const std::vector<ParsedEvent>& events) {
+        std::map<uint32_t, std::vector<std::string>> stacks;
+        std::map<uint32_t, uint32_t> scopeCounts;
+        for (const ParsedEvent& event : events) {
+            std::vector<std::string>& stack = stacks[event.tid];
+            if (event.phase == TRACE_EVENT_PHASE_BEGIN) {
+                stack.push_back(event.name);
+            } else if (event.phase == TRACE_EVENT_PHASE_END) {
+                EXPECT_FALSE(stack.empty());
+                if (!stack.empty()) {
+                    EXPECT_EQ(stack.back(), event.name);
+                    stack.pop_back();
+                    scopeCounts[event.tid]++;
+                }
+            }
+        }
+        for (const auto& [tid, stack] : stacks) {
+            EXPECT_TRUE(stack.empty()) << "Unterminated scopes on thread " << tid;
+        }
+        return scopeCounts;
+    }
+
+    std::string mPath;
+};
+
+// Test that the events recorded concurrently by multiple threads are all written, in well-formed
+// JSON, with the scopes of each thread correctly nested.
+TEST_F(ChromeTracingPlatformTests, MultipleThreadsNested) {
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kIterations = 1000;
+
+    ChromeTracingPlatformOptions options;
+    options.flushIntervalMs = 1;
+    std::unique_ptr<ChromeTracingPlatform> platform =
+        ChromeTracingPlatform::Create(mPath.c_str(), options);
+    ASSERT_NE(platform, nullptr);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&] {
+            for (uint32_t i = 0; i < kIterations; ++i) {
+                AddEvent(platform.get(), TRACE_EVENT_PHASE_BEGIN, TraceCategory::General, "Outer");
+                AddEvent(platform.get(), TRACE_EVENT_PHASE_BEGIN, TraceCategory::Validation,
+                         "Inner");
+                AddEvent(platform.get(), TRACE_EVENT_PHASE_INSTANT, TraceCategory::Recording,
+                         "Instant");
+                AddEvent(platform.get(), TRACE_EVENT_PHASE_END, TraceCategory::Validation,
+                         "Inner");
+                AddEvent(platform.get(), TRACE_EVENT_PHASE_END, TraceCategory::General, "Outer");
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(platform->GetDroppedEventCount(), 0u);
+    platform = nullptr;
+
+    std::vector<ParsedEvent> events = ReadEvents();
+    EXPECT_EQ(events.size(), kThreadCount * kIterations * 5);
+
+    std::map<uint32_t, uint32_t> scopeCounts = CheckNesting(events);
+    EXPECT_EQ(scopeCounts.size(), kThreadCount);
+    for (const auto& [tid, count] : scopeCounts) {
+        EXPECT_EQ(count, kIterations * 2) << "On thread " << tid;
+    }
+}
+
+// Test that the events of disabled categories are not recorded.
+TEST_F(ChromeTracingPlatformTests, DisabledCategory) {
+    std::unique_ptr<ChromeTracingPlatform> platform = ChromeTracingPlatform::Create(mPath.c_str());
+    ASSERT_NE(platform, nullptr);
+
+    ChromeTracingPlatform::SetCategoryEnabled(TraceCategory::Validation, false);
+    AddEvent(platform.get(), TRACE_EVENT_PHASE_INSTANT, TraceCategory::Validation, "Disabled");
+    AddEvent(platform.get(), TRACE_EVENT_PHASE_INSTANT, TraceCategory::General, "Enabled");
+    ChromeTracingPlatform::SetCategoryEnabled(TraceCategory::Validation, true);
+    AddEvent(platform.get(), TRACE_EVENT_PHASE_INSTANT, TraceCategory::Validation, "Reenabled");
+    platform = nullptr;
+
+    std::vector<ParsedEvent> events = ReadEvents();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].name, "Enabled");
+    EXPECT_EQ(events[0].category, "General");
+    EXPECT_EQ(events[1].name, "Reenabled");
+    EXPECT_EQ(events[1].category, "Validation");
+}
+
+// Test that the events are dropped when a thread's buffer is full, without breaking the nesting of
+// the written scopes.
+TEST_F(ChromeTracingPlatformTests, BoundedBuffer) {
+    constexpr uint32_t kEventsPerThread = 16;
+
+    ChromeTracingPlatformOptions options;
+    options.eventsPerThread = kEventsPerThread;
+    options.flushIntervalMs = 0;
+    std::unique_ptr<ChromeTracingPlatform> platform =
+        ChromeTracingPlatform::Create(mPath.c_str(), options);
+    ASSERT_NE(platform, nullptr);
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        AddEvent(platform.get(), TRACE_EVENT_PHASE_BEGIN, TraceCategory::General, "Outer");
+        for (uint32_t j = 0; j < 10; ++j) {
+            AddEvent(platform.get(), TRACE_EVENT_PHASE_BEGIN, TraceCategory::General, "Inner");
+            AddEvent(platform.get(), TRACE_EVENT_PHASE_INSTANT, TraceCategory::General, "Instant");
+            AddEvent(platform.get(), TRACE_EVENT_PHASE_END, TraceCategory::General, "Inner");
+        }
+        AddEvent(platform.get(), TRACE_EVENT_PHASE_END, TraceCategory::General, "Outer");
+    }
+    EXPECT_GT(platform->GetDroppedEventCount(), 0u);
+
+    // Flushing makes room for new events.
+    platform->Flush();
+    AddEvent(platform.get(), TRACE_EVENT_PHASE_INSTANT, TraceCategory::General, "AfterFlush");
+    uint64_t droppedEventCount = platform->GetDroppedEventCount();
+    platform = nullptr;
+
+    std::vector<ParsedEvent> events = ReadEvents();
+    EXPECT_EQ(events.size() + droppedEventCount, 10u * 32u + 1u);
+    EXPECT_LE(events.size(), kEventsPerThread + 1);
+    CheckNesting(events);
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(events.back().name, "AfterFlush");
+}
+
+}  // anonymous namespace
+}  // namespace dawn::platform
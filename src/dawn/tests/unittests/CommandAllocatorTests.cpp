@@ -500,4 +500,54 @@ TEST(CommandAllocator, AcquireCommandBlocks) {
     iterator.MakeEmptyAsDataWasDestroyed();
 }
 
+// Test that blocks are recycled through a CommandBlockPool once the commands are destroyed, and
+// that the pool doesn't keep more than its budget.
+TEST(CommandAllocator, BlocksAreRecycledThroughPool) {
+    constexpr size_t kNumCommands = 2000;
+    CommandBlockPool pool(64 * 1024);
+
+    auto EncodeAndDestroy = [&]() {
+        CommandAllocator allocator(&pool);
+        for (size_t i = 0; i < kNumCommands; ++i) {
+            CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+            draw->first = i;
+            draw->count = 1;
+        }
+
+        CommandIterator iterator(std::move(allocator));
+        for (size_t i = 0; i < kNumCommands; ++i) {
+            CommandType type;
+            ASSERT_TRUE(iterator.NextCommandId(&type));
+            ASSERT_EQ(type, CommandType::Draw);
+            ASSERT_EQ(iterator.NextCommand<CommandDraw>()->first, i);
+        }
+        iterator.MakeEmptyAsDataWasDestroyed();
+    };
+
+    EncodeAndDestroy();
+    CommandBlockPool::Stats stats = pool.GetStats();
+    uint64_t blockCount = stats.allocatedBlockCount;
+    EXPECT_GT(blockCount, 1u);
+    EXPECT_EQ(stats.reusedBlockCount, 0u);
+    EXPECT_GT(stats.pooledBytes, 0u);
+    EXPECT_LE(stats.pooledBytes, 64u * 1024u);
+
+    // Encoding the same commands again reuses all the pooled blocks.
+    size_t pooledBytes = stats.pooledBytes;
+    EncodeAndDestroy();
+    stats = pool.GetStats();
+    EXPECT_EQ(stats.allocatedBlockCount, blockCount);
+    EXPECT_EQ(stats.reusedBlockCount, blockCount);
+    EXPECT_EQ(stats.pooledBytes, pooledBytes);
+
+    // A pool with no budget frees all the blocks.
+    CommandBlockPool emptyPool(0);
+    {
+        CommandAllocator allocator(&emptyPool);
+        allocator.Allocate<CommandDraw>(CommandType::Draw);
+    }
+    EXPECT_EQ(emptyPool.GetStats().allocatedBlockCount, 1u);
+    EXPECT_EQ(emptyPool.GetStats().pooledBytes, 0u);
+}
+
 }  // namespace dawn::native
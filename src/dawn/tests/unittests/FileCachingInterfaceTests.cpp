@@ -0,0 +1,164 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dawn/platform/FileCachingInterface.h"
+#include "gtest/gtest.h"
+
+namespace dawn::platform {
+namespace {
+
+class FileCachingInterfaceTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        char directory[] = "/tmp/dawn_file_cache_XXXXXX";
+        ASSERT_NE(mkdtemp(directory), nullptr);
+        mDirectory = directory;
+    }
+
+    void TearDown() override {
+        for (const std::string& file : ListFiles()) {
+            unlink((mDirectory + "/" + file).c_str());
+        }
+        rmdir(mDirectory.c_str());
+    }
+
+    std::vector<std::string> ListFiles() const {
+        std::vector<std::string> files;
+        DIR* dir = opendir(mDirectory.c_str());
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                files.push_back(name);
+            }
+        }
+        closedir(dir);
+        return files;
+    }
+
+    std::unique_ptr<FileCachingInterface> CreateCache(uint64_t maxSize = 1024 * 1024) {
+        return FileCachingInterface::Create(mDirectory.c_str(), maxSize);
+    }
+
+    static void Store(CachingInterface* cache, const std::string& key, const std::string& value) {
+        cache->StoreData(key.data(), key.size(), value.data(), value.size());
+    }
+
+    static std::string Load(CachingInterface* cache, const std::string& key) {
+        size_t size = cache->LoadData(key.data(), key.size(), nullptr, 0);
+        if (size == 0) {
+            return "";
+        }
+        std::string value(size, '\0');
+        if (cache->LoadData(key.data(), key.size(), value.data(), size) != size) {
+            return "";
+        }
+        return value;
+    }
+
+    std::string mDirectory;
+};
+
+// Test storing and loading entries.
+TEST_F(FileCachingInterfaceTests, StoreAndLoad) {
+    auto cache = CreateCache();
+    ASSERT_NE(cache, nullptr);
+
+    EXPECT_EQ(Load(cache.get(), "key"), "");
+    Store(cache.get(), "key", "value");
+    Store(cache.get(), "other key", "other value");
+    EXPECT_EQ(Load(cache.get(), "key"), "value");
+    EXPECT_EQ(Load(cache.get(), "other key"), "other value");
+
+    // Storing again replaces the value.
+    Store(cache.get(), "key", "new value");
+    EXPECT_EQ(Load(cache.get(), "key"), "new value");
+
+    FileCachingInterfaceStats stats = cache->GetStats();
+    EXPECT_EQ(stats.hitCount, 3u);
+    EXPECT_EQ(stats.missCount, 1u);
+    EXPECT_EQ(stats.storeCount, 3u);
+    EXPECT_EQ(stats.evictionCount, 0u);
+    EXPECT_EQ(ListFiles().size(), 2u);
+}
+
+// Test that the entries are shared between caches using the same directory, like in different
+// processes.
+TEST_F(FileCachingInterfaceTests, SharedDirectory) {
+    auto cache = CreateCache();
+    Store(cache.get(), "key", "value");
+
+    auto otherCache = CreateCache();
+    EXPECT_EQ(otherCache->GetStats().totalSize, cache->GetStats().totalSize);
+    EXPECT_EQ(Load(otherCache.get(), "key"), "value");
+    Store(otherCache.get(), "other key", "other value");
+    EXPECT_EQ(Load(cache.get(), "other key"), "other value");
+}
+
+// Test that corrupted entries are misses and are removed.
+TEST_F(FileCachingInterfaceTests, CorruptedEntry) {
+    auto cache = CreateCache();
+    Store(cache.get(), "key", "value");
+    std::vector<std::string> files = ListFiles();
+    ASSERT_EQ(files.size(), 1u);
+
+    FILE* file = fopen((mDirectory + "/" + files[0]).c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    fseek(file, -1, SEEK_END);
+    fputc('X', file);
+    fclose(file);
+
+    EXPECT_EQ(Load(cache.get(), "key"), "");
+    EXPECT_TRUE(ListFiles().empty());
+    EXPECT_EQ(cache->GetStats().totalSize, 0u);
+}
+
+// Test that the least recently used entries are evicted when the cache is full.
+TEST_F(FileCachingInterfaceTests, LeastRecentlyUsedEviction) {
+    const std::string value(1000, 'v');
+    auto cache = CreateCache(3500);
+
+    // The modification times of the files are used for the eviction order, so make sure that
+    // they are different.
+    auto Wait = [] { std::this_thread::sleep_for(std::chrono::milliseconds(10)); };
+    Store(cache.get(), "a", value);
+    Wait();
+    Store(cache.get(), "b", value);
+    Wait();
+    Store(cache.get(), "c", value);
+    Wait();
+    EXPECT_EQ(Load(cache.get(), "a"), value);
+    Wait();
+    Store(cache.get(), "d", value);
+
+    EXPECT_EQ(Load(cache.get(), "a"), value);
+    EXPECT_EQ(Load(cache.get(), "b"), "");
+    EXPECT_EQ(Load(cache.get(), "d"), value);
+
+    FileCachingInterfaceStats stats = cache->GetStats();
+    EXPECT_GE(stats.evictionCount, 1u);
+    EXPECT_LE(stats.totalSize, 3500u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::platform
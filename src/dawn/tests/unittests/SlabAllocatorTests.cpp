@@ -226,5 +226,115 @@ TEST(SlabAllocatorTests, AllocateDeallocateManyMultithread) {
     }
 }
 
+// Test that the statistics track the slabs, the blocks in use and the peak usage.
+TEST(SlabAllocatorTests, Stats) {
+    SlabAllocator<Foo> allocator(4 * sizeof(Foo));
+
+    SlabAllocatorStats stats = allocator.GetStats();
+    EXPECT_EQ(stats.slabCount, 0u);
+    EXPECT_EQ(stats.blocksInUse, 0u);
+    EXPECT_EQ(stats.GetFragmentation(), 0.0);
+
+    std::vector<Foo*> objects;
+    for (int i = 0; i < 6; ++i) {
+        objects.push_back(allocator.Allocate(i));
+    }
+
+    stats = allocator.GetStats();
+    EXPECT_EQ(stats.slabCount, 2u);
+    EXPECT_EQ(stats.totalBlocks, 8u);
+    EXPECT_EQ(stats.blocksInUse, 6u);
+    EXPECT_EQ(stats.peakBlocksInUse, 6u);
+    EXPECT_GT(stats.totalBytes, 8 * sizeof(Foo));
+    EXPECT_EQ(stats.GetFragmentation(), 0.25);
+
+    for (int i = 0; i < 4; ++i) {
+        allocator.Deallocate(objects.back());
+        objects.pop_back();
+    }
+
+    stats = allocator.GetStats();
+    EXPECT_EQ(stats.slabCount, 2u);
+    EXPECT_EQ(stats.blocksInUse, 2u);
+    EXPECT_EQ(stats.peakBlocksInUse, 6u);
+    EXPECT_EQ(stats.GetFragmentation(), 0.75);
+
+    for (Foo* object : objects) {
+        allocator.Deallocate(object);
+    }
+}
+
+// Test that the magazine allocator reuses memory freed on the same thread and reports the blocks
+// it caches.
+TEST(SlabAllocatorTests, MagazineReusesFreedMemory) {
+    constexpr uint32_t kMagazineSize = 4;
+    MagazineSlabAllocator<Foo> allocator(17 * sizeof(Foo), kMagazineSize, 2);
+
+    std::set<Foo*> objects;
+    for (int i = 0; i < 10; ++i) {
+        Foo* object = allocator.Allocate(i);
+        EXPECT_EQ(object->value, i);
+        EXPECT_TRUE(objects.insert(object).second);
+    }
+    for (Foo* object : objects) {
+        allocator.Deallocate(object);
+    }
+
+    SlabAllocatorStats stats = allocator.GetStats();
+    EXPECT_EQ(stats.blocksInUse, stats.cachedBlocks);
+
+    for (int i = 0; i < 10; ++i) {
+        Foo* ptr = allocator.Allocate(i);
+        EXPECT_TRUE(objects.find(ptr) != objects.end());
+    }
+    stats = allocator.GetStats();
+    EXPECT_EQ(stats.blocksInUse - stats.cachedBlocks, 10u);
+
+    for (Foo* object : objects) {
+        allocator.Deallocate(object);
+    }
+}
+
+// Test many allocations and deallocations in a multithreaded environment with the magazine
+// allocator, including objects that are freed on a different thread than they were allocated on.
+TEST(SlabAllocatorTests, MagazineAllocateDeallocateManyMultithread) {
+    static constexpr uint32_t kNumObjectsPerThread = 1000;
+    static constexpr uint32_t kNumThreads = 10;
+
+    MagazineSlabAllocator<Foo> allocator(17 * sizeof(Foo), 8, 4);
+    std::vector<std::vector<Foo*>> leftovers(kNumThreads);
+    auto f = [&](uint32_t threadIndex) {
+        std::set<Foo*> objects;
+        for (uint32_t i = 0; i < kNumObjectsPerThread; i++) {
+            Foo* object = allocator.Allocate(i);
+            EXPECT_TRUE(objects.insert(object).second);
+        }
+        for (Foo* object : objects) {
+            if (object->value % 2 == 0) {
+                allocator.Deallocate(object);
+            } else {
+                leftovers[threadIndex].push_back(object);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < kNumThreads; i++) {
+        threads.emplace_back(f, i);
+    }
+    for (uint32_t i = 0; i < kNumThreads; i++) {
+        threads[i].join();
+    }
+
+    SlabAllocatorStats stats = allocator.GetStats();
+    EXPECT_EQ(stats.blocksInUse - stats.cachedBlocks, kNumThreads * kNumObjectsPerThread / 2);
+
+    for (const std::vector<Foo*>& objects : leftovers) {
+        for (Foo* object : objects) {
+            allocator.Deallocate(object);
+        }
+    }
+}
+
 }  // anonymous namespace
 }  // namespace dawn
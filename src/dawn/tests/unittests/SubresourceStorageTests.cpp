@@ -197,10 +197,12 @@ void CheckLayerCompressed(const SubresourceStorage<T>& s,
 
     uint32_t levelCount = s.GetMipLevelCountForTesting();
 
+    // A compressed layer is part of a run of compressed layers that is iterated at once.
     bool seen = false;
     s.Iterate([&](const SubresourceRange& range, const T&) {
-        if (range.aspects == aspect && range.layerCount == 1 && range.levelCount == levelCount &&
-            range.baseArrayLayer == layer && range.baseMipLevel == 0) {
+        if (range.aspects == aspect && range.levelCount == levelCount &&
+            range.baseArrayLayer <= layer && layer < range.baseArrayLayer + range.layerCount &&
+            range.baseMipLevel == 0) {
             seen = true;
         }
     });
@@ -697,6 +699,115 @@ TEST(SubresourceStorageTest, AspectDecompressionUpdatesLayer0) {
     EXPECT_EQ(3, s.Get(Aspect::Color, 0, 1));
 }
 
+// Test that updating full layers keeps them in a single compressed run that is coalesced with
+// its neighbors when they end up with the same data.
+TEST(SubresourceStorageTest, LayerRunsCoalesce) {
+    const uint32_t kLayers = 2048;
+    const uint32_t kLevels = 3;
+    SubresourceStorage<int> s(Aspect::Color, kLayers, kLevels);
+    FakeStorage<int> f(Aspect::Color, kLayers, kLevels);
+
+    // Updating a cluster of full layers splits the aspect in three runs without decompressing
+    // any layer.
+    {
+        SubresourceRange range(Aspect::Color, {100, 50}, {0, kLevels});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 1; });
+    }
+    EXPECT_EQ(s.GetLayerRunCountForTesting(Aspect::Color), 3u);
+    CheckLayerCompressed(s, Aspect::Color, 99, true);
+    CheckLayerCompressed(s, Aspect::Color, 120, true);
+    CheckLayerCompressed(s, Aspect::Color, 150, true);
+
+    // An adjacent cluster with the same data is merged in the same run.
+    {
+        SubresourceRange range(Aspect::Color, {150, 50}, {0, kLevels});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 1; });
+    }
+    EXPECT_EQ(s.GetLayerRunCountForTesting(Aspect::Color), 3u);
+
+    // A single subresource decompresses only its layer.
+    {
+        SubresourceRange range = SubresourceRange::MakeSingle(Aspect::Color, 120, 1);
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 2; });
+    }
+    EXPECT_EQ(s.GetLayerRunCountForTesting(Aspect::Color), 5u);
+    CheckLayerCompressed(s, Aspect::Color, 119, true);
+    CheckLayerCompressed(s, Aspect::Color, 120, false);
+    CheckLayerCompressed(s, Aspect::Color, 121, true);
+
+    // Setting the layer back to the value of its neighbors recompresses the whole cluster.
+    {
+        SubresourceRange range = SubresourceRange::MakeSingle(Aspect::Color, 120, 1);
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 1; });
+    }
+    {
+        SubresourceRange range(Aspect::Color, {120, 1}, {0, kLevels});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int*) {});
+    }
+    EXPECT_EQ(s.GetLayerRunCountForTesting(Aspect::Color), 3u);
+
+    // Updating the cluster back to the initial value recompresses the aspect.
+    {
+        SubresourceRange range(Aspect::Color, {100, 100}, {0, kLevels});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 0; });
+    }
+    CheckAspectCompressed(s, Aspect::Color, true);
+}
+
+// Test merging storages with runs that overlap partially.
+TEST(SubresourceStorageTest, MergeOverlappingLayerRuns) {
+    const uint32_t kLayers = 64;
+    const uint32_t kLevels = 2;
+    SubresourceStorage<int> s(Aspect::Color, kLayers, kLevels);
+    FakeStorage<int> f(Aspect::Color, kLayers, kLevels);
+    {
+        SubresourceRange range(Aspect::Color, {8, 16}, {0, kLevels});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 1; });
+    }
+
+    SubresourceStorage<int> other(Aspect::Color, kLayers, kLevels);
+    other.Update(SubresourceRange(Aspect::Color, {16, 16}, {0, kLevels}),
+                 [](const SubresourceRange&, int* data) { *data = 2; });
+    other.Update(SubresourceRange::MakeSingle(Aspect::Color, 40, 1),
+                 [](const SubresourceRange&, int* data) { *data = 4; });
+
+    CallMergeOnBoth(&s, &f, other,
+                    [](const SubresourceRange&, int* data, int otherData) { *data |= otherData; });
+    CheckLayerCompressed(s, Aspect::Color, 8, true);
+    CheckLayerCompressed(s, Aspect::Color, 20, true);
+    CheckLayerCompressed(s, Aspect::Color, 28, true);
+    CheckLayerCompressed(s, Aspect::Color, 40, false);
+    // Runs are [0, 8), [8, 16), [16, 24), [24, 32), [32, 40), [40], [41, 64).
+    EXPECT_EQ(s.GetLayerRunCountForTesting(Aspect::Color), 7u);
+}
+
+// Test that disabling recompression leaves the subresources decompressed.
+TEST(SubresourceStorageTest, RecompressionDisabled) {
+    const uint32_t kLayers = 4;
+    const uint32_t kLevels = 3;
+    SubresourceStorage<int> s(Aspect::Color, kLayers, kLevels);
+    FakeStorage<int> f(Aspect::Color, kLayers, kLevels);
+
+    s.Update(SubresourceRange::MakeSingle(Aspect::Color, 1, 1),
+             [](const SubresourceRange&, int* data) { *data = 1; },
+             SubresourceRecompression::Disabled);
+    s.Update(SubresourceRange(Aspect::Color, {1, 1}, {0, kLevels}),
+             [](const SubresourceRange&, int* data) { *data = 0; },
+             SubresourceRecompression::Disabled);
+    f.CheckSameAs(s);
+    CheckLayerCompressed(s, Aspect::Color, 1, false);
+
+    SubresourceStorage<int> other(Aspect::Color, kLayers, kLevels);
+    s.Merge(other, [](const SubresourceRange&, int*, int) {}, SubresourceRecompression::Disabled);
+    f.CheckSameAs(s);
+    CheckLayerCompressed(s, Aspect::Color, 1, false);
+
+    // Updates with recompression enabled pick up the decompressed layer again.
+    s.Update(SubresourceRange(Aspect::Color, {1, 1}, {0, kLevels}),
+             [](const SubresourceRange&, int*) {});
+    CheckAspectCompressed(s, Aspect::Color, true);
+}
+
 // Bugs found while testing:
 //  - mLayersCompressed not initialized to true.
 //  - DecompressLayer setting Compressed to true instead of false.
@@ -0,0 +1,188 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Version_autogen.h"
+#include "dawn/native/BlobCache.h"
+#include "dawn/native/CacheKey.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+namespace {
+
+// A thread-safe in-memory CachingInterface that counts the calls made to it. Loads can be blocked
+// to make them overlap.
+class FakeCachingInterface : public dawn::platform::CachingInterface {
+  public:
+    size_t LoadData(const void* key, size_t keySize, void* value, size_t valueSize) override {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mLoadCount++;
+        mCondition.wait(lock, [this] { return !mBlockLoads; });
+
+        auto it = mEntries.find(std::string(static_cast<const char*>(key), keySize));
+        if (it == mEntries.end()) {
+            return 0;
+        }
+        if (value != nullptr) {
+            EXPECT_EQ(valueSize, it->second.size());
+            memcpy(value, it->second.data(), it->second.size());
+        }
+        return it->second.size();
+    }
+
+    void StoreData(const void* key, size_t keySize, const void* value, size_t valueSize) override {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEntries[std::string(static_cast<const char*>(key), keySize)] =
+            std::string(static_cast<const char*>(value), valueSize);
+    }
+
+    void SetBlockLoads(bool block) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mBlockLoads = block;
+        }
+        mCondition.notify_all();
+    }
+
+    size_t GetLoadCount() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLoadCount;
+    }
+
+    size_t GetEntryCount() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mEntries.size();
+    }
+
+  private:
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mBlockLoads = false;
+    size_t mLoadCount = 0;
+    std::map<std::string, std::string> mEntries;
+};
+
+// A WorkerTaskPool that only runs its tasks when asked to.
+class ManualWorkerTaskPool : public dawn::platform::WorkerTaskPool {
+  public:
+    std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
+        dawn::platform::PostWorkerTaskCallback callback,
+        void* userdata) override {
+        mTasks.emplace_back(callback, userdata);
+        return nullptr;
+    }
+
+    size_t RunTasks() {
+        std::vector<std::pair<dawn::platform::PostWorkerTaskCallback, void*>> tasks;
+        tasks.swap(mTasks);
+        for (auto [callback, userdata] : tasks) {
+            callback(userdata);
+        }
+        return tasks.size();
+    }
+
+  private:
+    std::vector<std::pair<dawn::platform::PostWorkerTaskCallback, void*>> mTasks;
+};
+
+CacheKey MakeKey(const std::string& name) {
+    CacheKey key;
+    StreamIn(&key, kDawnVersion, name);
+    return key;
+}
+
+std::string ToString(const Blob& blob) {
+    return std::string(reinterpret_cast<const char*>(blob.Data()), blob.Size());
+}
+
+// Test that concurrent loads of the same key only query the CachingInterface once and all get the
+// value.
+TEST(BlobCacheTests, ConcurrentLoadsAreDeduplicated) {
+    FakeCachingInterface cachingInterface;
+    BlobCache cache(&cachingInterface);
+    const std::string value = "pipeline";
+    cache.Store(MakeKey("a"), value.size(), value.data());
+
+    constexpr size_t kThreadCount = 8;
+    cachingInterface.SetBlockLoads(true);
+    std::atomic<size_t> startedCount{0};
+    std::vector<std::string> results(kThreadCount);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadCount; ++i) {
+        threads.emplace_back([&, i] {
+            startedCount++;
+            results[i] = ToString(cache.Load(MakeKey("a")));
+        });
+    }
+
+    // Give all the threads time to start their load before letting the first one complete.
+    while (startedCount < kThreadCount) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    cachingInterface.SetBlockLoads(false);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // One query of the size and one load of the value.
+    EXPECT_EQ(cachingInterface.GetLoadCount(), 2u);
+    for (const std::string& result : results) {
+        EXPECT_EQ(result, value);
+    }
+}
+
+// Test that deferred stores are written by the writer task and visible to loads before that.
+TEST(BlobCacheTests, DeferredStores) {
+    FakeCachingInterface cachingInterface;
+    ManualWorkerTaskPool writerTaskPool;
+    BlobCache cache(&cachingInterface, &writerTaskPool);
+
+    std::string value = "first";
+    cache.Store(MakeKey("a"), value.size(), value.data());
+    value = "second";
+    cache.Store(MakeKey("b"), value.size(), value.data());
+    EXPECT_EQ(cachingInterface.GetEntryCount(), 0u);
+
+    // Pending stores are returned without querying the CachingInterface.
+    EXPECT_EQ(ToString(cache.Load(MakeKey("a"))), "first");
+    EXPECT_EQ(ToString(cache.Load(MakeKey("b"))), "second");
+    EXPECT_EQ(cachingInterface.GetLoadCount(), 0u);
+
+    // Both stores are written by a single task.
+    EXPECT_EQ(writerTaskPool.RunTasks(), 1u);
+    EXPECT_EQ(cachingInterface.GetEntryCount(), 2u);
+    EXPECT_EQ(ToString(cache.Load(MakeKey("a"))), "first");
+    EXPECT_EQ(cachingInterface.GetLoadCount(), 2u);
+
+    // A new store posts a new task.
+    cache.Store(MakeKey("c"), value.size(), value.data());
+    EXPECT_EQ(writerTaskPool.RunTasks(), 1u);
+    EXPECT_EQ(cachingInterface.GetEntryCount(), 3u);
+    cache.Flush();
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
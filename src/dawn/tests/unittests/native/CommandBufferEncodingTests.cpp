@@ -310,5 +310,68 @@ TEST_F(CommandBufferEncodingTests, StateNotLeakedAfterRestore) {
     EXPECT_FALSE(stateTracker->HasPipeline());
 }
 
+// Test that setting the same pipeline, bind group or vertex buffer again in a render pass is not
+// recorded, but that changing any of their parameters is.
+TEST_F(CommandBufferEncodingTests, RenderPassRedundantStateNotRecorded) {
+    utils::DynamicOffsetPipeline dynamicOffsetPipeline = utils::CreateDynamicOffsetPipeline(device);
+    wgpu::RenderPipeline pipeline = dynamicOffsetPipeline.pipeline;
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = 512;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::Vertex;
+    wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+    wgpu::BindGroup bindGroup =
+        utils::MakeBindGroup(device, dynamicOffsetPipeline.bindGroupLayout, {{0, buffer, 0, 16}});
+
+    utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, 1, 1);
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+
+    uint32_t offset0 = 0;
+    uint32_t offset1 = 256;
+    for (uint32_t i = 0; i < 2; ++i) {
+        pass.SetPipeline(pipeline);
+        pass.SetVertexBuffer(0, buffer);
+        pass.SetBindGroup(0, bindGroup, 1, &offset0);
+        pass.Draw(3);
+    }
+    pass.SetBindGroup(0, bindGroup, 1, &offset1);
+    pass.SetVertexBuffer(0, buffer, 256);
+    pass.Draw(3);
+    pass.End();
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    auto Skip = [](Command type) {
+        return [type](CommandIterator* commands) { SkipCommand(commands, type); };
+    };
+    auto ExpectSetBindGroupOffset = [](uint32_t offset) {
+        return [offset](CommandIterator* commands) {
+            auto* cmd = commands->NextCommand<SetBindGroupCmd>();
+            ASSERT_EQ(cmd->dynamicOffsetCount, 1u);
+            EXPECT_EQ(commands->NextData<uint32_t>(1)[0], offset);
+        };
+    };
+    auto ExpectSetVertexBufferOffset = [](uint64_t offset) {
+        return [offset](CommandIterator* commands) {
+            EXPECT_EQ(commands->NextCommand<SetVertexBufferCmd>()->offset, offset);
+        };
+    };
+
+    ExpectCommands(FromAPI(commandBuffer.Get())->GetCommandIteratorForTesting(),
+                   {
+                       {Command::BeginRenderPass, Skip(Command::BeginRenderPass)},
+                       {Command::SetRenderPipeline, Skip(Command::SetRenderPipeline)},
+                       {Command::SetVertexBuffer, ExpectSetVertexBufferOffset(0)},
+                       {Command::SetBindGroup, ExpectSetBindGroupOffset(offset0)},
+                       {Command::Draw, Skip(Command::Draw)},
+                       // The second iteration only records the draw.
+                       {Command::Draw, Skip(Command::Draw)},
+                       {Command::SetBindGroup, ExpectSetBindGroupOffset(offset1)},
+                       {Command::SetVertexBuffer, ExpectSetVertexBufferOffset(256)},
+                       {Command::Draw, Skip(Command::Draw)},
+                       {Command::EndRenderPass, Skip(Command::EndRenderPass)},
+                   });
+}
+
 }  // anonymous namespace
 }  // namespace dawn::native
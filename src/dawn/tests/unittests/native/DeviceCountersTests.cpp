@@ -0,0 +1,169 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/native/DeviceCounters.h"
+#include "dawn/tests/DawnNativeTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn::native {
+namespace {
+
+class DeviceCountersTests : public DawnNativeTest {
+  protected:
+    uint64_t GetCounter(const char* name) {
+        for (const CounterInfo& counter : GetDeviceCounters(device.Get())) {
+            if (strcmp(counter.name, name) == 0) {
+                return counter.value;
+            }
+        }
+        ADD_FAILURE() << "Unknown counter " << name;
+        return 0;
+    }
+};
+
+// Test that the snapshot contains each counter once.
+TEST_F(DeviceCountersTests, SnapshotNamesAreUnique) {
+    std::vector<CounterInfo> counters = GetDeviceCounters(device.Get());
+    for (size_t i = 0; i < counters.size(); ++i) {
+        for (size_t j = i + 1; j < counters.size(); ++j) {
+            EXPECT_STRNE(counters[i].name, counters[j].name);
+        }
+    }
+}
+
+// Test that objects are counted once per creation, per type.
+TEST_F(DeviceCountersTests, ObjectsCreated) {
+    uint64_t buffersBefore = GetCounter("ObjectsCreated.Buffer");
+    uint64_t texturesBefore = GetCounter("ObjectsCreated.Texture");
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = 4;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform;
+    for (uint32_t i = 0; i < 3; ++i) {
+        device.CreateBuffer(&bufferDesc);
+    }
+
+    EXPECT_EQ(GetCounter("ObjectsCreated.Buffer"), buffersBefore + 3);
+    EXPECT_EQ(GetCounter("ObjectsCreated.Texture"), texturesBefore);
+}
+
+// Test that each API bind group layout is counted once, and not a second time for the internal
+// layout that it wraps.
+TEST_F(DeviceCountersTests, BindGroupLayoutsCreated) {
+    uint64_t layoutsBefore = GetCounter("ObjectsCreated.BindGroupLayout");
+
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform}});
+    EXPECT_EQ(GetCounter("ObjectsCreated.BindGroupLayout"), layoutsBefore + 1);
+
+    // The second layout shares the cached internal layout of the first one.
+    wgpu::BindGroupLayout sameLayout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform}});
+    EXPECT_EQ(GetCounter("ObjectsCreated.BindGroupLayout"), layoutsBefore + 2);
+}
+
+// Test that the lookups of deduplicated objects count as cache hits and misses.
+TEST_F(DeviceCountersTests, CacheHitsAndMisses) {
+    uint64_t hitsBefore = GetCounter("CacheHits.Sampler");
+    uint64_t missesBefore = GetCounter("CacheMisses.Sampler");
+    uint64_t samplersBefore = GetCounter("ObjectsCreated.Sampler");
+
+    wgpu::SamplerDescriptor samplerDesc;
+    samplerDesc.magFilter = wgpu::FilterMode::Linear;
+    wgpu::Sampler sampler = device.CreateSampler(&samplerDesc);
+    wgpu::Sampler sameSampler = device.CreateSampler(&samplerDesc);
+
+    EXPECT_EQ(GetCounter("CacheHits.Sampler"), hitsBefore + 1);
+    EXPECT_EQ(GetCounter("CacheMisses.Sampler"), missesBefore + 1);
+    EXPECT_EQ(GetCounter("ObjectsCreated.Sampler"), samplersBefore + 1);
+}
+
+// Test that finishing and submitting command buffers counts the encoded bytes and the time spent
+// validating them.
+TEST_F(DeviceCountersTests, CommandBytesAndValidationTime) {
+    uint64_t bytesBefore = GetCounter("CommandBytesEncoded");
+    uint64_t validationTimeBefore = GetCounter("SubmitValidationTimeNS");
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    device.GetQueue().Submit(1, &commands);
+
+    EXPECT_GT(GetCounter("CommandBytesEncoded"), bytesBefore);
+    EXPECT_GT(GetCounter("SubmitValidationTimeNS"), validationTimeBefore);
+}
+
+// Test that the compilation of a compute pipeline counts as compute shader compilation time.
+TEST_F(DeviceCountersTests, ShaderCompilationTime) {
+    uint64_t computeTimeBefore = GetCounter("ComputeShaderCompilationTimeNS");
+    uint64_t vertexTimeBefore = GetCounter("VertexShaderCompilationTimeNS");
+
+    wgpu::ComputePipelineDescriptor csDesc;
+    csDesc.compute.module = utils::CreateShaderModule(device, R"(
+        @compute @workgroup_size(1) fn main() {
+        })");
+    csDesc.compute.entryPoint = "main";
+    device.CreateComputePipeline(&csDesc);
+
+    EXPECT_GT(GetCounter("ComputeShaderCompilationTimeNS"), computeTimeBefore);
+    EXPECT_EQ(GetCounter("VertexShaderCompilationTimeNS"), vertexTimeBefore);
+}
+
+// Test that no update is lost when many threads add to the same counters, including when there
+// are more threads than shards.
+TEST(DeviceCountersConcurrencyTests, UpdatesAreMerged) {
+    DeviceCounters counters;
+
+    constexpr uint32_t kThreadCount = 32;
+    constexpr uint32_t kAddsPerThread = 10000;
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < kThreadCount; ++i) {
+        threads.emplace_back([&counters] {
+            for (uint32_t j = 0; j < kAddsPerThread; ++j) {
+                counters.AddCommandBytesEncoded(2);
+                counters.AddCacheHit(CounterCache::Blob);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(counters.GetCommandBytesEncoded(), 2u * kThreadCount * kAddsPerThread);
+    EXPECT_EQ(counters.GetCacheHits(CounterCache::Blob), kThreadCount * kAddsPerThread);
+    EXPECT_EQ(counters.GetCacheMisses(CounterCache::Blob), 0u);
+}
+
+// Test that disabled counters ignore the updates, including the time of a ScopedCounterTimer.
+TEST(DeviceCountersDisabledTests, UpdatesAreIgnored) {
+    DeviceCounters counters(false);
+    EXPECT_FALSE(counters.IsEnabled());
+
+    counters.AddObjectCreated(ObjectType::Buffer);
+    counters.AddCommandBytesEncoded(4);
+    { ScopedCounterTimer timer(&counters, TimeCounter::SubmitValidation); }
+
+    EXPECT_EQ(counters.GetObjectsCreated(ObjectType::Buffer), 0u);
+    EXPECT_EQ(counters.GetCommandBytesEncoded(), 0u);
+    EXPECT_EQ(counters.GetTime(TimeCounter::SubmitValidation), 0u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
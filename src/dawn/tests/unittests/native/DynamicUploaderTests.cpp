@@ -0,0 +1,152 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/DawnNativeTest.h"
+
+namespace dawn::native {
+namespace {
+
+// The null backend writes buffers without staging, so the uploads are done with WriteTexture, in
+// rows of 4KB.
+constexpr uint32_t kTextureWidth = 1024;
+constexpr uint64_t kBytesPerRow = kTextureWidth * 4;
+constexpr uint64_t kLargeUploadSize = 8 * 1024 * 1024;
+
+class DynamicUploaderTests : public DawnNativeTest {
+  protected:
+    void SetUp() override {
+        DawnNativeTest::SetUp();
+        queue = device.GetQueue();
+
+        wgpu::TextureDescriptor desc;
+        desc.size = {kTextureWidth, 2 * kLargeUploadSize / kBytesPerRow};
+        desc.format = wgpu::TextureFormat::RGBA8Unorm;
+        desc.usage = wgpu::TextureUsage::CopyDst;
+        texture = device.CreateTexture(&desc);
+    }
+
+    // Uploads |size| bytes, which must be either a multiple of kBytesPerRow or 4 bytes.
+    void Upload(uint64_t size) {
+        std::vector<uint8_t> data(size, 42);
+        wgpu::ImageCopyTexture destination = {};
+        destination.texture = texture;
+        wgpu::TextureDataLayout layout = {};
+        layout.bytesPerRow = kBytesPerRow;
+        wgpu::Extent3D writeSize = {kTextureWidth, static_cast<uint32_t>(size / kBytesPerRow)};
+        if (size < kBytesPerRow) {
+            writeSize = {static_cast<uint32_t>(size / 4), 1};
+        }
+        queue.WriteTexture(&destination, data.data(), data.size(), &layout, &writeSize);
+    }
+
+    // Uploads |size| bytes then submits and ticks the device so that the upload is complete.
+    void UploadAndTick(uint64_t size) {
+        Upload(size);
+        queue.Submit(0, nullptr);
+        device.Tick();
+    }
+
+    StagingMemoryStats GetStats() { return GetStagingMemoryStats(device.Get()); }
+
+    wgpu::Queue queue;
+    wgpu::Texture texture;
+};
+
+// Test that the staging buffers of large uploads are pooled and reused by the next large uploads
+// of a similar size.
+TEST_F(DynamicUploaderTests, LargeUploadsReuseStagingBuffers) {
+    UploadAndTick(kLargeUploadSize);
+    StagingMemoryStats stats = GetStats();
+    EXPECT_EQ(stats.pooledStagingBufferCount, 1u);
+    EXPECT_GE(stats.pooledStagingBytes, kLargeUploadSize);
+    EXPECT_EQ(stats.pendingStagingBytes, 0u);
+    uint64_t createdBefore = stats.stagingBuffersCreated;
+    uint64_t reusedBefore = stats.stagingBuffersReused;
+
+    UploadAndTick(kLargeUploadSize);
+    UploadAndTick(kLargeUploadSize - kBytesPerRow);
+    stats = GetStats();
+    EXPECT_EQ(stats.stagingBuffersCreated, createdBefore);
+    EXPECT_EQ(stats.stagingBuffersReused, reusedBefore + 2);
+    EXPECT_EQ(stats.pooledStagingBufferCount, 1u);
+
+    // A much larger upload doesn't fit the pooled staging buffer.
+    UploadAndTick(2 * kLargeUploadSize);
+    stats = GetStats();
+    EXPECT_EQ(stats.stagingBuffersCreated, createdBefore + 1);
+    EXPECT_EQ(stats.pooledStagingBufferCount, 2u);
+}
+
+// Test that the pooled staging buffers are released when they stay unused.
+TEST_F(DynamicUploaderTests, UnusedPooledStagingBuffersAreReleased) {
+    UploadAndTick(kLargeUploadSize);
+    ASSERT_EQ(GetStats().pooledStagingBufferCount, 1u);
+    uint64_t releasedBefore = GetStats().stagingBuffersReleased;
+
+    // Keep the device busy with small uploads only.
+    for (uint32_t i = 0; i < 100; ++i) {
+        UploadAndTick(4);
+    }
+    StagingMemoryStats stats = GetStats();
+    EXPECT_EQ(stats.pooledStagingBufferCount, 0u);
+    EXPECT_EQ(stats.pooledStagingBytes, 0u);
+    EXPECT_EQ(stats.stagingBuffersReleased, releasedBefore + 1);
+}
+
+// Test that large uploads that are submitted but not ticked wait for the previous uploads to
+// complete instead of taking the staging memory over budget.
+TEST_F(DynamicUploaderTests, SubmittedUploadsStayInBudget) {
+    constexpr uint64_t kMemoryBudget = 256 * 1024 * 1024;
+    uint64_t reusedBefore = GetStats().stagingBuffersReused;
+
+    for (uint32_t i = 0; i < 2 * kMemoryBudget / kLargeUploadSize; ++i) {
+        Upload(kLargeUploadSize);
+        queue.Submit(0, nullptr);
+
+        StagingMemoryStats stats = GetStats();
+        EXPECT_LE(stats.ringBufferBytes + stats.pendingStagingBytes + stats.pooledStagingBytes,
+                  kMemoryBudget);
+    }
+
+    // The staging buffers of the completed uploads were reused.
+    EXPECT_GT(GetStats().stagingBuffersReused, reusedBefore);
+}
+
+// Test that the ring buffers grow when a lot of data is uploaded at each tick, and shrink back when
+// uploads slow down.
+TEST_F(DynamicUploaderTests, RingBufferSizeAdapts) {
+    uint64_t initialRingBufferSize = GetStats().ringBufferSize;
+
+    for (uint32_t tick = 0; tick < 10; ++tick) {
+        for (uint32_t i = 0; i < 12; ++i) {
+            Upload(1024 * 1024);
+        }
+        queue.Submit(0, nullptr);
+        device.Tick();
+    }
+    StagingMemoryStats stats = GetStats();
+    EXPECT_GT(stats.ringBufferSize, initialRingBufferSize);
+    EXPECT_EQ(stats.ringBufferCount, 1u);
+
+    for (uint32_t tick = 0; tick < 30; ++tick) {
+        UploadAndTick(4);
+    }
+    EXPECT_EQ(GetStats().ringBufferSize, initialRingBufferSize);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
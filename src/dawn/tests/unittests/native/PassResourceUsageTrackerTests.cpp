@@ -0,0 +1,222 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "dawn/native/Buffer.h"
+#include "dawn/native/CommandBuffer.h"
+#include "dawn/native/PassResourceUsageTracker.h"
+#include "dawn/native/Texture.h"
+#include "dawn/tests/DawnNativeTest.h"
+#include "dawn/utils/ComboRenderBundleEncoderDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn::native {
+namespace {
+
+using PassResourceUsageTrackerTests = DawnNativeTest;
+
+// Test that the buffers are merged and produced in address order, both in scopes small enough to
+// be searched linearly and in scopes that use the hash table.
+TEST_F(PassResourceUsageTrackerTests, BufferUsagesMatchStdMap) {
+    constexpr wgpu::BufferUsage kUsages[] = {
+        wgpu::BufferUsage::Uniform, wgpu::BufferUsage::Storage, wgpu::BufferUsage::Vertex,
+        wgpu::BufferUsage::Index, wgpu::BufferUsage::Indirect};
+
+    std::mt19937 rng(0);
+    for (uint32_t bufferCount : {1u, 10u, 100u, 1000u}) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = 4;
+        descriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::Storage |
+                           wgpu::BufferUsage::Vertex | wgpu::BufferUsage::Index |
+                           wgpu::BufferUsage::Indirect;
+        std::vector<wgpu::Buffer> buffers;
+        for (uint32_t i = 0; i < bufferCount; ++i) {
+            buffers.push_back(device.CreateBuffer(&descriptor));
+        }
+
+        // Use the same tracker for two scopes to check that it is reset correctly.
+        SyncScopeUsageTracker tracker;
+        for (uint32_t scope = 0; scope < 2; ++scope) {
+            std::map<BufferBase*, wgpu::BufferUsage> expected;
+            for (uint32_t i = 0; i < bufferCount * 3; ++i) {
+                BufferBase* buffer = FromAPI(buffers[rng() % bufferCount].Get());
+                wgpu::BufferUsage usage = kUsages[rng() % std::size(kUsages)];
+                tracker.BufferUsedAs(buffer, usage);
+                expected[buffer] |= usage;
+            }
+
+            SyncScopeResourceUsage usage = tracker.AcquireSyncScopeUsage();
+            ASSERT_EQ(usage.buffers.size(), expected.size());
+            ASSERT_EQ(usage.bufferUsages.size(), expected.size());
+            size_t i = 0;
+            for (const auto& [buffer, bufferUsage] : expected) {
+                EXPECT_EQ(usage.buffers[i], buffer);
+                EXPECT_EQ(usage.bufferUsages[i], bufferUsage);
+                i++;
+            }
+        }
+    }
+}
+
+// Test that the per-subresource usages of textures stay associated with their texture when the
+// textures are sorted.
+TEST_F(PassResourceUsageTrackerTests, TextureUsagesMatchStdMap) {
+    wgpu::TextureDescriptor descriptor;
+    descriptor.size = {1, 1, 2};
+    descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+    descriptor.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::StorageBinding;
+
+    constexpr uint32_t kTextureCount = 40;
+    std::vector<wgpu::Texture> textures;
+    std::vector<wgpu::TextureView> layerViews;
+    for (uint32_t i = 0; i < kTextureCount; ++i) {
+        textures.push_back(device.CreateTexture(&descriptor));
+
+        wgpu::TextureViewDescriptor viewDescriptor;
+        viewDescriptor.dimension = wgpu::TextureViewDimension::e2D;
+        viewDescriptor.arrayLayerCount = 1;
+        viewDescriptor.baseArrayLayer = i % 2;
+        layerViews.push_back(textures.back().CreateView(&viewDescriptor));
+    }
+
+    // Use the textures in reverse order, with a usage that depends on the array layer.
+    SyncScopeUsageTracker tracker;
+    for (uint32_t i = kTextureCount; i-- > 0;) {
+        wgpu::TextureUsage usage = i % 2 == 0 ? wgpu::TextureUsage::TextureBinding
+                                              : wgpu::TextureUsage::StorageBinding;
+        tracker.TextureViewUsedAs(FromAPI(layerViews[i].Get()), usage);
+    }
+
+    SyncScopeResourceUsage usage = tracker.AcquireSyncScopeUsage();
+    ASSERT_EQ(usage.textures.size(), kTextureCount);
+    ASSERT_EQ(usage.textureUsages.size(), kTextureCount);
+    EXPECT_TRUE(std::is_sorted(usage.textures.begin(), usage.textures.end()));
+
+    for (uint32_t i = 0; i < kTextureCount; ++i) {
+        TextureBase* texture = FromAPI(textures[i].Get());
+        auto it = std::find(usage.textures.begin(), usage.textures.end(), texture);
+        ASSERT_NE(it, usage.textures.end());
+
+        const TextureSubresourceUsage& textureUsage =
+            usage.textureUsages[std::distance(usage.textures.begin(), it)];
+        uint32_t usedLayer = i % 2;
+        wgpu::TextureUsage expectedUsage = usedLayer == 0 ? wgpu::TextureUsage::TextureBinding
+                                                          : wgpu::TextureUsage::StorageBinding;
+        EXPECT_EQ(textureUsage.Get(Aspect::Color, usedLayer, 0), expectedUsage);
+        EXPECT_EQ(textureUsage.Get(Aspect::Color, 1 - usedLayer, 0), wgpu::TextureUsage::None);
+    }
+}
+
+// Test that merging the sorted usages of a render bundle gives the same usages as adding them one
+// by one, and that the scope can still be updated after the merge.
+TEST_F(PassResourceUsageTrackerTests, RenderBundleUsagesMatchStdMap) {
+    constexpr wgpu::BufferUsage kUsages[] = {wgpu::BufferUsage::Uniform, wgpu::BufferUsage::Vertex,
+                                             wgpu::BufferUsage::Index};
+
+    std::mt19937 rng(0);
+    for (uint32_t bufferCount : {10u, 100u}) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = 4;
+        descriptor.usage =
+            wgpu::BufferUsage::Uniform | wgpu::BufferUsage::Vertex | wgpu::BufferUsage::Index;
+        std::vector<wgpu::Buffer> buffers;
+        for (uint32_t i = 0; i < bufferCount; ++i) {
+            buffers.push_back(device.CreateBuffer(&descriptor));
+        }
+
+        std::map<BufferBase*, wgpu::BufferUsage> expected;
+        auto UseRandomBuffers = [&](SyncScopeUsageTracker* tracker) {
+            for (uint32_t i = 0; i < bufferCount / 2; ++i) {
+                BufferBase* buffer = FromAPI(buffers[rng() % bufferCount].Get());
+                wgpu::BufferUsage usage = kUsages[rng() % std::size(kUsages)];
+                tracker->BufferUsedAs(buffer, usage);
+                expected[buffer] |= usage;
+            }
+        };
+
+        SyncScopeUsageTracker bundleTracker;
+        UseRandomBuffers(&bundleTracker);
+        SyncScopeResourceUsage bundleUsage = bundleTracker.AcquireSyncScopeUsage();
+
+        SyncScopeUsageTracker tracker;
+        UseRandomBuffers(&tracker);
+        tracker.AddRenderBundleUsage(bundleUsage);
+        tracker.AddRenderBundleUsage(bundleUsage);
+        UseRandomBuffers(&tracker);
+
+        SyncScopeResourceUsage usage = tracker.AcquireSyncScopeUsage();
+        ASSERT_EQ(usage.buffers.size(), expected.size());
+        ASSERT_EQ(usage.bufferUsages.size(), expected.size());
+        size_t i = 0;
+        for (const auto& [buffer, bufferUsage] : expected) {
+            EXPECT_EQ(usage.buffers[i], buffer);
+            EXPECT_EQ(usage.bufferUsages[i], bufferUsage);
+            i++;
+        }
+    }
+}
+
+// Test that the resources of a render bundle executed several times in a pass are recorded once in
+// the usages of the pass.
+TEST_F(PassResourceUsageTrackerTests, RepeatedRenderBundleIsRecordedOnce) {
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = 4;
+    bufferDesc.usage = wgpu::BufferUsage::Vertex;
+    wgpu::Buffer vertexBuffer = device.CreateBuffer(&bufferDesc);
+
+    wgpu::TextureDescriptor textureDesc;
+    textureDesc.size = {1, 1, 1};
+    textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    textureDesc.usage = wgpu::TextureUsage::TextureBinding;
+    wgpu::Texture sampledTexture = device.CreateTexture(&textureDesc);
+
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::TextureSampleType::Float}});
+    wgpu::BindGroup bindGroup =
+        utils::MakeBindGroup(device, layout, {{0, sampledTexture.CreateView()}});
+
+    utils::ComboRenderBundleEncoderDescriptor bundleDesc;
+    bundleDesc.colorFormatsCount = 1;
+    bundleDesc.cColorFormats[0] = wgpu::TextureFormat::RGBA8Unorm;
+    wgpu::RenderBundleEncoder bundleEncoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    bundleEncoder.SetVertexBuffer(0, vertexBuffer);
+    bundleEncoder.SetBindGroup(0, bindGroup);
+    wgpu::RenderBundle bundle = bundleEncoder.Finish();
+
+    utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, 1, 1);
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+    std::vector<wgpu::RenderBundle> bundles = {bundle, bundle, bundle};
+    pass.ExecuteBundles(bundles.size(), bundles.data());
+    pass.ExecuteBundles(1, &bundle);
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+
+    const RenderPassUsages& passUsages = FromAPI(commands.Get())->GetResourceUsages().renderPasses;
+    ASSERT_EQ(passUsages.size(), 1u);
+    const RenderPassResourceUsage& usage = passUsages[0];
+    EXPECT_EQ(usage.buffers, std::vector<BufferBase*>{FromAPI(vertexBuffer.Get())});
+    EXPECT_EQ(usage.bufferUsages, std::vector<wgpu::BufferUsage>{wgpu::BufferUsage::Vertex});
+    EXPECT_EQ(std::count(usage.textures.begin(), usage.textures.end(),
+                         FromAPI(sampledTexture.Get())),
+              1);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
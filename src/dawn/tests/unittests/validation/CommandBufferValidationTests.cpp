@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <gmock/gmock.h>
+#include <array>
+#include <string>
 
 #include "dawn/native/CommandEncoder.h"
 
@@ -427,5 +429,104 @@ TEST_F(CommandBufferValidationTest, EncodeAfterDeviceDestroyed) {
     }
 }
 
+class AsyncCommandBufferValidationTest : public ValidationTest {
+  protected:
+    WGPUDevice CreateTestDevice(native::Adapter dawnAdapter,
+                                wgpu::DeviceDescriptor descriptor) override {
+        const char* enabledToggle = "async_command_buffer_validation";
+        wgpu::DawnTogglesDescriptor deviceTogglesDesc;
+        deviceTogglesDesc.enabledToggles = &enabledToggle;
+        deviceTogglesDesc.enabledTogglesCount = 1;
+        descriptor.nextInChain = &deviceTogglesDesc;
+        return dawnAdapter.CreateDevice(&descriptor);
+    }
+
+    // Encodes a render pass using a buffer both as a writable storage buffer and a vertex buffer,
+    // which is only caught when validating the usages of the pass in Finish.
+    wgpu::CommandEncoder EncodeUsageConflict() {
+        wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Storage}});
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 16;
+        bufferDesc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::Vertex;
+        wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+        wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, layout, {{0, buffer}});
+
+        PlaceholderRenderPass renderPass(device);
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetBindGroup(0, bindGroup);
+        pass.SetVertexBuffer(0, buffer);
+        pass.End();
+        return encoder;
+    }
+};
+
+// Test that a command buffer without usage conflicts can be finished and submitted.
+TEST_F(AsyncCommandBufferValidationTest, Success) {
+    PlaceholderRenderPass renderPass(device);
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.BeginRenderPass(&renderPass).End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    device.GetQueue().Submit(1, &commands);
+}
+
+// Test that usage conflicts found by the deferred validation are still reported, and that the
+// command buffer can't be submitted.
+TEST_F(AsyncCommandBufferValidationTest, UsageConflict) {
+    wgpu::CommandEncoder encoder = EncodeUsageConflict();
+    wgpu::CommandBuffer commands;
+    ASSERT_DEVICE_ERROR(commands = encoder.Finish(), HasSubstr("synchronization scope"));
+    ASSERT_DEVICE_ERROR(device.GetQueue().Submit(1, &commands), HasSubstr("is invalid"));
+}
+
+// Test that usage conflicts found by the deferred validation are reported to the error scope that
+// was current when Finish was called.
+TEST_F(AsyncCommandBufferValidationTest, UsageConflictInErrorScope) {
+    wgpu::CommandEncoder encoder = EncodeUsageConflict();
+
+    device.PushErrorScope(wgpu::ErrorFilter::Validation);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    device.PushErrorScope(wgpu::ErrorFilter::Validation);
+
+    std::array<WGPUErrorType, 2> errorTypes = {WGPUErrorType_Unknown, WGPUErrorType_Unknown};
+    auto StoreErrorType = [](WGPUErrorType type, const char*, void* userdata) {
+        *static_cast<WGPUErrorType*>(userdata) = type;
+    };
+    device.PopErrorScope(StoreErrorType, &errorTypes[0]);
+    device.PopErrorScope(StoreErrorType, &errorTypes[1]);
+    FlushWire();
+    device.Tick();
+    FlushWire();
+    EXPECT_EQ(errorTypes[0], WGPUErrorType_NoError);
+    EXPECT_EQ(errorTypes[1], WGPUErrorType_Validation);
+}
+
+// Test that usage conflicts found by the deferred validation are reported before the errors of the
+// calls made after Finish, so that the error scope captures the error of Finish.
+TEST_F(AsyncCommandBufferValidationTest, UsageConflictReportedBeforeLaterErrors) {
+    wgpu::CommandEncoder encoder = EncodeUsageConflict();
+
+    device.PushErrorScope(wgpu::ErrorFilter::Validation);
+    wgpu::CommandBuffer commands = encoder.Finish();
+
+    // MapRead and MapWrite can't be used together.
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = 4;
+    bufferDesc.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapWrite;
+    device.CreateBuffer(&bufferDesc);
+
+    std::string message;
+    device.PopErrorScope(
+        [](WGPUErrorType, const char* message, void* userdata) {
+            *static_cast<std::string*>(userdata) = message;
+        },
+        &message);
+    FlushWire();
+    device.Tick();
+    FlushWire();
+    EXPECT_THAT(message, HasSubstr("synchronization scope"));
+}
+
 }  // anonymous namespace
 }  // namespace dawn
@@ -312,6 +312,15 @@ TEST_F(StorageTextureValidationTests, UnsupportedWGSLStorageTextureFormat) {
     }
 }
 
+// Verify that a 'bgra8unorm' storage texture is an error without 'bgra8unorm-storage' even when no
+// entry point uses it, since entry points are only reflected when they are used in a pipeline.
+TEST_F(StorageTextureValidationTests, BGRA8UnormStorageTextureUnusedInShader) {
+    ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var image0 : texture_storage_2d<bgra8unorm, write>;
+        @compute @workgroup_size(1) fn main() {}
+    )"));
+}
+
 // Verify that declaring a storage texture dimension that isn't supported by
 // WebGPU causes a compile failure. WebGPU doesn't support using cube map
 // texture views and cube map array texture views as storage textures.
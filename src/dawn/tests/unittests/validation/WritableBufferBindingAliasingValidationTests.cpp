@@ -634,6 +634,27 @@ TEST_F(WritableBufferBindingAliasingValidationTests, SetBindGroupLazyAspectDynam
         renderPassEncoder.End();
         commandEncoder.Finish();
     }
+
+    // Changing only the dynamic offsets of an already validated bind group to aliasing ones
+    // between draws is still an error.
+    {
+        wgpu::CommandEncoder commandEncoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder renderPassEncoder = commandEncoder.BeginRenderPass(&renderPass);
+        renderPassEncoder.SetPipeline(renderPipeline);
+
+        std::vector<uint32_t> dynamicOffsetsValid = {0, 0};
+        std::vector<uint32_t> dynamicOffsetsInvalid = {0, 256};
+
+        renderPassEncoder.SetBindGroup(0, bindGroups[0], dynamicOffsetsValid.size(),
+                                       dynamicOffsetsValid.data());
+        renderPassEncoder.Draw(3);
+        renderPassEncoder.SetBindGroup(0, bindGroups[0], dynamicOffsetsInvalid.size(),
+                                       dynamicOffsetsInvalid.data());
+        renderPassEncoder.Draw(3);
+
+        renderPassEncoder.End();
+        ASSERT_DEVICE_ERROR(commandEncoder.Finish());
+    }
 }
 
 }  // anonymous namespace
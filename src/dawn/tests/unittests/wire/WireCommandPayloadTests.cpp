@@ -0,0 +1,200 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dawn/utils/BatchingCommandBuffer.h"
+#include "dawn/wire/ChunkedCommandHandler.h"
+#include "dawn/wire/ChunkedCommandSerializer.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire {
+namespace {
+
+// A serializer that records the chunks returned by GetCmdSpace and the payloads it is given.
+class RecordingSerializer : public CommandSerializer {
+  public:
+    explicit RecordingSerializer(size_t maxAllocationSize)
+        : mMaxAllocationSize(maxAllocationSize) {}
+
+    void* GetCmdSpace(size_t size) override {
+        EXPECT_LE(size, mMaxAllocationSize);
+        chunks.emplace_back(size);
+        return chunks.back().data();
+    }
+    bool Flush() override { return true; }
+    size_t GetMaximumAllocationSize() const override { return mMaxAllocationSize; }
+
+    bool SerializeCommandPayloads(const CommandPayload* payloads, size_t count) override {
+        this->payloads.insert(this->payloads.end(), payloads, payloads + count);
+        return CommandSerializer::SerializeCommandPayloads(payloads, count);
+    }
+
+    std::vector<std::vector<char>> chunks;
+    std::vector<CommandPayload> payloads;
+
+  private:
+    size_t mMaxAllocationSize;
+};
+
+class NoAllocationDeserializeAllocator : public DeserializeAllocator {
+  public:
+    void* GetSpace(size_t) override { return nullptr; }
+};
+
+// Deserializes QueueWriteBuffer commands and records their data.
+class WriteBufferRecorder : public ChunkedCommandHandler {
+  public:
+    std::vector<std::vector<uint8_t>> writes;
+
+  private:
+    const volatile char* HandleCommandsImpl(const volatile char* commands, size_t size) override {
+        DeserializeBuffer deserializeBuffer(commands, size);
+        while (deserializeBuffer.AvailableSize() >= sizeof(CmdHeader) + sizeof(WireCmd)) {
+            switch (HandleChunkedCommands(deserializeBuffer.Buffer(),
+                                          deserializeBuffer.AvailableSize())) {
+                case ChunkedCommandsResult::Consumed:
+                    return commands + size;
+                case ChunkedCommandsResult::Error:
+                    return nullptr;
+                case ChunkedCommandsResult::Passthrough:
+                    break;
+            }
+
+            QueueWriteBufferCmd cmd;
+            NoAllocationDeserializeAllocator allocator;
+            if (cmd.Deserialize(&deserializeBuffer, &allocator) != WireResult::Success) {
+                return nullptr;
+            }
+            writes.emplace_back(cmd.data, cmd.data + cmd.size);
+        }
+        return commands + size;
+    }
+};
+
+std::vector<uint8_t> MakeData(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+    return data;
+}
+
+QueueWriteBufferCmd MakeWriteBufferCmd(const std::vector<uint8_t>& data) {
+    QueueWriteBufferCmd cmd = {};
+    cmd.queueId = 1;
+    cmd.bufferId = 2;
+    cmd.data = data.data();
+    cmd.size = data.size();
+    return cmd;
+}
+
+// Test that the default SerializeCommandPayloads copies payloads in chunks of the maximum
+// allocation size, regardless of the payload boundaries.
+TEST(WireCommandPayloadTests, DefaultCopiesInMaxSizeChunks) {
+    RecordingSerializer serializer(16);
+
+    const char a[] = "0123456789";
+    const char b[] = "abcdefghijklmnopqrstuvwxyz";
+    CommandPayload payloads[] = {{a, 10}, {b, 0}, {b, 26}};
+    ASSERT_TRUE(serializer.SerializeCommandPayloads(payloads, 3));
+
+    ASSERT_EQ(serializer.chunks.size(), 3u);
+    EXPECT_EQ(serializer.chunks[0].size(), 16u);
+    EXPECT_EQ(serializer.chunks[1].size(), 16u);
+    EXPECT_EQ(serializer.chunks[2].size(), 4u);
+
+    std::string serialized;
+    for (const auto& chunk : serializer.chunks) {
+        serialized.append(chunk.data(), chunk.size());
+    }
+    EXPECT_EQ(serialized, "0123456789abcdefghijklmnopqrstuvwxyz");
+}
+
+// Test that the data of a large WriteBuffer is passed to the serializer in place.
+TEST(WireCommandPayloadTests, LargeWriteBufferDataIsGathered) {
+    RecordingSerializer serializer(1024);
+    ChunkedCommandSerializer chunkedSerializer(&serializer);
+
+    std::vector<uint8_t> data = MakeData(10001);
+    chunkedSerializer.SerializeCommand(MakeWriteBufferCmd(data));
+
+    bool foundData = false;
+    for (const CommandPayload& payload : serializer.payloads) {
+        if (payload.data == data.data()) {
+            EXPECT_EQ(payload.size, data.size());
+            foundData = true;
+        }
+    }
+    EXPECT_TRUE(foundData);
+
+    // Small commands are still serialized directly in GetCmdSpace allocations.
+    serializer.payloads.clear();
+    std::vector<uint8_t> smallData = MakeData(100);
+    chunkedSerializer.SerializeCommand(MakeWriteBufferCmd(smallData));
+    EXPECT_TRUE(serializer.payloads.empty());
+}
+
+// Test that commands with large parts that aren't gathered, like extensions, are still serialized
+// correctly.
+TEST(WireCommandPayloadTests, LargeExtensionIsSerialized) {
+    RecordingSerializer serializer(1024);
+    ChunkedCommandSerializer chunkedSerializer(&serializer);
+
+    std::vector<uint8_t> data = MakeData(10000);
+    std::vector<uint8_t> extensionData = MakeData(20000);
+    CommandExtension extension{extensionData.size(), [&](char* buffer) {
+                                   memcpy(buffer, extensionData.data(), extensionData.size());
+                               }};
+    chunkedSerializer.SerializeCommand(MakeWriteBufferCmd(data), std::move(extension));
+
+    std::vector<uint8_t> serialized;
+    for (const auto& chunk : serializer.chunks) {
+        serialized.insert(serialized.end(), chunk.begin(), chunk.end());
+    }
+    ASSERT_GT(serialized.size(), data.size() + extensionData.size());
+    EXPECT_TRUE(std::equal(extensionData.begin(), extensionData.end(),
+                           serialized.end() - extensionData.size()));
+    EXPECT_TRUE(std::search(serialized.begin(), serialized.end(), data.begin(), data.end()) !=
+                serialized.end());
+}
+
+// Test that small and large WriteBuffers are received in order and intact through a
+// BatchingCommandBuffer, and that small commands are batched.
+TEST(WireCommandPayloadTests, BatchingCommandBufferRoundTrip) {
+    WriteBufferRecorder recorder;
+    utils::BatchingCommandBuffer transport(&recorder, 4096);
+    ChunkedCommandSerializer serializer(&transport);
+
+    std::vector<std::vector<uint8_t>> writes;
+    for (size_t size : {1u, 64u, 100000u, 7u, 4093u, 8192u, 3u}) {
+        writes.push_back(MakeData(size));
+        serializer.SerializeCommand(MakeWriteBufferCmd(writes.back()));
+    }
+    for (size_t i = 0; i < 100; ++i) {
+        writes.push_back(MakeData(16));
+        serializer.SerializeCommand(MakeWriteBufferCmd(writes.back()));
+    }
+    ASSERT_TRUE(transport.Flush());
+
+    EXPECT_EQ(recorder.writes, writes);
+    EXPECT_LT(transport.GetHandleCommandsCount(), 20u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
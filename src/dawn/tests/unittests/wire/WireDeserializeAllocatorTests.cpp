@@ -0,0 +1,102 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <vector>
+
+#include "dawn/wire/WireDeserializeAllocator.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire {
+namespace {
+
+// Allocates |count| blocks of |size| bytes and checks that they are usable and don't overlap.
+void AllocateAndFill(WireDeserializeAllocator* allocator, size_t count, size_t size) {
+    std::vector<char*> allocations;
+    for (size_t i = 0; i < count; ++i) {
+        char* allocation = static_cast<char*>(allocator->GetSpace(size));
+        ASSERT_NE(allocation, nullptr);
+        memset(allocation, static_cast<int>(i), size);
+        allocations.push_back(allocation);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < size; ++j) {
+            ASSERT_EQ(allocations[i][j], static_cast<char>(i));
+        }
+    }
+}
+
+// Test that small commands are deserialized in the inline buffer.
+TEST(WireDeserializeAllocatorTests, SmallCommandsDontAllocate) {
+    WireDeserializeAllocator allocator;
+    for (uint32_t i = 0; i < 100; ++i) {
+        AllocateAndFill(&allocator, 8, 64);
+        allocator.Reset();
+    }
+    EXPECT_EQ(allocator.GetHeapAllocationCount(), 0u);
+    EXPECT_EQ(allocator.GetRetainedSize(), 0u);
+}
+
+// Test that the memory of a large command is retained so that the next commands of the same size
+// don't allocate.
+TEST(WireDeserializeAllocatorTests, RetainsHighWaterMark) {
+    WireDeserializeAllocator allocator;
+    AllocateAndFill(&allocator, 100, 200);
+    allocator.Reset();
+
+    uint64_t heapAllocationCount = allocator.GetHeapAllocationCount();
+    EXPECT_GT(heapAllocationCount, 0u);
+    EXPECT_GE(allocator.GetRetainedSize(), 100u * 200u);
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        AllocateAndFill(&allocator, 100, 200);
+        allocator.Reset();
+        AllocateAndFill(&allocator, 4, 1000);
+        allocator.Reset();
+    }
+    EXPECT_EQ(allocator.GetHeapAllocationCount(), heapAllocationCount);
+
+    // A larger command grows the retained block.
+    AllocateAndFill(&allocator, 10, 10000);
+    allocator.Reset();
+    EXPECT_GE(allocator.GetRetainedSize(), 10u * 10000u);
+}
+
+// Test that the memory of huge commands isn't retained.
+TEST(WireDeserializeAllocatorTests, HugeCommandNotRetained) {
+    WireDeserializeAllocator allocator;
+    AllocateAndFill(&allocator, 1, 16 * 1024 * 1024);
+    allocator.Reset();
+    EXPECT_LT(allocator.GetRetainedSize(), 16u * 1024u * 1024u);
+}
+
+// Test the counters of bytes allocated per command.
+TEST(WireDeserializeAllocatorTests, AllocatedBytesPerCommand) {
+    WireDeserializeAllocator allocator;
+    AllocateAndFill(&allocator, 2, 8);
+    allocator.Reset(3);
+    AllocateAndFill(&allocator, 1, 4096);
+    allocator.Reset(1);
+    AllocateAndFill(&allocator, 1, 16);
+    allocator.Reset(3);
+
+    EXPECT_EQ(allocator.GetAllocatedBytes(0), 0u);
+    EXPECT_EQ(allocator.GetAllocatedBytes(1), 4096u);
+    EXPECT_EQ(allocator.GetAllocatedBytes(3), 32u);
+    EXPECT_EQ(allocator.GetAllocatedBytes(100), 0u);
+    EXPECT_EQ(allocator.GetAllocatedBytes(), 4096u + 32u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
@@ -0,0 +1,90 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+#include <random>
+
+#include "dawn/wire/server/ObjectStorage.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire::server {
+namespace {
+
+WGPUTexture FakeHandle(uintptr_t value) {
+    return reinterpret_cast<WGPUTexture>(value * alignof(uint64_t));
+}
+
+// Test storing, overwriting, getting and removing ids.
+TEST(WireObjectIdLookupTableTests, Basic) {
+    ObjectIdLookupTable<WGPUTexture> table;
+    EXPECT_EQ(table.Get(FakeHandle(1)), 0u);
+
+    table.Store(FakeHandle(1), 10);
+    table.Store(FakeHandle(2), 20);
+    EXPECT_EQ(table.Get(FakeHandle(1)), 10u);
+    EXPECT_EQ(table.Get(FakeHandle(2)), 20u);
+    EXPECT_EQ(table.Size(), 2u);
+
+    table.Store(FakeHandle(1), 11);
+    EXPECT_EQ(table.Get(FakeHandle(1)), 11u);
+    EXPECT_EQ(table.Size(), 2u);
+
+    table.Remove(FakeHandle(1));
+    table.Remove(FakeHandle(3));
+    EXPECT_EQ(table.Get(FakeHandle(1)), 0u);
+    EXPECT_EQ(table.Get(FakeHandle(2)), 20u);
+    EXPECT_EQ(table.Size(), 1u);
+}
+
+// Test that the nullptr handle is never stored.
+TEST(WireObjectIdLookupTableTests, NullHandle) {
+    ObjectIdLookupTable<WGPUTexture> table;
+    table.Store(nullptr, 1);
+    EXPECT_EQ(table.Get(nullptr), 0u);
+    EXPECT_EQ(table.Size(), 0u);
+    table.Remove(nullptr);
+}
+
+// Test a random sequence of operations against std::map, to exercise growth and the backward shift
+// of colliding entries on removal.
+TEST(WireObjectIdLookupTableTests, MatchesStdMap) {
+    ObjectIdLookupTable<WGPUTexture> table;
+    std::map<WGPUTexture, ObjectId> expected;
+
+    std::mt19937 rng(0);
+    for (uint32_t i = 0; i < 100000; ++i) {
+        WGPUTexture key = FakeHandle(rng() % 2000 + 1);
+        switch (rng() % 3) {
+            case 0: {
+                ObjectId id = rng();
+                table.Store(key, id);
+                expected[key] = id;
+                break;
+            }
+            case 1:
+                table.Remove(key);
+                expected.erase(key);
+                break;
+            case 2: {
+                auto it = expected.find(key);
+                ASSERT_EQ(table.Get(key), it == expected.end() ? 0u : it->second);
+                break;
+            }
+        }
+        ASSERT_EQ(table.Size(), expected.size());
+    }
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire::server
@@ -0,0 +1,319 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "dawn/utils/RingBufferCommandBuffer.h"
+#include "dawn/utils/SharedMemory.h"
+#include "dawn/utils/SharedMemoryTransferService.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire {
+namespace {
+
+// Appends all the commands it receives to a byte vector.
+class RecordingHandler : public CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        received.insert(received.end(), commands, commands + size);
+        return commands + size;
+    }
+
+    std::vector<char> received;
+};
+
+// Serializes |count| allocations of random sizes filled with a pattern, and returns the bytes
+// that should be received.
+std::vector<char> SerializeRandomCommands(CommandSerializer* serializer,
+                                          std::mt19937* rng,
+                                          size_t count) {
+    std::vector<char> expected;
+    for (size_t i = 0; i < count; ++i) {
+        size_t size = (*rng)() % (serializer->GetMaximumAllocationSize() + 1);
+        char* data = static_cast<char*>(serializer->GetCmdSpace(size));
+        EXPECT_NE(data, nullptr);
+        for (size_t j = 0; j < size; ++j) {
+            data[j] = static_cast<char>(expected.size() + j);
+        }
+        expected.insert(expected.end(), data, data + size);
+        if ((*rng)() % 4 == 0) {
+            EXPECT_TRUE(serializer->Flush());
+        }
+    }
+    EXPECT_TRUE(serializer->Flush());
+    return expected;
+}
+
+// Test that commands go through the ring buffer intact and in order, including across the end of
+// the ring buffer.
+TEST(WireSharedMemoryTests, RingBufferInOrder) {
+    auto region = utils::SharedMemoryRegion::Create(utils::kMinRingBufferSize);
+    ASSERT_NE(region, nullptr);
+    utils::RingBufferCommandSerializer serializer(region->GetData(), region->GetSize());
+    utils::RingBufferCommandReader reader(region->GetData(), region->GetSize());
+    RecordingHandler handler;
+
+    std::mt19937 rng(0);
+    std::vector<char> expected;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        std::vector<char> commands = SerializeRandomCommands(&serializer, &rng, 2);
+        expected.insert(expected.end(), commands.begin(), commands.end());
+        EXPECT_EQ(reader.HasCommands(), !commands.empty());
+        ASSERT_TRUE(reader.HandleCommands(&handler));
+        EXPECT_FALSE(reader.HasCommands());
+    }
+    EXPECT_EQ(handler.received, expected);
+}
+
+// Test a frame that ends exactly at the end of the ring buffer. It must be published before the
+// next command is written at the start of the ring buffer.
+TEST(WireSharedMemoryTests, RingBufferFrameEndsAtRingEnd) {
+    auto region = utils::SharedMemoryRegion::Create(utils::kMinRingBufferSize);
+    ASSERT_NE(region, nullptr);
+    utils::RingBufferCommandSerializer serializer(region->GetData(), region->GetSize());
+    utils::RingBufferCommandReader reader(region->GetData(), region->GetSize());
+    RecordingHandler handler;
+
+    std::vector<char> expected;
+    auto Serialize = [&](size_t size) {
+        char* data = static_cast<char*>(serializer.GetCmdSpace(size));
+        ASSERT_NE(data, nullptr);
+        for (size_t j = 0; j < size; ++j) {
+            data[j] = static_cast<char>(expected.size() + j);
+        }
+        expected.insert(expected.end(), data, data + size);
+    };
+
+    // Start the next frame away from the start of the ring buffer, and let the reader free the
+    // space before it.
+    const size_t maxSize = serializer.GetMaximumAllocationSize();
+    Serialize(maxSize);
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_TRUE(reader.HandleCommands(&handler));
+
+    // The ring buffer holds a bit more than four maximum allocations. Commands of 8 bytes fill a
+    // single frame up to exactly the end of the ring buffer, then continue at its start.
+    for (size_t i = 0; i < (3 * maxSize + maxSize / 2) / 8; ++i) {
+        Serialize(8);
+    }
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_TRUE(reader.HandleCommands(&handler));
+    EXPECT_EQ(handler.received, expected);
+}
+
+// Test the ring buffer with the serializer and reader on different threads, with the serializer
+// waiting for space when the ring buffer is full.
+TEST(WireSharedMemoryTests, RingBufferConcurrent) {
+    auto region = utils::SharedMemoryRegion::Create(utils::kMinRingBufferSize);
+    ASSERT_NE(region, nullptr);
+    utils::RingBufferCommandSerializer serializer(region->GetData(), region->GetSize());
+    utils::RingBufferCommandReader reader(region->GetData(), region->GetSize());
+
+    // |expected| is only read after the producer is joined.
+    std::vector<char> expected;
+    std::atomic<bool> producerDone{false};
+    std::thread producer([&] {
+        std::mt19937 rng(0);
+        expected = SerializeRandomCommands(&serializer, &rng, 20000);
+        producerDone.store(true, std::memory_order_release);
+    });
+
+    // On failure, the reader is closed so that the producer stops waiting for space.
+    RecordingHandler handler;
+    bool success = true;
+    size_t iterations = 0;
+    while (success && !producerDone.load(std::memory_order_acquire)) {
+        success = reader.HandleCommands(&handler);
+        if (++iterations % 16 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    if (!success) {
+        reader.Close();
+    }
+    producer.join();
+    ASSERT_TRUE(success);
+    ASSERT_TRUE(reader.HandleCommands(&handler));
+    EXPECT_EQ(handler.received, expected);
+}
+
+// Test that the serializer stops waiting for space once the reader is closed.
+TEST(WireSharedMemoryTests, RingBufferClosed) {
+    auto region = utils::SharedMemoryRegion::Create(utils::kMinRingBufferSize);
+    ASSERT_NE(region, nullptr);
+    utils::RingBufferCommandSerializer serializer(region->GetData(), region->GetSize());
+    utils::RingBufferCommandReader reader(region->GetData(), region->GetSize());
+
+    reader.Close();
+    const size_t size = serializer.GetMaximumAllocationSize();
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_NE(serializer.GetCmdSpace(size), nullptr);
+    }
+    EXPECT_EQ(serializer.GetCmdSpace(size), nullptr);
+    EXPECT_FALSE(serializer.Flush());
+}
+
+class WireSharedMemoryTransferServiceTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        region = utils::SharedMemoryRegion::Create(kRegionSize);
+        ASSERT_NE(region, nullptr);
+        clientService =
+            utils::CreateSharedMemoryClientTransferService(region->GetData(), region->GetSize());
+        serverService =
+            utils::CreateSharedMemoryServerTransferService(region->GetData(), region->GetSize());
+    }
+
+    template <typename ClientHandle>
+    std::vector<char> SerializeCreate(ClientHandle* handle) {
+        std::vector<char> serialized(handle->SerializeCreateSize());
+        handle->SerializeCreate(serialized.data());
+        return serialized;
+    }
+
+    static constexpr size_t kRegionSize = 1024 * 1024;
+
+    std::unique_ptr<utils::SharedMemoryRegion> region;
+    std::unique_ptr<client::MemoryTransferService> clientService;
+    std::unique_ptr<server::MemoryTransferService> serverService;
+};
+
+// Test that the data written by the client is copied by the server without going through the wire.
+TEST_F(WireSharedMemoryTransferServiceTests, WriteHandle) {
+    constexpr size_t kSize = 10000;
+    std::unique_ptr<client::MemoryTransferService::WriteHandle> clientHandle(
+        clientService->CreateWriteHandle(kSize));
+    ASSERT_NE(clientHandle, nullptr);
+
+    std::vector<char> create = SerializeCreate(clientHandle.get());
+    server::MemoryTransferService::WriteHandle* serverHandlePtr = nullptr;
+    ASSERT_TRUE(
+        serverService->DeserializeWriteHandle(create.data(), create.size(), &serverHandlePtr));
+    std::unique_ptr<server::MemoryTransferService::WriteHandle> serverHandle(serverHandlePtr);
+
+    std::vector<uint8_t> target(kSize, 0xFF);
+    serverHandle->SetTarget(target.data());
+    serverHandle->SetDataLength(kSize);
+
+    uint8_t* data = static_cast<uint8_t*>(clientHandle->GetData());
+    for (size_t i = 0; i < kSize; ++i) {
+        EXPECT_EQ(data[i], 0u);
+        data[i] = static_cast<uint8_t>(i);
+    }
+    EXPECT_EQ(clientHandle->SizeOfSerializeDataUpdate(100, 200), 0u);
+    clientHandle->SerializeDataUpdate(nullptr, 100, 200);
+
+    ASSERT_TRUE(serverHandle->DeserializeDataUpdate(nullptr, 0, 100, 200));
+    for (size_t i = 0; i < kSize; ++i) {
+        EXPECT_EQ(target[i], i >= 100 && i < 300 ? static_cast<uint8_t>(i) : 0xFF);
+    }
+
+    // Out of bounds updates are rejected.
+    EXPECT_FALSE(serverHandle->DeserializeDataUpdate(nullptr, 0, kSize - 1, 2));
+}
+
+// Test that the data written by the server is visible to the client without going through the
+// wire.
+TEST_F(WireSharedMemoryTransferServiceTests, ReadHandle) {
+    constexpr size_t kSize = 5000;
+    std::unique_ptr<client::MemoryTransferService::ReadHandle> clientHandle(
+        clientService->CreateReadHandle(kSize));
+    ASSERT_NE(clientHandle, nullptr);
+
+    std::vector<char> create = SerializeCreate(clientHandle.get());
+    server::MemoryTransferService::ReadHandle* serverHandlePtr = nullptr;
+    ASSERT_TRUE(
+        serverService->DeserializeReadHandle(create.data(), create.size(), &serverHandlePtr));
+    std::unique_ptr<server::MemoryTransferService::ReadHandle> serverHandle(serverHandlePtr);
+
+    std::vector<uint8_t> source(kSize);
+    for (size_t i = 0; i < kSize; ++i) {
+        source[i] = static_cast<uint8_t>(i * 3);
+    }
+    EXPECT_EQ(serverHandle->SizeOfSerializeDataUpdate(0, kSize), 0u);
+    serverHandle->SerializeDataUpdate(source.data(), 0, kSize, nullptr);
+
+    ASSERT_TRUE(clientHandle->DeserializeDataUpdate(nullptr, 0, 0, kSize));
+    EXPECT_EQ(memcmp(clientHandle->GetData(), source.data(), kSize), 0);
+
+    EXPECT_FALSE(clientHandle->DeserializeDataUpdate(nullptr, 0, 1, kSize));
+}
+
+// Test that the memory of a handle is only reused once both the client and the server handles
+// are destroyed.
+TEST_F(WireSharedMemoryTransferServiceTests, ReuseAfterClientAndServerRelease) {
+    // Find the largest handle that fits.
+    size_t size = kRegionSize;
+    std::unique_ptr<client::MemoryTransferService::WriteHandle> clientHandle;
+    while (clientHandle == nullptr) {
+        size -= 4096;
+        clientHandle.reset(clientService->CreateWriteHandle(size));
+    }
+    EXPECT_EQ(clientService->CreateWriteHandle(size), nullptr);
+
+    std::vector<char> create = SerializeCreate(clientHandle.get());
+    server::MemoryTransferService::WriteHandle* serverHandle = nullptr;
+    ASSERT_TRUE(serverService->DeserializeWriteHandle(create.data(), create.size(), &serverHandle));
+
+    clientHandle = nullptr;
+    EXPECT_EQ(clientService->CreateWriteHandle(size), nullptr);
+
+    delete serverHandle;
+    clientHandle.reset(clientService->CreateWriteHandle(size));
+    EXPECT_NE(clientHandle, nullptr);
+}
+
+// Test that the memory of a handle that was never serialized, so that the server never saw it, is
+// reused as soon as the client handle is destroyed.
+TEST_F(WireSharedMemoryTransferServiceTests, ReuseUnserializedHandle) {
+    size_t size = kRegionSize;
+    std::unique_ptr<client::MemoryTransferService::ReadHandle> clientHandle;
+    while (clientHandle == nullptr) {
+        size -= 4096;
+        clientHandle.reset(clientService->CreateReadHandle(size));
+    }
+
+    clientHandle = nullptr;
+    clientHandle.reset(clientService->CreateReadHandle(size));
+    EXPECT_NE(clientHandle, nullptr);
+}
+
+// Test that the server rejects handles that aren't in the shared memory.
+TEST_F(WireSharedMemoryTransferServiceTests, InvalidHandles) {
+    struct {
+        uint64_t offset;
+        uint64_t size;
+    } invalidHandles[] = {
+        {0, 16},                   // In the reference counts.
+        {kRegionSize, 16},         // After the end.
+        {kRegionSize - 4096, 8192},  // Overlapping the end.
+        {kRegionSize - 4095, 1},     // Not at the start of a block.
+    };
+    for (const auto& handle : invalidHandles) {
+        server::MemoryTransferService::ReadHandle* readHandle = nullptr;
+        EXPECT_FALSE(serverService->DeserializeReadHandle(&handle, sizeof(handle), &readHandle));
+        server::MemoryTransferService::WriteHandle* writeHandle = nullptr;
+        EXPECT_FALSE(serverService->DeserializeWriteHandle(&handle, sizeof(handle), &writeHandle));
+    }
+
+    server::MemoryTransferService::ReadHandle* readHandle = nullptr;
+    EXPECT_FALSE(serverService->DeserializeReadHandle(&invalidHandles[0], 1, &readHandle));
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
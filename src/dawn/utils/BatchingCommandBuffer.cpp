@@ -0,0 +1,90 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/utils/BatchingCommandBuffer.h"
+
+#include "dawn/common/Assert.h"
+
+namespace dawn::utils {
+
+BatchingCommandBuffer::BatchingCommandBuffer(size_t batchSize)
+    : BatchingCommandBuffer(nullptr, batchSize) {}
+
+BatchingCommandBuffer::BatchingCommandBuffer(dawn::wire::CommandHandler* handler,
+                                             size_t batchSize)
+    : mHandler(handler), mBatchSize(batchSize), mBuffer(new char[batchSize]) {
+    ASSERT(batchSize > 0);
+}
+
+BatchingCommandBuffer::~BatchingCommandBuffer() = default;
+
+void BatchingCommandBuffer::SetHandler(dawn::wire::CommandHandler* handler) {
+    mHandler = handler;
+}
+
+size_t BatchingCommandBuffer::GetMaximumAllocationSize() const {
+    return mBatchSize;
+}
+
+void* BatchingCommandBuffer::GetCmdSpace(size_t size) {
+    // Note: This returns non-null even if size is zero.
+    if (size > mBatchSize) {
+        return nullptr;
+    }
+    if (mBatchSize - size < mOffset) {
+        if (!Flush()) {
+            return nullptr;
+        }
+    }
+
+    char* result = &mBuffer[mOffset];
+    mOffset += size;
+    return result;
+}
+
+bool BatchingCommandBuffer::Flush() {
+    if (mOffset == 0) {
+        return true;
+    }
+    bool success = HandleCommands(mBuffer.get(), mOffset);
+    mOffset = 0;
+    return success;
+}
+
+bool BatchingCommandBuffer::SerializeCommandPayloads(const dawn::wire::CommandPayload* payloads,
+                                                     size_t count) {
+    // The commands already batched must be handled first to preserve the order of commands. Then
+    // the payloads are handled in place, which the handler sees as the chunks of a command that
+    // is larger than a batch.
+    if (!Flush()) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (payloads[i].size > 0 && !HandleCommands(payloads[i].data, payloads[i].size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t BatchingCommandBuffer::GetHandleCommandsCount() const {
+    return mHandleCommandsCount;
+}
+
+bool BatchingCommandBuffer::HandleCommands(const void* commands, size_t size) {
+    mHandleCommandsCount++;
+    return mHandler->HandleCommands(static_cast<const volatile char*>(commands), size) != nullptr;
+}
+
+}  // namespace dawn::utils
@@ -0,0 +1,60 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_UTILS_BATCHINGCOMMANDBUFFER_H_
+#define SRC_DAWN_UTILS_BATCHINGCOMMANDBUFFER_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "dawn/wire/Wire.h"
+
+namespace dawn::utils {
+
+// An in-process CommandSerializer that coalesces commands in batches of |batchSize| bytes, which
+// are handed to the handler when full or on Flush. Commands larger than a batch are handed to the
+// handler one payload at a time, without copying their inline data.
+class BatchingCommandBuffer : public dawn::wire::CommandSerializer {
+  public:
+    static constexpr size_t kDefaultBatchSize = 1 << 20;
+
+    explicit BatchingCommandBuffer(size_t batchSize = kDefaultBatchSize);
+    BatchingCommandBuffer(dawn::wire::CommandHandler* handler, size_t batchSize);
+    ~BatchingCommandBuffer() override;
+
+    void SetHandler(dawn::wire::CommandHandler* handler);
+
+    size_t GetMaximumAllocationSize() const override;
+
+    void* GetCmdSpace(size_t size) override;
+    bool Flush() override;
+    bool SerializeCommandPayloads(const dawn::wire::CommandPayload* payloads,
+                                  size_t count) override;
+
+    // The number of calls made to the handler so far.
+    uint64_t GetHandleCommandsCount() const;
+
+  private:
+    bool HandleCommands(const void* commands, size_t size);
+
+    dawn::wire::CommandHandler* mHandler = nullptr;
+    size_t mBatchSize;
+    size_t mOffset = 0;
+    std::unique_ptr<char[]> mBuffer;
+    uint64_t mHandleCommandsCount = 0;
+};
+
+}  // namespace dawn::utils
+
+#endif  // SRC_DAWN_UTILS_BATCHINGCOMMANDBUFFER_H_
@@ -0,0 +1,185 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/utils/RingBufferCommandBuffer.h"
+
+#include <atomic>
+#include <thread>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+
+namespace dawn::utils {
+
+// Lives at the start of the shared memory. The offsets are written by a single process each, and
+// are on separate cache lines to avoid false sharing.
+struct RingBufferHeader {
+    alignas(64) std::atomic<uint64_t> writeOffset;
+    alignas(64) std::atomic<uint64_t> readOffset;
+    std::atomic<uint32_t> closed;
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+namespace {
+
+// Each frame starts with its size, and frames start at multiples of kFrameAlignment. A frame size
+// of kWrapMarker means that the next frame is at the start of the ring buffer.
+constexpr size_t kFrameAlignment = sizeof(uint64_t);
+constexpr size_t kFrameHeaderSize = sizeof(uint64_t);
+constexpr uint64_t kWrapMarker = ~uint64_t(0);
+
+constexpr size_t kDataOffset = sizeof(RingBufferHeader);
+static_assert(kDataOffset % 64 == 0);
+
+size_t GetCapacity(size_t size) {
+    ASSERT(size >= kMinRingBufferSize);
+    return (size - kDataOffset) & ~(kFrameAlignment - 1);
+}
+
+}  // anonymous namespace
+
+RingBufferCommandSerializer::RingBufferCommandSerializer(void* sharedMemory, size_t size)
+    : mHeader(static_cast<RingBufferHeader*>(sharedMemory)),
+      mData(static_cast<char*>(sharedMemory) + kDataOffset),
+      mCapacity(GetCapacity(size)) {}
+
+RingBufferCommandSerializer::~RingBufferCommandSerializer() = default;
+
+size_t RingBufferCommandSerializer::GetMaximumAllocationSize() const {
+    return (mCapacity / 4) & ~(kFrameAlignment - 1);
+}
+
+void* RingBufferCommandSerializer::GetCmdSpace(size_t size) {
+    ASSERT(size <= GetMaximumAllocationSize());
+
+    // Allocations are appended to the open frame if they fit before the end of the ring buffer.
+    // Otherwise the frame is published first, which also lets the reader make space if the ring
+    // buffer is full.
+    if (mFrameOpen) {
+        // Frames never wrap, so the end of the frame is computed from its start. Taking the end
+        // modulo |mCapacity| would give 0 for a frame that ends exactly at the end of the ring
+        // buffer.
+        size_t position = mWriteOffset % mCapacity + (mFrameEnd - mWriteOffset);
+        if (position + size > mCapacity ||
+            mFrameEnd + size - mHeader->readOffset.load(std::memory_order_acquire) > mCapacity) {
+            PublishFrame();
+        }
+    }
+
+    if (!mFrameOpen) {
+        size_t position = mWriteOffset % mCapacity;
+        if (position + kFrameHeaderSize + size > mCapacity) {
+            if (!WaitForSpace(mWriteOffset + kFrameHeaderSize)) {
+                return nullptr;
+            }
+            *reinterpret_cast<uint64_t*>(mData + position) = kWrapMarker;
+            mWriteOffset += mCapacity - position;
+            mHeader->writeOffset.store(mWriteOffset, std::memory_order_release);
+        }
+
+        if (!WaitForSpace(mWriteOffset + kFrameHeaderSize + size)) {
+            return nullptr;
+        }
+        mFrameOpen = true;
+        mFrameEnd = mWriteOffset + kFrameHeaderSize;
+    }
+
+    char* result = mData + mFrameEnd % mCapacity;
+    mFrameEnd += size;
+    return result;
+}
+
+bool RingBufferCommandSerializer::Flush() {
+    if (mFrameOpen) {
+        PublishFrame();
+    }
+    return mHeader->closed.load(std::memory_order_relaxed) == 0;
+}
+
+bool RingBufferCommandSerializer::WaitForSpace(uint64_t end) {
+    uint32_t spinCount = 0;
+    while (end - mHeader->readOffset.load(std::memory_order_acquire) > mCapacity) {
+        if (mHeader->closed.load(std::memory_order_relaxed) != 0) {
+            return false;
+        }
+        // Spin for a short while since the reader is often about to make progress, then yield
+        // to avoid starving it when there are fewer cores than threads.
+        if (++spinCount > 64) {
+            std::this_thread::yield();
+        }
+    }
+    return true;
+}
+
+void RingBufferCommandSerializer::PublishFrame() {
+    ASSERT(mFrameOpen);
+    *reinterpret_cast<uint64_t*>(mData + mWriteOffset % mCapacity) =
+        mFrameEnd - mWriteOffset - kFrameHeaderSize;
+    mWriteOffset = Align(mFrameEnd, kFrameAlignment);
+    mHeader->writeOffset.store(mWriteOffset, std::memory_order_release);
+    mFrameOpen = false;
+}
+
+RingBufferCommandReader::RingBufferCommandReader(void* sharedMemory, size_t size)
+    : mHeader(static_cast<RingBufferHeader*>(sharedMemory)),
+      mData(static_cast<char*>(sharedMemory) + kDataOffset),
+      mCapacity(GetCapacity(size)) {}
+
+RingBufferCommandReader::~RingBufferCommandReader() = default;
+
+bool RingBufferCommandReader::HasCommands() const {
+    return mHeader->writeOffset.load(std::memory_order_relaxed) != mReadOffset;
+}
+
+bool RingBufferCommandReader::HandleCommands(dawn::wire::CommandHandler* handler) {
+    uint64_t writeOffset = mHeader->writeOffset.load(std::memory_order_acquire);
+    if (writeOffset - mReadOffset > mCapacity || writeOffset % kFrameAlignment != 0) {
+        return false;
+    }
+
+    while (mReadOffset != writeOffset) {
+        // The other process could modify the frame size at any time so it must be read once and
+        // validated before being used.
+        size_t position = mReadOffset % mCapacity;
+        uint64_t frameSize = *reinterpret_cast<const volatile uint64_t*>(mData + position);
+        uint64_t frameEnd;
+        if (frameSize == kWrapMarker) {
+            frameEnd = mReadOffset + (mCapacity - position);
+        } else if (frameSize <= mCapacity - position - kFrameHeaderSize) {
+            frameEnd = Align(mReadOffset + kFrameHeaderSize + frameSize, kFrameAlignment);
+        } else {
+            return false;
+        }
+        if (frameEnd - mReadOffset > writeOffset - mReadOffset) {
+            return false;
+        }
+
+        if (frameSize != kWrapMarker &&
+            handler->HandleCommands(mData + position + kFrameHeaderSize,
+                                    static_cast<size_t>(frameSize)) == nullptr) {
+            return false;
+        }
+
+        mReadOffset = frameEnd;
+        mHeader->readOffset.store(mReadOffset, std::memory_order_release);
+    }
+    return true;
+}
+
+void RingBufferCommandReader::Close() {
+    mHeader->closed.store(1, std::memory_order_relaxed);
+}
+
+}  // namespace dawn::utils
@@ -0,0 +1,89 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_UTILS_RINGBUFFERCOMMANDBUFFER_H_
+#define SRC_DAWN_UTILS_RINGBUFFERCOMMANDBUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dawn/wire/Wire.h"
+
+namespace dawn::utils {
+
+struct RingBufferHeader;
+
+// A single-producer single-consumer ring buffer of wire commands in a block of memory shared by
+// two processes, for example a SharedMemoryRegion. RingBufferCommandSerializer writes commands
+// directly in the ring buffer and publishes them on Flush, and RingBufferCommandReader hands the
+// published commands to a CommandHandler in place.
+//
+// The shared memory must be zero-initialized and at least kMinRingBufferSize bytes large. The
+// commands are stored in frames that are never split at the end of the ring buffer, so allocations
+// are limited to a quarter of its size.
+static constexpr size_t kMinRingBufferSize = 4096;
+
+class RingBufferCommandSerializer : public dawn::wire::CommandSerializer {
+  public:
+    RingBufferCommandSerializer(void* sharedMemory, size_t size);
+    ~RingBufferCommandSerializer() override;
+
+    size_t GetMaximumAllocationSize() const override;
+
+    // Waits for the reader to free enough space if the ring buffer is full. Returns nullptr if the
+    // reader was closed.
+    void* GetCmdSpace(size_t size) override;
+    bool Flush() override;
+
+  private:
+    bool WaitForSpace(uint64_t end);
+    void PublishFrame();
+
+    RingBufferHeader* mHeader;
+    char* mData;
+    size_t mCapacity;
+
+    // The offsets only increase, and are taken modulo |mCapacity| to index |mData|.
+    uint64_t mWriteOffset = 0;
+    bool mFrameOpen = false;
+    uint64_t mFrameEnd = 0;
+};
+
+class RingBufferCommandReader {
+  public:
+    RingBufferCommandReader(void* sharedMemory, size_t size);
+    ~RingBufferCommandReader();
+
+    // Returns whether commands were published since the last call to HandleCommands.
+    bool HasCommands() const;
+
+    // Hands all the published commands to |handler|. Returns false if the handler failed or the
+    // contents of the ring buffer are invalid.
+    bool HandleCommands(dawn::wire::CommandHandler* handler);
+
+    // Makes the serializer fail instead of waiting for space, for example when the reader is
+    // being destroyed.
+    void Close();
+
+  private:
+    RingBufferHeader* mHeader;
+    const volatile char* mData;
+    size_t mCapacity;
+
+    uint64_t mReadOffset = 0;
+};
+
+}  // namespace dawn::utils
+
+#endif  // SRC_DAWN_UTILS_RINGBUFFERCOMMANDBUFFER_H_
@@ -0,0 +1,68 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/utils/SharedMemory.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "dawn/common/Assert.h"
+
+namespace dawn::utils {
+
+// static
+std::unique_ptr<SharedMemoryRegion> SharedMemoryRegion::Create(size_t size) {
+    int fd = memfd_create("dawn-wire-shared-memory", MFD_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    return FromFd(fd, size);
+}
+
+// static
+std::unique_ptr<SharedMemoryRegion> SharedMemoryRegion::FromFd(int fd, size_t size) {
+    ASSERT(size > 0);
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<SharedMemoryRegion>(new SharedMemoryRegion(fd, data, size));
+}
+
+SharedMemoryRegion::SharedMemoryRegion(int fd, void* data, size_t size)
+    : mFd(fd), mData(data), mSize(size) {}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    munmap(mData, mSize);
+    close(mFd);
+}
+
+void* SharedMemoryRegion::GetData() const {
+    return mData;
+}
+
+size_t SharedMemoryRegion::GetSize() const {
+    return mSize;
+}
+
+int SharedMemoryRegion::GetFd() const {
+    return mFd;
+}
+
+}  // namespace dawn::utils
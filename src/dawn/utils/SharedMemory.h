@@ -0,0 +1,51 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_UTILS_SHAREDMEMORY_H_
+#define SRC_DAWN_UTILS_SHAREDMEMORY_H_
+
+#include <cstddef>
+#include <memory>
+
+namespace dawn::utils {
+
+// A region of memory backed by an anonymous memfd that can be mapped by several processes, either
+// by inheriting the file descriptor across fork() or by sending it over a Unix socket.
+class SharedMemoryRegion {
+  public:
+    // Creates a new zero-initialized region. Returns nullptr on failure.
+    static std::unique_ptr<SharedMemoryRegion> Create(size_t size);
+    // Maps |size| bytes of the region referred to by |fd|, and takes ownership of |fd|. Returns
+    // nullptr on failure, in which case |fd| is closed.
+    static std::unique_ptr<SharedMemoryRegion> FromFd(int fd, size_t size);
+
+    ~SharedMemoryRegion();
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+    void* GetData() const;
+    size_t GetSize() const;
+    int GetFd() const;
+
+  private:
+    SharedMemoryRegion(int fd, void* data, size_t size);
+
+    int mFd;
+    void* mData;
+    size_t mSize;
+};
+
+}  // namespace dawn::utils
+
+#endif  // SRC_DAWN_UTILS_SHAREDMEMORY_H_
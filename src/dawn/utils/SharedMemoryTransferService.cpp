@@ -0,0 +1,349 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/utils/SharedMemoryTransferService.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+
+namespace dawn::utils {
+
+namespace {
+
+constexpr size_t kBlockSize = 4096;
+
+using RefCount = std::atomic<uint32_t>;
+static_assert(RefCount::is_always_lock_free);
+
+// What is serialized for the creation of a handle. The offset is from the start of the shared
+// memory.
+struct HandleInfo {
+    uint64_t offset;
+    uint64_t size;
+};
+
+// The shared memory starts with one reference count per block, followed by the blocks. Handles
+// are spans of blocks, and the reference count of their first block is set to 2 by the client
+// when allocating the span. It is decremented by the client and server handles when they are
+// destroyed, so that the client can reuse the span once it reaches 0.
+class SharedMemoryLayout {
+  public:
+    SharedMemoryLayout(void* sharedMemory, size_t size)
+        : mMemory(static_cast<uint8_t*>(sharedMemory)) {
+        size_t blockCount = size / (kBlockSize + sizeof(RefCount));
+        mDataOffset = Align(blockCount * sizeof(RefCount), kBlockSize);
+        mBlockCount = size > mDataOffset ? (size - mDataOffset) / kBlockSize : 0;
+        ASSERT(mBlockCount <= blockCount);
+    }
+
+    size_t GetBlockCount() const { return mBlockCount; }
+
+    RefCount* GetRefCount(size_t block) const {
+        ASSERT(block < mBlockCount);
+        return reinterpret_cast<RefCount*>(mMemory) + block;
+    }
+
+    uint8_t* GetBlockData(size_t block) const {
+        ASSERT(block < mBlockCount);
+        return mMemory + mDataOffset + block * kBlockSize;
+    }
+
+    uint64_t GetBlockOffset(size_t block) const { return mDataOffset + block * kBlockSize; }
+
+    // Returns whether the handle info describes a range of the blocks starting at the beginning
+    // of a block, and the index of that block.
+    bool GetFirstBlock(const HandleInfo& info, size_t* firstBlock) const {
+        if (info.offset < mDataOffset || (info.offset - mDataOffset) % kBlockSize != 0) {
+            return false;
+        }
+        uint64_t block = (info.offset - mDataOffset) / kBlockSize;
+        if (block >= mBlockCount || info.size > (mBlockCount - block) * kBlockSize) {
+            return false;
+        }
+        *firstBlock = static_cast<size_t>(block);
+        return true;
+    }
+
+  private:
+    uint8_t* mMemory;
+    size_t mDataOffset;
+    size_t mBlockCount;
+};
+
+bool IsInRange(size_t offset, size_t size, size_t rangeSize) {
+    return offset <= rangeSize && size <= rangeSize - offset;
+}
+
+class ClientTransferService : public dawn::wire::client::MemoryTransferService {
+    // A span of blocks allocated for a handle, released when the handle is destroyed. The server
+    // only learns about the span when the handle is serialized, so the span also drops the
+    // server's reference if it never was.
+    class Span {
+      public:
+        Span(ClientTransferService* service, size_t firstBlock, size_t size)
+            : mService(service), mFirstBlock(firstBlock), mSize(size) {}
+        ~Span() { mService->Release(mFirstBlock, mSerialized ? 1 : 2); }
+
+        void* GetData() const { return mService->mLayout.GetBlockData(mFirstBlock); }
+        size_t GetSize() const { return mSize; }
+
+        void SerializeCreate(void* serializePointer) {
+            HandleInfo info = {mService->mLayout.GetBlockOffset(mFirstBlock), mSize};
+            memcpy(serializePointer, &info, sizeof(info));
+            mSerialized = true;
+        }
+
+      private:
+        ClientTransferService* mService;
+        size_t mFirstBlock;
+        size_t mSize;
+        bool mSerialized = false;
+    };
+
+    class ReadHandleImpl : public ReadHandle {
+      public:
+        explicit ReadHandleImpl(std::unique_ptr<Span> span) : mSpan(std::move(span)) {}
+        ~ReadHandleImpl() override = default;
+
+        size_t SerializeCreateSize() override { return sizeof(HandleInfo); }
+
+        void SerializeCreate(void* serializePointer) override {
+            mSpan->SerializeCreate(serializePointer);
+        }
+
+        const void* GetData() override { return mSpan->GetData(); }
+
+        bool DeserializeDataUpdate(const void* deserializePointer,
+                                   size_t deserializeSize,
+                                   size_t offset,
+                                   size_t size) override {
+            // The server already wrote the data in the shared memory.
+            return deserializeSize == 0 && IsInRange(offset, size, mSpan->GetSize());
+        }
+
+      private:
+        std::unique_ptr<Span> mSpan;
+    };
+
+    class WriteHandleImpl : public WriteHandle {
+      public:
+        explicit WriteHandleImpl(std::unique_ptr<Span> span) : mSpan(std::move(span)) {}
+        ~WriteHandleImpl() override = default;
+
+        size_t SerializeCreateSize() override { return sizeof(HandleInfo); }
+
+        void SerializeCreate(void* serializePointer) override {
+            mSpan->SerializeCreate(serializePointer);
+        }
+
+        void* GetData() override { return mSpan->GetData(); }
+
+        size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override {
+            ASSERT(IsInRange(offset, size, mSpan->GetSize()));
+            return 0;
+        }
+
+        // The server reads the data directly from the shared memory.
+        void SerializeDataUpdate(void* serializePointer, size_t offset, size_t size) override {}
+
+      private:
+        std::unique_ptr<Span> mSpan;
+    };
+
+  public:
+    ClientTransferService(void* sharedMemory, size_t size) : mLayout(sharedMemory, size) {}
+    ~ClientTransferService() override = default;
+
+    ReadHandle* CreateReadHandle(size_t size) override {
+        std::unique_ptr<Span> span = Allocate(size);
+        if (span == nullptr) {
+            return nullptr;
+        }
+        return new ReadHandleImpl(std::move(span));
+    }
+
+    WriteHandle* CreateWriteHandle(size_t size) override {
+        std::unique_ptr<Span> span = Allocate(size);
+        if (span == nullptr) {
+            return nullptr;
+        }
+        memset(span->GetData(), 0, size);
+        return new WriteHandleImpl(std::move(span));
+    }
+
+  private:
+    std::unique_ptr<Span> Allocate(size_t size) {
+        size_t blockCount = std::max(size_t(1), (size + kBlockSize - 1) / kBlockSize);
+        if (size > mLayout.GetBlockCount() * kBlockSize) {
+            return nullptr;
+        }
+
+        // Reclaim the spans that the server doesn't use anymore.
+        auto isUnused = [this](size_t firstBlock) {
+            if (mLayout.GetRefCount(firstBlock)->load(std::memory_order_acquire) != 0) {
+                return false;
+            }
+            mSpans.erase(firstBlock);
+            return true;
+        };
+        mReleasedSpans.erase(
+            std::remove_if(mReleasedSpans.begin(), mReleasedSpans.end(), isUnused),
+            mReleasedSpans.end());
+
+        // Find the first gap between the spans that is large enough.
+        size_t firstBlock = 0;
+        for (const auto& [spanFirstBlock, spanBlockCount] : mSpans) {
+            if (spanFirstBlock - firstBlock >= blockCount) {
+                break;
+            }
+            firstBlock = spanFirstBlock + spanBlockCount;
+        }
+        if (mLayout.GetBlockCount() - firstBlock < blockCount) {
+            return nullptr;
+        }
+
+        mSpans[firstBlock] = blockCount;
+        mLayout.GetRefCount(firstBlock)->store(2, std::memory_order_relaxed);
+        return std::make_unique<Span>(this, firstBlock, size);
+    }
+
+    void Release(size_t firstBlock, uint32_t references) {
+        mLayout.GetRefCount(firstBlock)->fetch_sub(references, std::memory_order_release);
+        mReleasedSpans.push_back(firstBlock);
+    }
+
+    SharedMemoryLayout mLayout;
+    // The first block and block count of all the spans that are in use by the client or the server.
+    std::map<size_t, size_t> mSpans;
+    // The spans that the client doesn't use anymore but the server might.
+    std::vector<size_t> mReleasedSpans;
+};
+
+class ServerTransferService : public dawn::wire::server::MemoryTransferService {
+    class ReadHandleImpl : public ReadHandle {
+      public:
+        ReadHandleImpl(RefCount* refCount, uint8_t* data, size_t size)
+            : mRefCount(refCount), mData(data), mSize(size) {}
+        ~ReadHandleImpl() override { mRefCount->fetch_sub(1, std::memory_order_release); }
+
+        size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override { return 0; }
+
+        void SerializeDataUpdate(const void* data,
+                                 size_t offset,
+                                 size_t size,
+                                 void* serializePointer) override {
+            // Copy the data directly in the shared memory. The client will fail to deserialize
+            // the update if the range doesn't fit in the handle.
+            if (size > 0 && IsInRange(offset, size, mSize)) {
+                ASSERT(data != nullptr);
+                memcpy(mData + offset, data, size);
+            }
+        }
+
+      private:
+        RefCount* mRefCount;
+        uint8_t* mData;
+        size_t mSize;
+    };
+
+    class WriteHandleImpl : public WriteHandle {
+      public:
+        WriteHandleImpl(RefCount* refCount, uint8_t* data, size_t size)
+            : mRefCount(refCount), mData(data), mSize(size) {}
+        ~WriteHandleImpl() override { mRefCount->fetch_sub(1, std::memory_order_release); }
+
+        bool DeserializeDataUpdate(const void* deserializePointer,
+                                   size_t deserializeSize,
+                                   size_t offset,
+                                   size_t size) override {
+            if (deserializeSize != 0 || mTargetData == nullptr) {
+                return false;
+            }
+            if (!IsInRange(offset, size, mDataLength) || !IsInRange(offset, size, mSize)) {
+                return false;
+            }
+            memcpy(static_cast<uint8_t*>(mTargetData) + offset, mData + offset, size);
+            return true;
+        }
+
+      private:
+        RefCount* mRefCount;
+        uint8_t* mData;
+        size_t mSize;
+    };
+
+  public:
+    ServerTransferService(void* sharedMemory, size_t size) : mLayout(sharedMemory, size) {}
+    ~ServerTransferService() override = default;
+
+    bool DeserializeReadHandle(const void* deserializePointer,
+                               size_t deserializeSize,
+                               ReadHandle** readHandle) override {
+        size_t firstBlock;
+        HandleInfo info;
+        if (!DeserializeHandleInfo(deserializePointer, deserializeSize, &info, &firstBlock)) {
+            return false;
+        }
+        *readHandle = new ReadHandleImpl(mLayout.GetRefCount(firstBlock),
+                                         mLayout.GetBlockData(firstBlock), info.size);
+        return true;
+    }
+
+    bool DeserializeWriteHandle(const void* deserializePointer,
+                                size_t deserializeSize,
+                                WriteHandle** writeHandle) override {
+        size_t firstBlock;
+        HandleInfo info;
+        if (!DeserializeHandleInfo(deserializePointer, deserializeSize, &info, &firstBlock)) {
+            return false;
+        }
+        *writeHandle = new WriteHandleImpl(mLayout.GetRefCount(firstBlock),
+                                           mLayout.GetBlockData(firstBlock), info.size);
+        return true;
+    }
+
+  private:
+    bool DeserializeHandleInfo(const void* deserializePointer,
+                               size_t deserializeSize,
+                               HandleInfo* info,
+                               size_t* firstBlock) const {
+        if (deserializeSize != sizeof(HandleInfo) || deserializePointer == nullptr) {
+            return false;
+        }
+        memcpy(info, deserializePointer, sizeof(HandleInfo));
+        return mLayout.GetFirstBlock(*info, firstBlock);
+    }
+
+    SharedMemoryLayout mLayout;
+};
+
+}  // anonymous namespace
+
+std::unique_ptr<dawn::wire::client::MemoryTransferService>
+CreateSharedMemoryClientTransferService(void* sharedMemory, size_t size) {
+    return std::make_unique<ClientTransferService>(sharedMemory, size);
+}
+
+std::unique_ptr<dawn::wire::server::MemoryTransferService>
+CreateSharedMemoryServerTransferService(void* sharedMemory, size_t size) {
+    return std::make_unique<ServerTransferService>(sharedMemory, size);
+}
+
+}  // namespace dawn::utils
@@ -0,0 +1,41 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
+#define SRC_DAWN_UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
+
+#include <cstddef>
+#include <memory>
+
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+
+namespace dawn::utils {
+
+// MemoryTransferServices whose read and write handles are ranges of a block of memory shared by
+// the client and server processes, for example a SharedMemoryRegion. The mapped data of buffers
+// is read and written in place by the client, and copied between the shared memory and the
+// buffers by the server, so only the offset and size of the handles go through the wire.
+//
+// The shared memory must be zero-initialized, have the same size on both sides, and outlive the
+// services and all their handles. The shared memory keeps track of which ranges are still used
+// by the server so that the client doesn't reuse them too early.
+std::unique_ptr<dawn::wire::client::MemoryTransferService>
+CreateSharedMemoryClientTransferService(void* sharedMemory, size_t size);
+std::unique_ptr<dawn::wire::server::MemoryTransferService>
+CreateSharedMemoryServerTransferService(void* sharedMemory, size_t size);
+
+}  // namespace dawn::utils
+
+#endif  // SRC_DAWN_UTILS_SHAREDMEMORYTRANSFERSERVICE_H_
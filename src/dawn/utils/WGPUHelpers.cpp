@@ -23,6 +23,7 @@
 #include "dawn/common/Constants.h"
 #include "dawn/common/Log.h"
 #include "dawn/common/Numeric.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
 
 #if TINT_BUILD_SPV_READER
 #include "spirv-tools/optimizer.hpp"
@@ -214,6 +215,32 @@ BasicRenderPass CreateBasicRenderPass(const wgpu::Device& device,
     return BasicRenderPass(width, height, color);
 }
 
+DynamicOffsetPipeline CreateDynamicOffsetPipeline(const wgpu::Device& device) {
+    DynamicOffsetPipeline result;
+    result.bindGroupLayout = MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Vertex, wgpu::BufferBindingType::Uniform, true}});
+
+    ComboRenderPipelineDescriptor descriptor;
+    descriptor.layout = MakePipelineLayout(device, {result.bindGroupLayout});
+    descriptor.vertex.module = CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<uniform> offset : vec4f;
+        @vertex fn main(@location(0) pos : vec4f) -> @builtin(position) vec4f {
+            return pos + offset;
+        })");
+    descriptor.cFragment.module = CreateShaderModule(device, R"(
+        @fragment fn main() -> @location(0) vec4f {
+            return vec4f(1.0);
+        })");
+    descriptor.vertex.bufferCount = 1;
+    descriptor.cBuffers[0].arrayStride = 4 * sizeof(float);
+    descriptor.cBuffers[0].attributeCount = 1;
+    descriptor.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+    descriptor.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+    result.pipeline = device.CreateRenderPipeline(&descriptor);
+
+    return result;
+}
+
 wgpu::ImageCopyBuffer CreateImageCopyBuffer(wgpu::Buffer buffer,
                                             uint64_t offset,
                                             uint32_t bytesPerRow,
@@ -183,6 +183,15 @@ wgpu::BindGroup MakeBindGroup(
     const wgpu::BindGroupLayout& layout,
     std::initializer_list<BindingInitializationHelper> entriesInitializer);
 
+// A render pipeline that adds a vec4f read from a uniform buffer to the vec4f position read from
+// vertex buffer 0. The uniform buffer is bound at group 0, binding 0 with a dynamic offset, so that
+// encoding tests can change the offset for every draw. It renders to one RGBA8Unorm attachment.
+struct DynamicOffsetPipeline {
+    wgpu::BindGroupLayout bindGroupLayout;
+    wgpu::RenderPipeline pipeline;
+};
+DynamicOffsetPipeline CreateDynamicOffsetPipeline(const wgpu::Device& device);
+
 struct ColorSpaceConversionInfo {
     std::array<float, 12> yuvToRgbConversionMatrix;
     std::array<float, 9> gamutConversionMatrix;
@@ -16,9 +16,12 @@
 #define SRC_DAWN_WIRE_BUFFERCONSUMER_H_
 
 #include <cstddef>
+#include <vector>
 
+#include "dawn/common/Assert.h"
 #include "dawn/common/Constants.h"
 #include "dawn/common/Math.h"
+#include "dawn/wire/Wire.h"
 #include "dawn/wire/WireResult.h"
 
 namespace dawn::wire {
@@ -64,11 +67,40 @@ class BufferConsumer {
     size_t mSize;
 };
 
+// SerializeBuffer can optionally gather the serialized command into a list of CommandPayloads
+// instead of a contiguous buffer. In that mode, large inline data passed to NextData is referenced
+// in place instead of being copied, and doesn't take any space in |buffer|.
 class SerializeBuffer : public BufferConsumer<char> {
   public:
     using BufferConsumer::BufferConsumer;
     using BufferConsumer::Next;
     using BufferConsumer::NextN;
+
+    SerializeBuffer(char* buffer, size_t size, std::vector<CommandPayload>* gatheredPayloads)
+        : BufferConsumer(buffer, size),
+          mGatheredPayloads(gatheredPayloads),
+          mSegmentStart(buffer) {}
+
+    // Serializes |count| bytes of |data|, followed by padding up to the wire alignment.
+    template <typename N>
+    WireResult NextData(N count, const void* data);
+
+    // Appends the bytes serialized since the last gathered data to the gathered payloads. Must be
+    // called once the whole command is serialized, in gather mode.
+    void EndGather() {
+        ASSERT(mGatheredPayloads != nullptr);
+        mGatheredPayloads->push_back(
+            {mSegmentStart, static_cast<size_t>(Buffer() - mSegmentStart)});
+        mSegmentStart = Buffer();
+    }
+
+  private:
+    // Inline data smaller than this is copied in the buffer even in gather mode since it is cheaper
+    // than adding payloads.
+    static constexpr size_t kMinGatheredDataSize = 4096;
+
+    std::vector<CommandPayload>* mGatheredPayloads = nullptr;
+    const char* mSegmentStart = nullptr;
 };
 
 class DeserializeBuffer : public BufferConsumer<const volatile char> {
@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_WIRE_BUFFERCONSUMER_IMPL_H_
 #define SRC_DAWN_WIRE_BUFFERCONSUMER_IMPL_H_
 
+#include <cstring>
 #include <limits>
 #include <type_traits>
 
@@ -64,6 +65,32 @@ WireResult BufferConsumer<BufferT>::NextN(N count, T** data) {
     return WireResult::Success;
 }
 
+template <typename N>
+WireResult SerializeBuffer::NextData(N count, const void* data) {
+    if (mGatheredPayloads == nullptr || count < kMinGatheredDataSize) {
+        char* dataBuffer;
+        WIRE_TRY(NextN(count, &dataBuffer));
+        memcpy(dataBuffer, data, count);
+        return WireResult::Success;
+    }
+
+    auto alignedSize = WireAlignSizeofN<char>(count);
+    if (!alignedSize) {
+        return WireResult::FatalError;
+    }
+
+    // Reference the data in place, followed by zeroes for the alignment padding.
+    static constexpr char kZeroPadding[kWireBufferAlignment] = {};
+    size_t paddingSize = *alignedSize - count;
+    mGatheredPayloads->push_back({mSegmentStart, static_cast<size_t>(Buffer() - mSegmentStart)});
+    mGatheredPayloads->push_back({data, static_cast<size_t>(count)});
+    if (paddingSize > 0) {
+        mGatheredPayloads->push_back({kZeroPadding, paddingSize});
+    }
+    mSegmentStart = Buffer();
+    return WireResult::Success;
+}
+
 }  // namespace dawn::wire
 
 #endif  // SRC_DAWN_WIRE_BUFFERCONSUMER_IMPL_H_
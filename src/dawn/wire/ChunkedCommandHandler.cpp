@@ -52,6 +52,11 @@ const volatile char* ChunkedCommandHandler::HandleCommands(const volatile char*
                 // out.
                 return nullptr;
             }
+            if (mChunkedCommandDataCapacity <= kMaxRetainedChunkedCommandDataSize) {
+                mChunkedCommandData = std::move(chunkedCommandData);
+            } else {
+                mChunkedCommandDataCapacity = 0;
+            }
         }
     }
 
@@ -62,13 +67,17 @@ ChunkedCommandHandler::ChunkedCommandsResult ChunkedCommandHandler::BeginChunked
     const volatile char* commands,
     size_t commandSize,
     size_t initialSize) {
-    ASSERT(!mChunkedCommandData);
+    ASSERT(mChunkedCommandRemainingSize == 0);
 
     // Reserve space for all the command data we're expecting, and copy the initial data
     // to the start of the memory.
-    mChunkedCommandData.reset(AllocNoThrow<char>(commandSize));
-    if (!mChunkedCommandData) {
-        return ChunkedCommandsResult::Error;
+    if (!mChunkedCommandData || mChunkedCommandDataCapacity < commandSize) {
+        mChunkedCommandData.reset(AllocNoThrow<char>(commandSize));
+        if (!mChunkedCommandData) {
+            mChunkedCommandDataCapacity = 0;
+            return ChunkedCommandsResult::Error;
+        }
+        mChunkedCommandDataCapacity = commandSize;
     }
 
     memcpy(mChunkedCommandData.get(), const_cast<const char*>(commands), initialSize);
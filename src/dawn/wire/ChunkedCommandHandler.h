@@ -62,9 +62,14 @@ class ChunkedCommandHandler : public CommandHandler {
                                                   size_t commandSize,
                                                   size_t initialSize);
 
+    // The storage of chunked commands is kept for the next ones if it isn't larger than this, to
+    // avoid allocating and faulting in new memory for each large command.
+    static constexpr size_t kMaxRetainedChunkedCommandDataSize = 16 * 1024 * 1024;
+
     size_t mChunkedCommandRemainingSize = 0;
     size_t mChunkedCommandPutOffset = 0;
     std::unique_ptr<char[]> mChunkedCommandData;
+    size_t mChunkedCommandDataCapacity = 0;
 };
 
 }  // namespace dawn::wire
@@ -20,6 +20,7 @@
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "dawn/common/Alloc.h"
 #include "dawn/common/Compiler.h"
@@ -114,21 +115,35 @@ class ChunkedCommandSerializer {
             return;
         }
 
-        auto cmdSpace = std::unique_ptr<char[]>(AllocNoThrow<char>(requiredSize));
-        if (!cmdSpace) {
-            return;
-        }
-        SerializeBuffer serializeBuffer(cmdSpace.get(), requiredSize);
-        WireResult rCmd = SerializeCmd(cmd, requiredSize, &serializeBuffer);
-        WireResult rExts = detail::SerializeCommandExtension(&serializeBuffer, extensions...);
-        if (DAWN_UNLIKELY(rCmd != WireResult::Success || rExts != WireResult::Success)) {
-            mSerializer->OnSerializeError();
-            return;
+        // Commands that don't fit in a single allocation are gathered in a list of payloads that
+        // reference large inline data in place, so only the rest of the command is serialized in
+        // |cmdSpace|. That is usually small, but commands with other large parts are serialized
+        // again with space for the whole command.
+        std::vector<CommandPayload> payloads;
+        size_t cmdSpaceSize = std::min(requiredSize, kInitialGatherSpaceSize);
+        while (true) {
+            auto cmdSpace = std::unique_ptr<char[]>(AllocNoThrow<char>(cmdSpaceSize));
+            if (!cmdSpace) {
+                return;
+            }
+            payloads.clear();
+            SerializeBuffer serializeBuffer(cmdSpace.get(), cmdSpaceSize, &payloads);
+            WireResult rCmd = SerializeCmd(cmd, requiredSize, &serializeBuffer);
+            WireResult rExts = detail::SerializeCommandExtension(&serializeBuffer, extensions...);
+            if (DAWN_LIKELY(rCmd == WireResult::Success && rExts == WireResult::Success)) {
+                serializeBuffer.EndGather();
+                mSerializer->SerializeCommandPayloads(payloads.data(), payloads.size());
+                return;
+            }
+            if (cmdSpaceSize == requiredSize) {
+                mSerializer->OnSerializeError();
+                return;
+            }
+            cmdSpaceSize = requiredSize;
         }
-        SerializeChunkedCommand(cmdSpace.get(), requiredSize);
     }
 
-    void SerializeChunkedCommand(const char* allocatedBuffer, size_t remainingSize);
+    static constexpr size_t kInitialGatherSpaceSize = 4096;
 
     CommandSerializer* mSerializer;
     size_t mMaxAllocationSize;
@@ -14,6 +14,9 @@
 
 #include "dawn/wire/Wire.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace dawn::wire {
 
 CommandSerializer::CommandSerializer() = default;
@@ -21,6 +24,40 @@ CommandSerializer::~CommandSerializer() = default;
 
 void CommandSerializer::OnSerializeError() {}
 
+bool CommandSerializer::SerializeCommandPayloads(const CommandPayload* payloads, size_t count) {
+    size_t remainingSize = 0;
+    for (size_t i = 0; i < count; ++i) {
+        remainingSize += payloads[i].size;
+    }
+
+    // Copy the payloads in chunks of the maximum allocation size. The chunk boundaries don't depend
+    // on the payload boundaries so that the handler sees the same chunks as for a contiguous
+    // command.
+    const size_t maxAllocationSize = GetMaximumAllocationSize();
+    size_t payloadOffset = 0;
+    while (remainingSize > 0) {
+        size_t chunkSize = std::min(remainingSize, maxAllocationSize);
+        char* dst = static_cast<char*>(GetCmdSpace(chunkSize));
+        if (dst == nullptr) {
+            return false;
+        }
+        remainingSize -= chunkSize;
+
+        while (chunkSize > 0) {
+            size_t copySize = std::min(chunkSize, payloads->size - payloadOffset);
+            memcpy(dst, static_cast<const char*>(payloads->data) + payloadOffset, copySize);
+            dst += copySize;
+            chunkSize -= copySize;
+            payloadOffset += copySize;
+            if (payloadOffset == payloads->size) {
+                payloads++;
+                payloadOffset = 0;
+            }
+        }
+    }
+    return true;
+}
+
 CommandHandler::CommandHandler() = default;
 CommandHandler::~CommandHandler() = default;
 
@@ -16,45 +16,124 @@
 
 #include <algorithm>
 
+#include "dawn/common/Compiler.h"
+#include "dawn/common/Math.h"
+
 namespace dawn::wire {
+
+namespace {
+
+// Commands that need more space than this are rare, for example ShaderModule creation with very
+// large sources, so their memory isn't retained.
+constexpr size_t kMaxRetainedSize = 1024 * 1024;
+
+}  // anonymous namespace
+
 WireDeserializeAllocator::WireDeserializeAllocator() {
     Reset();
 }
 
 WireDeserializeAllocator::~WireDeserializeAllocator() {
     Reset();
+    free(mRetainedBlock);
 }
 
 void* WireDeserializeAllocator::GetSpace(size_t size) {
+    mAllocatedSize += size;
+
     // Return space in the current buffer if possible first.
-    if (mRemainingSize >= size) {
+    if (DAWN_LIKELY(mRemainingSize >= size)) {
         char* buffer = mCurrentBuffer;
         mCurrentBuffer += size;
         mRemainingSize -= size;
         return buffer;
     }
+    return GetSpaceSlow(size);
+}
 
-    // Otherwise allocate a new buffer and try again.
-    size_t allocationSize = std::max(size, size_t(2048));
+void* WireDeserializeAllocator::GetSpaceSlow(size_t size) {
+    // Continue in the retained block once the inline buffer is full.
+    if (!mUsingRetainedBlock && mRetainedSize >= size) {
+        mUsingRetainedBlock = true;
+        mCurrentBuffer = mRetainedBlock + size;
+        mRemainingSize = mRetainedSize - size;
+        return mRetainedBlock;
+    }
+
+    // Otherwise allocate a new buffer, growing geometrically in case the command has many
+    // allocations.
+    size_t allocationSize = std::max(
+        {size, sizeof(mStaticBuffer), std::min(2 * mLastAllocationSize, kMaxRetainedSize)});
     char* allocation = static_cast<char*>(malloc(allocationSize));
     if (allocation == nullptr) {
         return nullptr;
     }
+    mHeapAllocationCount++;
 
     mAllocations.push_back(allocation);
-    mCurrentBuffer = allocation;
-    mRemainingSize = allocationSize;
-    return GetSpace(size);
+    mLastAllocationSize = allocationSize;
+    mCurrentBuffer = allocation + size;
+    mRemainingSize = allocationSize - size;
+    return allocation;
 }
 
 void WireDeserializeAllocator::Reset() {
-    for (auto* allocation : mAllocations) {
-        free(allocation);
+    if (!mAllocations.empty()) {
+        for (auto* allocation : mAllocations) {
+            free(allocation);
+        }
+        mAllocations.clear();
+        mLastAllocationSize = 0;
+
+        // Grow the retained block so that it can hold all the allocations of the command on its
+        // own: the next command of that size then fits in the inline buffer and the retained
+        // block without allocating.
+        if (mAllocatedSize > mRetainedSize && mAllocatedSize <= kMaxRetainedSize) {
+            size_t retainedSize = NextPowerOfTwo(mAllocatedSize);
+            char* retainedBlock = static_cast<char*>(malloc(retainedSize));
+            if (retainedBlock != nullptr) {
+                mHeapAllocationCount++;
+                free(mRetainedBlock);
+                mRetainedBlock = retainedBlock;
+                mRetainedSize = retainedSize;
+            }
+        }
     }
-    mAllocations.clear();
+
+    mAllocatedBytes += mAllocatedSize;
+    mAllocatedSize = 0;
 
     // The initial buffer is the inline buffer so that some allocations can be skipped
+    mUsingRetainedBlock = false;
     mCurrentBuffer = mStaticBuffer;
     mRemainingSize = sizeof(mStaticBuffer);
 }
+
+void WireDeserializeAllocator::Reset(uint32_t commandId) {
+    if (commandId >= mAllocatedBytesPerCommand.size()) {
+        mAllocatedBytesPerCommand.resize(commandId + 1, 0);
+    }
+    mAllocatedBytesPerCommand[commandId] += mAllocatedSize;
+    Reset();
+}
+
+uint64_t WireDeserializeAllocator::GetAllocatedBytes() const {
+    return mAllocatedBytes;
+}
+
+uint64_t WireDeserializeAllocator::GetAllocatedBytes(uint32_t commandId) const {
+    if (commandId >= mAllocatedBytesPerCommand.size()) {
+        return 0;
+    }
+    return mAllocatedBytesPerCommand[commandId];
+}
+
+uint64_t WireDeserializeAllocator::GetHeapAllocationCount() const {
+    return mHeapAllocationCount;
+}
+
+size_t WireDeserializeAllocator::GetRetainedSize() const {
+    return mRetainedSize;
+}
+
 }  // namespace dawn::wire
@@ -20,9 +20,11 @@
 #include "dawn/wire/WireCmd_autogen.h"
 
 namespace dawn::wire {
-// A really really simple implementation of the DeserializeAllocator. It's main feature
-// is that it has some inline storage so as to avoid allocations for the majority of
-// commands.
+
+// Bump allocates the memory of the command being deserialized, first from an inline buffer and
+// then from a heap block that is kept across commands. When a command doesn't fit, the extra space
+// is allocated on the heap and the retained block grows to the size used by that command on
+// Reset(), so that deserializing similar commands afterwards doesn't allocate.
 class WireDeserializeAllocator : public DeserializeAllocator {
   public:
     WireDeserializeAllocator();
@@ -30,14 +32,40 @@ class WireDeserializeAllocator : public DeserializeAllocator {
 
     void* GetSpace(size_t size) override;
 
+    // Makes all the space available for the next command. The overload taking |commandId| also
+    // adds the bytes allocated since the last reset to the counter of that command.
     void Reset();
+    void Reset(uint32_t commandId);
+
+    uint64_t GetAllocatedBytes() const;
+    uint64_t GetAllocatedBytes(uint32_t commandId) const;
+    uint64_t GetHeapAllocationCount() const;
+    size_t GetRetainedSize() const;
 
   private:
+    void* GetSpaceSlow(size_t size);
+
     size_t mRemainingSize = 0;
     char* mCurrentBuffer = nullptr;
-    char mStaticBuffer[2048];
+    alignas(sizeof(uint64_t)) char mStaticBuffer[2048];
+
+    char* mRetainedBlock = nullptr;
+    size_t mRetainedSize = 0;
+    bool mUsingRetainedBlock = false;
+
+    // Blocks allocated for the current command when the inline buffer and the retained block were
+    // too small. They are freed on Reset().
     std::vector<char*> mAllocations;
+    size_t mLastAllocationSize = 0;
+
+    // The bytes requested since the last Reset().
+    size_t mAllocatedSize = 0;
+
+    std::vector<uint64_t> mAllocatedBytesPerCommand;
+    uint64_t mAllocatedBytes = 0;
+    uint64_t mHeapAllocationCount = 0;
 };
+
 }  // namespace dawn::wire
 
 #endif  // SRC_DAWN_WIRE_WIREDESERIALIZEALLOCATOR_H_
@@ -64,6 +64,18 @@ bool WireServer::IsDeviceKnown(WGPUDevice device) const {
     return mImpl->IsDeviceKnown(device);
 }
 
+uint64_t WireServer::GetDeserializeAllocatedBytes() const {
+    return mImpl->GetDeserializeAllocator().GetAllocatedBytes();
+}
+
+uint64_t WireServer::GetDeserializeAllocatedBytes(uint32_t commandId) const {
+    return mImpl->GetDeserializeAllocator().GetAllocatedBytes(commandId);
+}
+
+uint64_t WireServer::GetDeserializeHeapAllocationCount() const {
+    return mImpl->GetDeserializeAllocator().GetHeapAllocationCount();
+}
+
 namespace server {
 MemoryTransferService::MemoryTransferService() = default;
 
@@ -16,8 +16,9 @@
 #define SRC_DAWN_WIRE_SERVER_OBJECTSTORAGE_H_
 
 #include <algorithm>
-#include <map>
+#include <cstdint>
 #include <memory>
+#include <type_traits>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -264,29 +265,116 @@ class KnownObjects<WGPUDevice> : public KnownObjectsBase<WGPUDevice> {
 // ObjectIds are lost in deserialization. Store the ids of deserialized
 // objects here so they can be used in command handlers. This is useful
 // for creating ReturnWireCmds which contain client ids
+//
+// The table is a flat open-addressing hash table with linear probing, keyed by the native handle.
+// Removals shift the following entries of the probe sequence back instead of leaving tombstones so
+// that lookups never get slower as objects are created and destroyed. The nullptr handle marks
+// empty slots, so it is never stored.
 template <typename T>
 class ObjectIdLookupTable {
+    static_assert(std::is_pointer_v<T>, "ObjectIdLookupTable is keyed by native handles");
+
   public:
-    void Store(T key, ObjectId id) { mTable[key] = id; }
+    void Store(T key, ObjectId id) {
+        if (key == nullptr) {
+            return;
+        }
+        if ((mCount + 1) * kMaxLoadDenominator > mSlots.size() * kMaxLoadNumerator) {
+            Grow();
+        }
+
+        size_t index = FindSlot(key);
+        if (mSlots[index].key == nullptr) {
+            mSlots[index].key = key;
+            mCount++;
+        }
+        mSlots[index].id = id;
+    }
 
     // Return the cached ObjectId, or 0 (null handle)
     ObjectId Get(T key) const {
-        const auto it = mTable.find(key);
-        if (it != mTable.end()) {
-            return it->second;
+        if (key == nullptr || mCount == 0) {
+            return 0;
         }
-        return 0;
+        return mSlots[FindSlot(key)].id;
     }
 
     void Remove(T key) {
-        auto it = mTable.find(key);
-        if (it != mTable.end()) {
-            mTable.erase(it);
+        if (key == nullptr || mCount == 0) {
+            return;
+        }
+
+        size_t index = FindSlot(key);
+        if (mSlots[index].key == nullptr) {
+            return;
         }
+        mCount--;
+
+        // Backward shift deletion: move back the entries of the probe sequence after the removed
+        // one, unless they are already at their ideal position or would be moved before it.
+        const size_t mask = mSlots.size() - 1;
+        size_t hole = index;
+        for (size_t next = (hole + 1) & mask; mSlots[next].key != nullptr;
+             next = (next + 1) & mask) {
+            size_t ideal = Hash(mSlots[next].key) & mask;
+            if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+                mSlots[hole] = mSlots[next];
+                hole = next;
+            }
+        }
+        mSlots[hole] = {};
     }
 
+    size_t Size() const { return mCount; }
+
   private:
-    std::map<T, ObjectId> mTable;
+    static constexpr size_t kMinCapacity = 16;
+    static constexpr size_t kMaxLoadNumerator = 3;
+    static constexpr size_t kMaxLoadDenominator = 4;
+
+    struct Slot {
+        T key = nullptr;
+        ObjectId id = 0;
+    };
+
+    static size_t Hash(T key) {
+        // Handles are heap pointers whose low bits are always zero, mix all the bits in the high
+        // ones with a multiplicative hash and fold them back down.
+        uint64_t bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key));
+        bits *= 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(bits ^ (bits >> 32));
+    }
+
+    // Returns the index of the slot that contains |key|, or of the empty slot where it would be
+    // inserted. There is always at least one empty slot because of the maximum load factor.
+    size_t FindSlot(T key) const {
+        const size_t mask = mSlots.size() - 1;
+        size_t index = Hash(key) & mask;
+        while (mSlots[index].key != nullptr && mSlots[index].key != key) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void Grow() {
+        std::vector<Slot> oldSlots(std::max(kMinCapacity, mSlots.size() * 2));
+        mSlots.swap(oldSlots);
+
+        const size_t mask = mSlots.size() - 1;
+        for (const Slot& slot : oldSlots) {
+            if (slot.key == nullptr) {
+                continue;
+            }
+            size_t index = Hash(slot.key) & mask;
+            while (mSlots[index].key != nullptr) {
+                index = (index + 1) & mask;
+            }
+            mSlots[index] = slot;
+        }
+    }
+
+    std::vector<Slot> mSlots;
+    size_t mCount = 0;
 };
 
 }  // namespace dawn::wire::server
@@ -135,14 +135,13 @@ WireResult Server::DoDeviceCreateBuffer(Known<WGPUDevice> device,
             if (mapping == nullptr) {
                 // A zero mapping is used to indicate an allocation error of an error buffer.
                 // This is a valid case and isn't fatal. Remember the buffer is an error so as
-                // to skip subsequent mapping operations.
+                // to skip subsequent mapping operations. The read handle is still deserialized
+                // below so that the transfer service can release it with the buffer.
                 buffer->mapWriteState = BufferMapWriteState::MapError;
-                return WireResult::Success;
+            } else {
+                writeHandle->SetTarget(mapping);
+                buffer->mapWriteState = BufferMapWriteState::Mapped;
             }
-            ASSERT(mapping != nullptr);
-            writeHandle->SetTarget(mapping);
-
-            buffer->mapWriteState = BufferMapWriteState::Mapped;
         }
     }
 
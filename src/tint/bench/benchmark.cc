@@ -14,11 +14,18 @@
 
 #include "src/tint/bench/benchmark.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
+#include <new>
 #include <utility>
 #include <vector>
 
+#include "src/tint/lang/wgsl/reader/parser/parser.h"
 #include "src/tint/utils/text/string.h"
 #include "src/tint/utils/text/string_stream.h"
 
@@ -27,6 +34,76 @@ namespace {
 
 std::filesystem::path kInputFileDir;
 
+std::atomic<size_t> bytes_allocated{0};
+std::atomic<size_t> peak_bytes_allocated{0};
+std::atomic<size_t> total_bytes_allocated{0};
+
+// Each allocation is prefixed with its size so that operator delete can account for it. The prefix
+// preserves the alignment of the allocations made by the default operator new.
+constexpr size_t kAllocationPrefixSize = alignof(std::max_align_t);
+
+// Over-aligned allocations are prefixed with the pointer returned by malloc and their size, just
+// before the aligned pointer.
+struct AlignedAllocationPrefix {
+    void* base;
+    size_t size;
+};
+
+void* CheckedMalloc(size_t size) {
+    void* ptr = std::malloc(size);
+    if (!ptr) {
+        // Don't use iostreams, which could allocate.
+        fputs("out of memory\n", stderr);
+        std::abort();
+    }
+    return ptr;
+}
+
+void CountAllocation(size_t size) {
+    total_bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+    size_t current = bytes_allocated.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = peak_bytes_allocated.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !peak_bytes_allocated.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+void* TrackedAllocate(size_t size) {
+    void* ptr = CheckedMalloc(size + kAllocationPrefixSize);
+    *static_cast<size_t*>(ptr) = size;
+    CountAllocation(size);
+    return static_cast<char*>(ptr) + kAllocationPrefixSize;
+}
+
+void TrackedFree(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    void* base = static_cast<char*>(ptr) - kAllocationPrefixSize;
+    bytes_allocated.fetch_sub(*static_cast<size_t*>(base), std::memory_order_relaxed);
+    std::free(base);
+}
+
+void* TrackedAllocateAligned(size_t size, std::align_val_t align) {
+    size_t alignment = std::max(static_cast<size_t>(align), alignof(AlignedAllocationPrefix));
+    void* base = CheckedMalloc(size + sizeof(AlignedAllocationPrefix) + alignment - 1);
+    uintptr_t aligned = reinterpret_cast<uintptr_t>(base) + sizeof(AlignedAllocationPrefix);
+    aligned = (aligned + alignment - 1) & ~(alignment - 1);
+    void* ptr = reinterpret_cast<void*>(aligned);
+    static_cast<AlignedAllocationPrefix*>(ptr)[-1] = {base, size};
+    CountAllocation(size);
+    return ptr;
+}
+
+void TrackedFreeAligned(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    const AlignedAllocationPrefix& prefix = static_cast<AlignedAllocationPrefix*>(ptr)[-1];
+    bytes_allocated.fetch_sub(prefix.size, std::memory_order_relaxed);
+    std::free(prefix.base);
+}
+
 /// Copies the content from the file named `input_file` to `buffer`,
 /// assuming each element in the file is of type `T`.  If any error occurs,
 /// writes error messages to the standard error stream and returns false.
@@ -116,6 +193,62 @@ std::variant<tint::Source::File, Error> LoadInputFile(std::string name) {
     return Error{"unsupported file extension: '" + name + "'"};
 }
 
+size_t MemoryUsage::Current() {
+    return bytes_allocated.load(std::memory_order_relaxed);
+}
+
+size_t MemoryUsage::Peak() {
+    return peak_bytes_allocated.load(std::memory_order_relaxed);
+}
+
+void MemoryUsage::ResetPeak() {
+    peak_bytes_allocated.store(bytes_allocated.load(std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+}
+
+size_t MemoryUsage::TotalAllocated() {
+    return total_bytes_allocated.load(std::memory_order_relaxed);
+}
+
+TransformCounters::TransformCounters(benchmark::State& state) : state_(state) {
+    previous_ = ast::transform::Manager::SetThreadListener(this);
+}
+
+TransformCounters::~TransformCounters() {
+    ast::transform::Manager::SetThreadListener(previous_);
+
+    for (auto& [name, totals] : totals_) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(totals.time).count();
+        state_.counters[name + "_ns"] =
+            benchmark::Counter(static_cast<double>(ns), benchmark::Counter::kAvgIterations);
+        state_.counters[name + "_bytes"] = benchmark::Counter(
+            static_cast<double>(totals.bytes), benchmark::Counter::kAvgIterations);
+    }
+}
+
+void TransformCounters::BeforeTransform(std::string_view, const Program&) {
+    running_.Push(Running{std::chrono::steady_clock::now(), MemoryUsage::TotalAllocated()});
+}
+
+void TransformCounters::AfterTransform(std::string_view name, const Program*) {
+    auto running = running_.Pop();
+    auto time = std::chrono::steady_clock::now() - running.start_time;
+    auto bytes = MemoryUsage::TotalAllocated() - running.start_bytes;
+
+    // Strip the namespaces from the names of the transforms, which may be joined with '+' when the
+    // transforms were fused.
+    std::string short_name;
+    for (auto part : Split(name, "+")) {
+        auto pos = part.rfind(':');
+        short_name += short_name.empty() ? "" : "+";
+        short_name += pos == std::string_view::npos ? part : part.substr(pos + 1);
+    }
+
+    auto& totals = totals_[short_name];
+    totals.time += time;
+    totals.bytes += bytes;
+}
+
 std::variant<ProgramAndFile, Error> LoadProgram(std::string name) {
     auto res = bench::LoadInputFile(name);
     if (auto err = std::get_if<bench::Error>(&res)) {
@@ -129,8 +262,60 @@ std::variant<ProgramAndFile, Error> LoadProgram(std::string name) {
     return ProgramAndFile{std::move(program), std::move(file)};
 }
 
+void TimeResolve(benchmark::State& state,
+                 const Source::File& file,
+                 const resolver::Options& options) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        {
+            wgsl::reader::Parser parser(&file);
+            bool parsed = parser.Parse();
+            state.ResumeTiming();
+            if (!parsed) {
+                state.SkipWithError(parser.builder().Diagnostics().str().c_str());
+                break;
+            }
+            auto program = resolver::Resolve(parser.builder(), options);
+            if (!program.IsValid()) {
+                state.SkipWithError(program.Diagnostics().str().c_str());
+                break;
+            }
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+}
+
 }  // namespace tint::bench
 
+// Replace the global operator new and delete to track the memory used by the benchmarks. The array
+// and nothrow forms of the standard library forward to these.
+void* operator new(size_t size) {
+    return tint::bench::TrackedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    tint::bench::TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    tint::bench::TrackedFree(ptr);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return tint::bench::TrackedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    tint::bench::TrackedFreeAligned(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    tint::bench::TrackedFreeAligned(ptr);
+}
+
+// The benchmark unit tests use gtest's main() instead.
+#ifndef TINT_BENCHMARK_NO_MAIN
 int main(int argc, char** argv) {
     benchmark::Initialize(&argc, argv);
     if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
@@ -142,3 +327,4 @@ int main(int argc, char** argv) {
     }
     benchmark::RunSpecifiedBenchmarks();
 }
+#endif  // TINT_BENCHMARK_NO_MAIN
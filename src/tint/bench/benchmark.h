@@ -15,11 +15,17 @@
 #ifndef SRC_TINT_BENCH_BENCHMARK_H_
 #define SRC_TINT_BENCH_BENCHMARK_H_
 
+#include <chrono>
+#include <cstddef>
+#include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <variant>
 
 #include "benchmark/benchmark.h"
+#include "src/tint/lang/wgsl/resolver/resolve.h"
+#include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/macros/concat.h"
 #include "tint/tint.h"
 
@@ -52,6 +58,66 @@ std::variant<Source::File, Error> LoadInputFile(std::string name);
 /// @returns either the loaded Program or an Error
 std::variant<ProgramAndFile, Error> LoadProgram(std::string name);
 
+/// TimeResolve runs the iterations of @p state, each parsing @p file and resolving the parsed
+/// program with @p options. Only the resolving is timed, not the parsing nor the destruction of
+/// the program. The benchmark is skipped with an error if the parsing or the resolving fails.
+/// @param state the benchmark state
+/// @param file the WGSL file to resolve
+/// @param options the resolver options
+void TimeResolve(benchmark::State& state,
+                 const Source::File& file,
+                 const resolver::Options& options = {});
+
+/// MemoryUsage queries the heap memory allocated with the global operator new, which the benchmark
+/// executable replaces to keep track of it.
+class MemoryUsage {
+  public:
+    /// @returns the number of bytes currently allocated
+    static size_t Current();
+    /// @returns the highest number of bytes allocated since the last call to ResetPeak()
+    static size_t Peak();
+    /// Sets the peak number of bytes allocated to the current number of bytes allocated.
+    static void ResetPeak();
+    /// @returns the total number of bytes allocated since the start of the program, including the
+    /// bytes that have since been freed
+    static size_t TotalAllocated();
+};
+
+/// TransformCounters records the time spent and the bytes allocated by each AST transform run on
+/// the current thread during its lifetime, and reports them as benchmark counters, averaged over
+/// the iterations, when destructed.
+class TransformCounters final : public ast::transform::Manager::Listener {
+  public:
+    /// Constructor
+    /// @param state the benchmark state to report the counters to
+    explicit TransformCounters(benchmark::State& state);
+    /// Destructor
+    ~TransformCounters() override;
+
+    /// @copydoc ast::transform::Manager::Listener::BeforeTransform
+    void BeforeTransform(std::string_view name, const Program& program) override;
+    /// @copydoc ast::transform::Manager::Listener::AfterTransform
+    void AfterTransform(std::string_view name, const Program* output) override;
+
+  private:
+    /// The start of a transform that has not finished yet. Transforms may run their own
+    /// transform::Manager, so these are kept as a stack.
+    struct Running {
+        std::chrono::steady_clock::time_point start_time;
+        size_t start_bytes = 0;
+    };
+
+    struct Totals {
+        std::chrono::steady_clock::duration time{};
+        size_t bytes = 0;
+    };
+
+    benchmark::State& state_;
+    ast::transform::Manager::Listener* previous_ = nullptr;
+    std::map<std::string, Totals> totals_;
+    Vector<Running, 4> running_;
+};
+
 // If TINT_BENCHMARK_EXTERNAL_SHADERS_HEADER is defined, include that to
 // declare the TINT_BENCHMARK_EXTERNAL_WGSL_PROGRAMS() and TINT_BENCHMARK_EXTERNAL_SPV_PROGRAMS()
 // macros, which appends external programs to the TINT_BENCHMARK_WGSL_PROGRAMS() and
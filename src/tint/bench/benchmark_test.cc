@@ -0,0 +1,140 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/bench/benchmark.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/tint/lang/wgsl/program/clone_context.h"
+#include "src/tint/lang/wgsl/program/program_builder.h"
+#include "src/tint/lang/wgsl/resolver/resolve.h"
+
+namespace tint::bench {
+
+/// The number of bytes allocated by OuterTransform before it runs InnerTransform
+static constexpr size_t kOuterAllocationSize = 1 << 20;
+
+class InnerTransform final : public Castable<InnerTransform, ast::transform::Transform> {
+    ApplyResult Apply(const Program* src, const ast::transform::DataMap&,
+                      ast::transform::DataMap&) const override {
+        ProgramBuilder b;
+        program::CloneContext ctx{&b, src};
+        b.Func(b.Sym("inner_func"), {}, b.ty.void_(), {});
+        ctx.Clone();
+        return resolver::Resolve(b);
+    }
+};
+
+class OuterTransform final : public Castable<OuterTransform, ast::transform::Transform> {
+    ApplyResult Apply(const Program* src,
+                      const ast::transform::DataMap& inputs,
+                      ast::transform::DataMap& outputs) const override {
+        std::vector<char> allocation(kOuterAllocationSize);
+        benchmark::DoNotOptimize(allocation.data());
+
+        ast::transform::Manager manager;
+        manager.Add<InnerTransform>();
+        return manager.Run(src, inputs, outputs);
+    }
+};
+
+namespace {
+
+/// A benchmark reporter that doesn't print anything
+class SilentReporter final : public benchmark::BenchmarkReporter {
+  public:
+    bool ReportContext(const Context&) override { return true; }
+    void ReportRuns(const std::vector<Run>&) override {}
+};
+
+/// Runs @p func as the only benchmark, for a single iteration
+/// @returns the counters reported by the benchmark
+template <typename F>
+std::map<std::string, double> RunBenchmark(F&& func) {
+    std::map<std::string, double> counters;
+    benchmark::RegisterBenchmark("TransformCountersTest", [&](benchmark::State& state) {
+        for (auto _ : state) {
+            func(state);
+        }
+        for (auto& [name, counter] : state.counters) {
+            counters[name] = counter.value;
+        }
+    })->Iterations(1);
+
+    SilentReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter, "TransformCountersTest");
+    benchmark::ClearRegisteredBenchmarks();
+    return counters;
+}
+
+Program MakeAST() {
+    ProgramBuilder b;
+    b.Func(b.Sym("main"), {}, b.ty.void_(), {});
+    return resolver::Resolve(b);
+}
+
+using TransformCountersTest = testing::Test;
+
+// Test that the counters of a transform that runs its own transform::Manager include the inner
+// transforms, and that the inner transforms are measured from their own start.
+TEST_F(TransformCountersTest, NestedManager) {
+    Program ast = MakeAST();
+
+    auto counters = RunBenchmark([&](benchmark::State& state) {
+        TransformCounters transform_counters(state);
+
+        ast::transform::Manager manager;
+        ast::transform::DataMap outputs;
+        manager.Add<OuterTransform>();
+        auto result = manager.Run(&ast, {}, outputs);
+        EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+    });
+
+    ASSERT_EQ(counters.count("OuterTransform_ns"), 1u);
+    ASSERT_EQ(counters.count("OuterTransform_bytes"), 1u);
+    ASSERT_EQ(counters.count("InnerTransform_ns"), 1u);
+    ASSERT_EQ(counters.count("InnerTransform_bytes"), 1u);
+
+    EXPECT_GE(counters["OuterTransform_ns"], counters["InnerTransform_ns"]);
+    EXPECT_GE(counters["OuterTransform_bytes"],
+              counters["InnerTransform_bytes"] + static_cast<double>(kOuterAllocationSize));
+    EXPECT_LT(counters["InnerTransform_bytes"], static_cast<double>(kOuterAllocationSize));
+}
+
+using MemoryUsageTest = testing::Test;
+
+// Test that over-aligned allocations are tracked and aligned.
+TEST_F(MemoryUsageTest, AlignedAllocation) {
+    struct alignas(128) Aligned {
+        char data[256];
+    };
+
+    size_t bytes_before = MemoryUsage::Current();
+    auto* aligned = new Aligned;
+    benchmark::DoNotOptimize(aligned);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % alignof(Aligned), 0u);
+    EXPECT_EQ(MemoryUsage::Current(), bytes_before + sizeof(Aligned));
+
+    delete aligned;
+    EXPECT_EQ(MemoryUsage::Current(), bytes_before);
+}
+
+}  // namespace
+}  // namespace tint::bench
+
+TINT_INSTANTIATE_TYPEINFO(tint::bench::InnerTransform);
+TINT_INSTANTIATE_TYPEINFO(tint::bench::OuterTransform);
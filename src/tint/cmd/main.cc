@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include <charconv>
+#include <chrono>
 #include <cstdio>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -114,6 +116,7 @@ struct Options {
     bool print_hash = false;
     bool dump_inspector_bindings = false;
     bool enable_robustness = false;
+    bool time_transforms = false;
 
     std::unordered_set<uint32_t> skip_hash;
 
@@ -303,6 +306,12 @@ violations that may be produced)",
                                                Default{false});
     TINT_DEFER(opts->print_hash = *print_hash.value);
 
+    auto& time_transforms = options.Add<BoolOption>(
+        "time-transforms", R"(Prints the time, the AST nodes and the node allocator bytes
+of each transform to stderr)",
+        Default{false});
+    TINT_DEFER(opts->time_transforms = *time_transforms.value);
+
     auto& transforms =
         options.Add<StringOption>("transform", R"(Runs transforms, name list is comma separated
 Available transforms:
@@ -416,6 +425,35 @@ Options:
     return true;
 }
 
+/// Prints the transforms recorded by @p profiler to stderr, with the time they took and the changes
+/// they made to the size of the program.
+/// @param profiler the transform profiler
+void PrintTransformProfile(const tint::ast::transform::Profiler& profiler) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    std::cerr << std::setw(12) << "time (us)" << std::setw(24) << "AST nodes" << std::setw(24)
+              << "node bytes" << "  transform" << std::endl;
+
+    std::chrono::nanoseconds total{};
+    for (auto& entry : profiler.Entries()) {
+        std::cerr << std::setw(12) << duration_cast<microseconds>(entry.time).count()  //
+                  << std::setw(11) << entry.ast_nodes_before << " -> "                 //
+                  << std::setw(9) << entry.ast_nodes_after                             //
+                  << std::setw(11) << entry.node_bytes_before << " -> "                //
+                  << std::setw(9) << entry.node_bytes_after                            //
+                  << "  " << std::string(entry.depth * 2, ' ') << entry.name
+                  << (entry.skipped ? " (skipped)" : "") << std::endl;
+        // The time of the nested transforms is already included in the time of the transform
+        // that ran them.
+        if (entry.depth == 0) {
+            total += entry.time;
+        }
+    }
+    std::cerr << std::setw(12) << duration_cast<microseconds>(total).count() << "  total"
+              << std::endl;
+}
+
 /// Writes the given `buffer` into the file named as `output_file` using the
 /// given `mode`.  If `output_file` is empty or "-", writes to standard
 /// output. If any error occurs, returns false and outputs error message to
@@ -1125,6 +1163,17 @@ int main(int argc, const char** argv) {
         transform_inputs.Add<tint::ast::transform::SingleEntryPoint::Config>(options.ep_name);
     }
 
+    // Records the transforms run from here on, including those run by the writers.
+    std::optional<tint::ast::transform::Profiler> profiler;
+    if (options.time_transforms) {
+        profiler.emplace();
+    }
+    TINT_DEFER({
+        if (profiler) {
+            PrintTransformProfile(*profiler);
+        }
+    });
+
     tint::ast::transform::DataMap outputs;
     auto out = transform_manager.Run(program.get(), std::move(transform_inputs), outputs);
     if (!out.IsValid()) {
@@ -35,6 +35,7 @@ void GenerateGLSL(benchmark::State& state, std::string input_name) {
         }
     }
 
+    bench::TransformCounters transform_counters(state);
     for (auto _ : state) {
         for (auto& ep : entry_points) {
             auto res = Generate(&program, {}, ep);
@@ -26,6 +26,7 @@ void GenerateHLSL(benchmark::State& state, std::string input_name) {
         return;
     }
     auto& program = std::get<bench::ProgramAndFile>(res).program;
+    bench::TransformCounters transform_counters(state);
     for (auto _ : state) {
         auto res = Generate(&program, {});
         if (!res) {
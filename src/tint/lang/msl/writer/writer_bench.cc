@@ -59,6 +59,8 @@ void GenerateMSL(benchmark::State& state, std::string input_name) {
             }
         }
     }
+
+    bench::TransformCounters transform_counters(state);
     for (auto _ : state) {
         auto res = Generate(&program, gen_options);
         if (!res) {
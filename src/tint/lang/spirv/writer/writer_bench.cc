@@ -26,6 +26,7 @@ void RunBenchmark(benchmark::State& state, std::string input_name, Options optio
         return;
     }
     auto& program = std::get<bench::ProgramAndFile>(res).program;
+    bench::TransformCounters transform_counters(state);
     for (auto _ : state) {
         auto res = Generate(&program, options);
         if (!res) {
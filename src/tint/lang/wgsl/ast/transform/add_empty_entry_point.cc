@@ -18,17 +18,19 @@
 
 #include "src/tint/lang/wgsl/program/clone_context.h"
 #include "src/tint/lang/wgsl/program/program_builder.h"
-#include "src/tint/lang/wgsl/resolver/resolve.h"
 
 TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::AddEmptyEntryPoint);
 
 using namespace tint::number_suffixes;  // NOLINT
 
 namespace tint::ast::transform {
-namespace {
 
-bool ShouldRun(const Program* program) {
-    for (auto* func : program->AST().Functions()) {
+AddEmptyEntryPoint::AddEmptyEntryPoint() = default;
+
+AddEmptyEntryPoint::~AddEmptyEntryPoint() = default;
+
+bool AddEmptyEntryPoint::ShouldRun(const Program* src, const DataMap&) const {
+    for (auto* func : src->AST().Functions()) {
         if (func->IsEntryPoint()) {
             return false;
         }
@@ -36,30 +38,16 @@ bool ShouldRun(const Program* program) {
     return true;
 }
 
-}  // namespace
-
-AddEmptyEntryPoint::AddEmptyEntryPoint() = default;
-
-AddEmptyEntryPoint::~AddEmptyEntryPoint() = default;
-
-Transform::ApplyResult AddEmptyEntryPoint::Apply(const Program* src,
-                                                 const DataMap&,
-                                                 DataMap&) const {
-    if (!ShouldRun(src)) {
-        return SkipTransform;
-    }
-
-    ProgramBuilder b;
-    program::CloneContext ctx{&b, src, /* auto_clone_symbols */ true};
-
+std::unique_ptr<FusableTransform::FusedState> AddEmptyEntryPoint::Fuse(program::CloneContext& ctx,
+                                                                      const DataMap&,
+                                                                      DataMap&) const {
+    auto& b = *ctx.dst;
     b.Func(b.Symbols().New("unused_entry_point"), {}, b.ty.void_(), {},
            tint::Vector{
                b.Stage(PipelineStage::kCompute),
                b.WorkgroupSize(1_i),
            });
-
-    ctx.Clone();
-    return resolver::Resolve(b);
+    return nullptr;
 }
 
 }  // namespace tint::ast::transform
@@ -15,22 +15,27 @@
 #ifndef SRC_TINT_LANG_WGSL_AST_TRANSFORM_ADD_EMPTY_ENTRY_POINT_H_
 #define SRC_TINT_LANG_WGSL_AST_TRANSFORM_ADD_EMPTY_ENTRY_POINT_H_
 
+#include <memory>
+
 #include "src/tint/lang/wgsl/ast/transform/transform.h"
 
 namespace tint::ast::transform {
 
 /// Add an empty entry point to the module, if no other entry points exist.
-class AddEmptyEntryPoint final : public Castable<AddEmptyEntryPoint, Transform> {
+class AddEmptyEntryPoint final : public Castable<AddEmptyEntryPoint, FusableTransform> {
   public:
     /// Constructor
     AddEmptyEntryPoint();
     /// Destructor
     ~AddEmptyEntryPoint() override;
 
-    /// @copydoc Transform::Apply
-    ApplyResult Apply(const Program* program,
-                      const DataMap& inputs,
-                      DataMap& outputs) const override;
+    /// @copydoc FusableTransform::ShouldRun
+    bool ShouldRun(const Program* program, const DataMap& inputs) const override;
+
+    /// @copydoc FusableTransform::Fuse
+    std::unique_ptr<FusedState> Fuse(program::CloneContext& ctx,
+                                     const DataMap& inputs,
+                                     DataMap& outputs) const override;
 };
 
 }  // namespace tint::ast::transform
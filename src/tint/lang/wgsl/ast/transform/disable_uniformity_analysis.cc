@@ -18,7 +18,6 @@
 
 #include "src/tint/lang/wgsl/program/clone_context.h"
 #include "src/tint/lang/wgsl/program/program_builder.h"
-#include "src/tint/lang/wgsl/resolver/resolve.h"
 #include "src/tint/lang/wgsl/sem/module.h"
 
 TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::DisableUniformityAnalysis);
@@ -29,20 +28,17 @@ DisableUniformityAnalysis::DisableUniformityAnalysis() = default;
 
 DisableUniformityAnalysis::~DisableUniformityAnalysis() = default;
 
-Transform::ApplyResult DisableUniformityAnalysis::Apply(const Program* src,
-                                                        const DataMap&,
-                                                        DataMap&) const {
-    if (src->Sem().Module()->Extensions().Contains(
-            builtin::Extension::kChromiumDisableUniformityAnalysis)) {
-        return SkipTransform;
-    }
-
-    ProgramBuilder b;
-    program::CloneContext ctx{&b, src, /* auto_clone_symbols */ true};
-    b.Enable(builtin::Extension::kChromiumDisableUniformityAnalysis);
+bool DisableUniformityAnalysis::ShouldRun(const Program* src, const DataMap&) const {
+    return !src->Sem().Module()->Extensions().Contains(
+        builtin::Extension::kChromiumDisableUniformityAnalysis);
+}
 
-    ctx.Clone();
-    return resolver::Resolve(b);
+std::unique_ptr<FusableTransform::FusedState> DisableUniformityAnalysis::Fuse(
+    program::CloneContext& ctx,
+    const DataMap&,
+    DataMap&) const {
+    ctx.dst->Enable(builtin::Extension::kChromiumDisableUniformityAnalysis);
+    return nullptr;
 }
 
 }  // namespace tint::ast::transform
@@ -15,22 +15,28 @@
 #ifndef SRC_TINT_LANG_WGSL_AST_TRANSFORM_DISABLE_UNIFORMITY_ANALYSIS_H_
 #define SRC_TINT_LANG_WGSL_AST_TRANSFORM_DISABLE_UNIFORMITY_ANALYSIS_H_
 
+#include <memory>
+
 #include "src/tint/lang/wgsl/ast/transform/transform.h"
 
 namespace tint::ast::transform {
 
 /// Disable uniformity analysis for the program.
-class DisableUniformityAnalysis final : public Castable<DisableUniformityAnalysis, Transform> {
+class DisableUniformityAnalysis final
+    : public Castable<DisableUniformityAnalysis, FusableTransform> {
   public:
     /// Constructor
     DisableUniformityAnalysis();
     /// Destructor
     ~DisableUniformityAnalysis() override;
 
-    /// @copydoc Transform::Apply
-    ApplyResult Apply(const Program* program,
-                      const DataMap& inputs,
-                      DataMap& outputs) const override;
+    /// @copydoc FusableTransform::ShouldRun
+    bool ShouldRun(const Program* program, const DataMap& inputs) const override;
+
+    /// @copydoc FusableTransform::Fuse
+    std::unique_ptr<FusedState> Fuse(program::CloneContext& ctx,
+                                     const DataMap& inputs,
+                                     DataMap& outputs) const override;
 };
 
 }  // namespace tint::ast::transform
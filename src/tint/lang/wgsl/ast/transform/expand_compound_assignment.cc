@@ -21,7 +21,6 @@
 #include "src/tint/lang/wgsl/ast/transform/hoist_to_decl_before.h"
 #include "src/tint/lang/wgsl/program/clone_context.h"
 #include "src/tint/lang/wgsl/program/program_builder.h"
-#include "src/tint/lang/wgsl/resolver/resolve.h"
 #include "src/tint/lang/wgsl/sem/block_statement.h"
 #include "src/tint/lang/wgsl/sem/for_loop_statement.h"
 #include "src/tint/lang/wgsl/sem/statement.h"
@@ -33,21 +32,8 @@ using namespace tint::number_suffixes;  // NOLINT
 
 namespace tint::ast::transform {
 
-namespace {
-
-bool ShouldRun(const Program* program) {
-    for (auto* node : program->ASTNodes().Objects()) {
-        if (node->IsAnyOf<CompoundAssignmentStatement, IncrementDecrementStatement>()) {
-            return true;
-        }
-    }
-    return false;
-}
-
-}  // namespace
-
 /// PIMPL state for the transform
-struct ExpandCompoundAssignment::State {
+struct ExpandCompoundAssignment::State : public FusableTransform::FusedState {
     /// Constructor
     /// @param context the clone context
     explicit State(program::CloneContext& context)
@@ -163,28 +149,31 @@ ExpandCompoundAssignment::ExpandCompoundAssignment() = default;
 
 ExpandCompoundAssignment::~ExpandCompoundAssignment() = default;
 
-Transform::ApplyResult ExpandCompoundAssignment::Apply(const Program* src,
-                                                       const DataMap&,
-                                                       DataMap&) const {
-    if (!ShouldRun(src)) {
-        return SkipTransform;
+bool ExpandCompoundAssignment::ShouldRun(const Program* src, const DataMap&) const {
+    for (auto* node : src->ASTNodes().Objects()) {
+        if (node->IsAnyOf<CompoundAssignmentStatement, IncrementDecrementStatement>()) {
+            return true;
+        }
     }
+    return false;
+}
 
-    ProgramBuilder b;
-    program::CloneContext ctx{&b, src, /* auto_clone_symbols */ true};
-    State state(ctx);
-    for (auto* node : src->ASTNodes().Objects()) {
+std::unique_ptr<FusableTransform::FusedState> ExpandCompoundAssignment::Fuse(
+    program::CloneContext& ctx,
+    const DataMap&,
+    DataMap&) const {
+    // The changes registered by the HoistToDeclBefore helper refer to the state.
+    auto state = std::make_unique<State>(ctx);
+    for (auto* node : ctx.src->ASTNodes().Objects()) {
         if (auto* assign = node->As<CompoundAssignmentStatement>()) {
-            state.Expand(assign, assign->lhs, ctx.Clone(assign->rhs), assign->op);
+            state->Expand(assign, assign->lhs, ctx.Clone(assign->rhs), assign->op);
         } else if (auto* inc_dec = node->As<IncrementDecrementStatement>()) {
             // For increment/decrement statements, `i++` becomes `i = i + 1`.
             auto op = inc_dec->increment ? BinaryOp::kAdd : BinaryOp::kSubtract;
-            state.Expand(inc_dec, inc_dec->lhs, ctx.dst->Expr(1_a), op);
+            state->Expand(inc_dec, inc_dec->lhs, ctx.dst->Expr(1_a), op);
         }
     }
-
-    ctx.Clone();
-    return resolver::Resolve(b);
+    return state;
 }
 
 }  // namespace tint::ast::transform
@@ -15,6 +15,8 @@
 #ifndef SRC_TINT_LANG_WGSL_AST_TRANSFORM_EXPAND_COMPOUND_ASSIGNMENT_H_
 #define SRC_TINT_LANG_WGSL_AST_TRANSFORM_EXPAND_COMPOUND_ASSIGNMENT_H_
 
+#include <memory>
+
 #include "src/tint/lang/wgsl/ast/transform/transform.h"
 
 namespace tint::ast::transform {
@@ -38,17 +40,20 @@ namespace tint::ast::transform {
 ///
 /// This transform also handles increment and decrement statements in the same
 /// manner, by replacing `i++` with `i = i + 1`.
-class ExpandCompoundAssignment final : public Castable<ExpandCompoundAssignment, Transform> {
+class ExpandCompoundAssignment final : public Castable<ExpandCompoundAssignment, FusableTransform> {
   public:
     /// Constructor
     ExpandCompoundAssignment();
     /// Destructor
     ~ExpandCompoundAssignment() override;
 
-    /// @copydoc Transform::Apply
-    ApplyResult Apply(const Program* program,
-                      const DataMap& inputs,
-                      DataMap& outputs) const override;
+    /// @copydoc FusableTransform::ShouldRun
+    bool ShouldRun(const Program* program, const DataMap& inputs) const override;
+
+    /// @copydoc FusableTransform::Fuse
+    std::unique_ptr<FusedState> Fuse(program::CloneContext& ctx,
+                                     const DataMap& inputs,
+                                     DataMap& outputs) const override;
 
   private:
     struct State;
@@ -13,6 +13,11 @@
 // limitations under the License.
 
 #include "src/tint/lang/wgsl/ast/transform/manager.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
 #include "src/tint/lang/wgsl/ast/transform/transform.h"
 #include "src/tint/lang/wgsl/program/clone_context.h"
 #include "src/tint/lang/wgsl/program/program_builder.h"
@@ -30,6 +35,18 @@
 #endif  // TINT_PRINT_PROGRAM_FOR_EACH_TRANSFORM
 
 namespace tint::ast::transform {
+namespace {
+
+/// The listener of the managers that run on the current thread.
+thread_local Manager::Listener* thread_listener = nullptr;
+
+}  // namespace
+
+Manager::Listener::~Listener() = default;
+
+Manager::Listener* Manager::SetThreadListener(Listener* listener) {
+    return std::exchange(thread_listener, listener);
+}
 
 Manager::Manager() = default;
 Manager::~Manager() = default;
@@ -52,14 +69,68 @@ Program Manager::Run(const Program* program, const DataMap& inputs, DataMap& out
 #endif
 
     std::optional<Program> output;
+    Listener* listener = thread_listener;
+
+    // Applies the FusableTransforms [begin, end) with a single clone and resolve of the program.
+    auto apply_fused = [&](size_t begin, size_t end) -> Transform::ApplyResult {
+        Vector<const FusableTransform*, 8> fused;
+        for (size_t i = begin; i < end; i++) {
+            auto* transform = transforms_[i]->As<FusableTransform>();
+            if (transform->ShouldRun(program, inputs)) {
+                fused.Push(transform);
+            }
+        }
+        if (fused.IsEmpty()) {
+            return Transform::SkipTransform;
+        }
+
+        ProgramBuilder b;
+        program::CloneContext ctx{&b, program, /* auto_clone_symbols */ true};
+        Vector<std::unique_ptr<FusableTransform::FusedState>, 8> states;
+        for (auto* transform : fused) {
+            states.Push(transform->Fuse(ctx, inputs, outputs));
+        }
+        ctx.Clone();
+        return resolver::Resolve(b);
+    };
 
     TINT_IF_PRINT_PROGRAM(print_program("Input of", this));
 
-    for (const auto& transform : transforms_) {
-        if (auto result = transform->Apply(program, inputs, outputs)) {
+    for (size_t i = 0; i < transforms_.size();) {
+        // Consecutive FusableTransforms are applied together.
+        size_t end = i + 1;
+        if (transforms_[i]->Is<FusableTransform>()) {
+            while (end < transforms_.size() && transforms_[end]->Is<FusableTransform>()) {
+                end++;
+            }
+        }
+        const auto& transform = transforms_[i];
+
+        std::string name;
+        if (listener) {
+            for (size_t j = i; j < end; j++) {
+                name += (j > i) ? "+" : "";
+                name += transforms_[j]->TypeInfo().name;
+            }
+            listener->BeforeTransform(name, *program);
+        }
+
+        Transform::ApplyResult result;
+        if (end - i > 1) {
+            result = apply_fused(i, end);
+        } else {
+            result = transform->Apply(program, inputs, outputs);
+        }
+        i = end;
+
+        if (result) {
             output.emplace(std::move(result.value()));
             program = &output.value();
 
+            if (listener) {
+                listener->AfterTransform(name, program);
+            }
+
             if (!program->IsValid()) {
                 TINT_IF_PRINT_PROGRAM(print_program("Invalid output of", transform.get()));
                 break;
@@ -67,6 +138,10 @@ Program Manager::Run(const Program* program, const DataMap& inputs, DataMap& out
 
             TINT_IF_PRINT_PROGRAM(print_program("Output of", transform.get()));
         } else {
+            if (listener) {
+                listener->AfterTransform(name, nullptr);
+            }
+
             TINT_IF_PRINT_PROGRAM(std::cout << "Skipped " << transform->TypeInfo().name
                                             << std::endl);
         }
@@ -16,6 +16,7 @@
 #define SRC_TINT_LANG_WGSL_AST_TRANSFORM_MANAGER_H_
 
 #include <memory>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -27,10 +28,35 @@ namespace tint::ast::transform {
 
 /// A collection of Transforms that act as a single Transform.
 /// The inner transforms will execute in the appended order.
+/// Consecutive FusableTransforms are applied together, with a single clone and resolve of the
+/// program.
 /// If any inner transform fails the manager will return immediately and
 /// the error can be retrieved with the Output's diagnostics.
 class Manager {
   public:
+    /// Listener is notified of the transforms run by the managers on a thread.
+    class Listener {
+      public:
+        /// Destructor
+        virtual ~Listener();
+
+        /// Called before transforms are applied to @p program.
+        /// @param name the type name of the transform, or the type names of the fused transforms
+        /// separated with '+'
+        /// @param program the program that the transforms are applied to
+        virtual void BeforeTransform(std::string_view name, const Program& program) = 0;
+
+        /// Called after transforms were applied.
+        /// @param name the name that was passed to BeforeTransform()
+        /// @param output the transformed program, or nullptr if the transforms were skipped
+        virtual void AfterTransform(std::string_view name, const Program* output) = 0;
+    };
+
+    /// Sets the listener notified of the transforms run by the managers on the calling thread.
+    /// @param listener the new listener, or nullptr to remove the listener
+    /// @returns the previous listener of the calling thread
+    static Listener* SetThreadListener(Listener* listener);
+
     /// Constructor
     Manager();
     ~Manager();
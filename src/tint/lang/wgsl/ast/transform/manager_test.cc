@@ -14,9 +14,14 @@
 
 #include "src/tint/lang/wgsl/ast/transform/manager.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "src/tint/lang/wgsl/ast/transform/manager_helper_test.h"
 #include "src/tint/lang/wgsl/ast/transform/transform.h"
 #include "src/tint/lang/wgsl/program/clone_context.h"
 #include "src/tint/lang/wgsl/program/program_builder.h"
@@ -27,27 +32,41 @@ namespace {
 
 using TransformManagerTest = testing::Test;
 
-class AST_NoOp final : public ast::transform::Transform {
-    ApplyResult Apply(const Program*, const DataMap&, DataMap&) const override {
-        return SkipTransform;
+class AST_FusableAddFunction final : public ast::transform::FusableTransform {
+  public:
+    AST_FusableAddFunction(std::string name, bool should_run)
+        : name_(std::move(name)), should_run_(should_run) {}
+
+    bool ShouldRun(const Program*, const DataMap&) const override { return should_run_; }
+
+    std::unique_ptr<FusedState> Fuse(program::CloneContext& ctx,
+                                     const DataMap&,
+                                     DataMap&) const override {
+        ctx.dst->Func(ctx.dst->Sym(name_), {}, ctx.dst->ty.void_(), {});
+        return nullptr;
     }
+
+  private:
+    std::string name_;
+    bool should_run_;
 };
 
-class AST_AddFunction final : public ast::transform::Transform {
-    ApplyResult Apply(const Program* src, const DataMap&, DataMap&) const override {
-        ProgramBuilder b;
-        program::CloneContext ctx{&b, src};
-        b.Func(b.Sym("ast_func"), {}, b.ty.void_(), {});
-        ctx.Clone();
-        return resolver::Resolve(b);
+/// Records the transforms reported to the listener, as "<name>" or "<name> (skipped)".
+class RecordingListener final : public Manager::Listener {
+  public:
+    RecordingListener() { previous_ = Manager::SetThreadListener(this); }
+    ~RecordingListener() override { Manager::SetThreadListener(previous_); }
+
+    void BeforeTransform(std::string_view, const Program&) override {}
+    void AfterTransform(std::string_view name, const Program* output) override {
+        records.push_back(std::string(name) + (output ? "" : " (skipped)"));
     }
-};
 
-Program MakeAST() {
-    ProgramBuilder b;
-    b.Func(b.Sym("main"), {}, b.ty.void_(), {});
-    return resolver::Resolve(b);
-}
+    std::vector<std::string> records;
+
+  private:
+    Manager::Listener* previous_ = nullptr;
+};
 
 // Test that an AST program is always cloned, even if all transforms are skipped.
 TEST_F(TransformManagerTest, AST_AlwaysClone) {
@@ -64,5 +83,52 @@ TEST_F(TransformManagerTest, AST_AlwaysClone) {
     EXPECT_EQ(result.AST().Functions()[0]->name->symbol.Name(), "main");
 }
 
+// Test that consecutive fusable transforms are applied with a single clone of the program.
+TEST_F(TransformManagerTest, AST_FuseTransforms) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_FusableAddFunction>("a", true);
+    manager.Add<AST_FusableAddFunction>("b", false);
+    manager.Add<AST_FusableAddFunction>("c", true);
+    manager.Add<AST_NoOp>();
+    manager.Add<AST_FusableAddFunction>("d", true);
+
+    RecordingListener listener;
+    auto result = manager.Run(&ast, {}, outputs);
+    EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+    ASSERT_EQ(result.AST().Functions().Length(), 4u);
+    EXPECT_EQ(result.AST().Functions()[0]->name->symbol.Name(), "d");
+    EXPECT_EQ(result.AST().Functions()[1]->name->symbol.Name(), "a");
+    EXPECT_EQ(result.AST().Functions()[2]->name->symbol.Name(), "c");
+    EXPECT_EQ(result.AST().Functions()[3]->name->symbol.Name(), "main");
+
+    // The three fused transforms are reported together, then AST_NoOp and the last transform.
+    ASSERT_EQ(listener.records.size(), 3u);
+    EXPECT_EQ(std::count(listener.records[0].begin(), listener.records[0].end(), '+'), 2);
+    EXPECT_EQ(listener.records[0].find(" (skipped)"), std::string::npos);
+    EXPECT_NE(listener.records[1].find(" (skipped)"), std::string::npos);
+    EXPECT_EQ(listener.records[2].find('+'), std::string::npos);
+    EXPECT_EQ(listener.records[2].find(" (skipped)"), std::string::npos);
+}
+
+// Test that fused transforms that don't need to run leave the program untouched.
+TEST_F(TransformManagerTest, AST_FuseTransforms_AllSkipped) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_FusableAddFunction>("a", false);
+    manager.Add<AST_FusableAddFunction>("b", false);
+
+    RecordingListener listener;
+    auto result = manager.Run(&ast, {}, outputs);
+    EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+    ASSERT_EQ(result.AST().Functions().Length(), 1u);
+    ASSERT_EQ(listener.records.size(), 1u);
+    EXPECT_NE(listener.records[0].find(" (skipped)"), std::string::npos);
+}
+
 }  // namespace
 }  // namespace tint::ast::transform
@@ -0,0 +1,58 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/wgsl/ast/transform/profiler.h"
+
+#include <utility>
+
+namespace tint::ast::transform {
+namespace {
+
+/// @returns the bytes of the AST and semantic node allocators of @p program
+size_t NodeBytes(const Program& program) {
+    return program.ASTNodes().AllocatedBytes() + program.SemNodes().AllocatedBytes();
+}
+
+}  // namespace
+
+Profiler::Profiler() {
+    previous_ = Manager::SetThreadListener(this);
+}
+
+Profiler::~Profiler() {
+    Manager::SetThreadListener(previous_);
+}
+
+void Profiler::BeforeTransform(std::string_view name, const Program& program) {
+    Entry entry;
+    entry.name = name;
+    entry.depth = running_.Length();
+    entry.ast_nodes_before = program.ASTNodes().Count();
+    entry.node_bytes_before = NodeBytes(program);
+    entries_.Push(std::move(entry));
+
+    running_.Push(Running{entries_.Length() - 1, std::chrono::steady_clock::now()});
+}
+
+void Profiler::AfterTransform(std::string_view, const Program* output) {
+    auto end_time = std::chrono::steady_clock::now();
+    auto running = running_.Pop();
+    auto& entry = entries_[running.index];
+    entry.time = end_time - running.start_time;
+    entry.skipped = output == nullptr;
+    entry.ast_nodes_after = output ? output->ASTNodes().Count() : entry.ast_nodes_before;
+    entry.node_bytes_after = output ? NodeBytes(*output) : entry.node_bytes_before;
+}
+
+}  // namespace tint::ast::transform
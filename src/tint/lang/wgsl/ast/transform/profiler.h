@@ -0,0 +1,86 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_WGSL_AST_TRANSFORM_PROFILER_H_
+#define SRC_TINT_LANG_WGSL_AST_TRANSFORM_PROFILER_H_
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include "src/tint/lang/wgsl/ast/transform/manager.h"
+#include "src/tint/utils/containers/vector.h"
+
+namespace tint::ast::transform {
+
+/// Profiler records the cost of each transform run by the transform managers on the thread that
+/// constructed it, until it is destructed.
+/// Only one Profiler records at a time: the profiler replaces the listener of the thread when
+/// constructed, and restores it when destructed.
+class Profiler final : public Manager::Listener {
+  public:
+    /// Entry is the profile of a single transform, or of a group of fused transforms.
+    struct Entry {
+        /// The type name of the transform, or the type names of the fused transforms separated
+        /// with '+'
+        std::string name;
+        /// True if the transforms did not need to run, and the program was not cloned
+        bool skipped = false;
+        /// The number of transforms that were still running when these transforms started. Entries
+        /// with a non-zero depth were run by a transform that runs a transform manager itself.
+        size_t depth = 0;
+        /// The wall time spent running the transforms
+        std::chrono::nanoseconds time{};
+        /// The number of AST nodes of the program before the transforms
+        size_t ast_nodes_before = 0;
+        /// The number of AST nodes of the program after the transforms
+        size_t ast_nodes_after = 0;
+        /// The bytes of the AST and semantic node allocators of the program before the transforms
+        size_t node_bytes_before = 0;
+        /// The bytes of the AST and semantic node allocators of the program after the transforms
+        size_t node_bytes_after = 0;
+    };
+
+    /// Constructor
+    Profiler();
+    /// Destructor
+    ~Profiler() override;
+
+    /// @copydoc Manager::Listener::BeforeTransform
+    void BeforeTransform(std::string_view name, const Program& program) override;
+    /// @copydoc Manager::Listener::AfterTransform
+    void AfterTransform(std::string_view name, const Program* output) override;
+
+    /// @returns the profiles of the transforms, in the order that they started. Transforms that
+    /// run a transform manager themselves are listed before the inner transforms, and their time
+    /// includes the time of the inner transforms.
+    const Vector<Entry, 32>& Entries() const { return entries_; }
+
+  private:
+    /// A transform that has started but not finished yet
+    struct Running {
+        /// The index of the transform's entry in #entries_
+        size_t index;
+        /// The time that the transform started
+        std::chrono::steady_clock::time_point start_time;
+    };
+
+    Manager::Listener* previous_ = nullptr;
+    Vector<Entry, 32> entries_;
+    Vector<Running, 4> running_;
+};
+
+}  // namespace tint::ast::transform
+
+#endif  // SRC_TINT_LANG_WGSL_AST_TRANSFORM_PROFILER_H_
@@ -0,0 +1,102 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/wgsl/ast/transform/profiler.h"
+
+#include "gtest/gtest.h"
+#include "src/tint/lang/wgsl/ast/transform/manager_helper_test.h"
+
+namespace tint::ast::transform {
+namespace {
+
+using TransformProfilerTest = testing::Test;
+
+class AST_RunInnerManager final : public ast::transform::Transform {
+    ApplyResult Apply(const Program* src, const DataMap& inputs, DataMap& outputs) const override {
+        Manager manager;
+        manager.Add<AST_AddFunction>();
+        return manager.Run(src, inputs, outputs);
+    }
+};
+
+// Test that the profiler records each transform, in order.
+TEST_F(TransformProfilerTest, Entries) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_AddFunction>();
+    manager.Add<AST_NoOp>();
+
+    Profiler profiler;
+    auto result = manager.Run(&ast, {}, outputs);
+    EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+
+    auto& entries = profiler.Entries();
+    ASSERT_EQ(entries.Length(), 2u);
+    EXPECT_FALSE(entries[0].name.empty());
+    EXPECT_FALSE(entries[0].skipped);
+    EXPECT_EQ(entries[0].depth, 0u);
+    EXPECT_EQ(entries[0].ast_nodes_before, ast.ASTNodes().Count());
+    EXPECT_GT(entries[0].ast_nodes_after, entries[0].ast_nodes_before);
+    EXPECT_GT(entries[0].node_bytes_before, 0u);
+    EXPECT_GT(entries[0].node_bytes_after, 0u);
+
+    EXPECT_TRUE(entries[1].skipped);
+    EXPECT_EQ(entries[1].depth, 0u);
+    EXPECT_EQ(entries[1].ast_nodes_after, entries[1].ast_nodes_before);
+    EXPECT_EQ(entries[1].node_bytes_after, entries[1].node_bytes_before);
+}
+
+// Test that transforms run by a transform are recorded after it, within its time.
+TEST_F(TransformProfilerTest, NestedManager) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_RunInnerManager>();
+
+    Profiler profiler;
+    auto result = manager.Run(&ast, {}, outputs);
+    EXPECT_TRUE(result.IsValid()) << result.Diagnostics();
+
+    auto& entries = profiler.Entries();
+    ASSERT_EQ(entries.Length(), 2u);
+    EXPECT_EQ(entries[0].depth, 0u);
+    EXPECT_EQ(entries[1].depth, 1u);
+    EXPECT_GE(entries[0].time, entries[1].time);
+    EXPECT_EQ(entries[0].ast_nodes_before, entries[1].ast_nodes_before);
+    EXPECT_EQ(entries[0].ast_nodes_after, entries[1].ast_nodes_after);
+}
+
+// Test that the profiler only records while it exists.
+TEST_F(TransformProfilerTest, Scope) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_AddFunction>();
+
+    {
+        Profiler profiler;
+        manager.Run(&ast, {}, outputs);
+        EXPECT_EQ(profiler.Entries().Length(), 1u);
+    }
+
+    Profiler profiler;
+    EXPECT_TRUE(profiler.Entries().IsEmpty());
+}
+
+}  // namespace
+}  // namespace tint::ast::transform
@@ -30,6 +30,7 @@
 #include "src/tint/lang/wgsl/sem/variable.h"
 
 TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::Transform);
+TINT_INSTANTIATE_TYPEINFO(tint::ast::transform::FusableTransform);
 
 namespace tint::ast::transform {
 
@@ -176,4 +177,23 @@ Type Transform::CreateASTTypeFor(program::CloneContext& ctx, const type::Type* t
     return Type{};
 }
 
+FusableTransform::FusableTransform() = default;
+FusableTransform::~FusableTransform() = default;
+FusableTransform::FusedState::~FusedState() = default;
+
+Transform::ApplyResult FusableTransform::Apply(const Program* src,
+                                               const DataMap& inputs,
+                                               DataMap& outputs) const {
+    if (!ShouldRun(src, inputs)) {
+        return SkipTransform;
+    }
+
+    ProgramBuilder b;
+    program::CloneContext ctx{&b, src, /* auto_clone_symbols */ true};
+    auto state = Fuse(ctx, inputs, outputs);
+
+    ctx.Clone();
+    return resolver::Resolve(b);
+}
+
 }  // namespace tint::ast::transform
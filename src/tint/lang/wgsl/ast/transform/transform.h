@@ -15,6 +15,7 @@
 #ifndef SRC_TINT_LANG_WGSL_AST_TRANSFORM_TRANSFORM_H_
 #define SRC_TINT_LANG_WGSL_AST_TRANSFORM_TRANSFORM_H_
 
+#include <memory>
 #include <utility>
 
 #include "src/tint/lang/wgsl/ast/transform/data.h"
@@ -99,6 +100,49 @@ class Transform : public Castable<Transform> {
     static void RemoveStatement(program::CloneContext& ctx, const Statement* stmt);
 };
 
+/// Interface for transforms that can be fused with other FusableTransforms, so that the Manager
+/// applies a run of consecutive FusableTransforms with a single clone and resolve of the program.
+/// The fused transforms all observe the same source program, so a FusableTransform must only make
+/// changes that do not depend on, nor conflict with, the changes of the other FusableTransforms.
+/// For example it may add module-scope declarations, or replace nodes that no other
+/// FusableTransform changes.
+class FusableTransform : public Castable<FusableTransform, Transform> {
+  public:
+    /// Constructor
+    FusableTransform();
+    /// Destructor
+    ~FusableTransform() override;
+
+    /// Applies the transform on its own, with ShouldRun() and Fuse().
+    /// @copydoc Transform::Apply
+    ApplyResult Apply(const Program* program,
+                      const DataMap& inputs,
+                      DataMap& outputs) const override;
+
+    /// @param program the source program
+    /// @param inputs optional extra transform-specific input data
+    /// @returns true if the transform needs to run on @p program
+    virtual bool ShouldRun(const Program* program, const DataMap& inputs) const = 0;
+
+    /// FusedState is the base class of the state that the changes registered by Fuse() refer to.
+    class FusedState {
+      public:
+        /// Destructor
+        virtual ~FusedState();
+    };
+
+    /// Registers the changes of the transform with @p ctx, without cloning the program. Only
+    /// called if ShouldRun() returned true for `ctx.src`.
+    /// @param ctx the clone context shared by the fused transforms
+    /// @param inputs optional extra transform-specific input data
+    /// @param outputs optional extra transform-specific output data
+    /// @returns the state that the registered changes refer to, which is kept alive until the
+    /// program has been cloned, or nullptr
+    virtual std::unique_ptr<FusedState> Fuse(program::CloneContext& ctx,
+                                             const DataMap& inputs,
+                                             DataMap& outputs) const = 0;
+};
+
 }  // namespace tint::ast::transform
 
 #endif  // SRC_TINT_LANG_WGSL_AST_TRANSFORM_TRANSFORM_H_
@@ -248,6 +248,35 @@ std::vector<EntryPoint> Inspector::GetEntryPoints() {
     return result;
 }
 
+std::vector<std::string> Inspector::GetEntryPointNames() {
+    std::vector<std::string> result;
+
+    for (auto* func : program_->AST().Functions()) {
+        if (func->IsEntryPoint()) {
+            result.push_back(func->name->symbol.Name());
+        }
+    }
+
+    return result;
+}
+
+std::vector<ResourceBinding::TexelFormat> Inspector::GetStorageTextureTexelFormats() {
+    std::vector<ResourceBinding::TexelFormat> result;
+
+    for (auto* var : program_->AST().GlobalVariables()) {
+        auto* global = program_->Sem().Get<sem::GlobalVariable>(var);
+        if (!global) {
+            continue;
+        }
+        if (auto* texture_type = global->Type()->UnwrapRef()->As<type::StorageTexture>()) {
+            result.push_back(
+                TypeTexelFormatToResourceBindingTexelFormat(texture_type->texel_format()));
+        }
+    }
+
+    return result;
+}
+
 std::map<OverrideId, Scalar> Inspector::GetOverrideDefaultValues() {
     std::map<OverrideId, Scalar> result;
     for (auto* var : program_->AST().GlobalVariables()) {
@@ -60,6 +60,14 @@ class Inspector {
     /// @returns the entry point information
     EntryPoint GetEntryPoint(const std::string& entry_point);
 
+    /// @returns the names of the entry points, without computing the rest of the entry point
+    /// information
+    std::vector<std::string> GetEntryPointNames();
+
+    /// @returns the texel formats of all the storage textures declared in the module, including
+    /// the ones that are not used by any entry point
+    std::vector<ResourceBinding::TexelFormat> GetStorageTextureTexelFormats();
+
     /// @returns map of override identifier to initial value
     std::map<OverrideId, Scalar> GetOverrideDefaultValues();
 
@@ -126,6 +126,10 @@ class InspectorGetSamplerTextureUsesTest : public InspectorRunner, public testin
 
 class InspectorGetWorkgroupStorageSizeTest : public InspectorBuilder, public testing::Test {};
 
+class InspectorGetEntryPointNamesTest : public InspectorRunner, public testing::Test {};
+
+class InspectorGetStorageTextureTexelFormatsTest : public InspectorRunner, public testing::Test {};
+
 class InspectorGetUsedExtensionNamesTest : public InspectorRunner, public testing::Test {};
 
 class InspectorGetEnableDirectivesTest : public InspectorRunner, public testing::Test {};
@@ -3557,6 +3561,70 @@ TEST_F(InspectorGetWorkgroupStorageSizeTest, StructAlignment) {
     EXPECT_EQ(1024u, inspector.GetWorkgroupStorageSize("ep_func"));
 }
 
+TEST_F(InspectorGetEntryPointNamesTest, Empty) {
+    Inspector& inspector = Initialize("");
+
+    auto result = inspector.GetEntryPointNames();
+    EXPECT_EQ(result.size(), 0u);
+}
+
+TEST_F(InspectorGetEntryPointNamesTest, MixFunctionsAndEntryPoints) {
+    std::string shader = R"(
+fn func() {}
+
+@compute @workgroup_size(1)
+fn foo() {
+    func();
+}
+
+@fragment
+fn bar() {
+    func();
+})";
+
+    Inspector& inspector = Initialize(shader);
+
+    auto result = inspector.GetEntryPointNames();
+    ASSERT_FALSE(inspector.has_error()) << inspector.error();
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0], "foo");
+    EXPECT_EQ(result[1], "bar");
+}
+
+TEST_F(InspectorGetStorageTextureTexelFormatsTest, None) {
+    std::string shader = R"(
+@group(0) @binding(0) var t : texture_2d<f32>;
+
+@fragment
+fn main() {
+    _ = t;
+})";
+
+    Inspector& inspector = Initialize(shader);
+
+    auto result = inspector.GetStorageTextureTexelFormats();
+    EXPECT_EQ(result.size(), 0u);
+}
+
+// Test that storage textures that are not used by any entry point are returned as well.
+TEST_F(InspectorGetStorageTextureTexelFormatsTest, UsedAndUnused) {
+    std::string shader = R"(
+@group(0) @binding(0) var used : texture_storage_2d<rgba8unorm, write>;
+@group(0) @binding(1) var unused : texture_storage_2d<r32float, write>;
+
+@fragment
+fn main() {
+    _ = used;
+})";
+
+    Inspector& inspector = Initialize(shader);
+
+    auto result = inspector.GetStorageTextureTexelFormats();
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0], ResourceBinding::TexelFormat::kRgba8Unorm);
+    EXPECT_EQ(result[1], ResourceBinding::TexelFormat::kR32Float);
+}
+
 // Test calling GetUsedExtensionNames on a empty shader.
 TEST_F(InspectorGetUsedExtensionNamesTest, Empty) {
     std::string shader = "";
@@ -15,12 +15,53 @@
 #ifndef SRC_TINT_LANG_WGSL_READER_PARSER_CLASSIFY_TEMPLATE_ARGS_H_
 #define SRC_TINT_LANG_WGSL_READER_PARSER_CLASSIFY_TEMPLATE_ARGS_H_
 
+#include <optional>
 #include <vector>
 
 #include "src/tint/lang/wgsl/reader/parser/token.h"
+#include "src/tint/utils/containers/vector.h"
 
 namespace tint::wgsl::reader {
 
+/// TemplateArgumentClassifier classifies the '<' and '>' tokens of a token stream as template
+/// argument list delimiters, one token at a time, so that a stream can be classified as it is
+/// lexed.
+class TemplateArgumentClassifier {
+  public:
+    /// Classifies the token @p token.
+    /// @param idx the index of @p token in the token stream
+    /// @param token the token to classify
+    /// @param next the token that follows @p token
+    /// @returns the number of tokens that were classified, 2 if @p next was classified with
+    /// @p token.
+    /// @note the classifier holds pointers to the tokens that are yet to be classified, so these
+    /// must not move in memory until they are classified.
+    size_t Classify(size_t idx, Token& token, Token& next);
+
+    /// @returns the index of the first '<' token that may still be classified as a template
+    /// argument list delimiter, or std::nullopt if all the classified tokens are final.
+    std::optional<size_t> FirstPending() const;
+
+  private:
+    /// An opening '<' token that has not been paired with a '>' token yet.
+    struct StackEntry {
+        Token* token;         // A pointer to the opening '<' token
+        size_t idx;           // The index of the opening '<' token in the token stream
+        uint64_t expr_depth;  // The value of 'expr_depth' for the opening '<'
+    };
+
+    /// The current expression nesting depth.
+    /// Each '(', '[' increments the depth.
+    /// Each ')', ']' decrements the depth.
+    uint64_t expr_depth_ = 0;
+
+    /// A stack of '<' tokens.
+    /// Used to pair '<' and '>' tokens at the same expression depth.
+    Vector<StackEntry, 16> stack_;
+};
+
+/// Classifies all the template argument list delimiters of @p tokens.
+/// @param tokens the tokens of a whole source file
 void ClassifyTemplateArguments(std::vector<Token>& tokens);
 
 }  // namespace tint::wgsl::reader
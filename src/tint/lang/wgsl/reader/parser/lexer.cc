@@ -14,6 +14,7 @@
 
 #include "src/tint/lang/wgsl/reader/parser/lexer.h"
 
+#include <array>
 #include <cctype>
 #include <charconv>
 #include <cmath>
@@ -68,6 +69,86 @@ bool read_blankspace(std::string_view str, size_t i, bool* is_blankspace, size_t
     return true;
 }
 
+/// A keyword and the token type that it is lexed as.
+struct Keyword {
+    std::string_view str;
+    Token::Type type = Token::Type::kUninitialized;
+};
+
+constexpr Keyword kKeywords[] = {
+    {"alias", Token::Type::kAlias},
+    {"bitcast", Token::Type::kBitcast},
+    {"break", Token::Type::kBreak},
+    {"case", Token::Type::kCase},
+    {"const", Token::Type::kConst},
+    {"const_assert", Token::Type::kConstAssert},
+    {"continue", Token::Type::kContinue},
+    {"continuing", Token::Type::kContinuing},
+    {"diagnostic", Token::Type::kDiagnostic},
+    {"discard", Token::Type::kDiscard},
+    {"default", Token::Type::kDefault},
+    {"else", Token::Type::kElse},
+    {"enable", Token::Type::kEnable},
+    {"fallthrough", Token::Type::kFallthrough},
+    {"false", Token::Type::kFalse},
+    {"fn", Token::Type::kFn},
+    {"for", Token::Type::kFor},
+    {"if", Token::Type::kIf},
+    {"let", Token::Type::kLet},
+    {"loop", Token::Type::kLoop},
+    {"override", Token::Type::kOverride},
+    {"return", Token::Type::kReturn},
+    {"requires", Token::Type::kRequires},
+    {"struct", Token::Type::kStruct},
+    {"switch", Token::Type::kSwitch},
+    {"true", Token::Type::kTrue},
+    {"var", Token::Type::kVar},
+    {"while", Token::Type::kWhile},
+    {"_", Token::Type::kUnderscore},
+};
+
+constexpr size_t kMaxKeywordLength = 12;  // const_assert
+constexpr size_t kKeywordTableSize = 64;
+
+/// A hash function that is perfect over kKeywords, so that looking up a keyword is a single table
+/// load and string comparison.
+/// @param str a non-empty string
+/// @returns the index of the entry of kKeywordTable to compare @p str with
+constexpr size_t KeywordHash(std::string_view str) {
+    return (static_cast<uint8_t>(str.front()) * 14u + static_cast<uint8_t>(str.back()) * 30u +
+            str.size()) %
+           kKeywordTableSize;
+}
+
+using KeywordTable = std::array<Keyword, kKeywordTableSize>;
+
+constexpr KeywordTable BuildKeywordTable() {
+    KeywordTable table{};
+    for (const Keyword& keyword : kKeywords) {
+        table[KeywordHash(keyword.str)] = keyword;
+    }
+    return table;
+}
+
+constexpr KeywordTable kKeywordTable = BuildKeywordTable();
+
+constexpr bool KeywordHashIsPerfect() {
+    for (const Keyword& keyword : kKeywords) {
+        if (keyword.str.size() > kMaxKeywordLength ||
+            kKeywordTable[KeywordHash(keyword.str)].str != keyword.str) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(KeywordHashIsPerfect(), "KeywordHash has collisions, change its multipliers");
+
+/// @returns true if @p c is an ASCII character that can continue an identifier
+bool is_ascii_ident_continue(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '_';
+}
+
 uint32_t dec_value(char c) {
     if (c >= '0' && c <= '9') {
         return static_cast<uint32_t>(c - '0');
@@ -98,24 +179,33 @@ std::vector<Token> Lexer::Lex() {
     std::vector<Token> tokens;
     tokens.reserve(kDefaultListSize);
 
-    while (true) {
-        tokens.emplace_back(next());
-        if (tokens.back().IsEof() || tokens.back().IsError()) {
-            break;
-        }
-
-        // If the token can be split, we insert a placeholder element(s) into the stream to hold the
-        // split character.
-        size_t num_placeholders = tokens.back().NumPlaceholders();
-        for (size_t i = 0; i < num_placeholders; i++) {
-            auto src = tokens.back().source();
-            src.range.begin.column++;
-            tokens.emplace_back(Token::Type::kPlaceholder, src);
-        }
+    while (lex_next(tokens)) {
     }
     return tokens;
 }
 
+bool Lexer::LexNext(std::deque<Token>& tokens) {
+    return lex_next(tokens);
+}
+
+template <typename TOKENS>
+bool Lexer::lex_next(TOKENS& tokens) {
+    tokens.emplace_back(next());
+    if (tokens.back().IsEof() || tokens.back().IsError()) {
+        return false;
+    }
+
+    // If the token can be split, we insert a placeholder element(s) into the stream to hold the
+    // split character.
+    size_t num_placeholders = tokens.back().NumPlaceholders();
+    for (size_t i = 0; i < num_placeholders; i++) {
+        auto src = tokens.back().source();
+        src.range.begin.column++;
+        tokens.emplace_back(Token::Type::kPlaceholder, src);
+    }
+    return true;
+}
+
 const std::string_view Lexer::line() const {
     if (file_->content.lines.size() == 0) {
         static const char* empty_string = "";
@@ -981,19 +1071,27 @@ std::optional<Token> Lexer::try_ident() {
     }
 
     while (!is_eol()) {
-        // Must continue with an XID_Continue unicode character
-        auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
-        auto [code_point, n] = tint::utf8::Decode(utf8, line().size() - pos());
-        if (n == 0) {
-            advance();  // Skip the bad byte.
-            return Token{Token::Type::kError, source, "invalid UTF-8"};
-        }
-        if (!code_point.IsXIDContinue()) {
+        // ASCII characters don't need to be decoded, and are the vast majority of identifiers.
+        char c = at(pos());
+        if (is_ascii_ident_continue(c)) {
+            advance();
+        } else if (static_cast<uint8_t>(c) < 0x80) {
             break;
-        }
+        } else {
+            // Must continue with an XID_Continue unicode character
+            auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
+            auto [code_point, n] = tint::utf8::Decode(utf8, line().size() - pos());
+            if (n == 0) {
+                advance();  // Skip the bad byte.
+                return Token{Token::Type::kError, source, "invalid UTF-8"};
+            }
+            if (!code_point.IsXIDContinue()) {
+                break;
+            }
 
-        // Consume continuing codepoint
-        advance(n);
+            // Consume continuing codepoint
+            advance(n);
+        }
 
         if (pos() - start == 2 && substr(start, 2) == "__") {
             // Identifiers prefixed with two or more underscores are not allowed.
@@ -1194,92 +1292,12 @@ std::optional<Token> Lexer::try_punctuation() {
 }
 
 std::optional<Token::Type> Lexer::parse_keyword(std::string_view str) {
-    if (str == "alias") {
-        return Token::Type::kAlias;
-    }
-    if (str == "bitcast") {
-        return Token::Type::kBitcast;
-    }
-    if (str == "break") {
-        return Token::Type::kBreak;
-    }
-    if (str == "case") {
-        return Token::Type::kCase;
-    }
-    if (str == "const") {
-        return Token::Type::kConst;
-    }
-    if (str == "const_assert") {
-        return Token::Type::kConstAssert;
-    }
-    if (str == "continue") {
-        return Token::Type::kContinue;
-    }
-    if (str == "continuing") {
-        return Token::Type::kContinuing;
-    }
-    if (str == "diagnostic") {
-        return Token::Type::kDiagnostic;
-    }
-    if (str == "discard") {
-        return Token::Type::kDiscard;
-    }
-    if (str == "default") {
-        return Token::Type::kDefault;
-    }
-    if (str == "else") {
-        return Token::Type::kElse;
-    }
-    if (str == "enable") {
-        return Token::Type::kEnable;
-    }
-    if (str == "fallthrough") {
-        return Token::Type::kFallthrough;
-    }
-    if (str == "false") {
-        return Token::Type::kFalse;
-    }
-    if (str == "fn") {
-        return Token::Type::kFn;
-    }
-    if (str == "for") {
-        return Token::Type::kFor;
-    }
-    if (str == "if") {
-        return Token::Type::kIf;
-    }
-    if (str == "let") {
-        return Token::Type::kLet;
-    }
-    if (str == "loop") {
-        return Token::Type::kLoop;
-    }
-    if (str == "override") {
-        return Token::Type::kOverride;
-    }
-    if (str == "return") {
-        return Token::Type::kReturn;
-    }
-    if (str == "requires") {
-        return Token::Type::kRequires;
-    }
-    if (str == "struct") {
-        return Token::Type::kStruct;
-    }
-    if (str == "switch") {
-        return Token::Type::kSwitch;
-    }
-    if (str == "true") {
-        return Token::Type::kTrue;
-    }
-    if (str == "var") {
-        return Token::Type::kVar;
-    }
-    if (str == "while") {
-        return Token::Type::kWhile;
+    if (str.size() > kMaxKeywordLength) {
+        return std::nullopt;
     }
-    if (str == "_") {
-        return Token::Type::kUnderscore;
+    const Keyword& keyword = kKeywordTable[KeywordHash(str)];
+    if (keyword.str == str) {
+        return keyword.type;
     }
     return std::nullopt;
 }
@@ -15,6 +15,7 @@
 #ifndef SRC_TINT_LANG_WGSL_READER_PARSER_LEXER_H_
 #define SRC_TINT_LANG_WGSL_READER_PARSER_LEXER_H_
 
+#include <deque>
 #include <optional>
 #include <string>
 #include <vector>
@@ -34,7 +35,18 @@ class Lexer {
     /// @return the token list.
     std::vector<Token> Lex();
 
+    /// Lexes the next token of the input stream, appending it to @p tokens followed by the
+    /// placeholders that it can be split into. This lets the parser pull tokens as it consumes
+    /// them instead of holding the tokens of the whole file.
+    /// @param tokens the token list to append to
+    /// @return false if the appended token is the end of file or an error, which ends the stream.
+    bool LexNext(std::deque<Token>& tokens);
+
   private:
+    /// Implementation of Lex() and LexNext().
+    template <typename TOKENS>
+    bool lex_next(TOKENS& tokens);
+
     /// Returns the next token in the input stream.
     /// @return Token
     Token next();
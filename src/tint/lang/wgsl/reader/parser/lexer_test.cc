@@ -14,6 +14,7 @@
 
 #include "src/tint/lang/wgsl/reader/parser/lexer.h"
 
+#include <deque>
 #include <limits>
 #include <tuple>
 #include <vector>
@@ -52,6 +53,29 @@ TEST_F(LexerTest, Empty) {
     EXPECT_TRUE(list[0].IsEof());
 }
 
+TEST_F(LexerTest, LexNext_MatchesLex) {
+    Source::File file("", "fn f() -> i32 { return a >> 2; }");
+
+    Lexer whole(&file);
+    auto list = whole.Lex();
+
+    Lexer streaming(&file);
+    std::deque<Token> tokens;
+    while (streaming.LexNext(tokens)) {
+    }
+
+    ASSERT_EQ(list.size(), tokens.size());
+    for (size_t i = 0; i < list.size(); i++) {
+        EXPECT_EQ(list[i].type(), tokens[i].type());
+        EXPECT_EQ(list[i].source().range, tokens[i].source().range);
+    }
+    EXPECT_TRUE(tokens.back().IsEof());
+
+    // Lexing past the end of the input keeps returning the end of file.
+    EXPECT_FALSE(streaming.LexNext(tokens));
+    EXPECT_TRUE(tokens.back().IsEof());
+}
+
 TEST_F(LexerTest, Skips_Blankspace_Basic) {
     Source::File file("", "\t\r\n\t    ident\t\n\t  \r ");
     Lexer l(&file);
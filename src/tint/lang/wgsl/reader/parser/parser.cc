@@ -250,38 +250,43 @@ void Parser::deprecated(const Source& source, std::string_view msg) {
 }
 
 const Token& Parser::next() {
+    // The token stream always ends with an error or the end of file, so it can't end before
+    // next_token_idx_.
+    lex_until(next_token_idx_);
+
     // If the next token is already an error or the end of file, stay there.
-    if (tokens_[next_token_idx_].IsEof() || tokens_[next_token_idx_].IsError()) {
-        return tokens_[next_token_idx_];
+    if (token_at(next_token_idx_).IsEof() || token_at(next_token_idx_).IsError()) {
+        return token_at(next_token_idx_);
     }
 
     // Skip over any placeholder elements
     while (true) {
-        if (!tokens_[next_token_idx_].IsPlaceholder()) {
+        if (!token_at(next_token_idx_).IsPlaceholder()) {
             break;
         }
         next_token_idx_++;
+        lex_until(next_token_idx_);
     }
     last_source_idx_ = next_token_idx_;
 
-    if (!tokens_[next_token_idx_].IsEof() && !tokens_[next_token_idx_].IsError()) {
+    if (!token_at(next_token_idx_).IsEof() && !token_at(next_token_idx_).IsError()) {
         next_token_idx_++;
     }
-    return tokens_[last_source_idx_];
+    return token_at(last_source_idx_);
 }
 
 const Token& Parser::peek(size_t count) {
-    for (size_t idx = next_token_idx_; idx < tokens_.size(); idx++) {
-        if (tokens_[idx].IsPlaceholder()) {
+    for (size_t idx = next_token_idx_; lex_until(idx); idx++) {
+        if (token_at(idx).IsPlaceholder()) {
             continue;
         }
         if (count == 0) {
-            return tokens_[idx];
+            return token_at(idx);
         }
         count--;
     }
     // Walked off the end of the token list, return last token.
-    return tokens_[tokens_.size() - 1];
+    return tokens_.back();
 }
 
 bool Parser::peek_is(Token::Type tok, size_t idx) {
@@ -292,24 +297,64 @@ void Parser::split_token(Token::Type lhs, Token::Type rhs) {
     if (TINT_UNLIKELY(next_token_idx_ == 0)) {
         TINT_ICE() << "attempt to update placeholder at beginning of tokens";
     }
-    if (TINT_UNLIKELY(next_token_idx_ >= tokens_.size())) {
+    if (TINT_UNLIKELY(!lex_until(next_token_idx_))) {
         TINT_ICE() << "attempt to update placeholder past end of tokens";
     }
-    if (TINT_UNLIKELY(!tokens_[next_token_idx_].IsPlaceholder())) {
+    if (TINT_UNLIKELY(!token_at(next_token_idx_).IsPlaceholder())) {
         TINT_ICE() << "attempt to update non-placeholder token";
     }
-    tokens_[next_token_idx_ - 1].SetType(lhs);
-    tokens_[next_token_idx_].SetType(rhs);
+    token_at(next_token_idx_ - 1).SetType(lhs);
+    token_at(next_token_idx_).SetType(rhs);
 }
 
 Source Parser::last_source() const {
-    return tokens_[last_source_idx_].source();
+    return tokens_[last_source_idx_ - first_token_idx_].source();
 }
 
 void Parser::InitializeLex() {
-    Lexer l{file_};
-    tokens_ = l.Lex();
-    ClassifyTemplateArguments(tokens_);
+    lexer_ = std::make_unique<Lexer>(file_);
+    classifier_ = {};
+    tokens_.clear();
+    first_token_idx_ = 0;
+    classified_token_count_ = 0;
+    lexed_all_tokens_ = false;
+    next_token_idx_ = 0;
+    last_source_idx_ = 0;
+}
+
+bool Parser::lex_until(size_t idx) {
+    while (true) {
+        // A token can be parsed once it is classified, and no '<' before it may still be
+        // classified as the start of a template argument list.
+        size_t end = first_token_idx_ + tokens_.size();
+        if (!lexed_all_tokens_) {
+            end = classifier_.FirstPending().value_or(classified_token_count_);
+        }
+        if (idx < end) {
+            return true;
+        }
+        if (lexed_all_tokens_) {
+            return false;
+        }
+
+        lexed_all_tokens_ = !lexer_->LexNext(tokens_);
+
+        // Each token is classified with the token that follows it. The last token is the end of
+        // file or an error, which doesn't need to be classified.
+        while (classified_token_count_ + 1 < first_token_idx_ + tokens_.size()) {
+            classified_token_count_ +=
+                classifier_.Classify(classified_token_count_, token_at(classified_token_count_),
+                                     token_at(classified_token_count_ + 1));
+        }
+    }
+}
+
+void Parser::release_consumed_tokens() {
+    // Keep the last consumed token, which is used by last_source().
+    while (first_token_idx_ < last_source_idx_) {
+        tokens_.pop_front();
+        first_token_idx_++;
+    }
 }
 
 bool Parser::Parse() {
@@ -323,6 +368,10 @@ bool Parser::Parse() {
 void Parser::translation_unit() {
     bool after_global_decl = false;
     while (continue_parsing()) {
+        // No tokens are referenced in between global declarations, so the tokens of the previous
+        // declarations can be released to bound the memory used by the token stream.
+        release_consumed_tokens();
+
         auto& p = peek();
         if (p.IsEof()) {
             break;
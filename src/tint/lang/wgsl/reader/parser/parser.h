@@ -15,6 +15,7 @@
 #ifndef SRC_TINT_LANG_WGSL_READER_PARSER_PARSER_H_
 #define SRC_TINT_LANG_WGSL_READER_PARSER_PARSER_H_
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -24,6 +25,7 @@
 
 #include "src/tint/lang/core/builtin/access.h"
 #include "src/tint/lang/wgsl/program/program_builder.h"
+#include "src/tint/lang/wgsl/reader/parser/classify_template_args.h"
 #include "src/tint/lang/wgsl/reader/parser/detail.h"
 #include "src/tint/lang/wgsl/reader/parser/token.h"
 #include "src/tint/lang/wgsl/resolver/resolve.h"
@@ -292,8 +294,8 @@ class Parser {
     explicit Parser(Source::File const* file);
     ~Parser();
 
-    /// Reads tokens from the source file. This will be called automatically
-    /// by |parse|.
+    /// Prepares the lexing of the source file. The tokens are then lexed on demand as the parser
+    /// consumes them. This will be called automatically by |parse|.
     void InitializeLex();
 
     /// Run the parser
@@ -867,6 +869,17 @@ class Parser {
     Maybe<const ast::Statement*> for_header_initializer();
     Maybe<const ast::Statement*> for_header_continuing();
 
+    /// Lexes and classifies tokens until the token at @p idx can be parsed.
+    /// @param idx the index of the token in the token stream
+    /// @returns false if the token stream ends before @p idx
+    bool lex_until(size_t idx);
+    /// @param idx the index of the token in the token stream
+    /// @returns the token at @p idx, which must have been lexed
+    Token& token_at(size_t idx) { return tokens_[idx - first_token_idx_]; }
+    /// Releases the tokens before the last consumed token. This must only be called when no
+    /// reference to a consumed token is held, like in between global declarations.
+    void release_consumed_tokens();
+
     class MultiTokenSource;
     MultiTokenSource make_source_range();
     MultiTokenSource make_source_range_from(const Source& start);
@@ -881,7 +894,15 @@ class Parser {
     }
 
     Source::File const* const file_;
-    std::vector<Token> tokens_;
+    std::unique_ptr<Lexer> lexer_;
+    TemplateArgumentClassifier classifier_;
+    /// The window of lexed tokens, which starts at the index first_token_idx_ of the token stream.
+    /// A std::deque keeps the references to the tokens valid while more tokens are lexed.
+    std::deque<Token> tokens_;
+    size_t first_token_idx_ = 0;
+    /// The number of tokens of the stream that were classified by classifier_.
+    size_t classified_token_count_ = 0;
+    bool lexed_all_tokens_ = false;
     size_t next_token_idx_ = 0;
     size_t last_source_idx_ = 0;
     bool synchronized_ = true;
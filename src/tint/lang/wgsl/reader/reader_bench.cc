@@ -12,13 +12,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <string>
 
 #include "src/tint/bench/benchmark.h"
+#include "src/tint/lang/wgsl/reader/parser/lexer.h"
+#include "src/tint/lang/wgsl/reader/parser/parser.h"
 
 namespace tint::wgsl::reader {
 namespace {
 
+/// @returns the number of tokens in @p file, not counting the placeholders for split tokens
+size_t CountTokens(const Source::File& file) {
+    Lexer lexer(&file);
+    auto tokens = lexer.Lex();
+    return static_cast<size_t>(std::count_if(tokens.begin(), tokens.end(),
+                                             [](const Token& t) { return !t.IsPlaceholder(); }));
+}
+
 void ParseWGSL(benchmark::State& state, std::string input_name) {
     auto res = bench::LoadInputFile(input_name);
     if (auto err = std::get_if<bench::Error>(&res)) {
@@ -26,12 +37,22 @@ void ParseWGSL(benchmark::State& state, std::string input_name) {
         return;
     }
     auto& file = std::get<Source::File>(res);
+    size_t token_count = CountTokens(file);
+
+    size_t peak_bytes = 0;
     for (auto _ : state) {
+        size_t bytes_before = bench::MemoryUsage::Current();
+        bench::MemoryUsage::ResetPeak();
         auto res = Parse(&file);
         if (res.Diagnostics().contains_errors()) {
             state.SkipWithError(res.Diagnostics().str().c_str());
         }
+        peak_bytes = std::max(peak_bytes, bench::MemoryUsage::Peak() - bytes_before);
     }
+
+    state.counters["peak_bytes"] = static_cast<double>(peak_bytes);
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(token_count),
+                                                  benchmark::Counter::kIsIterationInvariantRate);
 }
 
 TINT_BENCHMARK_PROGRAMS(ParseWGSL);
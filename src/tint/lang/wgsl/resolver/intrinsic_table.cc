@@ -951,6 +951,38 @@ bool operator==(const IntrinsicPrototype& a, const IntrinsicPrototype& b) {
     return true;
 }
 
+/// IntrinsicMatchKey is the key of the cache of overload resolutions. Types are interned per
+/// program, so type pointers uniquely identify the types of the arguments.
+struct IntrinsicMatchKey {
+    /// Hasher provides a hash function for the IntrinsicMatchKey
+    struct Hasher {
+        /// @param k the IntrinsicMatchKey to create a hash for
+        /// @return the hash value
+        inline std::size_t operator()(const IntrinsicMatchKey& k) const {
+            size_t hash = Hash(k.intrinsic, k.earliest_eval_stage, k.template_type);
+            for (auto* arg : k.args) {
+                hash = HashCombine(hash, arg);
+            }
+            return hash;
+        }
+    };
+
+    /// The intrinsic being called
+    const IntrinsicInfo* intrinsic = nullptr;
+    /// The earliest evaluation stage of the call
+    sem::EvaluationStage earliest_eval_stage = sem::EvaluationStage::kRuntime;
+    /// The explicit template type of a value constructor or conversion, if any
+    const type::Type* template_type = nullptr;
+    /// The argument types
+    Vector<const type::Type*, kNumFixedParams> args;
+};
+
+/// Equality operator for IntrinsicMatchKey
+bool operator==(const IntrinsicMatchKey& a, const IntrinsicMatchKey& b) {
+    return a.intrinsic == b.intrinsic && a.earliest_eval_stage == b.earliest_eval_stage &&
+           a.template_type == b.template_type && a.args == b.args;
+}
+
 /// Impl is the private implementation of the IntrinsicTable interface.
 class Impl : public IntrinsicTable {
   public:
@@ -1019,12 +1051,14 @@ class Impl : public IntrinsicTable {
     /// @returns the matched intrinsic. If no intrinsic could be matched then IntrinsicPrototype
     ///          will hold nullptrs for IntrinsicPrototype::overload and
     ///          IntrinsicPrototype::return_type.
+    /// @note successful matches are cached, so that later calls with the same argument types skip
+    ///       the scoring of the overloads.
     IntrinsicPrototype MatchIntrinsic(const IntrinsicInfo& intrinsic,
                                       const char* intrinsic_name,
                                       VectorRef<const type::Type*> args,
                                       sem::EvaluationStage earliest_eval_stage,
                                       TemplateState templates,
-                                      const OnNoMatch& on_no_match) const;
+                                      const OnNoMatch& on_no_match);
 
     /// Evaluates the single overload for the provided argument types.
     /// @param overload the overload being considered
@@ -1080,6 +1114,7 @@ class Impl : public IntrinsicTable {
 
     ProgramBuilder& builder;
     Matchers matchers;
+    Hashmap<IntrinsicMatchKey, IntrinsicPrototype, 64, IntrinsicMatchKey::Hasher> matches;
     Hashmap<IntrinsicPrototype, sem::Builtin*, 64, IntrinsicPrototype::Hasher> builtins;
     Hashmap<IntrinsicPrototype, sem::ValueConstructor*, 16, IntrinsicPrototype::Hasher>
         constructors;
@@ -1386,7 +1421,12 @@ IntrinsicPrototype Impl::MatchIntrinsic(const IntrinsicInfo& intrinsic,
                                         VectorRef<const type::Type*> args,
                                         sem::EvaluationStage earliest_eval_stage,
                                         TemplateState templates,
-                                        const OnNoMatch& on_no_match) const {
+                                        const OnNoMatch& on_no_match) {
+    IntrinsicMatchKey key{&intrinsic, earliest_eval_stage, templates.Type(0), args};
+    if (auto cached = matches.Find(key)) {
+        return *cached;
+    }
+
     size_t num_matched = 0;
     size_t match_idx = 0;
     Vector<Candidate, kNumFixedCandidates> candidates;
@@ -1436,7 +1476,9 @@ IntrinsicPrototype Impl::MatchIntrinsic(const IntrinsicInfo& intrinsic,
         return_type = builder.create<type::Void>();
     }
 
-    return IntrinsicPrototype{match.overload, return_type, std::move(match.parameters)};
+    IntrinsicPrototype prototype{match.overload, return_type, std::move(match.parameters)};
+    matches.Add(std::move(key), prototype);
+    return prototype;
 }
 
 Impl::Candidate Impl::ScoreOverload(const OverloadInfo* overload,
@@ -731,6 +731,18 @@ TEST_F(IntrinsicTableTest, MatchUnaryOp_Runtime) {
     EXPECT_EQ(Diagnostics().str(), "");
 }
 
+TEST_F(IntrinsicTableTest, MatchUnaryOp_ConstantThenRuntime) {
+    // The matches are cached, so the second lookup must not reuse the constant match.
+    auto* ai = create<type::AbstractInt>();
+    auto constant = table->Lookup(ast::UnaryOp::kNegation, ai, sem::EvaluationStage::kConstant,
+                                  Source{{12, 34}});
+    auto runtime = table->Lookup(ast::UnaryOp::kNegation, ai, sem::EvaluationStage::kRuntime,
+                                 Source{{12, 34}});
+    EXPECT_EQ(constant.result, ai);
+    EXPECT_TRUE(runtime.result->Is<type::I32>());
+    EXPECT_EQ(Diagnostics().str(), "");
+}
+
 TEST_F(IntrinsicTableTest, MatchBinaryOp) {
     auto* i32 = create<type::I32>();
     auto* vec3_i32 = create<type::Vector>(i32, 3u);
@@ -959,6 +971,21 @@ TEST_F(IntrinsicTableTest, MatchTypeConversion) {
     EXPECT_EQ(result.target->Parameters()[0]->Type(), vec3_f32);
 }
 
+TEST_F(IntrinsicTableTest, MatchTypeConversion_DifferentTemplateTypes) {
+    // The matches are cached, so the template type must distinguish the second lookup.
+    auto* i32 = create<type::I32>();
+    auto* u32 = create<type::U32>();
+    auto* vec3_f32 = create<type::Vector>(create<type::F32>(), 3u);
+    auto to_i32 = table->Lookup(CtorConvIntrinsic::kVec3, i32, Vector{vec3_f32},
+                                sem::EvaluationStage::kConstant, Source{{12, 34}});
+    auto to_u32 = table->Lookup(CtorConvIntrinsic::kVec3, u32, Vector{vec3_f32},
+                                sem::EvaluationStage::kConstant, Source{{12, 34}});
+    ASSERT_NE(to_i32.target, nullptr);
+    ASSERT_NE(to_u32.target, nullptr);
+    EXPECT_EQ(to_i32.target->ReturnType(), create<type::Vector>(i32, 3u));
+    EXPECT_EQ(to_u32.target->ReturnType(), create<type::Vector>(u32, 3u));
+}
+
 TEST_F(IntrinsicTableTest, MismatchTypeConversion) {
     auto* arr =
         create<type::Array>(create<type::U32>(), create<type::RuntimeArrayCount>(), 4u, 4u, 4u, 4u);
@@ -15,6 +15,8 @@
 #ifndef SRC_TINT_LANG_WGSL_RESOLVER_RESOLVE_H_
 #define SRC_TINT_LANG_WGSL_RESOLVER_RESOLVE_H_
 
+#include <cstdint>
+
 namespace tint {
 class Program;
 class ProgramBuilder;
@@ -22,9 +24,19 @@ class ProgramBuilder;
 
 namespace tint::resolver {
 
+/// Options used by Resolve()
+struct Options {
+    /// The number of threads used to analyze the uniformity of the functions. Functions are
+    /// analyzed on the calling thread if this is 1 or less. The rest of the resolving always runs
+    /// on the calling thread.
+    uint32_t uniformity_thread_count = 1;
+};
+
 /// Performs semantic analysis and validation on the program builder @p builder
+/// @param builder the program builder
+/// @param options the resolver options
 /// @returns the resolved Program. Program.Diagnostics() may contain validation errors.
-Program Resolve(ProgramBuilder& builder);
+Program Resolve(ProgramBuilder& builder, const Options& options = {});
 
 }  // namespace tint::resolver
 
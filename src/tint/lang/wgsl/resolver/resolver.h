@@ -28,6 +28,7 @@
 #include "src/tint/lang/wgsl/resolver/const_eval.h"
 #include "src/tint/lang/wgsl/resolver/dependency_graph.h"
 #include "src/tint/lang/wgsl/resolver/intrinsic_table.h"
+#include "src/tint/lang/wgsl/resolver/resolve.h"
 #include "src/tint/lang/wgsl/resolver/sem_helper.h"
 #include "src/tint/lang/wgsl/resolver/validator.h"
 #include "src/tint/lang/wgsl/sem/block_statement.h"
@@ -80,7 +81,8 @@ class Resolver {
   public:
     /// Constructor
     /// @param builder the program builder
-    explicit Resolver(ProgramBuilder* builder);
+    /// @param options the resolver options
+    explicit Resolver(ProgramBuilder* builder, const Options& options = {});
 
     /// Destructor
     ~Resolver();
@@ -603,6 +605,7 @@ class Resolver {
     };
 
     ProgramBuilder* const builder_;
+    const Options options_;
     diag::List& diagnostics_;
     ConstEval const_eval_;
     std::unique_ptr<IntrinsicTable> const intrinsic_table_;
@@ -0,0 +1,121 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include "src/tint/bench/benchmark.h"
+#include "src/tint/lang/wgsl/resolver/resolve.h"
+#include "src/tint/utils/text/string_stream.h"
+
+namespace tint::resolver {
+namespace {
+
+/// @returns a WGSL fragment shader with @p count pairs of statements, each making a few builtin
+/// function calls with the same argument types. The uniformity analysis is disabled so that the
+/// resolving of the calls dominates.
+std::string BuiltinCallShader(size_t count) {
+    StringStream wgsl;
+    wgsl << R"(enable chromium_disable_uniformity_analysis;
+
+@group(0) @binding(0) var t : texture_2d<f32>;
+@group(0) @binding(1) var s : sampler;
+
+@fragment
+fn main(@location(0) uv : vec2<f32>, @location(1) n : vec3<f32>) -> @location(0) vec4<f32> {
+  var color = vec4<f32>();
+  var l = normalize(n);
+)";
+    for (size_t i = 0; i < count; i++) {
+        wgsl << "  color += mix(textureSample(t, s, uv + vec2<f32>(" << i << ".0)), color, "
+             << "clamp(dot(l, n), 0.0, 1.0));\n";
+        wgsl << "  l = normalize(cross(l, n) + vec3<f32>(max(color.x, abs(color.y))));\n";
+    }
+    wgsl << "  return color;\n";
+    wgsl << "}\n";
+    return wgsl.str();
+}
+
+/// Resolves a shader dominated by builtin calls, where most calls use argument types that were
+/// already seen by the intrinsic table.
+void ResolveBuiltinCalls(benchmark::State& state) {
+    Source::File file("builtins.wgsl", BuiltinCallShader(static_cast<size_t>(state.range(0))));
+
+    bench::TimeResolve(state, file);
+
+    // Each pair of generated statements makes 8 builtin calls.
+    state.counters["calls"] = benchmark::Counter(static_cast<double>(state.range(0) * 8),
+                                                 benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(ResolveBuiltinCalls)->Arg(100)->Arg(1000)->Arg(4000);
+
+/// The number of layers of functions in the synthetic shader.
+constexpr size_t kSyntheticLayers = 16;
+/// The number of functions in each layer of the synthetic shader.
+constexpr size_t kSyntheticFunctionsPerLayer = 64;
+
+/// @returns a WGSL shader with kSyntheticLayers layers of kSyntheticFunctionsPerLayer functions,
+/// where each function calls two functions of the layer below.
+std::string SyntheticShader() {
+    StringStream wgsl;
+    wgsl << "@group(0) @binding(0) var<storage, read_write> output : array<f32>;\n\n";
+    for (size_t layer = 0; layer < kSyntheticLayers; layer++) {
+        for (size_t i = 0; i < kSyntheticFunctionsPerLayer; i++) {
+            wgsl << "fn f_" << layer << "_" << i << "(x : f32) -> f32 {\n";
+            if (layer == 0) {
+                wgsl << "  var v = x;\n";
+            } else {
+                size_t next = (i + 1) % kSyntheticFunctionsPerLayer;
+                wgsl << "  var v = f_" << layer - 1 << "_" << i << "(x) + f_" << layer - 1 << "_"
+                     << next << "(x * 2.0);\n";
+            }
+            wgsl << "  for (var i = 0; i < 4; i++) {\n";
+            wgsl << "    if (v > f32(i)) {\n";
+            wgsl << "      v = v * 0.5 + sin(v);\n";
+            wgsl << "    } else {\n";
+            wgsl << "      v = max(v, x) - cos(v);\n";
+            wgsl << "    }\n";
+            wgsl << "  }\n";
+            wgsl << "  return v;\n";
+            wgsl << "}\n\n";
+        }
+    }
+    wgsl << "@compute @workgroup_size(64)\n";
+    wgsl << "fn main(@builtin(global_invocation_id) id : vec3<u32>) {\n";
+    for (size_t i = 0; i < kSyntheticFunctionsPerLayer; i++) {
+        wgsl << "  output[id.x + " << i << "] = f_" << kSyntheticLayers - 1 << "_" << i
+             << "(f32(id.x));\n";
+    }
+    wgsl << "}\n";
+    return wgsl.str();
+}
+
+/// Resolves the synthetic shader, analyzing the uniformity of its functions on state.range(0)
+/// threads.
+void ResolveWithParallelUniformity(benchmark::State& state) {
+    Source::File file("synthetic.wgsl", SyntheticShader());
+    Options options;
+    options.uniformity_thread_count = static_cast<uint32_t>(state.range(0));
+
+    bench::TimeResolve(state, file, options);
+
+    state.counters["functions"] =
+        benchmark::Counter(static_cast<double>(kSyntheticLayers * kSyntheticFunctionsPerLayer + 1),
+                           benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(ResolveWithParallelUniformity)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+}  // namespace
+}  // namespace tint::resolver
@@ -14,8 +14,12 @@
 
 #include "src/tint/lang/wgsl/resolver/uniformity.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -340,7 +344,10 @@ class UniformityGraph {
     /// Constructor.
     /// @param builder the program to analyze
     explicit UniformityGraph(ProgramBuilder* builder)
-        : builder_(builder), sem_(builder->Sem()), diagnostics_(builder->Diagnostics()) {}
+        : builder_(builder),
+          sem_(builder->Sem()),
+          diagnostics_(&builder->Diagnostics()),
+          functions_(&owned_functions_) {}
 
     /// Destructor.
     ~UniformityGraph() {}
@@ -348,20 +355,26 @@ class UniformityGraph {
     /// Build and analyze the graph to determine whether the program satisfies the uniformity
     /// constraints of WGSL.
     /// @param dependency_graph the dependency-ordered module-scope declarations
+    /// @param thread_count the number of threads used to analyze the functions
     /// @returns true if all uniformity constraints are satisfied, otherise false
-    bool Build(const DependencyGraph& dependency_graph) {
+    bool Build(const DependencyGraph& dependency_graph, uint32_t thread_count) {
 #if TINT_DUMP_UNIFORMITY_GRAPH
         std::cout << "digraph G {\n";
         std::cout << "rankdir=BT\n";
+        thread_count = 1;
 #endif
 
         // Process all functions in the module.
         bool success = true;
-        for (auto* decl : dependency_graph.ordered_globals) {
-            if (auto* func = decl->As<ast::Function>()) {
-                if (!ProcessFunction(func)) {
-                    success = false;
-                    break;
+        if (thread_count > 1) {
+            success = ProcessFunctionsInParallel(dependency_graph, thread_count);
+        } else {
+            for (auto* decl : dependency_graph.ordered_globals) {
+                if (auto* func = decl->As<ast::Function>()) {
+                    if (!ProcessFunction(func)) {
+                        success = false;
+                        break;
+                    }
                 }
             }
         }
@@ -374,12 +387,33 @@ class UniformityGraph {
     }
 
   private:
+    /// Map of function to analyzed function results.
+    using FunctionInfoMap = Hashmap<const ast::Function*, FunctionInfo, 8>;
+
+    /// Constructor of a graph that analyzes functions in parallel with @p parent.
+    /// @param parent the graph that owns the function results
+    /// @param error_mutex the mutex held while reporting uniformity errors
+    UniformityGraph(const UniformityGraph& parent, std::mutex* error_mutex)
+        : builder_(parent.builder_),
+          sem_(parent.sem_),
+          diagnostics_(nullptr),
+          functions_(parent.functions_),
+          error_mutex_(error_mutex) {}
+
     const ProgramBuilder* builder_;
     const sem::Info& sem_;
-    diag::List& diagnostics_;
+    diag::List* diagnostics_;
 
-    /// Map of analyzed function results.
-    Hashmap<const ast::Function*, FunctionInfo, 8> functions_;
+    /// Map of analyzed function results, owned by the graph that analyzes the module.
+    FunctionInfoMap owned_functions_;
+
+    /// Map of analyzed function results. Points to owned_functions_ of the graph that analyzes
+    /// the module.
+    FunctionInfoMap* functions_;
+
+    /// The mutex held while reporting a uniformity error, as this traverses the graphs of the
+    /// called functions. nullptr when the functions are analyzed on a single thread.
+    std::mutex* error_mutex_ = nullptr;
 
     /// The function currently being analyzed.
     FunctionInfo* current_function_;
@@ -414,11 +448,123 @@ class UniformityGraph {
         return fn->Declaration()->name->symbol.Name();
     }
 
+    /// Process the functions of the module on @p thread_count threads. A function is processed
+    /// once all the functions that it calls have been processed. The diagnostics of each function
+    /// are added in declaration order up to the first function that fails, so that they match
+    /// the diagnostics of processing the functions on a single thread.
+    /// @param dependency_graph the dependency-ordered module-scope declarations
+    /// @param thread_count the number of threads used to process the functions
+    /// @returns true if there are no uniformity issues, false otherwise
+    bool ProcessFunctionsInParallel(const DependencyGraph& dependency_graph,
+                                    uint32_t thread_count) {
+        struct Task {
+            const ast::Function* func = nullptr;
+            FunctionInfo* info = nullptr;
+            /// The diagnostics raised while processing the function.
+            diag::List diagnostics;
+            /// The indices of the tasks of the functions that call this function.
+            Vector<size_t, 4> callers;
+            /// The number of calls to functions that have not been processed yet.
+            size_t pending_callees = 0;
+            /// True if a called function failed, in which case this function is not processed.
+            bool callee_failed = false;
+            bool success = false;
+        };
+
+        std::vector<Task> tasks;
+        Hashmap<const ast::Function*, size_t, 64> task_indices;
+        for (auto* decl : dependency_graph.ordered_globals) {
+            if (auto* func = decl->As<ast::Function>()) {
+                task_indices.Add(func, tasks.size());
+                tasks.emplace_back().func = func;
+                functions_->Add(func, FunctionInfo(func, builder_));
+            }
+        }
+        if (tasks.empty()) {
+            return true;
+        }
+
+        // The function results must not move while the tasks run, so only take their addresses
+        // once they have all been created.
+        Vector<size_t, 64> ready;
+        for (size_t i = 0; i < tasks.size(); i++) {
+            auto& task = tasks[i];
+            task.info = functions_->Find(task.func);
+            for (auto* call : sem_.Get(task.func)->DirectCalls()) {
+                if (auto* callee = call->Target()->As<sem::Function>()) {
+                    tasks[*task_indices.Find(callee->Declaration())].callers.Push(i);
+                    task.pending_callees++;
+                }
+            }
+            if (task.pending_callees == 0) {
+                ready.Push(i);
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::mutex error_mutex;
+        size_t remaining = tasks.size();
+        auto run = [&] {
+            UniformityGraph graph(*this, &error_mutex);
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                cv.wait(lock, [&] { return !ready.IsEmpty() || remaining == 0; });
+                if (remaining == 0) {
+                    return;
+                }
+                auto& task = tasks[ready.Pop()];
+                lock.unlock();
+
+                if (!task.callee_failed) {
+                    graph.diagnostics_ = &task.diagnostics;
+                    task.success = graph.ProcessFunction(task.func, task.info);
+                }
+
+                lock.lock();
+                remaining--;
+                for (size_t caller : task.callers) {
+                    auto& caller_task = tasks[caller];
+                    caller_task.callee_failed |= !task.success;
+                    if (--caller_task.pending_callees == 0) {
+                        ready.Push(caller);
+                    }
+                }
+                cv.notify_all();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < std::min<size_t>(thread_count, tasks.size()); i++) {
+            threads.emplace_back(run);
+        }
+        run();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (auto& task : tasks) {
+            diagnostics_->add(task.diagnostics);
+            if (!task.success) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     /// Process a function.
     /// @param func the function to process
     /// @returns true if there are no uniformity issues, false otherwise
     bool ProcessFunction(const ast::Function* func) {
-        current_function_ = functions_.Add(func, FunctionInfo(func, builder_)).value;
+        return ProcessFunction(func, functions_->Add(func, FunctionInfo(func, builder_)).value);
+    }
+
+    /// Process a function with an already created FunctionInfo.
+    /// @param func the function to process
+    /// @param info the FunctionInfo of @p func
+    /// @returns true if there are no uniformity issues, false otherwise
+    bool ProcessFunction(const ast::Function* func, FunctionInfo* info) {
+        current_function_ = info;
 
         // Process function body.
         if (func->body) {
@@ -463,6 +609,10 @@ class UniformityGraph {
             auto traverse = [&](builtin::DiagnosticSeverity severity) {
                 Traverse(current_function_->RequiredToBeUniform(severity), &reachable);
                 if (reachable.Contains(current_function_->may_be_non_uniform)) {
+                    std::unique_lock<std::mutex> lock;
+                    if (error_mutex_) {
+                        lock = std::unique_lock<std::mutex>(*error_mutex_);
+                    }
                     MakeError(*current_function_, current_function_->may_be_non_uniform, severity);
                     return false;
                 }
@@ -1573,7 +1723,7 @@ class UniformityGraph {
             [&](const sem::Function* func) {
                 // We must have already analyzed the user-defined function since we process
                 // functions in dependency order.
-                auto info = functions_.Find(func->Declaration());
+                auto info = functions_->Find(func->Declaration());
                 TINT_ASSERT(info != nullptr);
                 callsite_tag = info->callsite_tag;
                 function_tag = info->function_tag;
@@ -1734,7 +1884,7 @@ class UniformityGraph {
         } else if (auto* user = target->As<sem::Function>()) {
             // This is a call to a user-defined function, so inspect the functions called by that
             // function and look for one whose node has an edge from the RequiredToBeUniform node.
-            auto target_info = functions_.Find(user->Declaration());
+            auto target_info = functions_->Find(user->Declaration());
             for (auto* call_node : target_info->RequiredToBeUniform(severity)->edges) {
                 if (call_node->type == Node::kRegular) {
                     auto* child_call = call_node->ast->As<ast::CallExpression>();
@@ -1767,9 +1917,9 @@ class UniformityGraph {
         auto* control_flow = TraceBackAlongPathUntil(
             non_uniform_source, [](Node* node) { return node->affects_control_flow; });
         if (control_flow) {
-            diagnostics_.add_note(diag::System::Resolver,
-                                  "control flow depends on possibly non-uniform value",
-                                  control_flow->ast->source);
+            diagnostics_->add_note(diag::System::Resolver,
+                                   "control flow depends on possibly non-uniform value",
+                                   control_flow->ast->source);
             // TODO(jrprice): There are cases where the function with uniformity requirements is not
             // actually inside this control flow construct, for example:
             // - A conditional interrupt (e.g. break), with a barrier elsewhere in the loop
@@ -1823,20 +1973,20 @@ class UniformityGraph {
                     ss << "reading from " << var_type(var) << "'" << NameFor(ident)
                        << "' may result in a non-uniform value";
                 }
-                diagnostics_.add_note(diag::System::Resolver, ss.str(), ident->source);
+                diagnostics_->add_note(diag::System::Resolver, ss.str(), ident->source);
             },
             [&](const ast::Variable* v) {
                 auto* var = sem_.Get(v);
                 StringStream ss;
                 ss << "reading from " << var_type(var) << "'" << NameFor(v)
                    << "' may result in a non-uniform value";
-                diagnostics_.add_note(diag::System::Resolver, ss.str(), v->source);
+                diagnostics_->add_note(diag::System::Resolver, ss.str(), v->source);
             },
             [&](const ast::CallExpression* c) {
                 auto target_name = NameFor(c->target);
                 switch (non_uniform_source->type) {
                     case Node::kFunctionCallReturnValue: {
-                        diagnostics_.add_note(
+                        diagnostics_->add_note(
                             diag::System::Resolver,
                             "return value of '" + target_name + "' may be non-uniform", c->source);
                         break;
@@ -1847,21 +1997,21 @@ class UniformityGraph {
                         StringStream ss;
                         ss << "reading from " << var_type(var) << "'" << NameFor(var)
                            << "' may result in a non-uniform value";
-                        diagnostics_.add_note(diag::System::Resolver, ss.str(),
-                                              var->Declaration()->source);
+                        diagnostics_->add_note(diag::System::Resolver, ss.str(),
+                                               var->Declaration()->source);
                         break;
                     }
                     case Node::kFunctionCallArgumentValue: {
                         auto* arg = c->args[non_uniform_source->arg_index];
                         // TODO(jrprice): Which output? (return value vs another pointer argument).
-                        diagnostics_.add_note(diag::System::Resolver,
-                                              "passing non-uniform pointer to '" + target_name +
-                                                  "' may produce a non-uniform output",
-                                              arg->source);
+                        diagnostics_->add_note(diag::System::Resolver,
+                                               "passing non-uniform pointer to '" + target_name +
+                                                   "' may produce a non-uniform output",
+                                               arg->source);
                         break;
                     }
                     case Node::kFunctionCallPointerArgumentResult: {
-                        diagnostics_.add_note(
+                        diagnostics_->add_note(
                             diag::System::Resolver,
                             "contents of pointer may become non-uniform after calling '" +
                                 target_name + "'",
@@ -1875,8 +2025,8 @@ class UniformityGraph {
                 }
             },
             [&](const ast::Expression* e) {
-                diagnostics_.add_note(diag::System::Resolver,
-                                      "result of expression may be non-uniform", e->source);
+                diagnostics_->add_note(diag::System::Resolver,
+                                       "result of expression may be non-uniform", e->source);
             },
             [&](Default) { TINT_ICE() << "unhandled source of non-uniformity"; });
     }
@@ -1895,7 +2045,7 @@ class UniformityGraph {
             error.system = diag::System::Resolver;
             error.source = source;
             error.message = msg;
-            diagnostics_.add(std::move(error));
+            diagnostics_->add(std::move(error));
         };
 
         // Traverse the graph to generate a path from RequiredToBeUniform to the source node.
@@ -1921,7 +2071,7 @@ class UniformityGraph {
             auto* user_func = target->As<sem::Function>();
             if (user_func) {
                 // Recurse into the called function to show the reason for the requirement.
-                auto next_function = functions_.Find(user_func->Declaration());
+                auto next_function = functions_->Find(user_func->Declaration());
                 auto& param_info = next_function->parameters[cause->arg_index];
                 MakeError(*next_function,
                           is_value ? param_info.value : param_info.ptr_input_contents, severity);
@@ -1971,9 +2121,11 @@ class UniformityGraph {
 
 }  // namespace
 
-bool AnalyzeUniformity(ProgramBuilder* builder, const DependencyGraph& dependency_graph) {
+bool AnalyzeUniformity(ProgramBuilder* builder,
+                       const DependencyGraph& dependency_graph,
+                       uint32_t thread_count) {
     UniformityGraph graph(builder);
-    return graph.Build(dependency_graph);
+    return graph.Build(dependency_graph, thread_count);
 }
 
 }  // namespace tint::resolver
@@ -15,6 +15,8 @@
 #ifndef SRC_TINT_LANG_WGSL_RESOLVER_UNIFORMITY_H_
 #define SRC_TINT_LANG_WGSL_RESOLVER_UNIFORMITY_H_
 
+#include <cstdint>
+
 // Forward declarations.
 namespace tint::resolver {
 struct DependencyGraph;
@@ -31,8 +33,11 @@ constexpr bool kUniformityFailuresAsError = true;
 /// Analyze the uniformity of a program.
 /// @param builder the program to analyze
 /// @param dependency_graph the dependency-ordered module-scope declarations
+/// @param thread_count the number of threads used to analyze the functions
 /// @returns true if there are no uniformity issues, false otherwise
-bool AnalyzeUniformity(ProgramBuilder* builder, const resolver::DependencyGraph& dependency_graph);
+bool AnalyzeUniformity(ProgramBuilder* builder,
+                       const resolver::DependencyGraph& dependency_graph,
+                       uint32_t thread_count = 1);
 
 }  // namespace tint::resolver
 
@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "src/tint/lang/wgsl/program/program_builder.h"
+#include "src/tint/lang/wgsl/reader/parser/parser.h"
 #include "src/tint/lang/wgsl/reader/reader.h"
 #include "src/tint/lang/wgsl/resolver/resolve.h"
 #include "src/tint/lang/wgsl/resolver/uniformity.h"
@@ -59,6 +60,15 @@ class UniformityAnalysisTestBase {
     void RunTest(std::string src, bool should_pass) {
         auto file = std::make_unique<Source::File>("test", src);
         auto program = wgsl::reader::Parse(file.get());
+
+        // Analyzing the functions on multiple threads must raise the same diagnostics.
+        wgsl::reader::Parser parser(file.get());
+        parser.Parse();
+        Options options;
+        options.uniformity_thread_count = 4;
+        auto parallel = resolver::Resolve(parser.builder(), options);
+        EXPECT_EQ(parallel.Diagnostics().str(), program.Diagnostics().str());
+
         return RunTest(std::move(program), should_pass);
     }
 
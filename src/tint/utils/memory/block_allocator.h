@@ -245,6 +245,15 @@ class BlockAllocator {
     /// @returns the total number of allocated objects.
     size_t Count() const { return data.count; }
 
+    /// @returns the total number of bytes of the blocks allocated from the heap.
+    size_t AllocatedBytes() const {
+        size_t bytes = 0;
+        for (auto* block = data.block.root; block != nullptr; block = block->next) {
+            bytes += sizeof(Block);
+        }
+        return bytes;
+    }
+
   private:
     BlockAllocator(const BlockAllocator&) = delete;
     BlockAllocator& operator=(const BlockAllocator&) = delete;